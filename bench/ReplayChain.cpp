@@ -0,0 +1,256 @@
+#include <bench/ReplayChain.hpp>
+#include <fmt/core.h>
+#include <fstream>
+#include <json/reader.h>
+#include <json/value.h>
+#include <json/writer.h>
+#include <jsonrpccpp/client.h>
+#include <jsonrpccpp/client/connectors/httpclient.h>
+#include <memory>
+#include <utilxx/Opt.hpp>
+#include <utilxx/Result.hpp>
+
+using forge::bench::ReplayChain;
+using forge::bench::BenchError;
+using utilxx::Opt;
+using utilxx::Result;
+
+namespace {
+
+auto hasOpReturn(const Json::Value& tx)
+    -> bool
+{
+    for(const auto& vout : tx["vout"]) {
+        if(vout["scriptPubKey"]["type"].asString() == "nulldata") {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+} // namespace
+
+
+ReplayChain::ReplayChain(std::vector<Json::Value>&& blocks,
+                         std::unordered_map<std::string, Json::Value>&& transactions)
+    : blocks_(std::move(blocks)),
+      transactions_(std::move(transactions)),
+      first_height_(blocks_.empty()
+                        ? 0
+                        : blocks_.front()["height"].asInt64())
+{
+    block_indices_.reserve(blocks_.size());
+    for(std::size_t i = 0; i < blocks_.size(); i++) {
+        block_indices_.emplace(blocks_[i]["hash"].asString(), i);
+    }
+}
+
+auto ReplayChain::getBlockCount() const
+    -> std::int64_t
+{
+    return first_height_ + static_cast<std::int64_t>(blocks_.size()) - 1;
+}
+
+auto ReplayChain::getFirstHeight() const
+    -> std::int64_t
+{
+    return first_height_;
+}
+
+auto ReplayChain::getNumberOfBlocks() const
+    -> std::size_t
+{
+    return blocks_.size();
+}
+
+auto ReplayChain::getNumberOfTransactions() const
+    -> std::size_t
+{
+    return transactions_.size();
+}
+
+auto ReplayChain::getBlockHash(std::int64_t height) const
+    -> Opt<std::string>
+{
+    if(height < first_height_ || height > getBlockCount()) {
+        return std::nullopt;
+    }
+
+    return blocks_[height - first_height_]["hash"].asString();
+}
+
+auto ReplayChain::getBlock(const std::string& hash) const
+    -> Opt<std::reference_wrapper<const Json::Value>>
+{
+    auto iter = block_indices_.find(hash);
+    if(iter == block_indices_.end()) {
+        return std::nullopt;
+    }
+
+    return std::cref(blocks_[iter->second]);
+}
+
+auto ReplayChain::getTransaction(const std::string& txid) const
+    -> Opt<std::reference_wrapper<const Json::Value>>
+{
+    auto iter = transactions_.find(txid);
+    if(iter == transactions_.end()) {
+        return std::nullopt;
+    }
+
+    return std::cref(iter->second);
+}
+
+auto ReplayChain::toJson() const
+    -> Json::Value
+{
+    Json::Value json;
+    json["blocks"] = Json::Value{Json::ValueType::arrayValue};
+    json["transactions"] = Json::Value{Json::ValueType::objectValue};
+
+    for(const auto& block : blocks_) {
+        json["blocks"].append(block);
+    }
+
+    for(const auto& [txid, tx] : transactions_) {
+        json["transactions"][txid] = tx;
+    }
+
+    return json;
+}
+
+auto forge::bench::loadReplayChain(const std::string& path)
+    -> Result<ReplayChain, BenchError>
+{
+    std::ifstream file{path};
+    if(!file) {
+        return BenchError{fmt::format("unable to open chain file {}", path)};
+    }
+
+    Json::CharReaderBuilder builder;
+    Json::Value json;
+    std::string errors;
+
+    if(!Json::parseFromStream(builder, file, &json, &errors)) {
+        return BenchError{fmt::format("unable to parse chain file {}: {}",
+                                      path,
+                                      errors)};
+    }
+
+    std::vector<Json::Value> blocks;
+    blocks.reserve(json["blocks"].size());
+    for(auto&& block : json["blocks"]) {
+        auto expected = blocks.empty()
+            ? block["height"].asInt64()
+            : blocks.back()["height"].asInt64() + 1;
+
+        if(block["height"].asInt64() != expected) {
+            return BenchError{fmt::format("chain file {} has a gap at height {}",
+                                          path,
+                                          expected)};
+        }
+
+        blocks.push_back(block);
+    }
+
+    std::unordered_map<std::string, Json::Value> transactions;
+    const auto& txs = json["transactions"];
+    for(const auto& txid : txs.getMemberNames()) {
+        transactions.emplace(txid, txs[txid]);
+    }
+
+    return ReplayChain{std::move(blocks),
+                       std::move(transactions)};
+}
+
+auto forge::bench::saveReplayChain(const ReplayChain& chain,
+                                   const std::string& path)
+    -> Result<void, BenchError>
+{
+    std::ofstream file{path};
+    if(!file) {
+        return BenchError{fmt::format("unable to create chain file {}", path)};
+    }
+
+    Json::StreamWriterBuilder builder;
+    builder["indentation"] = "";
+
+    std::unique_ptr<Json::StreamWriter> writer{builder.newStreamWriter()};
+    writer->write(chain.toJson(), &file);
+
+    if(!file) {
+        return BenchError{fmt::format("unable to write chain file {}", path)};
+    }
+
+    return {};
+}
+
+auto forge::bench::recordReplayChain(const std::string& host,
+                                     const std::string& user,
+                                     const std::string& password,
+                                     std::int64_t port,
+                                     std::int64_t first_height,
+                                     std::int64_t last_height)
+    -> Result<ReplayChain, BenchError>
+{
+    jsonrpc::HttpClient http_client{fmt::format("http://{}:{}@{}:{}",
+                                                user,
+                                                password,
+                                                host,
+                                                port)};
+    jsonrpc::Client client{http_client, jsonrpc::JSONRPC_CLIENT_V1};
+
+    std::vector<Json::Value> blocks;
+    std::unordered_map<std::string, Json::Value> transactions;
+
+    auto fetch_tx = [&](const std::string& txid)
+        -> const Json::Value& {
+        if(auto iter = transactions.find(txid);
+           iter != transactions.end()) {
+            return iter->second;
+        }
+
+        Json::Value params;
+        params.append(txid);
+        params.append(1);
+
+        auto tx = client.CallMethod("getrawtransaction", params);
+        return transactions.emplace(txid, std::move(tx)).first->second;
+    };
+
+    try {
+        for(auto height = first_height; height <= last_height; height++) {
+            Json::Value hash_params;
+            hash_params.append(static_cast<Json::Int64>(height));
+            auto hash = client.CallMethod("getblockhash", hash_params);
+
+            Json::Value block_params;
+            block_params.append(hash);
+            auto block = client.CallMethod("getblock", block_params);
+
+            for(const auto& txid : block["tx"]) {
+                const auto& tx = fetch_tx(txid.asString());
+
+                //forge operations resolve the owner via the inputs
+                if(!hasOpReturn(tx)) {
+                    continue;
+                }
+
+                for(const auto& vin : tx["vin"]) {
+                    if(vin.isMember("txid")) {
+                        fetch_tx(vin["txid"].asString());
+                    }
+                }
+            }
+
+            blocks.push_back(std::move(block));
+        }
+    } catch(const jsonrpc::JsonRpcException& e) {
+        return BenchError{fmt::format("recording the chain failed: {}",
+                                      e.what())};
+    }
+
+    return ReplayChain{std::move(blocks),
+                       std::move(transactions)};
+}
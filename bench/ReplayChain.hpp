@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <json/value.h>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utilxx/Opt.hpp>
+#include <utilxx/Result.hpp>
+#include <vector>
+
+namespace forge::bench {
+
+class BenchError final : public std::runtime_error
+{
+public:
+    using std::runtime_error::runtime_error;
+};
+
+//recorded or synthetic chain which is served by the replay daemon.
+//Blocks and transactions are stored as the json the odin daemon returns
+//for getblock and getrawtransaction <txid> 1, the file format is
+//{"blocks" : [...], "transactions" : {"<txid>" : {...}, ...}}
+//with the blocks ordered by height without gaps.
+class ReplayChain final
+{
+public:
+    ReplayChain(std::vector<Json::Value>&& blocks,
+                std::unordered_map<std::string, Json::Value>&& transactions);
+
+    //height of the newest block
+    auto getBlockCount() const
+        -> std::int64_t;
+
+    auto getFirstHeight() const
+        -> std::int64_t;
+
+    auto getNumberOfBlocks() const
+        -> std::size_t;
+
+    auto getNumberOfTransactions() const
+        -> std::size_t;
+
+    auto getBlockHash(std::int64_t height) const
+        -> utilxx::Opt<std::string>;
+
+    auto getBlock(const std::string& hash) const
+        -> utilxx::Opt<std::reference_wrapper<const Json::Value>>;
+
+    auto getTransaction(const std::string& txid) const
+        -> utilxx::Opt<std::reference_wrapper<const Json::Value>>;
+
+    auto toJson() const
+        -> Json::Value;
+
+private:
+    std::vector<Json::Value> blocks_;
+    std::unordered_map<std::string, std::size_t> block_indices_;
+    std::unordered_map<std::string, Json::Value> transactions_;
+    std::int64_t first_height_;
+};
+
+auto loadReplayChain(const std::string& path)
+    -> utilxx::Result<ReplayChain, BenchError>;
+
+auto saveReplayChain(const ReplayChain& chain,
+                     const std::string& path)
+    -> utilxx::Result<void, BenchError>;
+
+//fetches the blocks [first_height, last_height] from a running daemon,
+//together with all their transactions and the inputs of
+//all transactions which carry an OP_RETURN
+auto recordReplayChain(const std::string& host,
+                       const std::string& user,
+                       const std::string& password,
+                       std::int64_t port,
+                       std::int64_t first_height,
+                       std::int64_t last_height)
+    -> utilxx::Result<ReplayChain, BenchError>;
+
+} // namespace forge::bench
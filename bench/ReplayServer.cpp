@@ -0,0 +1,139 @@
+#include <bench/ReplayChain.hpp>
+#include <bench/ReplayServer.hpp>
+#include <fmt/core.h>
+#include <json/value.h>
+#include <jsonrpccpp/common/exception.h>
+#include <jsonrpccpp/server.h>
+#include <thread>
+
+using forge::bench::ReplayServer;
+using jsonrpc::JsonRpcException;
+using jsonrpc::PARAMS_BY_POSITION;
+using jsonrpc::Procedure;
+
+namespace {
+
+//error code odind uses for unknown blocks and transactions
+constexpr inline auto RPC_INVALID_ADDRESS_OR_KEY = -5;
+
+} // namespace
+
+
+ReplayServer::ReplayServer(jsonrpc::AbstractServerConnector& connector,
+                           const ReplayChain& chain,
+                           std::chrono::microseconds latency)
+    : jsonrpc::AbstractServer<ReplayServer>(connector, jsonrpc::JSONRPC_SERVER_V1V2),
+      chain_(chain),
+      latency_(latency),
+      calls_(0)
+{
+    bindAndAddMethod(Procedure("getblockcount",
+                               PARAMS_BY_POSITION,
+                               jsonrpc::JSON_INTEGER,
+                               NULL),
+                     &ReplayServer::getblockcountI);
+    bindAndAddMethod(Procedure("getblockhash",
+                               PARAMS_BY_POSITION,
+                               jsonrpc::JSON_STRING,
+                               "height",
+                               jsonrpc::JSON_INTEGER,
+                               NULL),
+                     &ReplayServer::getblockhashI);
+    bindAndAddMethod(Procedure("getblock",
+                               PARAMS_BY_POSITION,
+                               jsonrpc::JSON_OBJECT,
+                               "hash",
+                               jsonrpc::JSON_STRING,
+                               NULL),
+                     &ReplayServer::getblockI);
+    bindAndAddMethod(Procedure("getrawtransaction",
+                               PARAMS_BY_POSITION,
+                               jsonrpc::JSON_OBJECT,
+                               "txid",
+                               jsonrpc::JSON_STRING,
+                               "verbose",
+                               jsonrpc::JSON_INTEGER,
+                               NULL),
+                     &ReplayServer::getrawtransactionI);
+}
+
+auto ReplayServer::getNumberOfCalls() const
+    -> std::uint64_t
+{
+    return calls_.load();
+}
+
+auto ReplayServer::resetNumberOfCalls()
+    -> void
+{
+    calls_.store(0);
+}
+
+auto ReplayServer::getblockcountI(const Json::Value& /*request*/,
+                                  Json::Value& response)
+    -> void
+{
+    simulateLatency();
+    response = static_cast<Json::Int64>(chain_.getBlockCount());
+}
+
+auto ReplayServer::getblockhashI(const Json::Value& request,
+                                 Json::Value& response)
+    -> void
+{
+    simulateLatency();
+
+    auto height = request[0].asInt64();
+    auto hash_opt = chain_.getBlockHash(height);
+
+    if(!hash_opt) {
+        throw JsonRpcException{RPC_INVALID_ADDRESS_OR_KEY,
+                               fmt::format("Block height {} out of range", height)};
+    }
+
+    response = std::move(hash_opt.getValue());
+}
+
+auto ReplayServer::getblockI(const Json::Value& request,
+                             Json::Value& response)
+    -> void
+{
+    simulateLatency();
+
+    auto hash = request[0].asString();
+    auto block_opt = chain_.getBlock(hash);
+
+    if(!block_opt) {
+        throw JsonRpcException{RPC_INVALID_ADDRESS_OR_KEY,
+                               fmt::format("Block {} not found", hash)};
+    }
+
+    response = block_opt.getValue().get();
+}
+
+auto ReplayServer::getrawtransactionI(const Json::Value& request,
+                                      Json::Value& response)
+    -> void
+{
+    simulateLatency();
+
+    auto txid = request[0].asString();
+    auto tx_opt = chain_.getTransaction(txid);
+
+    if(!tx_opt) {
+        throw JsonRpcException{RPC_INVALID_ADDRESS_OR_KEY,
+                               fmt::format("No information available about transaction {}", txid)};
+    }
+
+    response = tx_opt.getValue().get();
+}
+
+auto ReplayServer::simulateLatency()
+    -> void
+{
+    calls_++;
+
+    if(latency_.count() > 0) {
+        std::this_thread::sleep_for(latency_);
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <bench/ReplayChain.hpp>
+#include <chrono>
+#include <cstdint>
+#include <json/value.h>
+#include <jsonrpccpp/server.h>
+
+namespace forge::bench {
+
+//stand-in for the odin daemon, it serves the read only calls
+//the lookup needs from a ReplayChain and delays every answer
+//by the given latency to simulate a remote node
+class ReplayServer final : public jsonrpc::AbstractServer<ReplayServer>
+{
+public:
+    ReplayServer(jsonrpc::AbstractServerConnector& connector,
+                 const ReplayChain& chain,
+                 std::chrono::microseconds latency);
+
+    //number of answered rpc calls
+    auto getNumberOfCalls() const
+        -> std::uint64_t;
+
+    auto resetNumberOfCalls()
+        -> void;
+
+    auto getblockcountI(const Json::Value& request,
+                        Json::Value& response)
+        -> void;
+
+    auto getblockhashI(const Json::Value& request,
+                       Json::Value& response)
+        -> void;
+
+    auto getblockI(const Json::Value& request,
+                   Json::Value& response)
+        -> void;
+
+    auto getrawtransactionI(const Json::Value& request,
+                            Json::Value& response)
+        -> void;
+
+private:
+    auto simulateLatency()
+        -> void;
+
+private:
+    const ReplayChain& chain_;
+    std::chrono::microseconds latency_;
+    std::atomic<std::uint64_t> calls_;
+};
+
+} // namespace forge::bench
@@ -0,0 +1,539 @@
+#include <algorithm>
+#include <bench/WorkloadGenerator.hpp>
+#include <cmath>
+#include <core/Transaction.hpp>
+#include <entrys/token/UtilityTokenCreationOp.hpp>
+#include <entrys/token/UtilityTokenDeletionOp.hpp>
+#include <entrys/token/UtilityTokenOwnershipTransferOp.hpp>
+#include <entrys/uentry/UniqueEntryCreationOp.hpp>
+#include <entrys/uentry/UniqueEntryDeletionOp.hpp>
+#include <entrys/uentry/UniqueEntryOwnershipTransferOp.hpp>
+#include <entrys/uentry/UniqueEntryRenewalOp.hpp>
+#include <entrys/umentry/UMEntryCreationOp.hpp>
+#include <entrys/umentry/UMEntryDeletionOp.hpp>
+#include <entrys/umentry/UMEntryOwnershipTransferOp.hpp>
+#include <entrys/umentry/UMEntryRenewalOp.hpp>
+#include <entrys/umentry/UMEntryUpdateOp.hpp>
+#include <fmt/core.h>
+#include <tuple>
+
+using forge::bench::GeneratedOperation;
+using forge::bench::WorkloadConfig;
+using forge::bench::WorkloadGenerator;
+using forge::bench::ZipfDistribution;
+using forge::core::EntryKey;
+using forge::core::IPv4Value;
+
+namespace {
+
+constexpr inline auto MAX_BURN_VALUE = 100000;
+constexpr inline auto MAX_TOKEN_SUPPLY = 1000000;
+
+//key tags, so keys of different entry types never collide
+constexpr inline auto UMENTRY_KEY_TAG = static_cast<std::byte>(0x01);
+constexpr inline auto UNIQUE_ENTRY_KEY_TAG = static_cast<std::byte>(0x02);
+constexpr inline auto UTILITY_TOKEN_KEY_TAG = static_cast<std::byte>(0x03);
+
+} // namespace
+
+
+ZipfDistribution::ZipfDistribution(std::size_t n, double skew)
+    : cdf_(std::max<std::size_t>(n, 1))
+{
+    auto sum = 0.0;
+    for(std::size_t i = 0; i < cdf_.size(); i++) {
+        sum += 1.0 / std::pow(static_cast<double>(i + 1), skew);
+        cdf_[i] = sum;
+    }
+}
+
+auto ZipfDistribution::operator()(std::mt19937_64& rng) const
+    -> std::size_t
+{
+    std::uniform_real_distribution<double> dist{0.0, cdf_.back()};
+    auto iter = std::lower_bound(std::cbegin(cdf_),
+                                 std::cend(cdf_),
+                                 dist(rng));
+
+    auto rank = std::distance(std::cbegin(cdf_), iter);
+    return std::min(static_cast<std::size_t>(rank),
+                    cdf_.size() - 1);
+}
+
+
+WorkloadGenerator::WorkloadGenerator(WorkloadConfig config)
+    : config_(config),
+      rng_(config.seed),
+      key_dist_(config.number_of_keys, config.key_skew),
+      owner_dist_(config.number_of_owners, config.owner_skew),
+      entry_kind_dist_({config.renewal_weight,
+                        config.transfer_weight,
+                        config.update_weight,
+                        config.deletion_weight}),
+      entry_kind_without_update_dist_({config.renewal_weight,
+                                       config.transfer_weight,
+                                       0.0,
+                                       config.deletion_weight}) {}
+
+auto WorkloadGenerator::nextUMEntryBlock(std::int64_t /*block*/)
+    -> std::vector<GeneratedOperation>
+{
+    auto factory = [](EntryOperationKind kind,
+                      EntryKey&& key,
+                      IPv4Value value)
+        -> std::vector<std::byte> {
+        core::UMEntry entry{std::move(key), value};
+
+        switch(kind) {
+        case EntryOperationKind::Creation:
+            return core::createUMEntryCreationOpMetadata(std::move(entry));
+        case EntryOperationKind::Renewal:
+            return core::createUMEntryRenewalOpMetadata(std::move(entry));
+        case EntryOperationKind::Transfer:
+            return core::createUMEntryOwnershipTransferOpMetadata(std::move(entry));
+        case EntryOperationKind::Update:
+            return core::createUMEntryUpdateOpMetadata(std::move(entry.getKey()),
+                                                       value);
+        case EntryOperationKind::Deletion:
+            return core::createUMEntryDeletionOpMetadata(std::move(entry));
+        }
+
+        return {};
+    };
+
+    return nextEntryBlock(um_entrys_,
+                          UMENTRY_KEY_TAG,
+                          true,
+                          factory);
+}
+
+auto WorkloadGenerator::nextUniqueEntryBlock(std::int64_t /*block*/)
+    -> std::vector<GeneratedOperation>
+{
+    auto factory = [](EntryOperationKind kind,
+                      EntryKey&& key,
+                      IPv4Value value)
+        -> std::vector<std::byte> {
+        core::UniqueEntry entry{std::move(key), value};
+
+        switch(kind) {
+        case EntryOperationKind::Creation:
+            return core::createUniqueEntryCreationOpMetadata(std::move(entry));
+        case EntryOperationKind::Renewal:
+            return core::createUniqueEntryRenewalOpMetadata(std::move(entry));
+        case EntryOperationKind::Transfer:
+            return core::createUniqueEntryOwnershipTransferOpMetadata(std::move(entry));
+        case EntryOperationKind::Deletion:
+            return core::createUniqueEntryDeletionOpMetadata(std::move(entry));
+        //unique entrys cannot be updated
+        case EntryOperationKind::Update:
+            break;
+        }
+
+        return {};
+    };
+
+    return nextEntryBlock(unique_entrys_,
+                          UNIQUE_ENTRY_KEY_TAG,
+                          false,
+                          factory);
+}
+
+auto WorkloadGenerator::nextUtilityTokenBlock(std::int64_t /*block*/)
+    -> std::vector<GeneratedOperation>
+{
+    std::vector<GeneratedOperation> ops;
+    ops.reserve(config_.ops_per_block);
+
+    //the lookup checks all operations of a block against the balances
+    //before the block, so debits and credits are applied after it
+    std::unordered_set<std::size_t> created;
+    std::map<std::pair<std::size_t, std::size_t>, std::uint64_t> debits;
+    std::vector<std::tuple<std::size_t, std::size_t, std::uint64_t>> credits;
+
+    auto outsider = config_.number_of_owners;
+
+    while(ops.size() < config_.ops_per_block) {
+        auto rank = key_dist_(rng_);
+        auto id = generateKey(UTILITY_TOKEN_KEY_TAG, rank);
+        auto iter = token_accounts_.find(rank);
+
+        if(iter == token_accounts_.end()) {
+            //a token which is already created in this block only gets
+            //deletions of an owner without balance, which the lookup ignores
+            if(!created.insert(rank).second) {
+                ops.push_back({core::createUtilityTokenDeletionOpMetadata({std::move(id), 1}),
+                               generateOwner(outsider),
+                               drawBurnValue(),
+                               std::nullopt});
+                continue;
+            }
+
+            auto owner = drawOwner();
+            auto burn = drawBurnValue();
+            std::uniform_int_distribution<std::uint64_t> supply_dist{1, MAX_TOKEN_SUPPLY};
+            auto supply = supply_dist(rng_);
+
+            ops.push_back({core::createUtilityTokenCreationOpMetadata({id, supply}),
+                           generateOwner(owner),
+                           burn,
+                           std::nullopt});
+
+            auto tie = false;
+            if(drawProbability() < config_.conflict_rate) {
+                tie = drawProbability() < config_.tie_rate;
+                std::uniform_int_distribution<std::int64_t> burn_dist{0, burn - 1};
+                auto competitor_burn = tie ? burn : burn_dist(rng_);
+
+                ops.push_back({core::createUtilityTokenCreationOpMetadata({std::move(id), supply_dist(rng_)}),
+                               generateOwner(drawOtherOwner(owner)),
+                               competitor_burn,
+                               std::nullopt});
+            }
+
+            //ambiguous creations are not executed
+            if(!tie) {
+                credits.emplace_back(rank, owner, supply);
+            }
+            continue;
+        }
+
+        auto& accounts = iter->second;
+        std::uniform_int_distribution<std::size_t> holder_dist{0, accounts.size() - 1};
+        auto [holder, balance] = *std::next(std::begin(accounts),
+                                            holder_dist(rng_));
+
+        auto& debit = debits[{rank, holder}];
+        auto available = balance - debit;
+
+        auto is_transfer =
+            drawProbability() * (config_.transfer_weight + config_.deletion_weight)
+            < config_.transfer_weight;
+        auto receiver = drawOtherOwner(holder);
+
+        //the lookup sorts the operations of a sender by burn value and stops
+        //at the first one exceeding the balance, so overspending operations
+        //burn nothing to not invalidate the other operations of the sender
+        if(available == 0 || drawProbability() < config_.conflict_rate) {
+            core::UtilityToken token{std::move(id), available + 1};
+            ops.push_back({is_transfer
+                               ? core::createUtilityTokenOwnershipTransferOpMetadata(std::move(token))
+                               : core::createUtilityTokenDeletionOpMetadata(std::move(token)),
+                           generateOwner(holder),
+                           0,
+                           is_transfer
+                               ? utilxx::Opt<std::string>{generateOwner(receiver)}
+                               : std::nullopt});
+            continue;
+        }
+
+        std::uniform_int_distribution<std::uint64_t> amount_dist{1, available};
+        auto amount = amount_dist(rng_);
+        debit += amount;
+
+        core::UtilityToken token{std::move(id), amount};
+        if(is_transfer) {
+            ops.push_back({core::createUtilityTokenOwnershipTransferOpMetadata(std::move(token)),
+                           generateOwner(holder),
+                           drawBurnValue(),
+                           generateOwner(receiver)});
+            credits.emplace_back(rank, receiver, amount);
+        } else {
+            ops.push_back({core::createUtilityTokenDeletionOpMetadata(std::move(token)),
+                           generateOwner(holder),
+                           drawBurnValue(),
+                           std::nullopt});
+        }
+    }
+
+    for(const auto& [account, amount] : debits) {
+        auto& accounts = token_accounts_[account.first];
+        if((accounts[account.second] -= amount) == 0) {
+            accounts.erase(account.second);
+        }
+    }
+
+    for(const auto& [rank, owner, amount] : credits) {
+        token_accounts_[rank][owner] += amount;
+    }
+
+    //tokens without any balance are removed by the lookup
+    for(auto iter = token_accounts_.begin(); iter != token_accounts_.end();) {
+        if(iter->second.empty()) {
+            iter = token_accounts_.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+
+    return ops;
+}
+
+auto WorkloadGenerator::getConfig() const
+    -> const WorkloadConfig&
+{
+    return config_;
+}
+
+auto WorkloadGenerator::nextEntryBlock(EntryShadowMap& shadow,
+                                       std::byte key_tag,
+                                       bool with_updates,
+                                       MetadataFactory factory)
+    -> std::vector<GeneratedOperation>
+{
+    std::vector<GeneratedOperation> ops;
+    ops.reserve(config_.ops_per_block);
+
+    std::unordered_set<std::size_t> touched;
+
+    //owner rank which never owns anything
+    auto outsider = config_.number_of_owners;
+
+    while(ops.size() < config_.ops_per_block) {
+        auto rank = key_dist_(rng_);
+        auto key = generateKey(key_tag, rank);
+        auto iter = shadow.find(rank);
+
+        //keys which already got an operation in this block only get
+        //renewals of an outsider, which the lookup filters out,
+        //otherwise the shadow would have to replicate the conflict
+        //resolution of the lookup
+        if(!touched.insert(rank).second) {
+            ops.push_back({factory(EntryOperationKind::Renewal,
+                                   std::move(key),
+                                   drawValue()),
+                           generateOwner(outsider),
+                           drawBurnValue(),
+                           std::nullopt});
+            continue;
+        }
+
+        if(iter == shadow.end()) {
+            auto owner = drawOwner();
+            auto burn = drawBurnValue();
+            auto value = drawValue();
+
+            ops.push_back({factory(EntryOperationKind::Creation,
+                                   EntryKey{key},
+                                   value),
+                           generateOwner(owner),
+                           burn,
+                           std::nullopt});
+
+            auto tie = false;
+            if(drawProbability() < config_.conflict_rate) {
+                tie = drawProbability() < config_.tie_rate;
+                std::uniform_int_distribution<std::int64_t> burn_dist{0, burn - 1};
+                auto competitor_burn = tie ? burn : burn_dist(rng_);
+
+                ops.push_back({factory(EntryOperationKind::Creation,
+                                       std::move(key),
+                                       drawValue()),
+                               generateOwner(drawOtherOwner(owner)),
+                               competitor_burn,
+                               std::nullopt});
+            }
+
+            //ambiguous creations are not executed
+            if(!tie) {
+                shadow.emplace(rank, EntryShadow{owner, value});
+            }
+            continue;
+        }
+
+        auto& entry = iter->second;
+        auto kind = static_cast<EntryOperationKind>(
+            1 + (with_updates
+                     ? entry_kind_dist_(rng_)
+                     : entry_kind_without_update_dist_(rng_)));
+
+        //operations of somebody who does not own the entry
+        if(drawProbability() < config_.conflict_rate) {
+            auto value = kind == EntryOperationKind::Update
+                ? drawValue()
+                : entry.value;
+
+            ops.push_back({factory(kind,
+                                   std::move(key),
+                                   value),
+                           generateOwner(drawOtherOwner(entry.owner)),
+                           drawBurnValue(),
+                           kind == EntryOperationKind::Transfer
+                               ? utilxx::Opt<std::string>{generateOwner(drawOwner())}
+                               : std::nullopt});
+            continue;
+        }
+
+        auto owner = generateOwner(entry.owner);
+        utilxx::Opt<std::string> new_owner;
+
+        switch(kind) {
+        case EntryOperationKind::Transfer:
+            entry.owner = drawOtherOwner(entry.owner);
+            new_owner = generateOwner(entry.owner);
+            break;
+        case EntryOperationKind::Update:
+            entry.value = drawValue();
+            break;
+        default:
+            break;
+        }
+
+        ops.push_back({factory(kind,
+                               std::move(key),
+                               entry.value),
+                       std::move(owner),
+                       drawBurnValue(),
+                       std::move(new_owner)});
+
+        if(kind == EntryOperationKind::Deletion) {
+            shadow.erase(iter);
+        }
+    }
+
+    return ops;
+}
+
+auto WorkloadGenerator::drawOwner()
+    -> std::size_t
+{
+    return owner_dist_(rng_);
+}
+
+auto WorkloadGenerator::drawOtherOwner(std::size_t owner)
+    -> std::size_t
+{
+    if(config_.number_of_owners < 2) {
+        return config_.number_of_owners;
+    }
+
+    std::uniform_int_distribution<std::size_t> dist{0, config_.number_of_owners - 2};
+    auto other = dist(rng_);
+
+    return other >= owner ? other + 1 : other;
+}
+
+auto WorkloadGenerator::drawBurnValue()
+    -> std::int64_t
+{
+    std::uniform_int_distribution<std::int64_t> dist{1, MAX_BURN_VALUE};
+    return dist(rng_);
+}
+
+auto WorkloadGenerator::drawValue()
+    -> IPv4Value
+{
+    std::uniform_int_distribution<int> dist{0, 255};
+
+    IPv4Value value;
+    std::generate(std::begin(value),
+                  std::end(value),
+                  [&] {
+                      return static_cast<std::byte>(dist(rng_));
+                  });
+
+    return value;
+}
+
+auto WorkloadGenerator::drawProbability()
+    -> double
+{
+    std::uniform_real_distribution<double> dist{0.0, 1.0};
+    return dist(rng_);
+}
+
+
+auto forge::bench::generateKey(std::byte key_tag, std::size_t rank)
+    -> EntryKey
+{
+    EntryKey key{key_tag};
+    for(int shift = 56; shift >= 0; shift -= 8) {
+        key.push_back(static_cast<std::byte>((rank >> shift) & 0xff));
+    }
+
+    return key;
+}
+
+auto forge::bench::generateOwner(std::size_t rank)
+    -> std::string
+{
+    return fmt::format("o{:033}", rank);
+}
+
+auto forge::bench::toUMEntryOperations(const std::vector<GeneratedOperation>& generated,
+                                       std::int64_t block)
+    -> std::vector<core::UMEntryOperation>
+{
+    std::vector<core::UMEntryOperation> ops;
+    ops.reserve(generated.size());
+
+    for(const auto& op : generated) {
+        core::parseMetadataToUMEntryOp(op.metadata,
+                                       block,
+                                       std::string{op.owner},
+                                       op.burn_value,
+                                       utilxx::Opt<std::string>{op.new_owner})
+            .onValue([&](auto parsed) {
+                ops.emplace_back(std::move(parsed));
+            });
+    }
+
+    return ops;
+}
+
+auto forge::bench::toUniqueEntryOperations(const std::vector<GeneratedOperation>& generated,
+                                           std::int64_t block)
+    -> std::vector<core::UniqueEntryOperation>
+{
+    std::vector<core::UniqueEntryOperation> ops;
+    ops.reserve(generated.size());
+
+    for(const auto& op : generated) {
+        core::parseMetadataToUniqueEntryOp(op.metadata,
+                                           block,
+                                           std::string{op.owner},
+                                           op.burn_value,
+                                           utilxx::Opt<std::string>{op.new_owner})
+            .onValue([&](auto parsed) {
+                ops.emplace_back(std::move(parsed));
+            });
+    }
+
+    return ops;
+}
+
+auto forge::bench::toUtilityTokenOperations(const std::vector<GeneratedOperation>& generated,
+                                            std::int64_t block)
+    -> std::vector<core::UtilityTokenOperation>
+{
+    std::vector<core::UtilityTokenOperation> ops;
+    ops.reserve(generated.size());
+
+    for(const auto& op : generated) {
+        core::parseMetadataToUtilityTokenOp(op.metadata,
+                                            block,
+                                            std::string{op.owner},
+                                            op.burn_value,
+                                            utilxx::Opt<std::string>{op.new_owner})
+            .onValue([&](auto parsed) {
+                ops.emplace_back(std::move(parsed));
+            });
+    }
+
+    return ops;
+}
+
+auto forge::bench::toJson(const GeneratedOperation& op)
+    -> Json::Value
+{
+    Json::Value json;
+    json["metadata"] = core::toHexString(op.metadata);
+    json["owner"] = op.owner;
+    json["burnvalue"] = static_cast<Json::Int64>(op.burn_value);
+
+    if(op.new_owner) {
+        json["newowner"] = op.new_owner.getValue();
+    }
+
+    return json;
+}
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <entrys/token/UtilityTokenOperation.hpp>
+#include <entrys/uentry/UniqueEntryOperation.hpp>
+#include <entrys/umentry/UMEntryOperation.hpp>
+#include <json/value.h>
+#include <map>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utilxx/Opt.hpp>
+#include <vector>
+
+namespace forge::bench {
+
+struct WorkloadConfig
+{
+    std::uint64_t seed = 42;
+    std::size_t number_of_keys = 100000;
+    std::size_t number_of_owners = 10000;
+    std::size_t ops_per_block = 1000;
+
+    //exponents of the zipf distributions the keys and the owners
+    //are drawn from, 0 means uniform
+    double key_skew = 1.0;
+    double owner_skew = 1.0;
+
+    //fraction of operations which get a competing operation
+    //of another owner in the same block
+    double conflict_rate = 0.05;
+
+    //fraction of those conflicts where both operations burn
+    //the same value, which makes them ambiguous
+    double tie_rate = 0.2;
+
+    //relative weights of the operations on already existing keys
+    double renewal_weight = 4.0;
+    double transfer_weight = 2.0;
+    double update_weight = 3.0;
+    double deletion_weight = 1.0;
+};
+
+//an operation as it would be written into a transaction,
+//the metadata plus what the lookup extracts from the
+//transaction itself
+struct GeneratedOperation
+{
+    std::vector<std::byte> metadata;
+    std::string owner;
+    std::int64_t burn_value;
+    utilxx::Opt<std::string> new_owner;
+};
+
+//draws ranks in [0, n) where rank k has a probability
+//proportional to 1 / (k + 1)^skew
+class ZipfDistribution
+{
+public:
+    ZipfDistribution(std::size_t n, double skew);
+
+    auto operator()(std::mt19937_64& rng) const
+        -> std::size_t;
+
+private:
+    std::vector<double> cdf_;
+};
+
+//generates seeded streams of forge operations block by block.
+//the generator keeps a shadow of the state the operations
+//produce, so most operations are valid against a lookup
+//which executed all previous blocks, the rest are conflicts,
+//ties and operations of non owners the lookup has to filter
+class WorkloadGenerator
+{
+public:
+    explicit WorkloadGenerator(WorkloadConfig config);
+
+    auto nextUMEntryBlock(std::int64_t block)
+        -> std::vector<GeneratedOperation>;
+
+    auto nextUniqueEntryBlock(std::int64_t block)
+        -> std::vector<GeneratedOperation>;
+
+    auto nextUtilityTokenBlock(std::int64_t block)
+        -> std::vector<GeneratedOperation>;
+
+    auto getConfig() const
+        -> const WorkloadConfig&;
+
+private:
+    struct EntryShadow
+    {
+        std::size_t owner;
+        core::IPv4Value value;
+    };
+
+    using EntryShadowMap = std::unordered_map<std::size_t, EntryShadow>;
+
+    enum class EntryOperationKind {
+        Creation,
+        Renewal,
+        Transfer,
+        Update,
+        Deletion
+    };
+
+    //builds the metadata of an entry operation of the given kind
+    using MetadataFactory =
+        std::vector<std::byte> (*)(EntryOperationKind,
+                                   core::EntryKey&&,
+                                   core::IPv4Value);
+
+    auto nextEntryBlock(EntryShadowMap& shadow,
+                        std::byte key_tag,
+                        bool with_updates,
+                        MetadataFactory factory)
+        -> std::vector<GeneratedOperation>;
+
+    auto drawOwner()
+        -> std::size_t;
+
+    auto drawOtherOwner(std::size_t owner)
+        -> std::size_t;
+
+    auto drawBurnValue()
+        -> std::int64_t;
+
+    auto drawValue()
+        -> core::IPv4Value;
+
+    auto drawProbability()
+        -> double;
+
+private:
+    WorkloadConfig config_;
+    std::mt19937_64 rng_;
+    ZipfDistribution key_dist_;
+    ZipfDistribution owner_dist_;
+    std::discrete_distribution<int> entry_kind_dist_;
+    std::discrete_distribution<int> entry_kind_without_update_dist_;
+
+    EntryShadowMap um_entrys_;
+    EntryShadowMap unique_entrys_;
+
+    //token rank -> owner rank -> balance
+    std::unordered_map<std::size_t,
+                       std::map<std::size_t, std::uint64_t>>
+        token_accounts_;
+};
+
+//the key generated for the given rank
+auto generateKey(std::byte key_tag, std::size_t rank)
+    -> core::EntryKey;
+
+//the address generated for the given owner rank
+auto generateOwner(std::size_t rank)
+    -> std::string;
+
+auto toUMEntryOperations(const std::vector<GeneratedOperation>& generated,
+                         std::int64_t block)
+    -> std::vector<core::UMEntryOperation>;
+
+auto toUniqueEntryOperations(const std::vector<GeneratedOperation>& generated,
+                             std::int64_t block)
+    -> std::vector<core::UniqueEntryOperation>;
+
+auto toUtilityTokenOperations(const std::vector<GeneratedOperation>& generated,
+                              std::int64_t block)
+    -> std::vector<core::UtilityTokenOperation>;
+
+auto toJson(const GeneratedOperation& op)
+    -> Json::Value;
+
+} // namespace forge::bench
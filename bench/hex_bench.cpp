@@ -0,0 +1,177 @@
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <cctype>
+#include <core/Hex.hpp>
+#include <core/Transaction.hpp>
+#include <cstdlib>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using forge::core::decodeHex;
+using forge::core::encodeHex;
+using forge::core::hexEncodedSize;
+using forge::core::stringToByteVec;
+using forge::core::toHexString;
+
+namespace {
+
+//the stringstream based encoder the codecs replaced,
+//kept as baseline
+auto legacyToHexString(const std::vector<std::byte>& bytes)
+    -> std::string
+{
+    std::stringstream ss;
+    ss << std::hex;
+    for(auto&& b : bytes) {
+        ss << std::setw(2) << std::setfill('0') << static_cast<int>(b);
+    }
+    return ss.str();
+}
+
+//the strtol based decoder the codecs replaced,
+//kept as baseline
+auto legacyStringToByteVec(const std::string& str)
+    -> std::vector<std::byte>
+{
+    if(str.length() % 2 != 0) {
+        return {};
+    }
+
+    auto is_hex = std::all_of(std::begin(str),
+                              std::end(str),
+                              [](auto c) {
+                                  return std::isxdigit(c);
+                              });
+
+    if(!is_hex) {
+        return {};
+    }
+
+    std::vector<std::byte> data;
+
+    for(size_t i = 0; i < str.length(); i += 2) {
+        auto byte_string = str.substr(i, 2);
+        auto byte = static_cast<std::byte>(std::strtol(byte_string.c_str(), nullptr, 16));
+        data.push_back(byte);
+    }
+
+    return data;
+}
+
+//benchmark argument is the number of bytes
+auto makeBytes(const benchmark::State& state)
+    -> std::vector<std::byte>
+{
+    std::mt19937 rng{42};
+    std::uniform_int_distribution<int> dist{0, 255};
+
+    std::vector<std::byte> bytes(static_cast<std::size_t>(state.range(0)));
+    std::generate(std::begin(bytes),
+                  std::end(bytes),
+                  [&] {
+                      return static_cast<std::byte>(dist(rng));
+                  });
+
+    return bytes;
+}
+
+auto BM_LegacyToHexString(benchmark::State& state)
+    -> void
+{
+    auto bytes = makeBytes(state);
+
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(legacyToHexString(bytes));
+    }
+
+    state.SetBytesProcessed(state.iterations() * bytes.size());
+}
+
+auto BM_ToHexString(benchmark::State& state)
+    -> void
+{
+    auto bytes = makeBytes(state);
+
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(toHexString(bytes));
+    }
+
+    state.SetBytesProcessed(state.iterations() * bytes.size());
+}
+
+//no allocation at all, like when writing into a reused buffer
+auto BM_EncodeHex(benchmark::State& state)
+    -> void
+{
+    auto bytes = makeBytes(state);
+    std::string buffer(hexEncodedSize(bytes.size()), '\0');
+
+    for(auto _ : state) {
+        encodeHex(bytes.data(), bytes.size(), buffer.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetBytesProcessed(state.iterations() * bytes.size());
+}
+
+auto BM_LegacyStringToByteVec(benchmark::State& state)
+    -> void
+{
+    auto hex = toHexString(makeBytes(state));
+
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(legacyStringToByteVec(hex));
+    }
+
+    state.SetBytesProcessed(state.iterations() * hex.size() / 2);
+}
+
+auto BM_StringToByteVec(benchmark::State& state)
+    -> void
+{
+    auto hex = toHexString(makeBytes(state));
+
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(stringToByteVec(hex));
+    }
+
+    state.SetBytesProcessed(state.iterations() * hex.size() / 2);
+}
+
+auto BM_DecodeHex(benchmark::State& state)
+    -> void
+{
+    auto hex = toHexString(makeBytes(state));
+    std::vector<std::byte> buffer(hex.size() / 2);
+
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(decodeHex(hex, buffer.data()));
+        benchmark::ClobberMemory();
+    }
+
+    state.SetBytesProcessed(state.iterations() * buffer.size());
+}
+
+//a txid, the largest OP_RETURN payload and a raw transaction
+auto hexArguments(benchmark::internal::Benchmark* bench)
+    -> void
+{
+    bench->ArgName("bytes")
+        ->Arg(32)
+        ->Arg(80)
+        ->Arg(1024);
+}
+
+} // namespace
+
+BENCHMARK(BM_LegacyToHexString)->Apply(hexArguments);
+BENCHMARK(BM_ToHexString)->Apply(hexArguments);
+BENCHMARK(BM_EncodeHex)->Apply(hexArguments);
+BENCHMARK(BM_LegacyStringToByteVec)->Apply(hexArguments);
+BENCHMARK(BM_StringToByteVec)->Apply(hexArguments);
+BENCHMARK(BM_DecodeHex)->Apply(hexArguments);
+
+BENCHMARK_MAIN();
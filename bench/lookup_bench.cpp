@@ -0,0 +1,151 @@
+#include <bench/WorkloadGenerator.hpp>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <lookup/UMEntryLookup.hpp>
+#include <lookup/UniqueEntryLookup.hpp>
+#include <lookup/UtilityTokenLookup.hpp>
+#include <vector>
+
+using forge::bench::GeneratedOperation;
+using forge::bench::WorkloadConfig;
+using forge::bench::WorkloadGenerator;
+using forge::lookup::UMEntryLookup;
+using forge::lookup::UniqueEntryLookup;
+using forge::lookup::UtilityTokenLookup;
+
+namespace {
+
+//blocks executed before measuring, so the lookups are not empty
+constexpr inline auto WARMUP_BLOCKS = 100;
+
+using GenerateBlock = auto (WorkloadGenerator::*)(std::int64_t)
+    -> std::vector<GeneratedOperation>;
+
+//benchmark arguments are number of keys, operations per block
+//and the key skew in percent
+auto makeConfig(const benchmark::State& state)
+    -> WorkloadConfig
+{
+    WorkloadConfig config;
+    config.number_of_keys = static_cast<std::size_t>(state.range(0));
+    config.number_of_owners = config.number_of_keys / 10 + 1;
+    config.ops_per_block = static_cast<std::size_t>(state.range(1));
+    config.key_skew = static_cast<double>(state.range(2)) / 100;
+
+    return config;
+}
+
+template<class Lookup, class Convert>
+auto benchmarkExecuteOperations(benchmark::State& state,
+                                GenerateBlock generate,
+                                Convert convert)
+    -> void
+{
+    auto config = makeConfig(state);
+    WorkloadGenerator generator{config};
+    Lookup lookup{nullptr, 0};
+
+    std::int64_t block = 0;
+    for(; block < WARMUP_BLOCKS; block++) {
+        lookup.executeOperations(
+            convert((generator.*generate)(block), block));
+    }
+
+    for(auto _ : state) {
+        state.PauseTiming();
+        auto ops = convert((generator.*generate)(block), block);
+        state.ResumeTiming();
+
+        lookup.executeOperations(std::move(ops));
+        block++;
+    }
+
+    state.SetItemsProcessed(state.iterations() * config.ops_per_block);
+}
+
+template<class Convert>
+auto benchmarkParseMetadata(benchmark::State& state,
+                            GenerateBlock generate,
+                            Convert convert)
+    -> void
+{
+    auto config = makeConfig(state);
+    WorkloadGenerator generator{config};
+    auto generated = (generator.*generate)(0);
+
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(convert(generated, 0));
+    }
+
+    state.SetItemsProcessed(state.iterations() * generated.size());
+}
+
+auto BM_UMEntryExecuteOperations(benchmark::State& state)
+    -> void
+{
+    benchmarkExecuteOperations<UMEntryLookup>(state,
+                                              &WorkloadGenerator::nextUMEntryBlock,
+                                              forge::bench::toUMEntryOperations);
+}
+
+auto BM_UniqueEntryExecuteOperations(benchmark::State& state)
+    -> void
+{
+    benchmarkExecuteOperations<UniqueEntryLookup>(state,
+                                                  &WorkloadGenerator::nextUniqueEntryBlock,
+                                                  forge::bench::toUniqueEntryOperations);
+}
+
+auto BM_UtilityTokenExecuteOperations(benchmark::State& state)
+    -> void
+{
+    benchmarkExecuteOperations<UtilityTokenLookup>(state,
+                                                   &WorkloadGenerator::nextUtilityTokenBlock,
+                                                   forge::bench::toUtilityTokenOperations);
+}
+
+auto BM_UMEntryParseMetadata(benchmark::State& state)
+    -> void
+{
+    benchmarkParseMetadata(state,
+                           &WorkloadGenerator::nextUMEntryBlock,
+                           forge::bench::toUMEntryOperations);
+}
+
+auto BM_UtilityTokenParseMetadata(benchmark::State& state)
+    -> void
+{
+    benchmarkParseMetadata(state,
+                           &WorkloadGenerator::nextUtilityTokenBlock,
+                           forge::bench::toUtilityTokenOperations);
+}
+
+auto executeArguments(benchmark::internal::Benchmark* bench)
+    -> void
+{
+    bench->ArgNames({"keys", "ops", "skew"})
+        ->Args({10000, 1000, 100})
+        ->Args({1000000, 1000, 100})
+        ->Args({1000000, 10000, 100})
+        ->Args({1000000, 10000, 0})
+        ->Args({1000000, 10000, 150})
+        ->Unit(benchmark::kMicrosecond);
+}
+
+auto parseArguments(benchmark::internal::Benchmark* bench)
+    -> void
+{
+    bench->ArgNames({"keys", "ops", "skew"})
+        ->Args({1000000, 10000, 100})
+        ->Unit(benchmark::kMicrosecond);
+}
+
+} // namespace
+
+BENCHMARK(BM_UMEntryExecuteOperations)->Apply(executeArguments);
+BENCHMARK(BM_UniqueEntryExecuteOperations)->Apply(executeArguments);
+BENCHMARK(BM_UtilityTokenExecuteOperations)->Apply(executeArguments);
+BENCHMARK(BM_UMEntryParseMetadata)->Apply(parseArguments);
+BENCHMARK(BM_UtilityTokenParseMetadata)->Apply(parseArguments);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,155 @@
+#include <CLI/CLI.hpp>
+#include <bench/ReplayChain.hpp>
+#include <bench/ReplayServer.hpp>
+#include <chrono>
+#include <csignal>
+#include <fmt/core.h>
+#include <jsonrpccpp/server/connectors/httpserver.h>
+#include <string>
+#include <thread>
+
+using forge::bench::ReplayServer;
+using forge::bench::loadReplayChain;
+using forge::bench::recordReplayChain;
+using forge::bench::saveReplayChain;
+using jsonrpc::HttpServer;
+
+namespace {
+
+volatile std::sig_atomic_t should_shutdown = 0;
+
+auto handleSignal(int /*signal*/)
+    -> void
+{
+    should_shutdown = 1;
+}
+
+auto record(const std::string& chain_file,
+            const std::string& host,
+            const std::string& user,
+            const std::string& password,
+            std::int64_t port,
+            std::int64_t first_height,
+            std::int64_t last_height)
+    -> int
+{
+    auto res =
+        recordReplayChain(host,
+                          user,
+                          password,
+                          port,
+                          first_height,
+                          last_height)
+            .flatMap([&](auto chain) {
+                fmt::print("recorded {} blocks and {} transactions\n",
+                           chain.getNumberOfBlocks(),
+                           chain.getNumberOfTransactions());
+
+                return saveReplayChain(chain, chain_file);
+            });
+
+    if(!res) {
+        fmt::print("{}\n", res.getError().what());
+        return -1;
+    }
+
+    return 0;
+}
+
+auto serve(const std::string& chain_file,
+           int port,
+           int threads,
+           std::int64_t latency_us)
+    -> int
+{
+    auto chain_res = loadReplayChain(chain_file);
+    if(!chain_res) {
+        fmt::print("{}\n", chain_res.getError().what());
+        return -1;
+    }
+
+    const auto& chain = chain_res.getValue();
+
+    HttpServer httpserver{port, "", "", threads};
+    ReplayServer server{httpserver,
+                        chain,
+                        std::chrono::microseconds{latency_us}};
+
+    if(!server.StartListening()) {
+        fmt::print("unable to listen on port {}\n", port);
+        return -1;
+    }
+
+    fmt::print("serving blocks {} to {} on port {}\n",
+               chain.getFirstHeight(),
+               chain.getBlockCount(),
+               port);
+
+    std::signal(SIGINT, handleSignal);
+    std::signal(SIGTERM, handleSignal);
+
+    while(!should_shutdown) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{100});
+    }
+
+    server.StopListening();
+
+    fmt::print("answered {} calls\n", server.getNumberOfCalls());
+
+    return 0;
+}
+
+} // namespace
+
+auto main(int argc, char* argv[]) -> int
+{
+    CLI::App app{"forge-replayd serves a recorded chain like an odin daemon, for reproducible benchmarks"};
+
+    std::string chain_file;
+    int port = 18332;
+    int threads = 4;
+    std::int64_t latency_us = 0;
+
+    app.add_option("--chain", chain_file, "chain file to serve or to record into")
+        ->required();
+    app.add_option("--port", port, "port to listen on");
+    app.add_option("--threads", threads, "number of threads answering requests");
+    app.add_option("--latency", latency_us, "microseconds every answer is delayed");
+
+    std::string host = "localhost";
+    std::string user;
+    std::string password;
+    std::int64_t node_port = 0;
+    std::int64_t first_height = 0;
+    std::int64_t last_height = 0;
+
+    auto record_opt =
+        app.add_subcommand("record",
+                           "records blocks and transactions from a running daemon into the chain file");
+    record_opt->add_option("--host", host, "host of the daemon");
+    record_opt->add_option("--user", user, "rpc user of the daemon");
+    record_opt->add_option("--password", password, "rpc password of the daemon");
+    record_opt->add_option("--node-port", node_port, "rpc port of the daemon")
+        ->required();
+    record_opt->add_option("--from", first_height, "first block height to record")
+        ->required();
+    record_opt->add_option("--to", last_height, "last block height to record")
+        ->required();
+
+    CLI11_PARSE(app, argc, argv);
+
+    if(record_opt->parsed()) {
+        return record(chain_file,
+                      host,
+                      user,
+                      password,
+                      node_port,
+                      first_height,
+                      last_height);
+    }
+
+    return serve(chain_file,
+                 port,
+                 threads,
+                 latency_us);
+}
@@ -0,0 +1,131 @@
+#include <CLI/CLI.hpp>
+#include <bench/ReplayChain.hpp>
+#include <bench/ReplayServer.hpp>
+#include <chrono>
+#include <client/ReadOnlyClientBase.hpp>
+#include <core/Coin.hpp>
+#include <env/LoggingSetup.hpp>
+#include <fmt/core.h>
+#include <jsonrpccpp/server/connectors/httpserver.h>
+#include <lookup/LookupManager.hpp>
+#include <string>
+#include <sys/resource.h>
+
+using forge::bench::ReplayServer;
+using forge::bench::loadReplayChain;
+using forge::client::make_readonly_client;
+using forge::lookup::LookupManager;
+using jsonrpc::HttpServer;
+
+namespace {
+
+//peak resident set size of the process in KiB
+auto getPeakRss()
+    -> long
+{
+    rusage usage{};
+    ::getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+} // namespace
+
+//measures how fast LookupManager::updateLookup processes a chain
+//served by an in process replay daemon
+auto main(int argc, char* argv[]) -> int
+{
+    CLI::App app{"sync_bench measures the sync throughput of the lookup against a replayed chain"};
+
+    std::string chain_file;
+    std::string coin_str = "todin";
+    int port = 18332;
+    int threads = 4;
+    std::int64_t latency_us = 0;
+    bool verbose = false;
+
+    app.add_option("--chain", chain_file, "chain file to replay")
+        ->required();
+    app.add_option("--coin", coin_str, "coin the chain belongs to (odin or todin)");
+    app.add_option("--port", port, "port the replay daemon listens on");
+    app.add_option("--threads", threads, "number of threads of the replay daemon");
+    app.add_option("--latency", latency_us, "microseconds every rpc answer is delayed");
+    app.add_flag("--verbose", verbose, "log to the console while syncing");
+
+    CLI11_PARSE(app, argc, argv);
+
+    auto coin_opt = forge::core::fromString(coin_str);
+    if(!coin_opt) {
+        fmt::print("unknown coin {}\n", coin_str);
+        return -1;
+    }
+    auto coin = coin_opt.getValue();
+
+    if(verbose) {
+        forge::env::initConsoleLogger();
+    }
+
+    auto chain_res = loadReplayChain(chain_file);
+    if(!chain_res) {
+        fmt::print("{}\n", chain_res.getError().what());
+        return -1;
+    }
+    const auto& chain = chain_res.getValue();
+
+    HttpServer httpserver{port, "", "", threads};
+    ReplayServer server{httpserver,
+                        chain,
+                        std::chrono::microseconds{latency_us}};
+
+    if(!server.StartListening()) {
+        fmt::print("unable to listen on port {}\n", port);
+        return -1;
+    }
+
+    auto client = make_readonly_client("127.0.0.1",
+                                       "bench",
+                                       "bench",
+                                       port,
+                                       coin);
+    LookupManager lookup{std::move(client)};
+
+    //the lookup only processes mature blocks after its starting block
+    auto blocks = chain.getBlockCount()
+        - forge::core::getMaturity(coin)
+        - forge::core::getStartingBlock(coin);
+
+    if(blocks <= 0) {
+        fmt::print("the chain has no mature blocks after the starting block {}\n",
+                   forge::core::getStartingBlock(coin));
+        server.StopListening();
+        return -1;
+    }
+
+    auto rss_before = getPeakRss();
+    server.resetNumberOfCalls();
+
+    auto start = std::chrono::steady_clock::now();
+    auto res = lookup.updateLookup();
+    auto end = std::chrono::steady_clock::now();
+
+    auto calls = server.getNumberOfCalls();
+    server.StopListening();
+
+    if(!res) {
+        fmt::print("sync failed: {}\n",
+                   forge::lookup::generateMessage(std::move(res.getError())));
+        return -1;
+    }
+
+    std::chrono::duration<double> seconds = end - start;
+
+    fmt::print("blocks:          {}\n", blocks);
+    fmt::print("latency:         {} us\n", latency_us);
+    fmt::print("time:            {:.3f} s\n", seconds.count());
+    fmt::print("blocks/s:        {:.1f}\n", blocks / seconds.count());
+    fmt::print("rpcs:            {}\n", calls);
+    fmt::print("rpcs/block:      {:.2f}\n", static_cast<double>(calls) / blocks);
+    fmt::print("peak rss before: {} KiB\n", rss_before);
+    fmt::print("peak rss:        {} KiB\n", getPeakRss());
+
+    return 0;
+}
@@ -0,0 +1,87 @@
+#include <CLI/CLI.hpp>
+#include <bench/WorkloadGenerator.hpp>
+#include <fmt/core.h>
+#include <fstream>
+#include <iostream>
+#include <json/value.h>
+#include <json/writer.h>
+#include <memory>
+#include <string>
+
+using forge::bench::WorkloadConfig;
+using forge::bench::WorkloadGenerator;
+
+//writes a generated operation stream as json lines, one
+//operation per line together with its block and type
+auto main(int argc, char* argv[]) -> int
+{
+    CLI::App app{"forge-workload generates synthetic streams of forge operations"};
+
+    WorkloadConfig config;
+    std::string type = "umentry";
+    std::string output_file;
+    std::int64_t first_block = 0;
+    std::int64_t blocks = 1;
+
+    app.add_set("--type",
+                type,
+                {"umentry", "uniqueentry", "token"},
+                "type of the generated operations");
+    app.add_option("--blocks", blocks, "number of generated blocks");
+    app.add_option("--first-block", first_block, "height of the first generated block");
+    app.add_option("--output", output_file, "file to write to instead of stdout");
+    app.add_option("--seed", config.seed, "seed of the generator");
+    app.add_option("--keys", config.number_of_keys, "number of distinct keys");
+    app.add_option("--owners", config.number_of_owners, "number of distinct owners");
+    app.add_option("--ops", config.ops_per_block, "operations per block");
+    app.add_option("--key-skew", config.key_skew, "zipf exponent of the key popularity");
+    app.add_option("--owner-skew", config.owner_skew, "zipf exponent of the owner fan-out");
+    app.add_option("--conflict-rate", config.conflict_rate, "fraction of conflicting operations");
+    app.add_option("--tie-rate", config.tie_rate, "fraction of conflicts with equal burn values");
+
+    CLI11_PARSE(app, argc, argv);
+
+    std::ofstream file;
+    if(!output_file.empty()) {
+        file.open(output_file);
+        if(!file) {
+            fmt::print("unable to create {}\n", output_file);
+            return -1;
+        }
+    }
+    std::ostream& out = output_file.empty() ? std::cout : file;
+
+    Json::StreamWriterBuilder builder;
+    builder["indentation"] = "";
+    std::unique_ptr<Json::StreamWriter> writer{builder.newStreamWriter()};
+
+    WorkloadGenerator generator{config};
+
+    for(auto block = first_block; block < first_block + blocks; block++) {
+        auto ops = [&] {
+            if(type == "uniqueentry") {
+                return generator.nextUniqueEntryBlock(block);
+            }
+            if(type == "token") {
+                return generator.nextUtilityTokenBlock(block);
+            }
+            return generator.nextUMEntryBlock(block);
+        }();
+
+        for(const auto& op : ops) {
+            auto json = forge::bench::toJson(op);
+            json["block"] = static_cast<Json::Int64>(block);
+            json["type"] = type;
+
+            writer->write(json, &out);
+            out << '\n';
+        }
+    }
+
+    if(!out) {
+        fmt::print("writing the operations failed\n");
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,33 @@
+include(ExternalProject)
+include(GNUInstallDirs)
+
+set(CMAKE_ARGS
+  -DCMAKE_INSTALL_PREFIX=<INSTALL_DIR>
+  -DCMAKE_BUILD_TYPE=Release
+  -DBUILD_SHARED_LIBS=OFF
+  -DBENCHMARK_ENABLE_TESTING=OFF
+  -DBENCHMARK_ENABLE_GTEST_TESTS=OFF
+  -DBENCHMARK_ENABLE_INSTALL=ON)
+
+ExternalProject_Add(benchmark-project
+  PREFIX deps/benchmark
+  DOWNLOAD_NAME benchmark-1.5.0.tar.gz
+  DOWNLOAD_DIR ${CMAKE_BINARY_DIR}/downloads
+  URL https://github.com/google/benchmark/archive/v1.5.0.tar.gz
+  CMAKE_ARGS ${CMAKE_ARGS}
+  # Overwtire build and install commands to force Release build on MSVC.
+  BUILD_COMMAND cmake --build <BINARY_DIR> --config Release
+  INSTALL_COMMAND cmake --build <BINARY_DIR> --config Release --target install
+  )
+
+
+ExternalProject_Get_Property(benchmark-project INSTALL_DIR)
+add_library(benchmark STATIC IMPORTED)
+set(BENCHMARK_LIBRARY ${INSTALL_DIR}/${CMAKE_INSTALL_LIBDIR}/${CMAKE_STATIC_LIBRARY_PREFIX}benchmark${CMAKE_STATIC_LIBRARY_SUFFIX})
+set(BENCHMARK_INCLUDE_DIR ${INSTALL_DIR}/include)
+file(MAKE_DIRECTORY ${BENCHMARK_INCLUDE_DIR})  # Must exist.
+set_property(TARGET benchmark PROPERTY IMPORTED_LOCATION ${BENCHMARK_LIBRARY})
+set_property(TARGET benchmark PROPERTY INTERFACE_INCLUDE_DIRECTORIES ${BENCHMARK_INCLUDE_DIR})
+
+unset(INSTALL_DIR)
+unset(CMAKE_ARGS)
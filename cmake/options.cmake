@@ -1,2 +1,5 @@
 option(USE_CLANG "build application with clang" OFF)
 option(BUILD_TESTS "build test for cppFORGE" ON)
+option(BUILD_BENCHMARKS "build the benchmarks, the replay daemon and the workload generator" OFF)
+set(FORGE_MIN_LOG_LEVEL "DEBUG" CACHE STRING "FORGE_LOG sites below this level (DEBUG, INFO or WARNING) are compiled out")
+set_property(CACHE FORGE_MIN_LOG_LEVEL PROPERTY STRINGS DEBUG INFO WARNING)
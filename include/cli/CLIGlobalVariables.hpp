@@ -9,6 +9,8 @@ inline std::string KEY = "";
 
 inline bool IS_STRING = false;
 
+inline bool INCLUDE_PENDING = false;
+
 inline std::string OWNER = "";
 
 inline std::string ENTRY_VALUE_STR =
@@ -21,6 +23,24 @@ inline int BURN_VALUE = 0;
 
 inline std::string AMOUNT = "0";
 
+inline int BLOCK = 0;
+
+inline std::string PREFIX;
+
+inline std::string CURSOR;
+
+inline int SINCE = 0;
+
+inline int LIMIT = 100;
+
+inline int TIMEOUT = 0;
+
+inline std::string FILE_PATH;
+
+inline bool ASYNC = false;
+
+inline int OPERATION_ID = 0;
+
 inline Json::Value RESPONSE;
 
 } // namespace forge::cli
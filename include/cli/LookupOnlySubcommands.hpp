@@ -22,6 +22,8 @@ auto addLookupUniqueValue(CLI::App& app, forge::rpc::JsonRpcStubClient& client)
     -> void;
 auto addLookupOwner(CLI::App& app, forge::rpc::JsonRpcStubClient& client)
     -> void;
+auto addLookupAt(CLI::App& app, forge::rpc::JsonRpcStubClient& client)
+    -> void;
 auto addLookupActivationBlock(CLI::App& app, forge::rpc::JsonRpcStubClient& client)
     -> void;
 auto addLookupAllEntrysOf(CLI::App& app, forge::rpc::JsonRpcStubClient& client)
@@ -30,6 +32,12 @@ auto addGetUtilityTokenBalanceOf(CLI::App& app, forge::rpc::JsonRpcStubClient& c
     -> void;
 auto addGetSupplyOfUtilityToken(CLI::App& app, forge::rpc::JsonRpcStubClient& client)
     -> void;
+auto addScanEntrys(CLI::App& app, forge::rpc::JsonRpcStubClient& client)
+    -> void;
+auto addGetChanges(CLI::App& app, forge::rpc::JsonRpcStubClient& client)
+    -> void;
+auto addGetTrace(CLI::App& app, forge::rpc::JsonRpcStubClient& client)
+    -> void;
 
 auto addLookupOnlySubcommands(CLI::App& app, forge::rpc::JsonRpcStubClient& client)
     -> void;
@@ -27,6 +27,12 @@ auto addTransferOwnership(CLI::App& app, forge::rpc::JsonRpcStubClient& client)
 auto addTransferUtilityToken(CLI::App& app, forge::rpc::JsonRpcStubClient& client)
     -> void;
 
+auto addSubmitBulk(CLI::App& app, forge::rpc::JsonRpcStubClient& client)
+    -> void;
+
+auto addGetOperation(CLI::App& app, forge::rpc::JsonRpcStubClient& client)
+    -> void;
+
 auto addDeleteUtilityToken(CLI::App& app, forge::rpc::JsonRpcStubClient& client)
     -> void;
 
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <utilxx/Opt.hpp>
+
+namespace forge::client {
+
+//fee rate the daemon estimated for a block height, so that
+//the daemon is asked only once per block.
+//All methods are thread safe.
+class FeeRateCache final
+{
+public:
+    //none if the rate was not cached for *height*
+    auto get(std::int64_t height) const
+        -> utilxx::Opt<std::int64_t>;
+
+    auto set(std::int64_t fee_rate,
+             std::int64_t height)
+        -> void;
+
+private:
+    mutable std::mutex mtx_;
+    utilxx::Opt<std::int64_t> fee_rate_;
+    utilxx::Opt<std::int64_t> height_;
+};
+
+} // namespace forge::client
@@ -46,6 +46,11 @@ public:
         -> utilxx::Result<std::vector<std::string>,
                           ClientError> = 0;
 
+    //txids of the transactions in the mempool of the daemon
+    virtual auto getRawMempool() const
+        -> utilxx::Result<std::vector<std::string>,
+                          ClientError> = 0;
+
     virtual auto isMainnet() const
         -> utilxx::Result<bool, ClientError> = 0;
 
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <core/Transaction.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <utilxx/Opt.hpp>
+#include <vector>
+
+namespace forge::client {
+
+//number of blocks after which the cached outputs are listed completely
+//again, this drops outputs which were spent outside of forge
+constexpr inline std::int64_t UNSPENT_SET_RESYNC_INTERVAL = 100;
+
+//in memory copy of the unspent outputs of the wallet, indexed by value
+//and by address. Selected outputs are locked until the transaction
+//spending them was sent, so concurrent writes never select the same output.
+//All methods are thread safe.
+class UnspentSet final
+{
+public:
+    //block height of the last refresh, none if the set was never filled
+    auto getHeight() const
+        -> utilxx::Opt<std::int64_t>;
+
+    //block height of the last complete refresh
+    auto getResetHeight() const
+        -> utilxx::Opt<std::int64_t>;
+
+    //replaces all outputs which are not locked
+    auto reset(std::vector<core::Unspent>&& unspents,
+               std::int64_t height)
+        -> void;
+
+    //adds outputs which matured since the last refresh,
+    //outputs which are already known are ignored
+    auto add(std::vector<core::Unspent>&& unspents,
+             std::int64_t height)
+        -> void;
+
+    //selects the smallest output which is either exactly *amount*
+    //or leaves at least *min_change* after *amount* is taken and locks it.
+    //if an address is given only outputs of this address are considered
+    auto lock(std::int64_t amount,
+              std::int64_t min_change,
+              const utilxx::Opt<std::string>& address)
+        -> utilxx::Opt<core::Unspent>;
+
+    //an output which was spent, or which failed to be spent, is dropped,
+    //otherwise it can be selected again
+    auto unlock(const core::Unspent& output,
+                bool spent)
+        -> void;
+
+    //number of outputs which are not locked
+    auto size() const
+        -> std::size_t;
+
+    //forces a complete refresh with the next write
+    auto clear()
+        -> void;
+
+private:
+    using Outpoint = std::pair<std::string, std::int64_t>;
+    using ValueIndex = std::multimap<std::int64_t, Outpoint>;
+
+    //expect the mutex to be held
+    auto insert(core::Unspent&& unspent)
+        -> void;
+    auto erase(const Outpoint& outpoint)
+        -> utilxx::Opt<core::Unspent>;
+
+private:
+    mutable std::mutex mtx_;
+    std::map<Outpoint, core::Unspent> available_;
+    std::map<Outpoint, core::Unspent> locked_;
+    ValueIndex by_value_;
+    std::map<std::string, ValueIndex> by_address_;
+    utilxx::Opt<std::int64_t> height_;
+    utilxx::Opt<std::int64_t> reset_height_;
+};
+
+} // namespace forge::client
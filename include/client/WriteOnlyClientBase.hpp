@@ -1,10 +1,13 @@
 #pragma once
 
 #include <core/Coin.hpp>
+#include <core/Transaction.hpp>
 #include <entrys/umentry/UMEntryOperation.hpp>
 #include <client/ClientError.hpp>
 #include <client/ReadOnlyClientBase.hpp>
+#include <utilxx/Opt.hpp>
 #include <utilxx/Result.hpp>
+#include <vector>
 
 namespace forge::client {
 
@@ -46,6 +49,16 @@ public:
     virtual auto sendRawTx(std::vector<std::byte> tx) const
         -> utilxx::Result<std::string, ClientError> = 0;
 
+    //sign or broadcast multiple transactions, the results are
+    //in the order of the given transactions
+    virtual auto signRawTxs(std::vector<std::vector<std::byte>> txs) const
+        -> std::vector<
+            utilxx::Result<std::vector<std::byte>,
+                           ClientError>>;
+    virtual auto sendRawTxs(std::vector<std::vector<std::byte>> txs) const
+        -> std::vector<
+            utilxx::Result<std::string, ClientError>>;
+
     //extracts the txid of a raw transaction
     virtual auto decodeTxidOfRawTx(const std::vector<std::byte>& tx) const
         -> utilxx::Result<std::string, ClientError> = 0;
@@ -54,11 +67,23 @@ public:
     virtual auto generateNewAddress() const
         -> utilxx::Result<std::string, ClientError> = 0;
 
+    //generate *count* new addresses for the wallet,
+    //fails if any of them could not be generated
+    virtual auto generateNewAddresses(std::size_t count) const
+        -> utilxx::Result<std::vector<std::string>, ClientError>;
+
     //sends the given amount of coins to the given address
     virtual auto sendToAddress(std::int64_t amount,
                                std::string address) const
         -> utilxx::Result<std::string, ClientError> = 0;
 
+    //sends the given amounts to the given addresses with one transaction,
+    //every address may appear only once
+    virtual auto sendToAddresses(std::vector<
+                                 std::pair<std::string,
+                                           std::int64_t>> amounts) const
+        -> utilxx::Result<std::string, ClientError> = 0;
+
     //should check unspent outputs,
     //select an output enought value
     //if value = fee + amount then burn the output completly and write
@@ -87,18 +112,55 @@ public:
                             std::vector<std::byte> metadata) const
         -> utilxx::Result<std::string, ClientError> = 0;
 
+    //selects an unspent output of the wallet with at least *amount* coins
+    //and locks it, so that neither another write nor the coin selection
+    //of the daemon for sendToAddress(es) can select it.
+    //outputs which would leave less than *min_change* are skipped unless they
+    //match *amount* exactly. if an address is given, only outputs of
+    //this address are considered. none is returned if there is no such output
+    virtual auto lockUnspent(std::int64_t amount,
+                             std::int64_t min_change,
+                             const utilxx::Opt<std::string>& address) const
+        -> utilxx::Result<utilxx::Opt<core::Unspent>,
+                          ClientError> = 0;
+
+    //releases an output locked with lockUnspent, *spent* has to be true
+    //if a transaction spending the output was sent or tried to be sent
+    virtual auto unlockUnspent(const core::Unspent& output,
+                               bool spent) const
+        -> void = 0;
+
+    //fetches a transaction through the connection of the write client,
+    //so that the writes never share the connection of the lookup
+    virtual auto getTransaction(std::string txid) const
+        -> utilxx::Result<core::Transaction, ClientError> = 0;
 
     virtual auto getVOutIdxByAmountAndAddress(std::string txid,
                                               std::int64_t amount,
                                               std::string address) const
         -> utilxx::Result<std::int64_t, ClientError> = 0;
+
+    //fee rate in the smallest unit per 1000 bytes,
+    //either the configured one or the estimate of the daemon
+    virtual auto getFeeRate() const
+        -> utilxx::Result<std::int64_t, ClientError> = 0;
+
+    //fee of a transaction which spends one output, burns coins with
+    //*metadata_size* bytes of metadata and sends coins to
+    //*number_of_outputs* addresses
+    virtual auto computeBurnFee(std::int64_t fee_rate,
+                                std::size_t metadata_size,
+                                std::size_t number_of_outputs) const
+        -> std::int64_t = 0;
 };
 
+//if no fee rate is given, the estimate of the daemon is used
 auto make_writing_client(const std::string& host,
                          const std::string& user,
                          const std::string& password,
                          std::int64_t port,
-                         core::Coin coin)
+                         core::Coin coin,
+                         utilxx::Opt<std::int64_t> fee_rate = std::nullopt)
     -> std::unique_ptr<WriteOnlyClientBase>;
 
 } // namespace forge::client
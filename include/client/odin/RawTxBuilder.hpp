@@ -0,0 +1,50 @@
+#pragma once
+
+#include <client/ClientError.hpp>
+#include <core/ByteSpan.hpp>
+#include <core/Coin.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <utilxx/Result.hpp>
+#include <vector>
+
+namespace forge::client::odin {
+
+constexpr inline std::int32_t RAW_TX_VERSION = 1;
+
+//serializes an unsigned transaction which spends a single output.
+//every address gets a pay to pubkey hash output, the metadata
+//is pushed into an OP_RETURN output which burns *burn_value*.
+//only the signing is left to the daemon
+auto buildRawTx(core::Coin coin,
+                std::string_view input_txid,
+                std::int64_t index,
+                const std::vector<std::byte>& metadata,
+                std::int64_t burn_value,
+                const std::vector<
+                    std::pair<std::string,
+                              std::int64_t>>& outputs)
+    -> utilxx::Result<std::vector<std::byte>,
+                      ClientError>;
+
+//size of the transaction buildRawTx serializes for *metadata_size* bytes
+//of metadata and *number_of_outputs* addresses, after it was signed.
+//assumes a compressed pubkey and the largest possible signature
+auto estimateSignedTxSize(std::size_t metadata_size,
+                          std::size_t number_of_outputs)
+    -> std::size_t;
+
+//fee of a transaction with *tx_size* bytes, *fee_rate* is per 1000 bytes
+auto computeTxFee(std::size_t tx_size,
+                  std::int64_t fee_rate)
+    -> std::int64_t;
+
+//hex encoded double sha256 of the transaction,
+//in the reversed byte order the daemon uses
+auto computeTxid(core::ByteSpan tx)
+    -> std::string;
+
+} // namespace forge::client::odin
@@ -8,6 +8,7 @@
 #include <jsonrpccpp/client/connectors/httpclient.h>
 #include <utilxx/Opt.hpp>
 #include <utilxx/Result.hpp>
+#include <vector>
 
 namespace forge::client {
 
@@ -52,15 +53,32 @@ public:
         -> utilxx::Result<std::vector<std::string>,
                           ClientError> override;
 
+    auto getRawMempool() const
+        -> utilxx::Result<std::vector<std::string>,
+                          ClientError> override;
+
     auto isMainnet() const
         -> utilxx::Result<bool,
                           ClientError> override;
 
 protected:
+    //unspent outputs with a number of confirmations in the given range
+    auto listUnspent(std::int64_t min_confirmations,
+                     std::int64_t max_confirmations) const
+        -> utilxx::Result<std::vector<core::Unspent>,
+                          ClientError>;
+
     auto sendcommand(const std::string& command,
                      Json::Value params) const
         -> utilxx::Result<Json::Value, ClientError>;
 
+    //calls the command once for every given params with a single
+    //json-rpc batch request. the results are in the order of the params,
+    //if the request itself fails every call gets its error
+    auto sendbatch(const std::string& command,
+                   std::vector<Json::Value> params) const
+        -> std::vector<utilxx::Result<Json::Value, ClientError>>;
+
 
 private:
     jsonrpc::HttpClient http_client_;
@@ -93,6 +111,10 @@ auto processGetUnspentResponse(Json::Value&& response,
 auto processGetAddressesResponse(Json::Value&& response)
     -> utilxx::Result<std::vector<std::string>,
                       ClientError>;
+
+auto processGetRawMempoolResponse(Json::Value&& response)
+    -> utilxx::Result<std::vector<std::string>,
+                      ClientError>;
 } // namespace odin
 
 } // namespace forge::client
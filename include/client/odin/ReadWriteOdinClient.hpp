@@ -4,13 +4,23 @@
 #include <core/Coin.hpp>
 #include <core/Transaction.hpp>
 #include <client/ClientError.hpp>
+#include <client/FeeRateCache.hpp>
+#include <client/UnspentSet.hpp>
 #include <client/WriteOnlyClientBase.hpp>
 #include <client/odin/ReadOnlyOdinClient.hpp>
+#include <cstddef>
+#include <cstdint>
 #include <json/value.h>
+#include <memory>
+#include <utilxx/Opt.hpp>
 #include <utilxx/Result.hpp>
 
 namespace forge::client {
 
+//number of blocks the estimated fee rate should get
+//a transaction confirmed in
+constexpr inline std::int64_t FEE_ESTIMATION_BLOCKS = 6;
+
 class ReadWriteOdinClient : public ReadOnlyOdinClient,
                             public WriteOnlyClientBase
 {
@@ -18,7 +28,13 @@ public:
     ReadWriteOdinClient(ReadWriteOdinClient&&) = default;
     ReadWriteOdinClient(const ReadWriteOdinClient&) = delete;
 
-    using ReadOnlyOdinClient::ReadOnlyOdinClient;
+    //if no fee rate is given, the estimate of the daemon is used
+    ReadWriteOdinClient(const std::string& host,
+                        const std::string& user,
+                        const std::string& password,
+                        std::int64_t port,
+                        core::Coin coin,
+                        utilxx::Opt<std::int64_t> fee_rate = std::nullopt);
 
     auto operator=(ReadWriteOdinClient &&)
         -> ReadWriteOdinClient& = delete;
@@ -43,9 +59,23 @@ public:
     auto sendRawTx(std::vector<std::byte> tx) const
         -> utilxx::Result<std::string, ClientError> override;
 
+    //sign and send all given transactions with one request
+    auto signRawTxs(std::vector<std::vector<std::byte>> txs) const
+        -> std::vector<
+            utilxx::Result<std::vector<std::byte>,
+                           ClientError>> override;
+
+    auto sendRawTxs(std::vector<std::vector<std::byte>> txs) const
+        -> std::vector<
+            utilxx::Result<std::string, ClientError>> override;
+
     auto generateNewAddress() const
         -> utilxx::Result<std::string, ClientError> override;
 
+    //generates all addresses with one request
+    auto generateNewAddresses(std::size_t count) const
+        -> utilxx::Result<std::vector<std::string>, ClientError> override;
+
     auto burnAmount(std::int64_t amount,
                     std::vector<std::byte> metadata) const
         -> utilxx::Result<std::string, ClientError> override;
@@ -62,6 +92,11 @@ public:
                        std::string address) const
         -> utilxx::Result<std::string, ClientError> override;
 
+    auto sendToAddresses(std::vector<
+                         std::pair<std::string,
+                                   std::int64_t>> amounts) const
+        -> utilxx::Result<std::string, ClientError> override;
+
     auto burnAmount(std::string txid,
                     std::int64_t index,
                     std::int64_t amount,
@@ -69,43 +104,73 @@ public:
                     std::string change_address) const
         -> utilxx::Result<std::string, ClientError> override;
 
+    //overrides the reader and the writer interface at once
+    auto getTransaction(std::string txid) const
+        -> utilxx::Result<core::Transaction, ClientError> override;
+
     auto getVOutIdxByAmountAndAddress(std::string txid,
                                       std::int64_t amount,
                                       std::string address) const
         -> utilxx::Result<std::int64_t, ClientError> override;
 
+    auto lockUnspent(std::int64_t amount,
+                     std::int64_t min_change,
+                     const utilxx::Opt<std::string>& address) const
+        -> utilxx::Result<utilxx::Opt<core::Unspent>,
+                          ClientError> override;
+
+    auto unlockUnspent(const core::Unspent& output,
+                       bool spent) const
+        -> void override;
+
+    //the estimate is cached until the next block
+    auto getFeeRate() const
+        -> utilxx::Result<std::int64_t, ClientError> override;
+
+    auto computeBurnFee(std::int64_t fee_rate,
+                        std::size_t metadata_size,
+                        std::size_t number_of_outputs) const
+        -> std::int64_t override;
+
+private:
+    //lists only the outputs which matured since the last refresh,
+    //and all outputs every UNSPENT_SET_RESYNC_INTERVAL blocks
+    auto refreshUnspentSet() const
+        -> utilxx::Result<void, ClientError>;
+
+    //mirrors the locks of the unspent set with lockunspent,
+    //so that sendtoaddress and sendmany never pick a locked output
+    auto lockInDaemon(const core::Unspent& output,
+                      bool lock) const
+        -> utilxx::Result<void, ClientError>;
+
 private:
-    auto generateRpcParamsForRawTx(std::string input_txid,
-                                   std::int64_t index,
-                                   std::vector<std::byte> metadata,
-                                   std::int64_t burn_value,
-                                   std::vector<
-                                       std::pair<std::string,
-                                                 std::int64_t>>
-                                       outputs) const
-        -> Json::Value;
+    std::unique_ptr<UnspentSet> unspent_set_ = std::make_unique<UnspentSet>();
+    utilxx::Opt<std::int64_t> fee_rate_;
+    std::unique_ptr<FeeRateCache> fee_rate_cache_ = std::make_unique<FeeRateCache>();
 };
 
 namespace odin {
 
-auto processGenerateRawTxResponse(Json::Value&& response)
-    -> utilxx::Result<std::vector<std::byte>,
-                      ClientError>;
-
 auto processSignRawTxResponse(Json::Value&& response)
     -> utilxx::Result<std::vector<std::byte>,
                       ClientError>;
 
-auto processGenerateNewAddressResponse(Json::Value&& response)
+auto processSendRawTxResponse(Json::Value&& response)
     -> utilxx::Result<std::string, ClientError>;
 
-auto processDecodeTxidOfRawTxResponse(Json::Value&& response)
+auto processGenerateNewAddressResponse(Json::Value&& response)
     -> utilxx::Result<std::string, ClientError>;
 
 auto processSendToAddressResponse(Json::Value&& response,
                                   const std::string& address)
     -> utilxx::Result<std::string, ClientError>;
 
+//none if the daemon has no estimate yet
+auto processEstimateFeeResponse(Json::Value&& response)
+    -> utilxx::Result<utilxx::Opt<std::int64_t>,
+                      ClientError>;
+
 auto processGetVOutIdxByAmountAndAddressResponse(Json::Value&& response,
                                                  std::int64_t amount,
                                                  const std::string& address)
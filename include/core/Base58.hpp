@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include <utilxx/Opt.hpp>
+#include <vector>
+
+namespace forge::core {
+
+constexpr inline std::size_t BASE58_CHECKSUM_SIZE = 4;
+
+//decodes a base58 string, returns none if it
+//contains a character which is not in the alphabet
+auto decodeBase58(std::string_view str)
+    -> utilxx::Opt<std::vector<std::byte>>;
+
+//decodes a base58 string and verifies the appended checksum,
+//the returned payload does not contain the checksum
+auto decodeBase58Check(std::string_view str)
+    -> utilxx::Opt<std::vector<std::byte>>;
+
+} // namespace forge::core
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace forge::core {
+
+//non owning view of contiguous bytes, the viewed bytes
+//have to outlive the span
+class ByteSpan final
+{
+public:
+    constexpr ByteSpan(const std::byte* data,
+                       std::size_t size) noexcept
+        : data_(data),
+          size_(size) {}
+
+    //implicit, so functions taking a span can still be
+    //called with a vector
+    ByteSpan(const std::vector<std::byte>& data) noexcept
+        : data_(data.data()),
+          size_(data.size()) {}
+
+    constexpr auto data() const noexcept
+        -> const std::byte*
+    {
+        return data_;
+    }
+
+    constexpr auto size() const noexcept
+        -> std::size_t
+    {
+        return size_;
+    }
+
+    constexpr auto begin() const noexcept
+        -> const std::byte*
+    {
+        return data_;
+    }
+
+    constexpr auto end() const noexcept
+        -> const std::byte*
+    {
+        return data_ + size_;
+    }
+
+    constexpr auto operator[](std::size_t index) const noexcept
+        -> std::byte
+    {
+        return data_[index];
+    }
+
+    //offset has to be <= size()
+    constexpr auto subspan(std::size_t offset) const noexcept
+        -> ByteSpan
+    {
+        return ByteSpan{data_ + offset, size_ - offset};
+    }
+
+    auto toVector() const
+        -> std::vector<std::byte>
+    {
+        return std::vector<std::byte>(begin(), end());
+    }
+
+private:
+    const std::byte* data_;
+    std::size_t size_;
+};
+
+inline auto operator==(ByteSpan lhs, ByteSpan rhs)
+    -> bool
+{
+    return std::equal(lhs.begin(), lhs.end(),
+                      rhs.begin(), rhs.end());
+}
+
+inline auto operator!=(ByteSpan lhs, ByteSpan rhs)
+    -> bool
+{
+    return !(lhs == rhs);
+}
+
+//same order as std::vector<std::byte>
+inline auto operator<(ByteSpan lhs, ByteSpan rhs)
+    -> bool
+{
+    return std::lexicographical_compare(lhs.begin(), lhs.end(),
+                                        rhs.begin(), rhs.end());
+}
+
+} // namespace forge::core
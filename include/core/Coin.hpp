@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <string_view>
 #include <utilxx/Opt.hpp>
@@ -23,13 +24,29 @@ auto getStartingBlock(Coin c)
 auto getBlockTimeInSeconds(Coin c)
     -> std::int64_t;
 
-auto getDefaultTxFee(Coin c)
+//fee rates are in the smallest unit per 1000 bytes.
+//the default rate is used when the daemon has no estimate,
+//estimates below the minimum rate are raised to it
+auto getDefaultFeeRate(Coin c)
+    -> std::int64_t;
+
+auto getMinimumFeeRate(Coin c)
     -> std::int64_t;
 
 auto getValidityLength(Coin c)
     -> std::int64_t;
 
+//first block in which competing creations of one key are compared by the
+//amount they burn instead of by burning anything at all. this is a consensus
+//change, it stays unscheduled until a height is agreed on for the network
+auto getCreationBurnComparisonHeight(Coin c)
+    -> std::int64_t;
+
 auto getMinimumTxAmount(Coin c)
     -> std::int64_t;
 
+//version byte of base58 encoded pay to pubkey hash addresses
+auto getPubkeyAddressPrefix(Coin c)
+    -> std::byte;
+
 } // namespace forge::core
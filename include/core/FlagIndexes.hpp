@@ -14,6 +14,9 @@ constexpr static inline auto OPERATION_FLAG_INDEX = 4;
 //index of the flag identifying the type of value for mutable and immutable entry types
 constexpr static inline auto ENTRY_VALUE_FLAG_INDEX = 5;
 
+//index where the attached amount of a utility token starts
+constexpr static inline auto UTILITY_TOKEN_AMOUNT_INDEX = 5;
+
 //index of the were the id of a utility token starts
 constexpr static inline auto UTILITY_TOKEN_ID_START_INDEX = 13;
 
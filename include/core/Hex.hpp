@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace forge::core {
+
+constexpr auto hexEncodedSize(std::size_t number_of_bytes)
+    -> std::size_t
+{
+    return number_of_bytes * 2;
+}
+
+//writes hexEncodedSize(size) lowercase characters to out,
+//out is not null terminated
+auto encodeHex(const std::byte* bytes,
+               std::size_t size,
+               char* out)
+    -> void;
+
+//decodes hex.size() / 2 bytes into out, accepts lower and upper case.
+//returns false if hex has an odd length or contains a non hex character,
+//in this case the content of out is unspecified
+auto decodeHex(std::string_view hex,
+               std::byte* out)
+    -> bool;
+
+//appends the hex representation of the bytes to out
+auto appendHex(const std::vector<std::byte>& bytes,
+               std::string& out)
+    -> void;
+
+} // namespace forge::core
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <array>
+#include <core/ByteSpan.hpp>
+#include <cstddef>
+
+namespace forge::core {
+
+constexpr inline std::size_t SHA256_DIGEST_SIZE = 32;
+
+using Sha256Digest = std::array<std::byte, SHA256_DIGEST_SIZE>;
+
+auto sha256(ByteSpan data)
+    -> Sha256Digest;
+
+//sha256 of the sha256 of data, used for txids and
+//the checksums of addresses
+auto doubleSha256(ByteSpan data)
+    -> Sha256Digest;
+
+} // namespace forge::core
@@ -4,6 +4,7 @@
 #include <cstddef>
 #include <json/value.h>
 #include <memory>
+#include <string_view>
 #include <utilxx/Opt.hpp>
 #include <vector>
 
@@ -190,10 +191,10 @@ auto buildTxOut(Json::Value&& json)
 auto buildTransaction(Json::Value&& json)
     -> utilxx::Opt<Transaction>;
 
-auto extractMetadata(std::string&& hex)
+auto extractMetadata(std::string_view hex)
     -> utilxx::Opt<std::vector<std::byte>>;
 
-auto stringToByteVec(const std::string& str)
+auto stringToByteVec(std::string_view str)
     -> utilxx::Opt<std::vector<std::byte>>;
 
 auto stringToASCIIByteVec(const std::string& str)
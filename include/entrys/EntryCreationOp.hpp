@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <entrys/token/UtilityTokenCreationOp.hpp>
 #include <entrys/uentry/UniqueEntryCreationOp.hpp>
 #include <entrys/umentry/UMEntryCreationOp.hpp>
@@ -11,6 +12,19 @@ using EntryCreationOp = std::variant<UniqueEntryCreationOp,
                                      UMEntryCreationOp,
                                      UtilityTokenCreationOp>;
 
+//competing creations of one key are compared by this value, so every
+//creation which burns coins ties with every other one. this is part of
+//the consensus rules, changing it splits nodes with and without the change
 auto getBurnValue(const EntryCreationOp& op)
     -> bool;
+
+//amount the creation burns, competing creations are compared by it
+//from getCreationBurnComparisonHeight on
+auto getBurnAmount(const EntryCreationOp& op)
+    -> std::int64_t;
+
+//the entry key or the id of the created token
+auto getEntryKey(const EntryCreationOp& op)
+    -> const EntryKey&;
+
 } // namespace forge::core
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <array>
+#include <core/ByteSpan.hpp>
+#include <core/FlagIndexes.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <entrys/umentry/UMEntry.hpp>
+#include <utilxx/Opt.hpp>
+
+namespace forge::core {
+
+//3 bytes mask
+//1 token type flag
+//1 op flag
+//1 value flag
+//at least 4 value
+//at least 1 key
+constexpr inline std::size_t ENTRY_METADATA_MIN_SIZE = 11;
+
+//3 bytes mask
+//1 token type flag
+//1 op flag
+//8 amount
+//at least 1 id
+constexpr inline std::size_t UTILITY_TOKEN_METADATA_MIN_SIZE = 14;
+
+//what an operation flag means, independent of the token type
+enum class OperationKind : std::uint8_t {
+    Invalid = 0,
+    Creation,
+    Renewal,
+    OwnershipTransfer,
+    Update,
+    Deletion
+};
+
+//one operation flag a token type understands
+struct OperationLayout
+{
+    std::byte flag;
+    OperationKind kind;
+};
+
+//operation kind of every possible operation flag
+using OperationTable = std::array<OperationKind, 256>;
+
+//describes the metadata of one token type
+struct MetadataLayout
+{
+    std::byte token_type;
+    std::size_t min_size;
+    OperationTable operations;
+};
+
+//builds the layout of a token type at compile time,
+//all flags which are not listed decode to OperationKind::Invalid
+template<std::size_t N>
+constexpr auto makeMetadataLayout(std::byte token_type,
+                                  std::size_t min_size,
+                                  const std::array<OperationLayout, N>& operations)
+    -> MetadataLayout
+{
+    OperationTable table{};
+
+    for(const auto& operation : operations) {
+        table[static_cast<std::size_t>(operation.flag)] = operation.kind;
+    }
+
+    return MetadataLayout{token_type,
+                          min_size,
+                          table};
+}
+
+//value and key of an entry, the key still points
+//into the decoded metadata
+struct DecodedEntry
+{
+    UMEntryValue value;
+    ByteSpan key;
+};
+
+//amount and id of a utility token, the id still points
+//into the decoded metadata
+struct DecodedToken
+{
+    std::uint64_t amount;
+    ByteSpan id;
+};
+
+//decodes the value flag, the value and the key of an entry
+//without looking at the token type or the operation flag
+auto decodeEntryValue(ByteSpan metadata)
+    -> utilxx::Opt<DecodedEntry>;
+
+//returns nullopt if the metadata is too short or
+//belongs to a different token type
+auto decodeEntry(ByteSpan metadata,
+                 const MetadataLayout& layout)
+    -> utilxx::Opt<DecodedEntry>;
+
+//returns nullopt if the metadata is too short or
+//belongs to a different token type
+auto decodeToken(ByteSpan metadata,
+                 const MetadataLayout& layout)
+    -> utilxx::Opt<DecodedToken>;
+
+//the metadata has to be at least layout.min_size bytes,
+//which is the case after decodeEntry or decodeToken succeeded
+constexpr auto decodeOperation(ByteSpan metadata,
+                               const MetadataLayout& layout)
+    -> OperationKind
+{
+    auto flag = metadata[OPERATION_FLAG_INDEX];
+    return layout.operations[static_cast<std::size_t>(flag)];
+}
+
+} // namespace forge::core
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <core/ByteSpan.hpp>
 #include <cstddef>
 #include <cstdint>
 #include <json/value.h>
@@ -47,7 +48,7 @@ private:
     std::uint64_t attached_amount_;
 };
 
-auto parseUtilityToken(const std::vector<std::byte>& metadata)
+auto parseUtilityToken(ByteSpan metadata)
     -> utilxx::Opt<UtilityToken>;
 
 
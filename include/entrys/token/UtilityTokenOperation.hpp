@@ -5,6 +5,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <client/ReadOnlyClientBase.hpp>
+#include <entrys/MetadataDecoder.hpp>
 #include <entrys/token/UtilityToken.hpp>
 #include <entrys/token/UtilityTokenCreationOp.hpp>
 #include <entrys/token/UtilityTokenDeletionOp.hpp>
@@ -21,6 +22,15 @@ constexpr inline auto UTILITY_TOKEN_OWNERSHIP_TRANSFER_FLAG = static_cast<std::b
 constexpr inline auto UTILITY_TOKEN_DELETION_FLAG     = static_cast<std::byte>(0b00000100);
 // clang-format on
 
+//layout of the metadata of all UtilityToken operations
+constexpr inline auto UTILITY_TOKEN_METADATA_LAYOUT =
+    makeMetadataLayout(UTILITY_TOKEN_IDENTIFICATION_FLAG,
+                       UTILITY_TOKEN_METADATA_MIN_SIZE,
+                       std::array{
+                           OperationLayout{UTILITY_TOKEN_CREATION_FLAG, OperationKind::Creation},
+                           OperationLayout{UTILITY_TOKEN_OWNERSHIP_TRANSFER_FLAG, OperationKind::OwnershipTransfer},
+                           OperationLayout{UTILITY_TOKEN_DELETION_FLAG, OperationKind::Deletion}});
+
 using UtilityTokenOperation = std::variant<UtilityTokenCreationOp,
                                            UtilityTokenDeletionOp,
                                            UtilityTokenOwnershipTransferOp>;
@@ -47,7 +57,7 @@ auto extractOperationFlag(const UtilityTokenOperation&)
 //checks the metadata of a transaction and parses it into
 //an UtilityTokenOp if it holds the needed information
 //and the metadata has the needed formating
-auto parseTransactionToUtilityTokenOp(core::Transaction tx,
+auto parseTransactionToUtilityTokenOp(const core::Transaction& tx,
                                       std::int64_t block,
                                       const client::ReadOnlyClientBase* client)
     -> utilxx::Result<utilxx::Opt<UtilityTokenOperation>,
@@ -55,7 +65,7 @@ auto parseTransactionToUtilityTokenOp(core::Transaction tx,
 
 //parses given metadata and constructs a UtilityTokenOp from
 //the given information if possible
-auto parseMetadataToUtilityTokenOp(const std::vector<std::byte>& metadata,
+auto parseMetadataToUtilityTokenOp(ByteSpan metadata,
                                    std::int64_t block,
                                    std::string&& owner,
                                    std::int64_t value,
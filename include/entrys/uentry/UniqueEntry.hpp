@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <core/ByteSpan.hpp>
 #include <cstddef>
 #include <entrys/umentry/UMEntry.hpp>
 #include <json/value.h>
@@ -48,13 +49,13 @@ private:
     UniqueEntryValue value_;
 };
 
-auto parseUniqueValue(const std::vector<std::byte>& data)
+auto parseUniqueValue(ByteSpan data)
     -> utilxx::Opt<UniqueEntryValue>;
 
-auto parseUniqueKey(const std::vector<std::byte>& data)
+auto parseUniqueKey(ByteSpan data)
     -> utilxx::Opt<EntryKey>;
 
-auto parseUniqueEntry(const std::vector<std::byte>& data)
+auto parseUniqueEntry(ByteSpan data)
     -> utilxx::Opt<UniqueEntry>;
 
 auto extractUniqueValueFlag(const UniqueEntryValue& value)
@@ -4,6 +4,7 @@
 #include <core/Transaction.hpp>
 #include <cstddef>
 #include <client/ReadOnlyClientBase.hpp>
+#include <entrys/MetadataDecoder.hpp>
 #include <entrys/uentry/UniqueEntry.hpp>
 #include <entrys/uentry/UniqueEntryCreationOp.hpp>
 #include <entrys/uentry/UniqueEntryDeletionOp.hpp>
@@ -22,6 +23,16 @@ constexpr inline auto UNIQUE_ENTRY_OWNERSHIP_TRANSFER_FLAG = static_cast<std::by
 constexpr inline auto UNIQUE_ENTRY_DELETION_FLAG           = static_cast<std::byte>(0b00001000);
 // clang-format on
 
+//layout of the metadata of all UniqueEntry operations
+constexpr inline auto UNIQUE_ENTRY_METADATA_LAYOUT =
+    makeMetadataLayout(UNIQUE_ENTRY_IDENTIFICATION_FLAG,
+                       ENTRY_METADATA_MIN_SIZE,
+                       std::array{
+                           OperationLayout{UNIQUE_ENTRY_CREATION_FLAG, OperationKind::Creation},
+                           OperationLayout{UNIQUE_ENTRY_RENEWAL_FLAG, OperationKind::Renewal},
+                           OperationLayout{UNIQUE_ENTRY_OWNERSHIP_TRANSFER_FLAG, OperationKind::OwnershipTransfer},
+                           OperationLayout{UNIQUE_ENTRY_DELETION_FLAG, OperationKind::Deletion}});
+
 using UniqueEntryOperation = std::variant<UniqueEntryCreationOp,
                                           UniqueEntryRenewalOp,
                                           UniqueEntryOwnershipTransferOp,
@@ -57,14 +68,14 @@ auto extractOperationFlag(const UniqueEntryOperation&)
 //checks the metadata of a transaction and parses it into
 //an UniqueEntryOperation if it holds the needed information
 //and the metadata has the needed formating
-auto parseTransactionToUniqueEntry(core::Transaction tx,
+auto parseTransactionToUniqueEntry(const core::Transaction& tx,
                                    std::int64_t block,
                                    const client::ReadOnlyClientBase* client)
     -> utilxx::Result<utilxx::Opt<UniqueEntryOperation>, client::ClientError>;
 
 //parses given metadata and constructs a UniqueEntryOperation from
 //the given information if possible
-auto parseMetadataToUniqueEntryOp(const std::vector<std::byte>& metadata,
+auto parseMetadataToUniqueEntryOp(ByteSpan metadata,
                                   std::int64_t block,
                                   std::string&& owner,
                                   std::int64_t value,
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <core/ByteSpan.hpp>
 #include <cstddef>
 #include <json/value.h>
 #include <utilxx/Opt.hpp>
@@ -33,6 +34,10 @@ constexpr static inline auto IPv6_VALUE_FLAG = static_cast<std::byte>(0b00000010
 constexpr static inline auto NONE_VALUE_FLAG = static_cast<std::byte>(0b00000100);
 constexpr static inline auto BYTE_ARRAY_VALUE_FLAG = static_cast<std::byte>(0b00001000);
 
+//byte arrays are prefixed with a single length byte,
+//so longer values can not be encoded
+constexpr static inline std::size_t MAX_BYTE_ARRAY_VALUE_SIZE = 255;
+
 using UMEntryValue = std::variant<IPv4Value,
                                   IPv6Value,
                                   ByteArray,
@@ -73,13 +78,13 @@ private:
 };
 
 
-auto parseUMValue(const std::vector<std::byte>& data)
+auto parseUMValue(ByteSpan data)
     -> utilxx::Opt<UMEntryValue>;
 
-auto parseUMKey(const std::vector<std::byte>& data)
+auto parseUMKey(ByteSpan data)
     -> utilxx::Opt<EntryKey>;
 
-auto parseUMEntry(const std::vector<std::byte>& data)
+auto parseUMEntry(ByteSpan data)
     -> utilxx::Opt<UMEntry>;
 
 auto extractValueFlag(const UMEntryValue& value)
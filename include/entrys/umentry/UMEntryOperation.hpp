@@ -4,6 +4,7 @@
 #include <core/Transaction.hpp>
 #include <cstddef>
 #include <client/ReadOnlyClientBase.hpp>
+#include <entrys/MetadataDecoder.hpp>
 #include <entrys/umentry/UMEntry.hpp>
 #include <entrys/umentry/UMEntryCreationOp.hpp>
 #include <entrys/umentry/UMEntryDeletionOp.hpp>
@@ -24,6 +25,17 @@ constexpr inline auto UMENTRY_UPDATE_FLAG       = static_cast<std::byte>(0b00001
 constexpr inline auto UMENTRY_DELETION_FLAG     = static_cast<std::byte>(0b00010000);
 // clang-format on
 
+//layout of the metadata of all UMEntry operations
+constexpr inline auto UMENTRY_METADATA_LAYOUT =
+    makeMetadataLayout(UMENTRY_IDENTIFICATION_FLAG,
+                       ENTRY_METADATA_MIN_SIZE,
+                       std::array{
+                           OperationLayout{UMENTRY_CREATION_FLAG, OperationKind::Creation},
+                           OperationLayout{UMENTRY_RENEWAL_FLAG, OperationKind::Renewal},
+                           OperationLayout{UMENTRY_OWNERSHIP_TRANSFER_FLAG, OperationKind::OwnershipTransfer},
+                           OperationLayout{UMENTRY_UPDATE_FLAG, OperationKind::Update},
+                           OperationLayout{UMENTRY_DELETION_FLAG, OperationKind::Deletion}});
+
 using UMEntryOperation = std::variant<UMEntryCreationOp,
                                       UMEntryRenewalOp,
                                       UMEntryOwnershipTransferOp,
@@ -60,14 +72,14 @@ auto extractOperationFlag(const UMEntryOperation&)
 //checks the metadata of a transaction and parses it into
 //an UMEntryOperation if it holds the needed information
 //and the metadata has the needed formating
-auto parseTransactionToUMEntry(core::Transaction tx,
+auto parseTransactionToUMEntry(const core::Transaction& tx,
                                std::int64_t block,
                                const client::ReadOnlyClientBase* client)
     -> utilxx::Result<utilxx::Opt<UMEntryOperation>, client::ClientError>;
 
 //parses given metadata and constructs a UNEntryOperation from
 //the given information if possible
-auto parseMetadataToUMEntryOp(const std::vector<std::byte>& metadata,
+auto parseMetadataToUMEntryOp(ByteSpan metadata,
                               std::int64_t block,
                               std::string&& owner,
                               std::int64_t value,
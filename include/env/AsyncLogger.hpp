@@ -0,0 +1,257 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <fmt/core.h>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <variant>
+
+//log sites below this level are compiled out, set with
+//-DFORGE_MIN_LOG_LEVEL=FORGE_LOG_LEVEL_<level>
+#define FORGE_LOG_LEVEL_DEBUG 0
+#define FORGE_LOG_LEVEL_INFO 1
+#define FORGE_LOG_LEVEL_WARNING 2
+
+#ifndef FORGE_MIN_LOG_LEVEL
+#define FORGE_MIN_LOG_LEVEL FORGE_LOG_LEVEL_DEBUG
+#endif
+
+//logs a message through the async logger. the format has to be a string
+//literal with plain {} placeholders, arguments are copied into the record
+//and formatted on the logger thread.
+//every call site below WARNING logs at most DEFAULT_LOG_RATE_LIMIT
+//messages per second, warnings are written right away and never dropped
+//  FORGE_LOG(INFO, "{} contains a OP_RETURN output", txid);
+#define FORGE_LOG(level, ...)                                                 \
+    FORGE_LOG_EVERY_N(level, 1, __VA_ARGS__)
+
+//only logs every n-th call of the site
+#define FORGE_LOG_EVERY_N(level, n, ...)                                      \
+    do {                                                                      \
+        if constexpr(FORGE_LOG_LEVEL_##level >= FORGE_MIN_LOG_LEVEL) {        \
+            static forge::env::LogSite forge_log_site{                       \
+                forge::env::LogLevel::level,                                  \
+                __FILE__,                                                     \
+                __LINE__,                                                     \
+                n,                                                            \
+                forge::env::DEFAULT_LOG_RATE_LIMIT};                          \
+            forge::env::getAsyncLogger().log(forge_log_site, __VA_ARGS__);    \
+        }                                                                     \
+    } while(false)
+
+namespace forge::env {
+
+enum class LogLevel {
+    DEBUG = FORGE_LOG_LEVEL_DEBUG,
+    INFO = FORGE_LOG_LEVEL_INFO,
+    WARNING = FORGE_LOG_LEVEL_WARNING
+};
+
+//messages per second and call site, warnings are not limited
+constexpr inline std::uint32_t DEFAULT_LOG_RATE_LIMIT = 100;
+
+//records which can be queued before new ones are dropped
+constexpr inline std::size_t DEFAULT_LOG_QUEUE_CAPACITY = 1024;
+
+constexpr inline std::size_t MAX_LOG_ARGS = 4;
+
+//longer strings get truncated, except in warnings
+constexpr inline std::size_t MAX_LOG_STRING_SIZE = 127;
+
+struct LogString
+{
+    std::uint8_t size;
+    std::array<char, MAX_LOG_STRING_SIZE> data;
+};
+
+using LogArg = std::variant<std::int64_t,
+                            std::uint64_t,
+                            double,
+                            bool,
+                            LogString>;
+
+//static state of a single log statement
+class LogSite final
+{
+public:
+    LogSite(LogLevel level,
+            const char* file,
+            int line,
+            std::uint32_t every_n,
+            std::uint32_t max_per_second);
+
+    //applies sampling and, below WARNING, the rate limit
+    auto shouldLog()
+        -> bool;
+
+    //returns the number of messages dropped by the rate limit
+    //since the last call
+    auto takeSuppressed()
+        -> std::uint64_t;
+
+    auto getLevel() const
+        -> LogLevel;
+    auto getFile() const
+        -> const char*;
+    auto getLine() const
+        -> int;
+
+private:
+    LogLevel level_;
+    const char* file_;
+    int line_;
+    std::uint32_t every_n_;
+    std::uint32_t max_per_second_;
+    std::atomic<std::uint64_t> hits_{0};
+    std::atomic<std::int64_t> window_{0};
+    std::atomic<std::uint32_t> logged_in_window_{0};
+    std::atomic<std::uint64_t> suppressed_{0};
+};
+
+struct LogRecord
+{
+    const LogSite* site;
+    //has to point to a string literal
+    const char* format;
+    std::uint64_t suppressed;
+    std::size_t number_of_args;
+    std::array<LogArg, MAX_LOG_ARGS> args;
+};
+
+//receives the formatted messages on the logger thread,
+//warnings are passed to it on the thread which logs them,
+//so it has to be thread safe
+using LogSink = std::function<void(const LogSite&, std::string&&)>;
+
+//forwards to g3log, keeping file and line of the site
+auto g3logSink(const LogSite& site,
+               std::string&& message)
+    -> void;
+
+template<class T>
+auto toLogArg(T&& value)
+    -> LogArg
+{
+    using Type = std::decay_t<T>;
+
+    if constexpr(std::is_same_v<Type, bool>) {
+        return value;
+    } else if constexpr(std::is_integral_v<Type> && std::is_signed_v<Type>) {
+        return static_cast<std::int64_t>(value);
+    } else if constexpr(std::is_integral_v<Type>) {
+        return static_cast<std::uint64_t>(value);
+    } else if constexpr(std::is_floating_point_v<Type>) {
+        return static_cast<double>(value);
+    } else {
+        static_assert(std::is_convertible_v<const Type&, std::string_view>,
+                      "only numbers and strings can be logged asynchronously");
+
+        std::string_view view{value};
+        LogString string{};
+        string.size = static_cast<std::uint8_t>(
+            std::min(view.size(), MAX_LOG_STRING_SIZE));
+        std::memcpy(string.data.data(), view.data(), string.size);
+        return string;
+    }
+}
+
+//moves formatting and writing of log messages off the calling thread.
+//producers only copy their arguments into a bounded lock free queue,
+//if the queue is full the record is dropped instead of blocking.
+//records which are still queued when the process crashes are lost.
+//Warnings bypass the queue, so error texts are neither truncated nor lost
+class AsyncLogger final
+{
+public:
+    explicit AsyncLogger(LogSink sink = g3logSink,
+                         std::size_t capacity = DEFAULT_LOG_QUEUE_CAPACITY);
+
+    AsyncLogger(const AsyncLogger&) = delete;
+    AsyncLogger(AsyncLogger&&) = delete;
+    auto operator=(const AsyncLogger&) = delete;
+    auto operator=(AsyncLogger&&) = delete;
+
+    //writes all queued records before returning
+    ~AsyncLogger();
+
+    template<class... Args>
+    auto log(LogSite& site,
+             const char* format,
+             Args&&... args)
+        -> void
+    {
+        static_assert(sizeof...(Args) <= MAX_LOG_ARGS,
+                      "too many arguments for an async log record");
+
+        if(!site.shouldLog()) {
+            return;
+        }
+
+        if(site.getLevel() >= LogLevel::WARNING) {
+            writeUnqueued(site, format, fmt::make_format_args(args...));
+            return;
+        }
+
+        push(LogRecord{&site,
+                       format,
+                       site.takeSuppressed(),
+                       sizeof...(Args),
+                       {toLogArg(std::forward<Args>(args))...}});
+    }
+
+    //blocks until all records queued so far are written
+    auto flush()
+        -> void;
+
+    auto getDropped() const
+        -> std::uint64_t;
+
+private:
+    struct Cell
+    {
+        std::atomic<std::size_t> sequence;
+        LogRecord record;
+    };
+
+    auto push(LogRecord&& record)
+        -> void;
+
+    auto pop(LogRecord& record)
+        -> bool;
+
+    auto write(const LogRecord& record)
+        -> void;
+
+    auto writeUnqueued(const LogSite& site,
+                       const char* format,
+                       fmt::format_args args)
+        -> void;
+
+    auto run()
+        -> void;
+
+private:
+    LogSink sink_;
+    std::size_t mask_;
+    std::unique_ptr<Cell[]> cells_;
+    std::atomic<std::size_t> enqueue_pos_{0};
+    std::atomic<std::size_t> written_{0};
+    std::size_t dequeue_pos_{0};
+    std::atomic<std::uint64_t> dropped_{0};
+    std::atomic<bool> should_stop_{false};
+    std::thread thread_;
+};
+
+//logger of the process, used by FORGE_LOG
+auto getAsyncLogger()
+    -> AsyncLogger&;
+
+} // namespace forge::env
@@ -23,7 +23,27 @@ constexpr static inline auto DEFAULT_CONFIG_FILE =
     "user = \"user\"\n"
     "password = \"password\"\n"
     "host = \"localhost\"\n"
-    "port = 22101\n";
+    "port = 22101\n"
+    "#fee rate in the smallest unit per 1000 bytes,\n"
+    "#estimated by the daemon if not set\n"
+    "#feerate = 100000\n\n"
+
+    "#publish the lookup into shared memory for local readers\n"
+    "#[shm]\n"
+    "#name = \"/forge-lookup\"\n\n"
+
+    "#serve prometheus metrics on http://<host>:<port>/metrics\n"
+    "#[metrics]\n"
+    "#port = 9100\n\n"
+
+    "#track the forge operations of the mempool and of immature blocks\n"
+    "#[lookup]\n"
+    "#pending = true\n\n"
+
+    "#file the owned and watched addresses are kept in,\n"
+    "#defaults to <workdir>/addressbook\n"
+    "#[wallet]\n"
+    "#addressbook = \"/path/to/addressbook\"\n";
 
 
 enum class Mode {
@@ -46,7 +66,12 @@ public:
                    std::string&& coin_password,
                    std::int64_t rpc_port,
                    std::string&& rpc_user,
-                   std::string&& rpc_password);
+                   std::string&& rpc_password,
+                   utilxx::Opt<std::string>&& shm_name,
+                   utilxx::Opt<std::int64_t>&& metrics_port,
+                   bool track_pending,
+                   std::string&& address_book_path,
+                   utilxx::Opt<std::int64_t>&& fee_rate);
 
     auto getLogFolder() const
         -> const std::string&;
@@ -84,6 +109,30 @@ public:
     auto getRpcPassword() const
         -> const std::string&;
 
+    //name of the shared memory region the lookup is published to,
+    //if none is set the lookup is only available via rpc
+    auto getSharedMemoryName() const
+        -> const utilxx::Opt<std::string>&;
+
+    //port /metrics is served on, if none is set
+    //no metrics are served
+    auto getMetricsPort() const
+        -> const utilxx::Opt<std::int64_t>&;
+
+    //if set, operations which are not mature yet
+    //can be queried and are respected by the wallet
+    auto shouldTrackPendingOperations() const
+        -> bool;
+
+    //file the owned and watched addresses of the wallet are kept in
+    auto getAddressBookPath() const
+        -> const std::string&;
+
+    //fee rate of the transactions forged writes, if none is set
+    //the estimate of the daemon is used
+    auto getFeeRate() const
+        -> const utilxx::Opt<std::int64_t>&;
+
 private:
     std::string logfolder_;
     bool log_to_console_;
@@ -102,6 +151,12 @@ private:
     std::int64_t rpc_port_;
     std::string rpc_user_;
     std::string rpc_password_;
+
+    utilxx::Opt<std::string> shm_name_;
+    utilxx::Opt<std::int64_t> metrics_port_;
+    bool track_pending_;
+    std::string address_book_path_;
+    utilxx::Opt<std::int64_t> fee_rate_;
 };
 
 auto parseOptions(int argc, char* argv[])
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+
+namespace forge::lookup {
+
+//the arena starts with this many bytes and grows to the
+//largest block seen so far, up to MAX_BLOCK_ARENA_SIZE
+constexpr inline std::size_t DEFAULT_BLOCK_ARENA_SIZE = 256 * 1024;
+constexpr inline std::size_t MAX_BLOCK_ARENA_SIZE = 64 * 1024 * 1024;
+
+//monotonic memory for everything which only lives while a
+//single block is processed. allocations are never freed one
+//by one, reset() releases all of them at once.
+//not thread safe, it is used under the writer lock of the lookup
+class BlockArena final
+{
+public:
+    explicit BlockArena(std::size_t initial_size = DEFAULT_BLOCK_ARENA_SIZE);
+
+    auto getResource()
+        -> std::pmr::memory_resource*;
+
+    //releases all allocations, if the last block did not fit
+    //into the buffer the buffer grows so that the next one does.
+    //nothing allocated from the arena may be used afterwards
+    auto reset()
+        -> void;
+
+    //bytes which are available before the arena
+    //has to fall back to the heap
+    auto getBufferSize() const
+        -> std::size_t;
+
+    //bytes which were requested from the heap
+    //since the last reset
+    auto getOverflowSize() const
+        -> std::size_t;
+
+private:
+    //counts what the monotonic resource requests
+    //once its buffer is exhausted
+    class OverflowResource final : public std::pmr::memory_resource
+    {
+    public:
+        auto getAllocated() const
+            -> std::size_t;
+
+        auto clear()
+            -> void;
+
+    private:
+        auto do_allocate(std::size_t bytes,
+                         std::size_t alignment)
+            -> void* override;
+
+        auto do_deallocate(void* ptr,
+                           std::size_t bytes,
+                           std::size_t alignment)
+            -> void override;
+
+        auto do_is_equal(const std::pmr::memory_resource& other) const noexcept
+            -> bool override;
+
+        std::size_t allocated_{0};
+    };
+
+    std::unique_ptr<std::byte[]> buffer_;
+    std::size_t buffer_size_;
+    OverflowResource overflow_;
+    std::optional<std::pmr::monotonic_buffer_resource> resource_;
+};
+
+} // namespace forge::lookup
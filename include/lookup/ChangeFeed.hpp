@@ -0,0 +1,90 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <entrys/token/UtilityTokenOperation.hpp>
+#include <entrys/uentry/UniqueEntryOperation.hpp>
+#include <entrys/umentry/UMEntryOperation.hpp>
+#include <json/value.h>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace forge::lookup {
+
+//number of events kept in memory, older ones are dropped
+constexpr inline std::size_t DEFAULT_CHANGE_FEED_CAPACITY = 100000;
+
+//maximum time a subscriber can wait for new events, a waiting
+//subscriber blocks one thread of the rpc server meanwhile
+constexpr inline auto MAX_CHANGE_FEED_WAIT = std::chrono::seconds{1};
+
+struct ChangeEvent
+{
+    std::uint64_t sequence;
+    std::int64_t block_height;
+    Json::Value data;
+};
+
+//in memory log of all operations which were applied to the lookup
+//and of rollbacks, subscribers poll it with the sequence of the
+//next event they expect
+class ChangeFeed final
+{
+public:
+    ChangeFeed(std::size_t capacity = DEFAULT_CHANGE_FEED_CAPACITY);
+
+    //instantiated for the operations of the umentry,
+    //unique entry and utility token lookups
+    template<class Operation>
+    auto recordOperations(std::int64_t block_height,
+                          const std::vector<Operation>& ops)
+        -> void;
+
+    //all operations of blocks >= first_invalid_block have been undone
+    auto recordRollback(std::int64_t first_invalid_block)
+        -> void;
+
+    //returns at most limit events with a sequence >= since,
+    //if there are none it waits up to timeout for new ones
+    auto getEvents(std::uint64_t since,
+                   std::size_t limit,
+                   std::chrono::milliseconds timeout) const
+        -> std::vector<ChangeEvent>;
+
+    //sequence of the oldest event still available
+    auto getFirstSequence() const
+        -> std::uint64_t;
+
+    //sequence the next recorded event will get
+    auto getNextSequence() const
+        -> std::uint64_t;
+
+private:
+    //expects mtx_ to be locked
+    auto push(std::int64_t block_height,
+              Json::Value&& data)
+        -> void;
+
+private:
+    std::unique_ptr<std::mutex> mtx_;
+    std::unique_ptr<std::condition_variable> new_events_;
+    std::deque<ChangeEvent> events_;
+    std::uint64_t next_sequence_;
+    std::size_t capacity_;
+};
+
+auto changeEventToJson(const ChangeEvent& event)
+    -> Json::Value;
+
+//json description of an operation as it is recorded in the feed
+auto operationToJson(const core::UMEntryOperation& operation)
+    -> Json::Value;
+auto operationToJson(const core::UniqueEntryOperation& operation)
+    -> Json::Value;
+auto operationToJson(const core::UtilityTokenOperation& operation)
+    -> Json::Value;
+
+} // namespace forge::lookup
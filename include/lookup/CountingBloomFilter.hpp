@@ -0,0 +1,62 @@
+#pragma once
+
+#include <core/ByteSpan.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace forge::lookup {
+
+//with 10 counters per key and 7 hashes about 1% of the keys
+//which were never inserted are reported as maybe contained
+constexpr inline std::size_t BLOOM_COUNTERS_PER_KEY = 10;
+constexpr inline std::size_t BLOOM_NUMBER_OF_HASHES = 7;
+
+//bloom filter which supports erasing keys. every slot is an 8 bit
+//counter instead of a bit, a counter which reached its maximum
+//stays there, so erasing can never cause a false negative
+class CountingBloomFilter final
+{
+public:
+    explicit CountingBloomFilter(std::size_t capacity);
+
+    //a key can be inserted multiple times,
+    //it then has to be erased as often
+    auto insert(core::ByteSpan key)
+        -> void;
+
+    //the key has to be inserted before
+    auto erase(core::ByteSpan key)
+        -> void;
+
+    //false means the key is definitely not inserted,
+    //a filter without counters may contain every key
+    auto mayContain(core::ByteSpan key) const
+        -> bool;
+
+    //number of inserted keys
+    auto size() const
+        -> std::size_t;
+
+    //number of keys the filter was sized for, more keys
+    //increase the rate of false positives
+    auto getCapacity() const
+        -> std::size_t;
+
+    //removes all keys and resizes the filter
+    auto clear(std::size_t capacity)
+        -> void;
+
+private:
+    template<class Func>
+    auto forEachCounter(core::ByteSpan key,
+                        Func&& func) const
+        -> void;
+
+private:
+    std::vector<std::uint8_t> counters_;
+    std::size_t capacity_;
+    std::size_t size_{0};
+};
+
+} // namespace forge::lookup
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <entrys/Entry.hpp>
+#include <map>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utilxx/Opt.hpp>
+#include <vector>
+
+namespace forge::lookup {
+
+//state of an umentry or unique entry
+struct EntryState
+{
+    core::Entry entry;
+    std::string owner;
+    std::int64_t activation_block;
+};
+
+//state of an entry starting at a given block,
+//an empty state means the entry did not exist
+struct EntryVersion
+{
+    std::int64_t block;
+    utilxx::Opt<EntryState> state;
+};
+
+//append only list of all versions of every entry key,
+//used to answer queries about past blocks.
+//The key is only stored once, owners are interned and
+//values and activation blocks are only stored when they change.
+class EntryHistory final
+{
+public:
+    //blocks have to be recorded in ascending order,
+    //recording a key twice in the same block replaces the version
+    auto record(const core::EntryKey& key,
+                std::int64_t block,
+                utilxx::Opt<EntryState>&& state)
+        -> void;
+
+    //returns the state of the entry at the end of the given block
+    auto lookupAt(const core::EntryKey& key,
+                  std::int64_t block) const
+        -> utilxx::Opt<EntryVersion>;
+
+    //returns all versions of the given key, oldest first
+    auto getVersions(const core::EntryKey& key) const
+        -> std::vector<EntryVersion>;
+
+    //number of distinct owners which are interned
+    auto getNumberOfOwners() const
+        -> std::size_t;
+
+    auto clear()
+        -> void;
+
+private:
+    enum class EntryKind : std::uint8_t {
+        Deleted,
+        UMEntry,
+        UniqueEntry
+    };
+
+    //indices into the values and activation blocks of the key
+    //and into the interned owners
+    struct CompactVersion
+    {
+        std::int64_t block;
+        std::uint32_t value;
+        std::uint32_t activation_block;
+        std::uint32_t owner;
+        EntryKind kind;
+    };
+
+    struct KeyHistory
+    {
+        std::vector<CompactVersion> versions;
+        std::vector<core::UMEntryValue> values;
+        std::vector<std::int64_t> activation_blocks;
+    };
+
+    auto internOwner(std::string&& owner)
+        -> std::uint32_t;
+
+    auto expand(const core::EntryKey& key,
+                const KeyHistory& history,
+                const CompactVersion& version) const
+        -> EntryVersion;
+
+private:
+    std::map<core::EntryKey, KeyHistory> history_;
+    //a deque keeps the owners in place, the ids refer to them
+    std::deque<std::string> owners_;
+    std::unordered_map<std::string_view, std::uint32_t> owner_ids_;
+};
+
+} // namespace forge::lookup
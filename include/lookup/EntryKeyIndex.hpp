@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <entrys/umentry/UMEntry.hpp>
+#include <lookup/UMEntryLookup.hpp>
+#include <lookup/UniqueEntryLookup.hpp>
+#include <lookup/UtilityTokenLookup.hpp>
+#include <utilxx/Opt.hpp>
+#include <vector>
+
+namespace forge::lookup {
+
+enum class IndexedEntryType : std::uint8_t {
+    UMEntry,
+    UniqueEntry,
+    UtilityToken
+};
+
+//sorted flat index over the keys of all umentrys, unique entrys
+//and utility tokens. The key bytes are stored back to back in one
+//buffer, so a scan only touches sequential memory.
+class EntryKeyIndex final
+{
+public:
+    using ScanResult = std::vector<std::pair<core::EntryKey,
+                                             IndexedEntryType>>;
+
+    //replaces the index with the keys of the given lookups
+    auto rebuild(const UMEntryLookup& um_entrys,
+                 const UniqueEntryLookup& unique_entrys,
+                 const UtilityTokenLookup& utility_tokens)
+        -> void;
+
+    //replaces the records of one key, the types have to be
+    //in the order of IndexedEntryType. No types remove the key
+    auto update(const core::EntryKey& key,
+                const std::vector<IndexedEntryType>& types)
+        -> void;
+
+    //returns at most limit keys starting with prefix in ascending order,
+    //if a cursor is given only keys greater than the cursor are returned
+    auto scan(const core::EntryKey& prefix,
+              const utilxx::Opt<core::EntryKey>& cursor,
+              std::size_t limit) const
+        -> ScanResult;
+
+    auto size() const
+        -> std::size_t;
+
+    auto clear()
+        -> void;
+
+private:
+    struct IndexRecord
+    {
+        std::uint32_t offset;
+        std::uint32_t size;
+        IndexedEntryType type;
+    };
+
+    auto append(const core::EntryKey& key,
+                IndexedEntryType type)
+        -> void;
+
+    auto keyBegin(const IndexRecord& record) const
+        -> const std::byte*;
+
+    //copies the keys of the records into a new buffer
+    //without the bytes of removed keys
+    auto compact()
+        -> void;
+
+private:
+    std::vector<std::byte> key_data_;
+    std::vector<IndexRecord> records_;
+    //bytes in key_data_ which belong to no record anymore
+    std::size_t unused_bytes_{0};
+};
+
+} // namespace forge::lookup
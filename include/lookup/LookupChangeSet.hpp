@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <entrys/umentry/UMEntry.hpp>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace forge::lookup {
+
+//number of change sets the lookup manager keeps,
+//consumers which fall further behind have to rescan
+constexpr inline std::size_t MAX_LOOKUP_CHANGE_SETS = 1000;
+
+//keys and token accounts which were touched by the operations of one block,
+//consumers can use it to update derived state without rescanning the lookup
+struct LookupChangeSet
+{
+    std::int64_t block_height;
+    std::vector<core::EntryKey> um_entry_keys;
+    std::vector<core::EntryKey> unique_entry_keys;
+
+    //(token id, owner) of every account whose balance may have changed
+    std::vector<std::pair<core::EntryKey, std::string>> token_accounts;
+};
+
+} // namespace forge::lookup
@@ -2,16 +2,28 @@
 
 #include <core/Coin.hpp>
 #include <core/Transaction.hpp>
+#include <cstddef>
 #include <cstdint>
+#include <deque>
 #include <client/ReadOnlyClientBase.hpp>
 #include <entrys/Entry.hpp>
 #include <entrys/EntryCreationOp.hpp>
 #include <entrys/token/UtilityToken.hpp>
 #include <entrys/umentry/UMEntryOperation.hpp>
 #include <functional>
+#include <memory_resource>
+#include <lookup/BlockArena.hpp>
+#include <lookup/ChangeFeed.hpp>
+#include <lookup/CountingBloomFilter.hpp>
+#include <lookup/EntryKeyIndex.hpp>
+#include <lookup/LookupChangeSet.hpp>
+#include <lookup/EntryHistory.hpp>
+#include <lookup/PendingOperations.hpp>
+#include <lookup/SharedLookupPublisher.hpp>
 #include <lookup/UMEntryLookup.hpp>
 #include <lookup/UniqueEntryLookup.hpp>
 #include <lookup/UtilityTokenLookup.hpp>
+#include <mutex>
 #include <set>
 #include <shared_mutex>
 #include <utilxx/Opt.hpp>
@@ -25,11 +37,17 @@ using ManagerError = std::variant<LookupError,
 auto generateMessage(ManagerError&& error)
     -> std::string;
 
+//number of keys the reserved key filter is sized for at startup,
+//it doubles whenever the lookups hold more keys
+constexpr inline std::size_t INITIAL_RESERVED_KEY_CAPACITY = 1 << 14;
+
 class LookupManager final
 {
 public:
     LookupManager(std::unique_ptr<client::ReadOnlyClientBase>&& client);
-    LookupManager(LookupManager&&) = default;
+    //the lookups point back to the manager, so it can not be moved
+    LookupManager(LookupManager&&) = delete;
+    auto operator=(LookupManager&&) -> LookupManager& = delete;
 
     auto updateLookup()
         -> utilxx::Result<bool, ManagerError>;
@@ -37,6 +55,20 @@ public:
     auto rebuildLookup()
         -> utilxx::Result<void, ManagerError>;
 
+    //pending operations are only tracked if enabled
+    auto setTrackPendingOperations(bool track)
+        -> void;
+
+    //parses the forge operations of the mempool and of the blocks which
+    //are not mature yet, does nothing if pending operations are not tracked
+    auto updatePendingOperations()
+        -> utilxx::Result<void, ManagerError>;
+
+    //publishes the lookup tables into shared memory after every
+    //processed block, so that local processes can read them without rpc
+    auto setSharedLookupPublisher(std::unique_ptr<SharedLookupPublisher>&& publisher)
+        -> void;
+
     auto lookupUMValue(const core::EntryKey& key) const
         -> utilxx::Opt<std::reference_wrapper<const core::UMEntryValue>>;
 
@@ -52,6 +84,29 @@ public:
     auto lookupActivationBlock(const core::EntryKey& key) const
         -> utilxx::Opt<std::reference_wrapper<const std::int64_t>>;
 
+    //returns the state of an umentry or unique entry
+    //at the end of the given block
+    auto lookupAt(const core::EntryKey& key,
+                  std::int64_t block) const
+        -> utilxx::Opt<EntryVersion>;
+
+    //returns at most limit entrys whose keys start with prefix,
+    //ordered by key and starting after cursor if one is given
+    auto scanEntrys(const core::EntryKey& prefix,
+                    const utilxx::Opt<core::EntryKey>& cursor,
+                    std::size_t limit) const
+        -> std::vector<core::Entry>;
+
+    //generation of the next change set, a consumer which
+    //is up to date with the lookup has seen all generations before it
+    auto getChangeSetGeneration() const
+        -> std::uint64_t;
+
+    //returns the change sets of all blocks processed since the given generation,
+    //returns nothing if they are not available anymore and the consumer has to rescan
+    auto getChangeSetsSince(std::uint64_t generation) const
+        -> utilxx::Opt<std::vector<LookupChangeSet>>;
+
     auto lookupIsValid() const
         -> utilxx::Result<bool, client::ClientError>;
 
@@ -91,10 +146,83 @@ public:
     auto getClient() const
         -> const client::ReadOnlyClientBase&;
 
+    //log of all applied operations and rollbacks,
+    //it has its own lock and can be polled without blocking the lookup
+    auto getChangeFeed() const
+        -> const ChangeFeed&;
+
+    //operations which are not applied to the lookup yet,
+    //it has its own lock as well
+    auto getPendingOperations() const
+        -> const PendingOperations&;
+
 private:
+    //acquire rw_mtx_ and record the time spent waiting for it
+    auto lockShared() const
+        -> std::shared_lock<std::shared_mutex>;
+    auto lockExclusive() const
+        -> std::unique_lock<std::shared_mutex>;
+
+    //expects the writer lock to be held
+    auto publishSharedLookup()
+        -> void;
+
+    //expects the writer lock to be held
+    auto updateSizeMetrics(std::int64_t actual_height) const
+        -> void;
+
     auto processBlock(core::Block&& block)
         -> utilxx::Result<void, ManagerError>;
 
+    //expects the writer lock to be held
+    auto lookupEntryState(const core::EntryKey& key) const
+        -> utilxx::Opt<EntryState>;
+
+    //appends the current state of the given keys to the history
+    auto recordHistory(const std::vector<core::EntryKey>& keys,
+                       std::int64_t block_height)
+        -> void;
+
+    //every key the operations of a lookup may reserve or free,
+    //sorted and without duplicates
+    auto collectTouchedKeys(const std::vector<core::EntryKey>& entry_keys)
+        -> std::pmr::vector<const core::EntryKey*>;
+    auto collectTouchedKeys(const std::vector<std::pair<core::EntryKey, std::string>>& token_accounts)
+        -> std::pmr::vector<const core::EntryKey*>;
+
+    //keys which are in no lookup are added before the operations touching
+    //them are applied and dropped again if they are still in no lookup
+    //afterwards, so that the filter never misses a key a lookup holds
+    auto reserveKeys(const std::pmr::vector<const core::EntryKey*>& keys)
+        -> void;
+    auto releaseKeys(const std::pmr::vector<const core::EntryKey*>& keys)
+        -> void;
+
+    //updates the records of every key the block touched in the key index,
+    //so that the index never lists keys the lookups dropped
+    auto updateKeyIndex(const LookupChangeSet& change_set)
+        -> void;
+
+    //a key is in the filter as long as any lookup holds it,
+    //this is a superset of the reserved keys
+    auto isKeyInLookups(const core::EntryKey& key) const
+        -> bool;
+
+    //refills the filter from all lookups
+    auto rebuildReservedKeyFilter(std::size_t capacity)
+        -> void;
+
+    //adds the keys and accounts the applied operations touched
+    auto addToChangeSet(LookupChangeSet& change_set,
+                        const std::vector<core::UMEntryOperation>& ops) const
+        -> void;
+    auto addToChangeSet(LookupChangeSet& change_set,
+                        const std::vector<core::UniqueEntryOperation>& ops) const
+        -> void;
+    auto addToChangeSet(LookupChangeSet& change_set,
+                        const std::vector<core::UtilityTokenOperation>& ops) const
+        -> void;
+
     auto processUMEntrys(const std::vector<core::Transaction>& txs,
                          std::int64_t block_height)
         -> void;
@@ -117,17 +245,22 @@ private:
                       std::vector<core::UniqueEntryOperation>,
                       std::vector<core::UtilityTokenOperation>>;
 
+    //every forge operation of a transaction which is not mature yet
+    auto parsePendingTransaction(const core::Transaction& tx,
+                                 std::int64_t block_height) const
+        -> std::vector<PendingOperationVariant>;
+
     auto extractUMEntryOperations(const std::vector<core::Transaction>& txs,
                                   std::int64_t block_height)
-        -> std::vector<core::UMEntryOperation>;
+        -> std::pmr::vector<core::UMEntryOperation>;
 
     auto extractUniqueEntryOperations(const std::vector<core::Transaction>& txs,
                                       std::int64_t block_height)
-        -> std::vector<core::UniqueEntryOperation>;
+        -> std::pmr::vector<core::UniqueEntryOperation>;
 
     auto extractUtilityTokenOperations(const std::vector<core::Transaction>& txs,
                                        std::int64_t block_height)
-        -> std::vector<core::UtilityTokenOperation>;
+        -> std::pmr::vector<core::UtilityTokenOperation>;
 
 private:
     std::unique_ptr<client::ReadOnlyClientBase> client_;
@@ -138,6 +271,21 @@ private:
     UtilityTokenLookup utility_token_lookup_;
     std::int64_t lookup_block_height_;
     std::vector<std::string> block_hashes_;
+    std::unique_ptr<SharedLookupPublisher> shared_publisher_;
+    ChangeFeed change_feed_;
+    EntryHistory entry_history_;
+    EntryKeyIndex key_index_;
+    std::deque<LookupChangeSet> change_sets_;
+    std::uint64_t next_change_set_;
+    //transient data of the block which is processed
+    std::unique_ptr<BlockArena> block_arena_;
+    //every key of the lookups, answers most checks for free keys
+    //without touching the lookups
+    CountingBloomFilter reserved_keys_;
+    bool track_pending_{false};
+    //serializes the updates of the pending operations
+    std::unique_ptr<std::mutex> pending_mtx_;
+    PendingOperations pending_operations_;
 };
 
 } // namespace forge::lookup
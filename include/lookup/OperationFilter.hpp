@@ -0,0 +1,64 @@
+#pragma once
+
+#include <core/ByteSpan.hpp>
+#include <cstddef>
+#include <map>
+#include <memory_resource>
+#include <vector>
+
+namespace forge::lookup {
+
+//returns the index of the operation with the highest burn value
+//for every key, ordered by key. keys where two or more operations
+//share the highest burn value are skipped, because it would be
+//ambiguous which one to execute.
+//keys are only viewed, nothing is copied or moved out of ops
+template<class Operations,
+         class KeyOf,
+         class BurnOf>
+auto selectHighestBurnPerKey(const Operations& ops,
+                             KeyOf&& key_of,
+                             BurnOf&& burn_of,
+                             std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+    -> std::pmr::vector<std::size_t>
+{
+    struct Candidate
+    {
+        std::size_t index;
+        bool ambiguous;
+    };
+
+    std::pmr::map<core::ByteSpan, Candidate> candidates{resource};
+
+    for(std::size_t i = 0; i < ops.size(); i++) {
+        auto [iter, inserted] =
+            candidates.try_emplace(core::ByteSpan{key_of(ops[i])},
+                                   Candidate{i, false});
+        if(inserted) {
+            continue;
+        }
+
+        auto& candidate = iter->second;
+        auto burn = burn_of(ops[i]);
+        auto max_burn = burn_of(ops[candidate.index]);
+
+        if(burn > max_burn) {
+            candidate = Candidate{i, false};
+        } else if(burn == max_burn) {
+            candidate.ambiguous = true;
+        }
+    }
+
+    std::pmr::vector<std::size_t> selected{resource};
+    selected.reserve(candidates.size());
+
+    for(const auto& [_, candidate] : candidates) {
+        if(!candidate.ambiguous) {
+            selected.push_back(candidate.index);
+        }
+    }
+
+    return selected;
+}
+
+} // namespace forge::lookup
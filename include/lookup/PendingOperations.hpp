@@ -0,0 +1,91 @@
+#pragma once
+
+#include <core/Transaction.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <entrys/token/UtilityTokenOperation.hpp>
+#include <entrys/uentry/UniqueEntryOperation.hpp>
+#include <entrys/umentry/UMEntryOperation.hpp>
+#include <json/value.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utilxx/Opt.hpp>
+#include <variant>
+#include <vector>
+
+namespace forge::lookup {
+
+using PendingOperationVariant = std::variant<core::UMEntryOperation,
+                                             core::UniqueEntryOperation,
+                                             core::UtilityTokenOperation>;
+
+//forge operations of a transaction which is not part of the lookup yet
+struct PendingTransaction
+{
+    //none while the transaction is in the mempool,
+    //otherwise the height of its immature block
+    utilxx::Opt<std::int64_t> block_height;
+    std::vector<PendingOperationVariant> operations;
+};
+
+struct PendingOperation
+{
+    std::string txid;
+    utilxx::Opt<std::int64_t> block_height;
+    PendingOperationVariant operation;
+};
+
+//operations of transactions in the mempool and in blocks which are
+//not mature yet. Nothing is validated against the lookup, an operation
+//here may never be applied. All methods are thread safe.
+class PendingOperations final
+{
+public:
+    PendingOperations();
+
+    //returns the transaction if it was parsed before at the same height,
+    //so that only new transactions have to be fetched and parsed
+    auto getTransaction(const std::string& txid,
+                        const utilxx::Opt<std::int64_t>& block_height) const
+        -> utilxx::Opt<PendingTransaction>;
+
+    //replaces all transactions, the ones which are not
+    //given anymore were either mined, matured or dropped
+    auto replace(std::map<std::string, PendingTransaction>&& transactions)
+        -> void;
+
+    //operations on an umentry or unique entry key or on a utility token id,
+    //ordered by txid
+    auto getOperationsOn(const core::EntryKey& key) const
+        -> std::vector<PendingOperation>;
+
+    auto hasOperationsOn(const core::EntryKey& key) const
+        -> bool;
+
+    //amount of the given token pending transfers
+    //and deletions take from the owner
+    auto getUtilityTokenDebitOf(const std::string& owner,
+                                const core::EntryKey& token) const
+        -> std::uint64_t;
+
+    //number of pending operations
+    auto size() const
+        -> std::size_t;
+
+    auto clear()
+        -> void;
+
+private:
+    std::unique_ptr<std::mutex> mtx_;
+    std::map<std::string, PendingTransaction> transactions_;
+    std::map<core::EntryKey, std::vector<PendingOperation>> by_key_;
+    std::map<std::pair<std::string, core::EntryKey>, std::uint64_t> token_debits_;
+    std::size_t size_{0};
+};
+
+auto pendingOperationToJson(const PendingOperation& operation)
+    -> Json::Value;
+
+} // namespace forge::lookup
@@ -0,0 +1,492 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <type_traits>
+#include <unistd.h>
+#include <utility>
+#include <variant>
+#include <vector>
+
+//this header is intentionally self contained (std + posix only),
+//so that processes running next to forged can include it without
+//linking against forge
+
+//layout of the shared memory region (version 2):
+//
+// [SharedLookupHeader][data area .......................................]
+//
+//the data area contains three tables (um entrys, unique entrys and
+//utility token accounts). every table consists of an index, which is an
+//array of std::uint64_t offsets (relative to the start of the data area)
+//sorted by key, and the records the offsets point to.
+//
+//a record is a SharedRecordHeader followed by the key bytes,
+//the owner bytes and the value bytes, padded to 8 bytes.
+//entry records carry the value flag of the entry value (see UMEntry.hpp)
+//and the activation block, token account records use the token id as key,
+//the owner as owner and carry the balance in amount.
+//token account records are sorted by (token id, owner).
+//
+//the header contains a sequence counter which is odd while forged writes
+//a new snapshot. readers retry until they observe the same even sequence
+//before and after reading (seqlock), but give up after
+//SHARED_LOOKUP_READ_TIMEOUT.
+//
+//every region carries the generation of the forged instance which created
+//it and a closed flag which forged sets when it shuts down. a restarted
+//forged replaces the region under the same name, so readers have to open
+//it again once their region is closed or has an old generation.
+
+namespace forge::lookup {
+
+constexpr inline std::uint64_t SHARED_LOOKUP_MAGIC = 0x4d48534547524f46; // "FORGESHM" little endian
+constexpr inline std::uint32_t SHARED_LOOKUP_VERSION = 2;
+
+//time a read waits for forged to finish a snapshot,
+//forged might have died while publishing
+constexpr inline std::chrono::milliseconds SHARED_LOOKUP_READ_TIMEOUT{1000};
+
+enum class SharedTable : std::size_t {
+    UMEntrys = 0,
+    UniqueEntrys = 1,
+    UtilityTokens = 2
+};
+
+constexpr inline std::size_t SHARED_TABLE_COUNT = 3;
+
+struct SharedTableDescriptor
+{
+    std::uint64_t count;
+    std::uint64_t index_offset;
+};
+
+struct alignas(64) SharedLookupHeader
+{
+    std::uint64_t magic;
+    std::uint32_t version;
+    std::uint32_t header_size;
+    std::atomic<std::uint64_t> sequence;
+    //size of the whole mapping including the header
+    std::uint64_t region_size;
+    //number of bytes in use in the data area
+    std::uint64_t image_size;
+    std::int64_t block_height;
+    //set once when the region is created, differs between forged instances
+    std::uint64_t generation;
+    //set when forged shuts down and the region is not updated anymore
+    std::atomic<std::uint32_t> closed;
+    SharedTableDescriptor tables[SHARED_TABLE_COUNT];
+};
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+              "seqlock needs a lock free 64 bit atomic");
+static_assert(std::atomic<std::uint32_t>::is_always_lock_free,
+              "the closed flag needs a lock free 32 bit atomic");
+
+struct SharedRecordHeader
+{
+    //activation block of an entry, 0 for token accounts
+    std::int64_t block;
+    //balance of a token account, 0 for entrys
+    std::uint64_t amount;
+    std::uint32_t key_size;
+    std::uint32_t owner_size;
+    std::uint32_t value_size;
+    std::uint8_t value_flag;
+    std::uint8_t padding[3];
+};
+
+static_assert(sizeof(SharedRecordHeader) == 32);
+
+constexpr inline auto alignSharedOffset(std::uint64_t offset)
+    -> std::uint64_t
+{
+    return (offset + 7) & ~static_cast<std::uint64_t>(7);
+}
+
+struct SharedEntry
+{
+    std::vector<std::byte> value;
+    std::uint8_t value_flag;
+    std::string owner;
+    std::int64_t block;
+};
+
+enum class SharedReadError {
+    //forged did not finish a snapshot within SHARED_LOOKUP_READ_TIMEOUT
+    Timeout,
+    //forged shut down, the region has to be opened again
+    Closed
+};
+
+//value or error of a read, mirrors the interface of utilxx::Result
+template<class T>
+class SharedReadResult
+{
+public:
+    SharedReadResult(T value)
+        : result_(std::move(value)) {}
+    SharedReadResult(SharedReadError error)
+        : result_(error) {}
+
+    auto hasValue() const
+        -> bool
+    {
+        return std::holds_alternative<T>(result_);
+    }
+
+    operator bool() const
+    {
+        return hasValue();
+    }
+
+    auto getValue() const
+        -> const T&
+    {
+        return std::get<T>(result_);
+    }
+
+    auto getValue()
+        -> T&
+    {
+        return std::get<T>(result_);
+    }
+
+    auto getError() const
+        -> SharedReadError
+    {
+        return std::get<SharedReadError>(result_);
+    }
+
+private:
+    std::variant<T, SharedReadError> result_;
+};
+
+class SharedLookupReader
+{
+public:
+    //opens the region published by forged under the given name,
+    //returns std::nullopt if it does not exist or is not a
+    //compatible forge lookup region
+    static auto open(const std::string& name)
+        -> std::optional<SharedLookupReader>
+    {
+        auto fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+        if(fd < 0) {
+            return std::nullopt;
+        }
+
+        SharedLookupReader reader{fd, name};
+        if(!reader.remap()
+           || reader.header()->magic != SHARED_LOOKUP_MAGIC
+           || reader.header()->version != SHARED_LOOKUP_VERSION) {
+            return std::nullopt;
+        }
+
+        reader.generation_ = reader.header()->generation;
+        return reader;
+    }
+
+    SharedLookupReader(SharedLookupReader&& other) noexcept
+        : fd_(std::exchange(other.fd_, -1)),
+          base_(std::exchange(other.base_, nullptr)),
+          mapped_size_(std::exchange(other.mapped_size_, 0)),
+          name_(std::move(other.name_)),
+          generation_(other.generation_) {}
+
+    auto operator=(SharedLookupReader&& other) noexcept
+        -> SharedLookupReader&
+    {
+        std::swap(fd_, other.fd_);
+        std::swap(base_, other.base_);
+        std::swap(mapped_size_, other.mapped_size_);
+        std::swap(name_, other.name_);
+        std::swap(generation_, other.generation_);
+        return *this;
+    }
+
+    SharedLookupReader(const SharedLookupReader&) = delete;
+    auto operator=(const SharedLookupReader&) = delete;
+
+    ~SharedLookupReader()
+    {
+        if(base_ != nullptr) {
+            ::munmap(base_, mapped_size_);
+        }
+        if(fd_ >= 0) {
+            ::close(fd_);
+        }
+    }
+
+    //true if forged shut down or created a new region under the name
+    //since this reader was opened, the reader has to be opened again then.
+    //this opens the region by name, so it should not be called on every read
+    auto isReplaced() const
+        -> bool
+    {
+        if(header()->closed.load(std::memory_order_acquire) != 0) {
+            return true;
+        }
+
+        auto current = open(name_);
+        return !current || current->generation_ != generation_;
+    }
+
+    auto getBlockHeight()
+        -> SharedReadResult<std::int64_t>
+    {
+        return read([&](bool&) {
+            return header()->block_height;
+        });
+    }
+
+    auto lookupUMEntry(const std::vector<std::byte>& key)
+        -> SharedReadResult<std::optional<SharedEntry>>
+    {
+        return lookupEntry(SharedTable::UMEntrys, key);
+    }
+
+    auto lookupUniqueEntry(const std::vector<std::byte>& key)
+        -> SharedReadResult<std::optional<SharedEntry>>
+    {
+        return lookupEntry(SharedTable::UniqueEntrys, key);
+    }
+
+    auto getBalanceOf(const std::vector<std::byte>& token,
+                      std::string_view owner)
+        -> SharedReadResult<std::uint64_t>
+    {
+        return read([&](bool& torn) -> std::uint64_t {
+            auto idx = find(SharedTable::UtilityTokens,
+                            asView(token),
+                            owner,
+                            torn);
+            if(!idx) {
+                return 0;
+            }
+            return record(*idx, torn)->amount;
+        });
+    }
+
+private:
+    SharedLookupReader(int fd, std::string name)
+        : fd_(fd),
+          name_(std::move(name)) {}
+
+    auto header() const
+        -> const SharedLookupHeader*
+    {
+        return static_cast<const SharedLookupHeader*>(base_);
+    }
+
+    auto data() const
+        -> const std::byte*
+    {
+        return static_cast<const std::byte*>(base_) + sizeof(SharedLookupHeader);
+    }
+
+    auto dataSize() const
+        -> std::uint64_t
+    {
+        return mapped_size_ - sizeof(SharedLookupHeader);
+    }
+
+    //maps the whole region again, needed after forged grew it
+    auto remap()
+        -> bool
+    {
+        struct stat st;
+        if(::fstat(fd_, &st) != 0
+           || static_cast<std::uint64_t>(st.st_size) < sizeof(SharedLookupHeader)) {
+            return false;
+        }
+
+        //keep the old mapping if the new one cannot be created
+        auto size = static_cast<std::size_t>(st.st_size);
+        auto* base = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd_, 0);
+        if(base == MAP_FAILED) {
+            return false;
+        }
+
+        if(base_ != nullptr) {
+            ::munmap(base_, mapped_size_);
+        }
+
+        base_ = base;
+        mapped_size_ = size;
+        return true;
+    }
+
+    //seqlock read loop, the function gets a flag it has to set
+    //if it detected inconsistent offsets while reading
+    template<class Function>
+    auto read(Function&& function)
+        -> SharedReadResult<std::invoke_result_t<Function, bool&>>
+    {
+        auto deadline = std::chrono::steady_clock::now()
+            + SHARED_LOOKUP_READ_TIMEOUT;
+
+        for(std::size_t attempt = 0;; attempt++) {
+            if(header()->closed.load(std::memory_order_acquire) != 0) {
+                return SharedReadError::Closed;
+            }
+
+            //forged might have died while publishing,
+            //so every read gives up eventually
+            if(attempt > 0) {
+                if(std::chrono::steady_clock::now() > deadline) {
+                    return SharedReadError::Timeout;
+                }
+                std::this_thread::yield();
+            }
+
+            auto begin = header()->sequence.load(std::memory_order_acquire);
+            if(begin & 1) {
+                continue;
+            }
+
+            if(header()->region_size > mapped_size_ && !remap()) {
+                continue;
+            }
+
+            bool torn{false};
+            auto result = function(torn);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            auto end = header()->sequence.load(std::memory_order_relaxed);
+
+            if(!torn && begin == end) {
+                return result;
+            }
+        }
+    }
+
+    auto lookupEntry(SharedTable table,
+                     const std::vector<std::byte>& key)
+        -> SharedReadResult<std::optional<SharedEntry>>
+    {
+        return read([&](bool& torn) -> std::optional<SharedEntry> {
+            auto idx = find(table, asView(key), std::nullopt, torn);
+            if(!idx) {
+                return std::nullopt;
+            }
+
+            auto* rec = record(*idx, torn);
+            if(torn) {
+                return std::nullopt;
+            }
+
+            auto* owner = reinterpret_cast<const char*>(rec + 1) + rec->key_size;
+            auto* value = reinterpret_cast<const std::byte*>(owner + rec->owner_size);
+
+            return SharedEntry{std::vector<std::byte>(value, value + rec->value_size),
+                               rec->value_flag,
+                               std::string(owner, rec->owner_size),
+                               rec->block};
+        });
+    }
+
+    static auto asView(const std::vector<std::byte>& bytes)
+        -> std::string_view
+    {
+        return std::string_view{reinterpret_cast<const char*>(bytes.data()),
+                                bytes.size()};
+    }
+
+    //returns the record at the given offset, sets torn if
+    //the record does not fit into the mapping
+    auto record(std::uint64_t offset, bool& torn) const
+        -> const SharedRecordHeader*
+    {
+        static const SharedRecordHeader empty{};
+
+        if(offset + sizeof(SharedRecordHeader) > dataSize()) {
+            torn = true;
+            return &empty;
+        }
+
+        auto* rec = reinterpret_cast<const SharedRecordHeader*>(data() + offset);
+        auto payload = static_cast<std::uint64_t>(rec->key_size)
+            + rec->owner_size
+            + rec->value_size;
+
+        if(offset + sizeof(SharedRecordHeader) + payload > dataSize()) {
+            torn = true;
+            return &empty;
+        }
+
+        return rec;
+    }
+
+    //binary search over the index of a table, if owner is given
+    //records are compared by (key, owner)
+    auto find(SharedTable table,
+              std::string_view key,
+              std::optional<std::string_view> owner,
+              bool& torn) const
+        -> std::optional<std::uint64_t>
+    {
+        const auto& desc = header()->tables[static_cast<std::size_t>(table)];
+        auto count = desc.count;
+        auto index_offset = desc.index_offset;
+
+        if(index_offset + count * sizeof(std::uint64_t) > dataSize()) {
+            torn = true;
+            return std::nullopt;
+        }
+
+        auto* index = reinterpret_cast<const std::uint64_t*>(data() + index_offset);
+
+        auto compare = [&](std::uint64_t offset) {
+            auto* rec = record(offset, torn);
+            auto* raw = reinterpret_cast<const char*>(rec + 1);
+            std::string_view rec_key{raw, rec->key_size};
+
+            if(auto cmp = rec_key.compare(key);
+               cmp != 0 || !owner) {
+                return cmp;
+            }
+
+            std::string_view rec_owner{raw + rec->key_size, rec->owner_size};
+            return rec_owner.compare(*owner);
+        };
+
+        std::uint64_t low = 0;
+        std::uint64_t high = count;
+        while(low < high && !torn) {
+            auto mid = low + (high - low) / 2;
+            auto cmp = compare(index[mid]);
+            if(cmp == 0) {
+                return index[mid];
+            }
+            if(cmp < 0) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+
+        return std::nullopt;
+    }
+
+private:
+    int fd_ = -1;
+    void* base_ = nullptr;
+    std::size_t mapped_size_ = 0;
+    std::string name_;
+    std::uint64_t generation_ = 0;
+};
+
+} // namespace forge::lookup
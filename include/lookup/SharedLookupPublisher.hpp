@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <lookup/LookupError.hpp>
+#include <lookup/SharedLookupLayout.hpp>
+#include <lookup/UMEntryLookup.hpp>
+#include <lookup/UniqueEntryLookup.hpp>
+#include <lookup/UtilityTokenLookup.hpp>
+#include <memory>
+#include <string>
+#include <utilxx/Result.hpp>
+#include <vector>
+
+namespace forge::lookup {
+
+//initial size of the shared memory region, it grows if needed
+constexpr inline std::size_t DEFAULT_SHARED_LOOKUP_SIZE = 16 * 1024 * 1024;
+
+//writes snapshots of the lookup tables into a posix shared memory
+//region which can be read by SharedLookupReader (see SharedLookupLayout.hpp)
+class SharedLookupPublisher final
+{
+public:
+    SharedLookupPublisher(std::string&& name,
+                          int fd,
+                          void* base,
+                          std::size_t mapped_size);
+
+    SharedLookupPublisher(const SharedLookupPublisher&) = delete;
+    SharedLookupPublisher(SharedLookupPublisher&&) = delete;
+    auto operator=(const SharedLookupPublisher&) = delete;
+    auto operator=(SharedLookupPublisher&&) = delete;
+
+    //marks the region as closed, unmaps and unlinks it
+    ~SharedLookupPublisher();
+
+    //serializes the given lookups and copies them into the
+    //region while holding the seqlock,
+    //the caller has to make sure the lookups are not modified meanwhile
+    auto publish(const UMEntryLookup& um_entrys,
+                 const UniqueEntryLookup& unique_entrys,
+                 const UtilityTokenLookup& utility_tokens,
+                 std::int64_t block_height)
+        -> utilxx::Result<void, LookupError>;
+
+    auto getName() const
+        -> const std::string&;
+
+private:
+    auto buildImage(const UMEntryLookup& um_entrys,
+                    const UniqueEntryLookup& unique_entrys,
+                    const UtilityTokenLookup& utility_tokens)
+        -> void;
+
+    //grows the region so that at least size bytes are mapped
+    auto ensureSize(std::size_t size)
+        -> utilxx::Result<void, LookupError>;
+
+    auto header()
+        -> SharedLookupHeader*;
+
+private:
+    std::string name_;
+    int fd_;
+    void* base_;
+    std::size_t mapped_size_;
+
+    //staging buffer of the data area, reused between snapshots
+    std::vector<std::byte> image_;
+    SharedTableDescriptor tables_[SHARED_TABLE_COUNT];
+};
+
+//creates (or replaces) the shared memory region with the given name
+auto make_shared_lookup_publisher(std::string name,
+                                  std::size_t initial_size = DEFAULT_SHARED_LOOKUP_SIZE)
+    -> utilxx::Result<std::unique_ptr<SharedLookupPublisher>, LookupError>;
+
+} // namespace forge::lookup
@@ -14,12 +14,21 @@ class LookupManager;
 class UMEntryLookup final
 {
 public:
+    using MapType = std::map<core::EntryKey, //key
+                             std::tuple<core::UMEntryValue, //value
+                                        std::string, //owner
+                                        std::int64_t>>; //block
+
     UMEntryLookup(const LookupManager* const manager,
                   std::int64_t start_block = 0);
 
     auto executeOperations(std::vector<core::UMEntryOperation>&& ops)
         -> void;
 
+    //executes operations which already passed filterNonRelevantOperations
+    auto applyOperations(std::vector<core::UMEntryOperation>&& ops)
+        -> void;
+
     auto lookup(const core::EntryKey& key) const
         -> utilxx::Opt<std::reference_wrapper<const core::UMEntryValue>>;
 
@@ -68,6 +77,10 @@ public:
     auto clear()
         -> void;
 
+    //read only access to all entrys, used to publish snapshots
+    auto getLookupMap() const
+        -> const MapType&;
+
     auto getUMEntrysOfOwner(const std::string& owner) const
         -> std::vector<core::UMEntry>;
 
@@ -87,10 +100,6 @@ public:
         -> void;
 
 private:
-    using MapType = std::map<core::EntryKey, //key
-                             std::tuple<core::UMEntryValue, //value
-                                        std::string, //owner
-                                        std::int64_t>>; //block
     MapType lookup_map_;
     const LookupManager* const manager_;
     std::int64_t block_height_;
@@ -14,12 +14,21 @@ class LookupManager;
 class UniqueEntryLookup final
 {
 public:
+    using MapType = std::map<core::EntryKey, //key
+                             std::tuple<core::UniqueEntryValue, //value
+                                        std::string, //owner
+                                        std::int64_t>>; //block
+
     UniqueEntryLookup(const LookupManager* const manager,
                       std::int64_t start_block = 0);
 
     auto executeOperations(std::vector<core::UniqueEntryOperation>&& ops)
         -> void;
 
+    //executes operations which already passed filterNonRelevantOperations
+    auto applyOperations(std::vector<core::UniqueEntryOperation>&& ops)
+        -> void;
+
     auto lookup(const core::EntryKey& key) const
         -> utilxx::Opt<std::reference_wrapper<const core::UniqueEntryValue>>;
 
@@ -68,6 +77,10 @@ public:
     auto clear()
         -> void;
 
+    //read only access to all entrys, used to publish snapshots
+    auto getLookupMap() const
+        -> const MapType&;
+
     auto getUniqueEntrysOfOwner(const std::string& owner) const
         -> std::vector<core::UniqueEntry>;
 
@@ -84,10 +97,6 @@ public:
         -> void;
 
 private:
-    using MapType = std::map<core::EntryKey, //key
-                             std::tuple<core::UniqueEntryValue, //value
-                                        std::string, //owner
-                                        std::int64_t>>; //block
     MapType lookup_map_;
     const LookupManager* const manager_;
     std::int64_t block_height_;
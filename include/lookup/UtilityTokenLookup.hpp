@@ -20,12 +20,24 @@ class LookupManager;
 class UtilityTokenLookup final
 {
 public:
+    using UtilityTokenAccounts =
+        std::unordered_map<std::string, //owner
+                           std::uint64_t>; //number of owned tokens
+
+    using AccountMapType =
+        std::map<std::vector<std::byte>, // token id
+                 UtilityTokenAccounts>; //token accounts
+
     UtilityTokenLookup(const LookupManager* const manager, std::int64_t start_block = 0);
 
     //filters out operations which would be illegal and then executes them
     auto executeOperations(std::vector<core::UtilityTokenOperation>&& ops)
         -> void;
 
+    //executes operations which already passed filterNonRelevantOperations
+    auto applyOperations(std::vector<core::UtilityTokenOperation>&& ops)
+        -> void;
+
     auto setBlockHeight(std::int64_t height)
         -> void;
 
@@ -37,6 +49,10 @@ public:
                                const std::vector<std::byte>& token) const
         -> std::uint64_t;
 
+    //throws away operations which would be illegal
+    auto filterNonRelevantOperations(std::vector<core::UtilityTokenOperation>&& ops) const
+        -> std::vector<core::UtilityTokenOperation>;
+
     //resets the lookup
     auto clear()
         -> void;
@@ -51,6 +67,10 @@ public:
     auto getSupplyOfToken(const std::vector<std::byte>& token) const
         -> std::uint64_t;
 
+    //read only access to all token accounts, used to publish snapshots
+    auto getAccountMap() const
+        -> const AccountMapType&;
+
     //execute Creation Operation
     auto operator()(core::UtilityTokenCreationOp&& op)
         -> void;
@@ -64,10 +84,6 @@ public:
         -> void;
 
 private:
-    //throws away operations which would be illegal
-    auto filterNonRelevantOperations(std::vector<core::UtilityTokenOperation>&& ops) const
-        -> std::vector<core::UtilityTokenOperation>;
-
     //expects operations of exactly one token
     //filters out operations which would be illegal
     //like creating operations on a already existing token,
@@ -103,13 +119,7 @@ private:
 
 
 private:
-    using UtilityTokenAccounts =
-        std::unordered_map<std::string, //owner
-                           std::uint64_t>; //number of owned tokens
-
-    std::map<std::vector<std::byte>, // token id
-             UtilityTokenAccounts> //token accounts
-        utility_account_lookup_;
+    AccountMapType utility_account_lookup_;
 
     const LookupManager* const manager_;
     std::int64_t block_height_;
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace forge::metrics {
+
+using Labels = std::vector<std::pair<std::string, //name
+                                     std::string>>; //value
+
+//upper bounds in seconds, from 10us to 10s
+inline const std::vector<double> DEFAULT_LATENCY_BUCKETS{
+    0.00001,
+    0.0001,
+    0.0005,
+    0.001,
+    0.0025,
+    0.005,
+    0.01,
+    0.025,
+    0.05,
+    0.1,
+    0.25,
+    0.5,
+    1.0,
+    2.5,
+    5.0,
+    10.0};
+
+class Counter final
+{
+public:
+    auto increment(std::uint64_t value = 1)
+        -> void;
+
+    auto getValue() const
+        -> std::uint64_t;
+
+private:
+    std::atomic<std::uint64_t> value_{0};
+};
+
+class Gauge final
+{
+public:
+    auto set(std::int64_t value)
+        -> void;
+
+    auto getValue() const
+        -> std::int64_t;
+
+private:
+    std::atomic<std::int64_t> value_{0};
+};
+
+class Histogram final
+{
+public:
+    //bounds have to be sorted ascending
+    explicit Histogram(std::vector<double> bounds);
+
+    auto observe(double value)
+        -> void;
+
+    auto getBounds() const
+        -> const std::vector<double>&;
+
+    //cumulative counts of all buckets, the last one
+    //is the +Inf bucket
+    auto getBucketCounts() const
+        -> std::vector<std::uint64_t>;
+
+    auto getCount() const
+        -> std::uint64_t;
+
+    auto getSum() const
+        -> double;
+
+private:
+    std::vector<double> bounds_;
+    std::unique_ptr<std::atomic<std::uint64_t>[]> buckets_;
+    std::atomic<std::uint64_t> count_{0};
+    std::atomic<double> sum_{0.0};
+};
+
+//observes the lifetime of the timer in seconds
+class ScopedTimer final
+{
+public:
+    explicit ScopedTimer(Histogram& histogram);
+    ~ScopedTimer();
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer(ScopedTimer&&) = delete;
+    auto operator=(const ScopedTimer&) = delete;
+    auto operator=(ScopedTimer&&) = delete;
+
+private:
+    Histogram& histogram_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+//owns all metrics, they are created on first use and live as long as
+//the registry so references to them can be cached.
+//updating a metric is lock free, only looking it up takes a shared lock
+class Registry final
+{
+public:
+    auto counter(const std::string& name,
+                 const std::string& help,
+                 const Labels& labels = {})
+        -> Counter&;
+
+    auto gauge(const std::string& name,
+               const std::string& help,
+               const Labels& labels = {})
+        -> Gauge&;
+
+    auto histogram(const std::string& name,
+                   const std::string& help,
+                   const Labels& labels = {},
+                   const std::vector<double>& bounds = DEFAULT_LATENCY_BUCKETS)
+        -> Histogram&;
+
+    //renders all metrics in the prometheus text exposition format
+    auto render() const
+        -> std::string;
+
+private:
+    template<class Metric>
+    struct Family
+    {
+        std::string help;
+        std::map<Labels, std::unique_ptr<Metric>> metrics;
+    };
+
+    template<class Metric, class Factory>
+    auto getOrCreate(std::map<std::string, Family<Metric>>& families,
+                     const std::string& name,
+                     const std::string& help,
+                     const Labels& labels,
+                     Factory&& factory)
+        -> Metric&;
+
+private:
+    mutable std::shared_mutex mtx_;
+    std::map<std::string, Family<Counter>> counters_;
+    std::map<std::string, Family<Gauge>> gauges_;
+    std::map<std::string, Family<Histogram>> histograms_;
+};
+
+//registry of the process, this is what /metrics exposes
+auto getRegistry()
+    -> Registry&;
+
+} // namespace forge::metrics
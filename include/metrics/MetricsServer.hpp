@@ -0,0 +1,50 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <metrics/Metrics.hpp>
+#include <metrics/MetricsError.hpp>
+#include <thread>
+#include <utilxx/Result.hpp>
+
+namespace forge::metrics {
+
+//minimal http server which answers GET /metrics with the
+//rendered registry, connections are handled one after another
+//on a single background thread
+class MetricsServer final
+{
+public:
+    //takes ownership of a listening socket
+    MetricsServer(int fd,
+                  const Registry& registry);
+
+    MetricsServer(const MetricsServer&) = delete;
+    MetricsServer(MetricsServer&&) = delete;
+    auto operator=(const MetricsServer&) = delete;
+    auto operator=(MetricsServer&&) = delete;
+
+    //stops the thread and closes the socket
+    ~MetricsServer();
+
+private:
+    auto run()
+        -> void;
+
+    auto handleConnection(int client_fd)
+        -> void;
+
+private:
+    int fd_;
+    const Registry& registry_;
+    std::atomic<bool> should_stop_{false};
+    std::thread thread_;
+};
+
+//listens on the given port on all interfaces
+auto make_metrics_server(std::int64_t port,
+                         const Registry& registry = getRegistry())
+    -> utilxx::Result<std::unique_ptr<MetricsServer>, MetricsError>;
+
+} // namespace forge::metrics
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <json/value.h>
+#include <memory>
+#include <metrics/MetricsError.hpp>
+#include <string>
+#include <thread>
+#include <utilxx/Result.hpp>
+#include <vector>
+
+namespace forge::metrics {
+
+//enough for a few hundred blocks worth of spans
+constexpr inline std::size_t DEFAULT_TRACE_CAPACITY = 16 * 1024;
+
+//spans without an argument carry this as arg
+constexpr inline std::int64_t NO_TRACE_ARG = -1;
+
+struct TraceEvent
+{
+    //has to point to a string literal
+    const char* name;
+    std::int64_t start_ns;
+    std::int64_t duration_ns;
+    std::uint32_t thread_id;
+    std::int64_t arg;
+};
+
+//fixed size ring buffer of trace events.
+//recording is lock free and never blocks, if the buffer is full
+//the oldest events get overwritten. every slot is guarded by a
+//sequence number so a snapshot skips slots which are written
+//while it reads them
+class TraceBuffer final
+{
+public:
+    //capacity gets rounded up to the next power of two
+    explicit TraceBuffer(std::size_t capacity = DEFAULT_TRACE_CAPACITY);
+
+    auto record(const char* name,
+                std::int64_t start_ns,
+                std::int64_t duration_ns,
+                std::int64_t arg = NO_TRACE_ARG)
+        -> void;
+
+    //all complete events still in the buffer, oldest first
+    auto snapshot() const
+        -> std::vector<TraceEvent>;
+
+    auto getCapacity() const
+        -> std::size_t;
+
+private:
+    struct Slot
+    {
+        //odd while the slot is written, 2 * (index + 1) when done
+        std::atomic<std::uint64_t> sequence{0};
+        std::atomic<const char*> name{nullptr};
+        std::atomic<std::int64_t> start_ns{0};
+        std::atomic<std::int64_t> duration_ns{0};
+        std::atomic<std::uint32_t> thread_id{0};
+        std::atomic<std::int64_t> arg{NO_TRACE_ARG};
+    };
+
+private:
+    std::size_t mask_;
+    std::unique_ptr<Slot[]> slots_;
+    std::atomic<std::uint64_t> next_{0};
+};
+
+//records the lifetime of the span into the buffer
+class TraceSpan final
+{
+public:
+    //name has to be a string literal
+    explicit TraceSpan(const char* name,
+                       std::int64_t arg = NO_TRACE_ARG);
+    TraceSpan(const char* name,
+              std::int64_t arg,
+              TraceBuffer& buffer);
+    ~TraceSpan();
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan(TraceSpan&&) = delete;
+    auto operator=(const TraceSpan&) = delete;
+    auto operator=(TraceSpan&&) = delete;
+
+private:
+    const char* name_;
+    std::int64_t arg_;
+    TraceBuffer& buffer_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+//trace buffer of the process, this is what gettrace and
+//SIGUSR1 dump
+auto getTraceBuffer()
+    -> TraceBuffer&;
+
+//converts the events into the chrome trace event format
+//which can be loaded into chrome://tracing or perfetto
+auto toChromeTrace(const std::vector<TraceEvent>& events)
+    -> Json::Value;
+
+auto dumpChromeTrace(const TraceBuffer& buffer,
+                     const std::string& path)
+    -> utilxx::Result<void, MetricsError>;
+
+//dumps the trace buffer as forge-trace-<unixtime>.json
+//into the given folder every time the process gets a SIGUSR1.
+//only one dumper should exist at a time
+class TraceDumper final
+{
+public:
+    explicit TraceDumper(std::string folder,
+                         const TraceBuffer& buffer = getTraceBuffer());
+
+    TraceDumper(const TraceDumper&) = delete;
+    TraceDumper(TraceDumper&&) = delete;
+    auto operator=(const TraceDumper&) = delete;
+    auto operator=(TraceDumper&&) = delete;
+
+    //stops the thread and restores the default signal handler
+    ~TraceDumper();
+
+private:
+    auto run()
+        -> void;
+
+private:
+    std::string folder_;
+    const TraceBuffer& buffer_;
+    std::atomic<bool> should_stop_{false};
+    std::thread thread_;
+};
+
+} // namespace forge::metrics
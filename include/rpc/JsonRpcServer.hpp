@@ -1,10 +1,14 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <entrys/token/UtilityToken.hpp>
 #include <json/value.h>
 #include <jsonrpccpp/server/connectors/httpserver.h>
 #include <lookup/LookupManager.hpp>
+#include <memory>
+#include <rpc/OperationQueue.hpp>
 #include <rpc/abstractjsonrpcstubserver.h>
 #include <thread>
 #include <variant>
@@ -13,6 +17,14 @@
 
 namespace forge::rpc {
 
+//write operations submitted with submitoperation run on this many
+//threads, one keeps them in the order they were submitted
+constexpr inline std::size_t WRITE_OPERATION_WORKERS = 1;
+
+//synchronous write rpcs run as operations too and wait this long
+//for them, afterwards the caller has to poll with getoperation
+constexpr inline std::chrono::milliseconds SYNC_WRITE_TIMEOUT = std::chrono::seconds{10};
+
 class JsonRpcServer : public AbstractJsonRpcStubSever
 {
 public:
@@ -26,10 +38,20 @@ public:
 
     JsonRpcServer(jsonrpc::AbstractServerConnector& connector,
                   jsonrpc::serverVersion_t type,
-                  lookup::LookupManager&& lookup);
+                  std::unique_ptr<lookup::LookupManager>&& lookup);
 
     virtual ~JsonRpcServer();
 
+    //record latency and failures of every call in the metrics
+    virtual auto HandleMethodCall(jsonrpc::Procedure& proc,
+                                  const Json::Value& input,
+                                  Json::Value& output)
+        -> void override;
+
+    virtual auto HandleNotificationCall(jsonrpc::Procedure& proc,
+                                        const Json::Value& input)
+        -> void override;
+
     virtual auto updatelookup()
         -> bool override;
 
@@ -45,12 +67,31 @@ public:
     virtual auto lookupuniquevalue(bool isstring, const std::string& key)
         -> Json::Value override;
 
+    //like lookupumvalue, but also lists the operations
+    //on the key which are not mature yet
+    virtual auto lookupumvaluepending(bool isstring, const std::string& key)
+        -> Json::Value override;
+
+    virtual auto lookupuniquevaluepending(bool isstring, const std::string& key)
+        -> Json::Value override;
+
     virtual auto lookupowner(bool isstring, const std::string& key)
         -> std::string override;
 
     virtual auto lookupactivationblock(bool isstring, const std::string& key)
         -> int override;
 
+    virtual auto lookupat(int block,
+                          bool isstring,
+                          const std::string& key)
+        -> Json::Value override;
+
+    virtual auto scanentries(const std::string& cursor,
+                             bool isstring,
+                             int limit,
+                             const std::string& prefix)
+        -> Json::Value override;
+
     virtual auto checkvalidity()
         -> bool override;
 
@@ -63,6 +104,14 @@ public:
     virtual auto getutilitytokensof(const std::string& owner)
         -> Json::Value override;
 
+    virtual auto getchanges(int limit,
+                            int since,
+                            int timeout)
+        -> Json::Value override;
+
+    virtual auto gettrace()
+        -> Json::Value override;
+
     virtual auto getbalanceof(bool isstring,
                               const std::string& owner,
                               const std::string& token)
@@ -165,6 +214,19 @@ public:
                                  const std::string& key)
         -> std::string override;
 
+    virtual auto submitbulk(int burnvalue,
+                            const Json::Value& operations)
+        -> Json::Value override;
+
+    //enqueues a call of a write rpc and returns the id of the operation
+    //right away, the rpc threads are not blocked while it runs
+    virtual auto submitoperation(const std::string& method,
+                                 const Json::Value& params)
+        -> int override;
+
+    virtual auto getoperation(int id)
+        -> Json::Value override;
+
     auto hasShutdownRequest() const
         -> bool;
 
@@ -188,13 +250,33 @@ private:
                          const std::string& key_str)
         -> core::EntryKey;
 
+    auto extractBulkOperation(const Json::Value& operation)
+        -> wallet::BulkOperation;
+
+    using MethodCall = void (AbstractJsonRpcStubSever::*)(const Json::Value&, Json::Value&);
+
+    //queues the write rpc on write_queue_, fails if the queue is full
+    auto submitOperation(const std::string& method,
+                         MethodCall call,
+                         const Json::Value& params)
+        -> std::uint64_t;
+
+    //runs the write rpc on write_queue_ and waits
+    //at most SYNC_WRITE_TIMEOUT for its result
+    auto callAsOperation(const std::string& method,
+                         MethodCall call,
+                         const Json::Value& params)
+        -> Json::Value;
+
 private:
     // wallet::ReadWriteWallet wallet_;
     std::variant<wallet::ReadWriteWallet,
                  wallet::ReadOnlyWallet,
-                 lookup::LookupManager>
+                 std::unique_ptr<lookup::LookupManager>>
         logic_;
     // lookup::LookupManager& lookup_;
+    //only set in readwrite mode, destroyed before the wallet
+    std::unique_ptr<OperationQueue> write_queue_;
     std::atomic_bool should_shutdown_{false};
     std::atomic_bool indexing_{false};
     std::thread updater_;
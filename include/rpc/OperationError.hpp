@@ -0,0 +1,12 @@
+#pragma once
+#include <stdexcept>
+
+namespace forge::rpc {
+
+class OperationError final : public std::runtime_error
+{
+public:
+    using std::runtime_error::runtime_error;
+};
+
+} // namespace forge::rpc
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <json/value.h>
+#include <map>
+#include <mutex>
+#include <rpc/OperationError.hpp>
+#include <string>
+#include <thread>
+#include <utilxx/Opt.hpp>
+#include <utilxx/Result.hpp>
+#include <vector>
+
+namespace forge::rpc {
+
+//number of finished operations whose results are kept,
+//older ones are forgotten
+constexpr inline std::size_t OPERATION_HISTORY_SIZE = 1000;
+
+//number of operations which can wait for a worker,
+//submitting more fails until some of them started
+constexpr inline std::size_t MAX_QUEUED_OPERATIONS = 1000;
+
+enum class OperationStatus {
+    Queued,
+    Running,
+    Done,
+    Failed
+};
+
+struct OperationState
+{
+    std::uint64_t id;
+    std::string method;
+    OperationStatus status;
+    //result of a done operation or the error of a failed one
+    Json::Value result;
+};
+
+//runs submitted operations on its own worker threads and keeps their
+//state, so that the caller does not have to wait for them.
+//With a single worker the operations run in the order they were submitted.
+//All methods are thread safe.
+class OperationQueue final
+{
+public:
+    using Task = std::function<utilxx::Result<Json::Value, OperationError>()>;
+
+    explicit OperationQueue(std::size_t number_of_workers,
+                            std::size_t history_size = OPERATION_HISTORY_SIZE,
+                            std::size_t max_queued = MAX_QUEUED_OPERATIONS);
+
+    //operations which did not start yet are dropped
+    ~OperationQueue();
+
+    OperationQueue(OperationQueue&&) = delete;
+    OperationQueue(const OperationQueue&) = delete;
+
+    auto operator=(OperationQueue&&)
+        -> OperationQueue& = delete;
+    auto operator=(const OperationQueue&)
+        -> OperationQueue& = delete;
+
+    //enqueues the task and returns the id of the operation,
+    //fails if max_queued operations are waiting already
+    auto submit(std::string method,
+                Task&& task)
+        -> utilxx::Result<std::uint64_t, OperationError>;
+
+    //none if the id is unknown or the operation was forgotten
+    auto getOperation(std::uint64_t id) const
+        -> utilxx::Opt<OperationState>;
+
+    //waits until the operation is done or failed, but at most timeout,
+    //and returns its state like getOperation
+    auto waitForOperation(std::uint64_t id,
+                          std::chrono::milliseconds timeout) const
+        -> utilxx::Opt<OperationState>;
+
+    //number of operations which are queued or running
+    auto getNumberOfOpenOperations() const
+        -> std::size_t;
+
+private:
+    auto work()
+        -> void;
+
+    //expects mtx_ to be locked
+    auto finish(std::uint64_t id,
+                utilxx::Result<Json::Value, OperationError>&& result)
+        -> void;
+
+private:
+    mutable std::mutex mtx_;
+    std::condition_variable work_available_;
+    mutable std::condition_variable operation_finished_;
+    std::deque<std::pair<std::uint64_t, Task>> queue_;
+    std::map<std::uint64_t, OperationState> operations_;
+    std::deque<std::uint64_t> finished_;
+    std::size_t history_size_;
+    std::size_t max_queued_;
+    std::size_t open_operations_{0};
+    std::uint64_t next_id_{1};
+    bool stop_{false};
+    std::vector<std::thread> workers_;
+};
+
+auto operationStatusToString(OperationStatus status)
+    -> std::string;
+
+auto operationStateToJson(const OperationState& state)
+    -> Json::Value;
+
+} // namespace forge::rpc
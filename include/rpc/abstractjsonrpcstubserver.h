@@ -52,6 +52,15 @@ namespace forge {
                     this->bindAndAddMethod(jsonrpc::Procedure("createnewutilitytoken", jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_STRING, "address",jsonrpc::JSON_STRING,"burnvalue",jsonrpc::JSON_INTEGER,"isstring",jsonrpc::JSON_BOOLEAN,"key",jsonrpc::JSON_STRING,"supply",jsonrpc::JSON_STRING, NULL), &forge::rpc::AbstractJsonRpcStubSever::createnewutilitytokenI);
                     this->bindAndAddMethod(jsonrpc::Procedure("sendutilitytokens", jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_ARRAY, "amount",jsonrpc::JSON_STRING,"burnvalue",jsonrpc::JSON_INTEGER,"isstring",jsonrpc::JSON_BOOLEAN,"key",jsonrpc::JSON_STRING,"recipient",jsonrpc::JSON_STRING, NULL), &forge::rpc::AbstractJsonRpcStubSever::sendutilitytokensI);
                     this->bindAndAddMethod(jsonrpc::Procedure("burnutilitytokens", jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_ARRAY, "amount",jsonrpc::JSON_STRING,"burnvalue",jsonrpc::JSON_INTEGER,"isstring",jsonrpc::JSON_BOOLEAN,"key",jsonrpc::JSON_STRING, NULL), &forge::rpc::AbstractJsonRpcStubSever::burnutilitytokensI);
+                    this->bindAndAddMethod(jsonrpc::Procedure("getchanges", jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_OBJECT, "limit",jsonrpc::JSON_INTEGER,"since",jsonrpc::JSON_INTEGER,"timeout",jsonrpc::JSON_INTEGER, NULL), &forge::rpc::AbstractJsonRpcStubSever::getchangesI);
+                    this->bindAndAddMethod(jsonrpc::Procedure("lookupat", jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_OBJECT, "block",jsonrpc::JSON_INTEGER,"isstring",jsonrpc::JSON_BOOLEAN,"key",jsonrpc::JSON_STRING, NULL), &forge::rpc::AbstractJsonRpcStubSever::lookupatI);
+                    this->bindAndAddMethod(jsonrpc::Procedure("scanentries", jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_OBJECT, "cursor",jsonrpc::JSON_STRING,"isstring",jsonrpc::JSON_BOOLEAN,"limit",jsonrpc::JSON_INTEGER,"prefix",jsonrpc::JSON_STRING, NULL), &forge::rpc::AbstractJsonRpcStubSever::scanentriesI);
+                    this->bindAndAddMethod(jsonrpc::Procedure("gettrace", jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_OBJECT,  NULL), &forge::rpc::AbstractJsonRpcStubSever::gettraceI);
+                    this->bindAndAddMethod(jsonrpc::Procedure("submitbulk", jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_ARRAY, "burnvalue",jsonrpc::JSON_INTEGER,"operations",jsonrpc::JSON_ARRAY, NULL), &forge::rpc::AbstractJsonRpcStubSever::submitbulkI);
+                    this->bindAndAddMethod(jsonrpc::Procedure("submitoperation", jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_INTEGER, "method",jsonrpc::JSON_STRING,"params",jsonrpc::JSON_OBJECT, NULL), &forge::rpc::AbstractJsonRpcStubSever::submitoperationI);
+                    this->bindAndAddMethod(jsonrpc::Procedure("getoperation", jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_OBJECT, "id",jsonrpc::JSON_INTEGER, NULL), &forge::rpc::AbstractJsonRpcStubSever::getoperationI);
+                    this->bindAndAddMethod(jsonrpc::Procedure("lookupumvaluepending", jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_OBJECT, "isstring",jsonrpc::JSON_BOOLEAN,"key",jsonrpc::JSON_STRING, NULL), &forge::rpc::AbstractJsonRpcStubSever::lookupumvaluependingI);
+                    this->bindAndAddMethod(jsonrpc::Procedure("lookupuniquevaluepending", jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_OBJECT, "isstring",jsonrpc::JSON_BOOLEAN,"key",jsonrpc::JSON_STRING, NULL), &forge::rpc::AbstractJsonRpcStubSever::lookupuniquevaluependingI);
                 }
 
                 inline virtual void updatelookupI(const Json::Value &/*request*/, Json::Value &response)
@@ -206,6 +215,42 @@ namespace forge {
                 {
                     response = this->burnutilitytokens(request["amount"].asString(), request["burnvalue"].asInt(), request["isstring"].asBool(), request["key"].asString());
                 }
+                inline virtual void getchangesI(const Json::Value &request, Json::Value &response)
+                {
+                    response = this->getchanges(request["limit"].asInt(), request["since"].asInt(), request["timeout"].asInt());
+                }
+                inline virtual void lookupatI(const Json::Value &request, Json::Value &response)
+                {
+                    response = this->lookupat(request["block"].asInt(), request["isstring"].asBool(), request["key"].asString());
+                }
+                inline virtual void scanentriesI(const Json::Value &request, Json::Value &response)
+                {
+                    response = this->scanentries(request["cursor"].asString(), request["isstring"].asBool(), request["limit"].asInt(), request["prefix"].asString());
+                }
+                inline virtual void gettraceI(const Json::Value &/*request*/, Json::Value &response)
+                {
+                    response = this->gettrace();
+                }
+                inline virtual void submitbulkI(const Json::Value &request, Json::Value &response)
+                {
+                    response = this->submitbulk(request["burnvalue"].asInt(), request["operations"]);
+                }
+                inline virtual void submitoperationI(const Json::Value &request, Json::Value &response)
+                {
+                    response = this->submitoperation(request["method"].asString(), request["params"]);
+                }
+                inline virtual void getoperationI(const Json::Value &request, Json::Value &response)
+                {
+                    response = this->getoperation(request["id"].asInt());
+                }
+                inline virtual void lookupumvaluependingI(const Json::Value &request, Json::Value &response)
+                {
+                    response = this->lookupumvaluepending(request["isstring"].asBool(), request["key"].asString());
+                }
+                inline virtual void lookupuniquevaluependingI(const Json::Value &request, Json::Value &response)
+                {
+                    response = this->lookupuniquevaluepending(request["isstring"].asBool(), request["key"].asString());
+                }
                 virtual bool updatelookup() = 0;
                 virtual void shutdown() = 0;
                 virtual void rebuildlookup() = 0;
@@ -244,6 +289,15 @@ namespace forge {
                 virtual std::string createnewutilitytoken(const std::string& address, int burnvalue, bool isstring, const std::string& key, const std::string& supply) = 0;
                 virtual Json::Value sendutilitytokens(const std::string& amount, int burnvalue, bool isstring, const std::string& key, const std::string& recipient) = 0;
                 virtual Json::Value burnutilitytokens(const std::string& amount, int burnvalue, bool isstring, const std::string& key) = 0;
+                virtual Json::Value getchanges(int limit, int since, int timeout) = 0;
+                virtual Json::Value lookupat(int block, bool isstring, const std::string& key) = 0;
+                virtual Json::Value scanentries(const std::string& cursor, bool isstring, int limit, const std::string& prefix) = 0;
+                virtual Json::Value gettrace() = 0;
+                virtual Json::Value submitbulk(int burnvalue, const Json::Value& operations) = 0;
+                virtual int submitoperation(const std::string& method, const Json::Value& params) = 0;
+                virtual Json::Value getoperation(int id) = 0;
+                virtual Json::Value lookupumvaluepending(bool isstring, const std::string& key) = 0;
+                virtual Json::Value lookupuniquevaluepending(bool isstring, const std::string& key) = 0;
         };
 
     }
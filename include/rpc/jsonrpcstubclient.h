@@ -412,6 +412,107 @@ namespace forge {
                     else
                         throw jsonrpc::JsonRpcException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, result.toStyledString());
                 }
+                Json::Value getchanges(int limit, int since, int timeout) 
+                {
+                    Json::Value p;
+                    p["limit"] = limit;
+                    p["since"] = since;
+                    p["timeout"] = timeout;
+                    Json::Value result = this->CallMethod("getchanges",p);
+                    if (result.isObject())
+                        return result;
+                    else
+                        throw jsonrpc::JsonRpcException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, result.toStyledString());
+                }
+                Json::Value lookupat(int block, bool isstring, const std::string& key) 
+                {
+                    Json::Value p;
+                    p["block"] = block;
+                    p["isstring"] = isstring;
+                    p["key"] = key;
+                    Json::Value result = this->CallMethod("lookupat",p);
+                    if (result.isObject())
+                        return result;
+                    else
+                        throw jsonrpc::JsonRpcException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, result.toStyledString());
+                }
+                Json::Value scanentries(const std::string& cursor, bool isstring, int limit, const std::string& prefix) 
+                {
+                    Json::Value p;
+                    p["cursor"] = cursor;
+                    p["isstring"] = isstring;
+                    p["limit"] = limit;
+                    p["prefix"] = prefix;
+                    Json::Value result = this->CallMethod("scanentries",p);
+                    if (result.isObject())
+                        return result;
+                    else
+                        throw jsonrpc::JsonRpcException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, result.toStyledString());
+                }
+                Json::Value gettrace() 
+                {
+                    Json::Value p;
+                    p = Json::nullValue;
+                    Json::Value result = this->CallMethod("gettrace",p);
+                    if (result.isObject())
+                        return result;
+                    else
+                        throw jsonrpc::JsonRpcException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, result.toStyledString());
+                }
+                Json::Value submitbulk(int burnvalue, const Json::Value& operations) 
+                {
+                    Json::Value p;
+                    p["burnvalue"] = burnvalue;
+                    p["operations"] = operations;
+                    Json::Value result = this->CallMethod("submitbulk",p);
+                    if (result.isArray())
+                        return result;
+                    else
+                        throw jsonrpc::JsonRpcException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, result.toStyledString());
+                }
+                int submitoperation(const std::string& method, const Json::Value& params) 
+                {
+                    Json::Value p;
+                    p["method"] = method;
+                    p["params"] = params;
+                    Json::Value result = this->CallMethod("submitoperation",p);
+                    if (result.isIntegral())
+                        return result.asInt();
+                    else
+                        throw jsonrpc::JsonRpcException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, result.toStyledString());
+                }
+                Json::Value getoperation(int id) 
+                {
+                    Json::Value p;
+                    p["id"] = id;
+                    Json::Value result = this->CallMethod("getoperation",p);
+                    if (result.isObject())
+                        return result;
+                    else
+                        throw jsonrpc::JsonRpcException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, result.toStyledString());
+                }
+                Json::Value lookupumvaluepending(bool isstring, const std::string& key) 
+                {
+                    Json::Value p;
+                    p["isstring"] = isstring;
+                    p["key"] = key;
+                    Json::Value result = this->CallMethod("lookupumvaluepending",p);
+                    if (result.isObject())
+                        return result;
+                    else
+                        throw jsonrpc::JsonRpcException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, result.toStyledString());
+                }
+                Json::Value lookupuniquevaluepending(bool isstring, const std::string& key) 
+                {
+                    Json::Value p;
+                    p["isstring"] = isstring;
+                    p["key"] = key;
+                    Json::Value result = this->CallMethod("lookupuniquevaluepending",p);
+                    if (result.isObject())
+                        return result;
+                    else
+                        throw jsonrpc::JsonRpcException(jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, result.toStyledString());
+                }
         };
 
     }
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <unordered_set>
+#include <utilxx/Opt.hpp>
+
+namespace forge::wallet {
+
+using AddressSet = std::unordered_set<std::string>;
+
+//the log is rewritten when loading it if it holds more than
+//this many records per address, e.g. after a lot of unwatching
+constexpr inline std::size_t ADDRESS_BOOK_COMPACTION_FACTOR = 2;
+
+//owned and watched addresses of a wallet.
+//If a path is given, the addresses are persisted in an append only log
+//with one "<kind> <address>" record per line, which is replayed when the
+//book is opened. Every change appends a single record.
+//The book is not thread safe.
+class AddressBook final
+{
+public:
+    //keeps the addresses only in memory
+    AddressBook() = default;
+
+    //loads the log at *path*, a missing log is created
+    explicit AddressBook(std::string path);
+
+    AddressBook(AddressBook&&) = default;
+    AddressBook(const AddressBook&) = delete;
+
+    auto operator=(AddressBook&&)
+        -> AddressBook& = default;
+    auto operator=(const AddressBook&)
+        -> AddressBook& = delete;
+
+    //returns false if the address was already known
+    auto addOwned(std::string address)
+        -> bool;
+    auto addWatched(std::string address)
+        -> bool;
+    auto removeWatched(const std::string& address)
+        -> bool;
+
+    auto getOwned() const
+        -> const AddressSet&;
+    auto getWatched() const
+        -> const AddressSet&;
+
+    auto isOwned(const std::string& address) const
+        -> bool;
+    auto isWatched(const std::string& address) const
+        -> bool;
+
+    //path of the log, none if the book is not persisted
+    auto getPath() const
+        -> const utilxx::Opt<std::string>&;
+
+private:
+    //replays the log and returns the number of records
+    auto load()
+        -> std::size_t;
+
+    //writes only the current addresses to the log
+    auto compact()
+        -> void;
+
+    auto append(char kind,
+                const std::string& address)
+        -> void;
+
+private:
+    utilxx::Opt<std::string> path_;
+    std::ofstream log_;
+    AddressSet owned_;
+    AddressSet watched_;
+};
+
+} // namespace forge::wallet
@@ -1,17 +1,23 @@
 #pragma once
 
+#include <cstdint>
 #include <lookup/LookupManager.hpp>
 #include <memory>
-#include <set>
+#include <mutex>
 #include <string>
 #include <vector>
+#include <wallet/AddressBook.hpp>
+#include <wallet/WalletView.hpp>
 
 namespace forge::wallet {
 
 class ReadOnlyWallet
 {
 public:
-    ReadOnlyWallet(std::unique_ptr<lookup::LookupManager>&& lookup);
+    //the owned addresses are only requested from the daemon
+    //if the address book does not know any
+    ReadOnlyWallet(std::unique_ptr<lookup::LookupManager>&& lookup,
+                   AddressBook&& address_book = AddressBook{});
 
     auto addWatchOnlyAddress(std::string adr)
         -> void;
@@ -22,6 +28,11 @@ public:
     auto addNewOwnedAddress(std::string adr)
         -> void;
 
+    //adds all addresses of the daemons wallet to the owned addresses,
+    //e.g. to pick up addresses which were not created by forge
+    auto importOwnedAddresses()
+        -> void;
+
     auto getOwnedUMEntrys() const
         -> std::vector<core::UMEntry>;
 
@@ -49,11 +60,13 @@ public:
     auto getAllWatchedUtilityTokens() const
         -> std::vector<core::UtilityToken>;
 
+    //copies, because other threads may
+    //add addresses while they are used
     auto getWatchedAddresses() const
-        -> const std::set<std::string>&;
+        -> AddressSet;
 
     auto getOwnedAddresses() const
-        -> const std::set<std::string>&;
+        -> AddressSet;
 
     auto ownesAddress(const std::string& addr) const
         -> bool;
@@ -63,10 +76,22 @@ public:
     auto getLookup()
         -> lookup::LookupManager&;
 
+private:
+    //applies the change sets of all blocks the lookup processed
+    //since the last call to the views, expects view_mtx_ to be locked
+    auto syncViews() const
+        -> void;
+
 protected:
-    std::set<std::string> owned_addresses_;
-    std::set<std::string> watched_addresses_;
     std::unique_ptr<lookup::LookupManager> lookup_;
+
+private:
+    //guarded by view_mtx_, like the views
+    AddressBook address_book_;
+    mutable std::unique_ptr<std::mutex> view_mtx_;
+    mutable WalletView owned_view_;
+    mutable WalletView watched_view_;
+    mutable std::uint64_t view_generation_;
 };
 
 } // namespace forge::wallet
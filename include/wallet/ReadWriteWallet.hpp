@@ -1,24 +1,64 @@
 #pragma once
 
 #include <core/Coin.hpp>
+#include <core/Transaction.hpp>
+#include <cstddef>
+#include <cstdint>
 #include <client/WriteOnlyClientBase.hpp>
 #include <entrys/Entry.hpp>
 #include <entrys/uentry/UniqueEntry.hpp>
 #include <entrys/umentry/UMEntry.hpp>
 #include <lookup/LookupManager.hpp>
+#include <map>
 #include <memory>
 #include <string>
+#include <utilxx/Opt.hpp>
+#include <utilxx/Result.hpp>
+#include <variant>
 #include <vector>
+#include <wallet/AddressBook.hpp>
 #include <wallet/ReadOnlyWallet.hpp>
 #include <wallet/WalletError.hpp>
 
 namespace forge::wallet {
 
+//number of transactions of a bulk submission
+//which are built, signed and broadcast together
+constexpr inline std::size_t BULK_BATCH_SIZE = 50;
+
+//an entry created by a bulk submission,
+//an empty address means that a new owner address is generated
+struct BulkEntryCreation
+{
+    core::Entry entry;
+    std::string address;
+};
+
+//utility tokens sent by a bulk submission
+struct BulkTokenTransfer
+{
+    core::EntryKey token;
+    std::string new_owner;
+    std::uint64_t amount;
+};
+
+//utility tokens deleted by a bulk submission
+struct BulkTokenDeletion
+{
+    core::EntryKey token;
+    std::uint64_t amount;
+};
+
+using BulkOperation = std::variant<BulkEntryCreation,
+                                   BulkTokenTransfer,
+                                   BulkTokenDeletion>;
+
 class ReadWriteWallet : public ReadOnlyWallet
 {
 public:
     ReadWriteWallet(std::unique_ptr<lookup::LookupManager>&& lookup,
-                    std::unique_ptr<client::WriteOnlyClientBase>&& client);
+                    std::unique_ptr<client::WriteOnlyClientBase>&& client,
+                    AddressBook&& address_book = AddressBook{});
     //creates a new entry key value pair on the blockchain
     //using any output of the dameonwallet
     //coins will be send to a new address and this output
@@ -144,6 +184,8 @@ public:
         -> utilxx::Result<std::string, WalletError>;
 
     //transfers a given *amount* of utility tokens to a *new_owner*
+    //the tokens are sent by as few addresses as possible,
+    //the transactions of all addresses are submitted together
     auto transferUtilityTokens(core::EntryKey id,
                                std::string new_owner,
                                std::uint64_t amount,
@@ -152,7 +194,8 @@ public:
                           WalletError>;
 
     //delete/burns a given *amount* of utility tokens if they
-    //are owned by the wallet
+    //are owned by the wallet, like transferUtilityTokens
+    //with as few transactions as possible
     auto deleteUtilityTokens(core::EntryKey id,
                              std::uint64_t amount,
                              std::int64_t burn_amount)
@@ -169,7 +212,61 @@ public:
                          std::int64_t amount)
         -> utilxx::Result<std::string, WalletError>;
 
+    //submits all operations with one transaction per burn.
+    //inputs of all operations are selected before the first transaction
+    //is built, owner addresses without a suitable output are funded with
+    //a single transaction. the transactions are then built, signed and
+    //broadcast in batches of BULK_BATCH_SIZE.
+    //returns the txids or the error of every operation in the given order
+    auto submitBulk(std::vector<BulkOperation> operations,
+                    std::int64_t burn_amount)
+        -> std::vector<
+            utilxx::Result<std::vector<std::string>,
+                           WalletError>>;
+
 private:
+    //one burn transaction of a bulk submission
+    struct PendingBurn
+    {
+        //index of the bulk operation the burn belongs to
+        std::size_t operation;
+        std::string owner;
+        utilxx::Opt<std::string> new_owner;
+        std::vector<std::byte> metadata;
+        //value of the input, burn amount plus fee
+        //and the output of the new owner
+        std::int64_t needed;
+        utilxx::Opt<core::Unspent> output;
+    };
+
+    using BulkResults = std::vector<
+        utilxx::Result<std::vector<std::string>,
+                       WalletError>>;
+
+    //turns every operation into its burns, operations
+    //which cannot be submitted get their error
+    auto prepareBulkBurns(std::vector<BulkOperation>&& operations,
+                          std::int64_t burn_amount,
+                          BulkResults& results)
+        -> std::vector<PendingBurn>;
+
+    //locks an output for every burn and funds
+    //all owners without one with a single transaction
+    auto selectBulkOutputs(std::vector<PendingBurn>& burns,
+                           BulkResults& results)
+        -> void;
+
+    //builds, signs and broadcasts the transactions of the given burns
+    auto sendBulkBurns(std::vector<PendingBurn>& burns,
+                       std::int64_t burn_amount,
+                       BulkResults& results)
+        -> void;
+
+    //fails if an operation on the key is not mature yet,
+    //a second one would conflict with it
+    auto checkForPendingOperations(const core::EntryKey& key) const
+        -> utilxx::Result<void, WalletError>;
+
     auto createEntryOwnerPairFromKey(core::EntryKey key)
         -> utilxx::Result<std::pair<core::Entry,
                                     std::string>,
@@ -181,15 +278,35 @@ private:
                           WalletError>;
     //returns a vector of pairs (string, int) where the string is the address
     //and the int is the amount of the token to be send from the address to
-    //be able to send desired_amount in total
+    //be able to send desired_amount in total, see planTokenSends
+    //tokens in *reserved* are already planned to be sent by an address
     auto getUtilityTokenSendVector(const std::vector<std::byte>& token,
-                                   std::uint64_t desired_amount)
+                                   std::uint64_t desired_amount,
+                                   const std::map<std::string, std::uint64_t>& reserved = {})
         -> utilxx::Result<
             std::vector<
                 std::pair<std::string,
                           std::uint64_t>>,
             WalletError>;
 
+    //locks the smallest unspent output of *address* which covers *amount*
+    //exactly or leaves enough for a change output
+    auto findOutputOfAddress(const std::string& address,
+                             std::int64_t amount) const
+        -> utilxx::Opt<core::Unspent>;
+
+    //sends exactly *amount* to *address* and returns the created output
+    auto fundAddress(const std::string& address,
+                     std::int64_t amount)
+        -> utilxx::Result<core::Unspent, client::ClientError>;
+
+    //returns an output of *address* covering *amount*,
+    //the address is only funded if it has none.
+    //the output has to be unlocked after it was spent
+    auto getOutputToBurn(const std::string& address,
+                         std::int64_t amount)
+        -> utilxx::Result<core::Unspent, client::ClientError>;
+
     //burns a given *burn_amout* from a given *address* while
     //writeing the given *metadata* into the OP_RETURN transaction
     auto burn(const std::string& address,
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <utilxx/Opt.hpp>
+#include <vector>
+
+namespace forge::wallet {
+
+//(address, number of tokens)
+using TokenBalances = std::vector<std::pair<std::string,
+                                            std::uint64_t>>;
+
+//chooses the addresses which send *amount* tokens together.
+//every address needs its own transaction, so the largest balances
+//are used first, which needs the fewest addresses possible.
+//only the last address may send less than its balance.
+//returns none if the balances do not cover the amount
+auto planTokenSends(TokenBalances balances,
+                    std::uint64_t amount)
+    -> utilxx::Opt<TokenBalances>;
+
+} // namespace forge::wallet
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <entrys/token/UtilityToken.hpp>
+#include <entrys/uentry/UniqueEntry.hpp>
+#include <entrys/umentry/UMEntry.hpp>
+#include <lookup/LookupChangeSet.hpp>
+#include <lookup/LookupManager.hpp>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include <wallet/AddressBook.hpp>
+
+namespace forge::wallet {
+
+//materialized set of the entrys and tokens owned by a set of addresses.
+//It is kept up to date with the change sets of the lookup manager,
+//so queries only touch the entrys of the view and never scan the lookup.
+class WalletView final
+{
+public:
+    //scans the lookup once for the entrys of the new address
+    auto addAddress(const lookup::LookupManager& lookup,
+                    const std::string& address)
+        -> void;
+
+    auto removeAddress(const lookup::LookupManager& lookup,
+                       const std::string& address)
+        -> void;
+
+    //re-evaluates all keys and token accounts touched by the change set
+    auto apply(const lookup::LookupManager& lookup,
+               const lookup::LookupChangeSet& change_set,
+               const AddressSet& addresses)
+        -> void;
+
+    auto getUMEntrys(const lookup::LookupManager& lookup) const
+        -> std::vector<core::UMEntry>;
+
+    auto getUniqueEntrys(const lookup::LookupManager& lookup) const
+        -> std::vector<core::UniqueEntry>;
+
+    auto getUtilityTokens(const lookup::LookupManager& lookup) const
+        -> std::vector<core::UtilityToken>;
+
+    auto clear()
+        -> void;
+
+private:
+    std::set<core::EntryKey> um_entrys_;
+    std::set<core::EntryKey> unique_entrys_;
+
+    //token ids with a positive balance per address
+    std::map<std::string, std::set<core::EntryKey>> utility_tokens_;
+};
+
+} // namespace forge::wallet
@@ -26,10 +26,14 @@ auto forge::cli::addLookupOnlySubcommands(CLI::App& app, forge::rpc::JsonRpcStub
     addLookupUMValue(app, client);
     addLookupUniqueValue(app, client);
     addLookupOwner(app, client);
+    addLookupAt(app, client);
     addLookupActivationBlock(app, client);
     addLookupAllEntrysOf(app, client);
     addGetUtilityTokenBalanceOf(app, client);
     addGetSupplyOfUtilityToken(app, client);
+    addScanEntrys(app, client);
+    addGetChanges(app, client);
+    addGetTrace(app, client);
 }
 
 auto forge::cli::addShutdown(CLI::App& app, forge::rpc::JsonRpcStubClient& client)
@@ -95,7 +99,9 @@ auto forge::cli::addLookupUMValue(CLI::App& app, forge::rpc::JsonRpcStubClient&
             ->add_subcommand("lookupvalue",
                              "looks up the value of a given byte vector/string")
             ->callback([&] {
-                RESPONSE = client.lookupumvalue(IS_STRING, KEY);
+                RESPONSE = INCLUDE_PENDING
+                    ? client.lookupumvaluepending(IS_STRING, KEY)
+                    : client.lookupumvalue(IS_STRING, KEY);
             });
 
     lookupumvalue_opt
@@ -108,6 +114,11 @@ auto forge::cli::addLookupUMValue(CLI::App& app, forge::rpc::JsonRpcStubClient&
         ->add_flag("--isstring",
                    IS_STRING,
                    "if set, the given key will be interpreted as string and not as byte vector");
+
+    lookupumvalue_opt
+        ->add_flag("--includepending",
+                   INCLUDE_PENDING,
+                   "if set, operations on the key which are not mature yet are returned as well");
 }
 
 auto forge::cli::addLookupUniqueValue(CLI::App& app, forge::rpc::JsonRpcStubClient& client)
@@ -118,7 +129,9 @@ auto forge::cli::addLookupUniqueValue(CLI::App& app, forge::rpc::JsonRpcStubClie
             ->add_subcommand("lookupvalue",
                              "looks up the value of a given byte vector/string")
             ->callback([&] {
-                RESPONSE = client.lookupuniquevalue(IS_STRING, KEY);
+                RESPONSE = INCLUDE_PENDING
+                    ? client.lookupuniquevaluepending(IS_STRING, KEY)
+                    : client.lookupuniquevalue(IS_STRING, KEY);
             });
 
     lookupumvalue_opt
@@ -131,6 +144,11 @@ auto forge::cli::addLookupUniqueValue(CLI::App& app, forge::rpc::JsonRpcStubClie
         ->add_flag("--isstring",
                    IS_STRING,
                    "if set, the given key will be interpreted as string and not as byte vector");
+
+    lookupumvalue_opt
+        ->add_flag("--includepending",
+                   INCLUDE_PENDING,
+                   "if set, operations on the key which are not mature yet are returned as well");
 }
 
 auto forge::cli::addLookupOwner(CLI::App& app, forge::rpc::JsonRpcStubClient& client)
@@ -155,6 +173,34 @@ auto forge::cli::addLookupOwner(CLI::App& app, forge::rpc::JsonRpcStubClient& cl
                    "if set, the given key will be interpreted as string and not as byte vector");
 }
 
+auto forge::cli::addLookupAt(CLI::App& app, forge::rpc::JsonRpcStubClient& client)
+    -> void
+{
+    auto lookupat_opt =
+        app.add_subcommand("lookupat",
+                           "looks up value and owner of the entry with the given key at the end of a given block")
+            ->callback([&] {
+                RESPONSE = client.lookupat(BLOCK, IS_STRING, KEY);
+            });
+
+    lookupat_opt
+        ->add_option("--key",
+                     KEY,
+                     "the key of which the entry will be looked up")
+        ->required();
+
+    lookupat_opt
+        ->add_option("--block",
+                     BLOCK,
+                     "the block height at which the entry will be looked up")
+        ->required();
+
+    lookupat_opt
+        ->add_flag("--isstring",
+                   IS_STRING,
+                   "if set, the given key will be interpreted as string and not as byte vector");
+}
+
 auto forge::cli::addLookupActivationBlock(CLI::App& app, forge::rpc::JsonRpcStubClient& client)
     -> void
 {
@@ -246,3 +292,73 @@ auto forge::cli::addGetSupplyOfUtilityToken(CLI::App& app, forge::rpc::JsonRpcSt
                    IS_STRING,
                    "if set, the given token id will be interpreted as string and not as byte vector");
 }
+
+auto forge::cli::addScanEntrys(CLI::App& app, forge::rpc::JsonRpcStubClient& client)
+    -> void
+{
+    auto scanentries_opt =
+        app.get_subcommand("lookup")
+            ->add_subcommand("scanentries",
+                             "returns all entrys and tokens whose keys start with a given prefix, ordered by key")
+            ->callback([&] {
+                RESPONSE = client.scanentries(CURSOR, IS_STRING, LIMIT, PREFIX);
+            });
+
+    scanentries_opt
+        ->add_option("--prefix",
+                     PREFIX,
+                     "the prefix of the keys which will be returned");
+
+    scanentries_opt
+        ->add_option("--limit",
+                     LIMIT,
+                     "maximum number of entrys which will be returned");
+
+    scanentries_opt
+        ->add_option("--cursor",
+                     CURSOR,
+                     "the cursor returned by the previous call, to get the next page");
+
+    scanentries_opt
+        ->add_flag("--isstring",
+                   IS_STRING,
+                   "if set, the given prefix will be interpreted as string and not as byte vector");
+}
+
+auto forge::cli::addGetChanges(CLI::App& app, forge::rpc::JsonRpcStubClient& client)
+    -> void
+{
+    auto getchanges_opt =
+        app.get_subcommand("lookup")
+            ->add_subcommand("getchanges",
+                             "returns the applied operations and rollbacks since a given sequence number")
+            ->callback([&] {
+                RESPONSE = client.getchanges(LIMIT, SINCE, TIMEOUT);
+            });
+
+    getchanges_opt
+        ->add_option("--since",
+                     SINCE,
+                     "sequence number of the first event which will be returned");
+
+    getchanges_opt
+        ->add_option("--limit",
+                     LIMIT,
+                     "maximum number of events which will be returned");
+
+    getchanges_opt
+        ->add_option("--timeout",
+                     TIMEOUT,
+                     "milliseconds to wait for new events if there are none, at most 1000");
+}
+
+auto forge::cli::addGetTrace(CLI::App& app, forge::rpc::JsonRpcStubClient& client)
+    -> void
+{
+    app.get_subcommand("lookup")
+        ->add_subcommand("gettrace",
+                         "returns the recorded block processing spans as chrome trace json")
+        ->callback([&] {
+            RESPONSE = client.gettrace();
+        });
+}
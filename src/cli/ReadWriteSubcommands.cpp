@@ -4,6 +4,8 @@
 #include <core/Transaction.hpp>
 #include <entrys/umentry/UMEntry.hpp>
 #include <fmt/core.h>
+#include <fstream>
+#include <iterator>
 #include <rpc/jsonrpcstubclient.h>
 
 using forge::core::stringToByteVec;
@@ -476,6 +478,80 @@ auto forge::cli::addCreateUtilityToken(CLI::App& app, forge::rpc::JsonRpcStubCli
                      "addres which will be the owner of all the newly created tokens, if not set a new address will be generated");
 }
 
+auto forge::cli::addSubmitBulk(CLI::App& app, forge::rpc::JsonRpcStubClient& client)
+    -> void
+{
+    auto submitbulk_opt =
+        app.get_subcommand("entry")
+            ->add_subcommand("bulk",
+                             "submits all operations of a file, every operation "
+                             "is written with its own transaction")
+            ->callback([&] {
+                std::ifstream file{FILE_PATH};
+                if(!file) {
+                    fmt::print("unable to open file {}\n", FILE_PATH);
+                    std::exit(0);
+                }
+
+                std::string content{std::istreambuf_iterator<char>{file},
+                                    std::istreambuf_iterator<char>{}};
+
+                auto operations = parseIntoJson(content);
+                if(!operations.isArray()) {
+                    fmt::print("given file {} does not hold a json array of operations\n",
+                               FILE_PATH);
+                    std::exit(0);
+                }
+
+                if(ASYNC) {
+                    Json::Value params;
+                    params["burnvalue"] = BURN_VALUE;
+                    params["operations"] = std::move(operations);
+                    RESPONSE = client.submitoperation("submitbulk", params);
+                    return;
+                }
+
+                RESPONSE = client.submitbulk(BURN_VALUE, operations);
+            });
+
+    submitbulk_opt
+        ->add_option("--file",
+                     FILE_PATH,
+                     "json file with an array of operations. every operation is an object "
+                     "with the fields \"type\" (\"umentry\", \"uniqueentry\", \"utilitytoken\", "
+                     "\"sendutilitytokens\" or \"burnutilitytokens\"), \"key\", \"isstring\" and, depending on "
+                     "the type, \"value\", \"supply\", \"address\", \"amount\" or \"newowner\"")
+        ->required();
+
+    submitbulk_opt
+        ->add_option("--burn-value",
+                     BURN_VALUE,
+                     "number of coins which will be burned by every transaction")
+        ->required();
+
+    submitbulk_opt
+        ->add_flag("--async",
+                   ASYNC,
+                   "if set, only the id of the operation is returned, "
+                   "its result can be queried with \"entry getoperation\"");
+}
+
+auto forge::cli::addGetOperation(CLI::App& app, forge::rpc::JsonRpcStubClient& client)
+    -> void
+{
+    app.get_subcommand("entry")
+        ->add_subcommand("getoperation",
+                         "returns the status and, once it finished, "
+                         "the result of a submitted operation")
+        ->callback([&] {
+            RESPONSE = client.getoperation(OPERATION_ID);
+        })
+        ->add_option("--id",
+                     OPERATION_ID,
+                     "id of the operation")
+        ->required();
+}
+
 auto forge::cli::addReadWriteSubcommands(CLI::App& app, forge::rpc::JsonRpcStubClient& client)
     -> void
 {
@@ -493,4 +569,6 @@ auto forge::cli::addReadWriteSubcommands(CLI::App& app, forge::rpc::JsonRpcStubC
     addTransferUtilityToken(app, client);
     addDeleteUtilityToken(app, client);
     addCreateUtilityToken(app, client);
+    addSubmitBulk(app, client);
+    addGetOperation(app, client);
 }
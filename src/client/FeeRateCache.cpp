@@ -0,0 +1,28 @@
+#include <client/FeeRateCache.hpp>
+#include <cstdint>
+#include <mutex>
+#include <utilxx/Opt.hpp>
+
+using forge::client::FeeRateCache;
+using utilxx::Opt;
+
+auto FeeRateCache::get(std::int64_t height) const
+    -> Opt<std::int64_t>
+{
+    std::lock_guard lock{mtx_};
+
+    if(!height_ || height_.getValue() != height) {
+        return std::nullopt;
+    }
+
+    return fee_rate_;
+}
+
+auto FeeRateCache::set(std::int64_t fee_rate,
+                       std::int64_t height)
+    -> void
+{
+    std::lock_guard lock{mtx_};
+    fee_rate_ = Opt<std::int64_t>{fee_rate};
+    height_ = Opt<std::int64_t>{height};
+}
@@ -0,0 +1,188 @@
+#include <client/UnspentSet.hpp>
+#include <core/Transaction.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utilxx/Opt.hpp>
+#include <vector>
+
+using forge::client::UnspentSet;
+using forge::core::Unspent;
+using utilxx::Opt;
+
+namespace {
+
+template<class ValueIndex>
+auto eraseFromIndex(ValueIndex& index,
+                    std::int64_t value,
+                    const typename ValueIndex::mapped_type& outpoint)
+    -> void
+{
+    auto [begin, end] = index.equal_range(value);
+    for(auto iter = begin; iter != end; ++iter) {
+        if(iter->second == outpoint) {
+            index.erase(iter);
+            return;
+        }
+    }
+}
+
+} // namespace
+
+auto UnspentSet::getHeight() const
+    -> Opt<std::int64_t>
+{
+    std::lock_guard lock{mtx_};
+    return height_;
+}
+
+auto UnspentSet::getResetHeight() const
+    -> Opt<std::int64_t>
+{
+    std::lock_guard lock{mtx_};
+    return reset_height_;
+}
+
+auto UnspentSet::reset(std::vector<Unspent>&& unspents,
+                       std::int64_t height)
+    -> void
+{
+    std::lock_guard lock{mtx_};
+    available_.clear();
+    by_value_.clear();
+    by_address_.clear();
+
+    for(auto&& unspent : unspents) {
+        Outpoint outpoint{unspent.getTxid(), unspent.getVoutIdx()};
+        if(locked_.count(outpoint) == 0) {
+            insert(std::move(unspent));
+        }
+    }
+
+    height_ = Opt<std::int64_t>{height};
+    reset_height_ = Opt<std::int64_t>{height};
+}
+
+auto UnspentSet::add(std::vector<Unspent>&& unspents,
+                     std::int64_t height)
+    -> void
+{
+    std::lock_guard lock{mtx_};
+    for(auto&& unspent : unspents) {
+        Outpoint outpoint{unspent.getTxid(), unspent.getVoutIdx()};
+        if(locked_.count(outpoint) == 0
+           && available_.count(outpoint) == 0) {
+            insert(std::move(unspent));
+        }
+    }
+
+    if(!height_ || height_.getValue() < height) {
+        height_ = Opt<std::int64_t>{height};
+    }
+}
+
+auto UnspentSet::lock(std::int64_t amount,
+                      std::int64_t min_change,
+                      const Opt<std::string>& address)
+    -> Opt<Unspent>
+{
+    std::lock_guard lock{mtx_};
+
+    const ValueIndex* index = &by_value_;
+    if(address) {
+        auto iter = by_address_.find(address.getValue());
+        if(iter == std::cend(by_address_)) {
+            return std::nullopt;
+        }
+        index = &iter->second;
+    }
+
+    //an exact match needs no change output,
+    //which makes it the best choice
+    auto iter = index->find(amount);
+    if(iter == std::cend(*index)) {
+        iter = index->lower_bound(amount + min_change);
+    }
+    if(iter == std::cend(*index)) {
+        return std::nullopt;
+    }
+
+    auto outpoint = iter->second;
+    auto unspent = erase(outpoint).getValue();
+    locked_.emplace(std::move(outpoint), unspent);
+
+    return unspent;
+}
+
+auto UnspentSet::unlock(const Unspent& output,
+                        bool spent)
+    -> void
+{
+    std::lock_guard lock{mtx_};
+
+    auto iter = locked_.find(Outpoint{output.getTxid(), output.getVoutIdx()});
+    if(iter == std::end(locked_)) {
+        return;
+    }
+
+    auto unspent = std::move(iter->second);
+    locked_.erase(iter);
+
+    if(!spent) {
+        insert(std::move(unspent));
+    }
+}
+
+auto UnspentSet::size() const
+    -> std::size_t
+{
+    std::lock_guard lock{mtx_};
+    return available_.size();
+}
+
+auto UnspentSet::clear()
+    -> void
+{
+    std::lock_guard lock{mtx_};
+    available_.clear();
+    by_value_.clear();
+    by_address_.clear();
+    height_ = std::nullopt;
+    reset_height_ = std::nullopt;
+}
+
+auto UnspentSet::insert(Unspent&& unspent)
+    -> void
+{
+    Outpoint outpoint{unspent.getTxid(), unspent.getVoutIdx()};
+    auto value = unspent.getValue();
+
+    by_value_.emplace(value, outpoint);
+    by_address_[unspent.getAddress()].emplace(value, outpoint);
+    available_.emplace(std::move(outpoint), std::move(unspent));
+}
+
+auto UnspentSet::erase(const Outpoint& outpoint)
+    -> Opt<Unspent>
+{
+    auto iter = available_.find(outpoint);
+    if(iter == std::end(available_)) {
+        return std::nullopt;
+    }
+
+    auto unspent = std::move(iter->second);
+    available_.erase(iter);
+
+    auto value = unspent.getValue();
+    eraseFromIndex(by_value_, value, outpoint);
+
+    auto address_iter = by_address_.find(unspent.getAddress());
+    eraseFromIndex(address_iter->second, value, outpoint);
+    if(address_iter->second.empty()) {
+        by_address_.erase(address_iter);
+    }
+
+    return unspent;
+}
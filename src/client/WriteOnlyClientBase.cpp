@@ -4,6 +4,7 @@
 #include <client/odin/ReadWriteOdinClient.hpp>
 #include <entrys/umentry/UMEntryOperation.hpp>
 #include <g3log/g3log.hpp>
+#include <utilxx/Opt.hpp>
 #include <utilxx/Result.hpp>
 
 using forge::client::WriteOnlyClientBase;
@@ -34,12 +35,62 @@ auto WriteOnlyClientBase::writeTxToBlockchain(std::string txid_input,
         });
 }
 
+auto WriteOnlyClientBase::signRawTxs(std::vector<std::vector<std::byte>> txs) const
+    -> std::vector<
+        utilxx::Result<std::vector<std::byte>,
+                       ClientError>>
+{
+    std::vector<utilxx::Result<std::vector<std::byte>,
+                               ClientError>>
+        signed_txs;
+    signed_txs.reserve(txs.size());
+
+    for(auto&& tx : txs) {
+        signed_txs.push_back(signRawTx(std::move(tx)));
+    }
+
+    return signed_txs;
+}
+
+auto WriteOnlyClientBase::sendRawTxs(std::vector<std::vector<std::byte>> txs) const
+    -> std::vector<
+        utilxx::Result<std::string, ClientError>>
+{
+    std::vector<utilxx::Result<std::string, ClientError>> txids;
+    txids.reserve(txs.size());
+
+    for(auto&& tx : txs) {
+        txids.push_back(sendRawTx(std::move(tx)));
+    }
+
+    return txids;
+}
+
+auto WriteOnlyClientBase::generateNewAddresses(std::size_t count) const
+    -> utilxx::Result<std::vector<std::string>, ClientError>
+{
+    std::vector<std::string> addresses;
+    addresses.reserve(count);
+
+    for(std::size_t i = 0; i < count; i++) {
+        auto address_res = generateNewAddress();
+        if(!address_res) {
+            return address_res.getError();
+        }
+
+        addresses.push_back(std::move(address_res.getValue()));
+    }
+
+    return addresses;
+}
+
 
 auto forge::client::make_writing_client(const std::string& host,
                                         const std::string& user,
                                         const std::string& password,
                                         std::int64_t port,
-                                        core::Coin coin)
+                                        core::Coin coin,
+                                        utilxx::Opt<std::int64_t> fee_rate)
     -> std::unique_ptr<WriteOnlyClientBase>
 {
     switch(coin) {
@@ -49,7 +100,8 @@ auto forge::client::make_writing_client(const std::string& host,
                                                      user,
                                                      password,
                                                      port,
-                                                     coin);
+                                                     coin,
+                                                     fee_rate);
 
     default:
         LOG(FATAL) << "entered default case which should never happen";
@@ -0,0 +1,307 @@
+#include <algorithm>
+#include <array>
+#include <client/ClientError.hpp>
+#include <client/odin/RawTxBuilder.hpp>
+#include <core/Base58.hpp>
+#include <core/ByteSpan.hpp>
+#include <core/Coin.hpp>
+#include <core/Hex.hpp>
+#include <core/Sha256.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <fmt/core.h>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utilxx/Result.hpp>
+#include <vector>
+
+using forge::client::ClientError;
+using forge::core::ByteSpan;
+using forge::core::Coin;
+using forge::core::decodeBase58Check;
+using forge::core::decodeHex;
+using forge::core::doubleSha256;
+using forge::core::encodeHex;
+using forge::core::getPubkeyAddressPrefix;
+using forge::core::hexEncodedSize;
+using forge::core::SHA256_DIGEST_SIZE;
+using utilxx::Result;
+
+namespace {
+
+constexpr inline std::size_t PUBKEY_HASH_SIZE = 20;
+constexpr inline std::uint32_t FINAL_SEQUENCE = 0xffffffff;
+constexpr inline std::uint32_t LOCK_TIME = 0;
+
+constexpr inline std::byte OP_DUP{0x76};
+constexpr inline std::byte OP_HASH160{0xa9};
+constexpr inline std::byte OP_EQUALVERIFY{0x88};
+constexpr inline std::byte OP_CHECKSIG{0xac};
+constexpr inline std::byte OP_RETURN{0x6a};
+constexpr inline std::byte OP_PUSHDATA1{0x4c};
+constexpr inline std::byte OP_PUSHDATA2{0x4d};
+constexpr inline std::size_t MAX_DIRECT_PUSH_SIZE = 75;
+
+//txid and index
+constexpr inline std::size_t OUTPOINT_SIZE = SHA256_DIGEST_SIZE + 4;
+constexpr inline std::size_t PUBKEY_HASH_SCRIPT_SIZE = PUBKEY_HASH_SIZE + 5;
+//pushes of a der signature with its sighash type (at most 72 bytes)
+//and of a compressed pubkey (33 bytes)
+constexpr inline std::size_t SIGNED_SCRIPT_SIG_SIZE = 1 + 72 + 1 + 33;
+
+template<class Integer>
+auto writeLittleEndian(Integer value,
+                       std::vector<std::byte>& out)
+    -> void
+{
+    auto unsigned_value = static_cast<std::make_unsigned_t<Integer>>(value);
+    for(std::size_t i = 0; i < sizeof(Integer); i++) {
+        out.push_back(static_cast<std::byte>(unsigned_value >> (i * 8)));
+    }
+}
+
+auto writeCompactSize(std::uint64_t size,
+                      std::vector<std::byte>& out)
+    -> void
+{
+    if(size < 0xfd) {
+        out.push_back(static_cast<std::byte>(size));
+    } else if(size <= 0xffff) {
+        out.push_back(std::byte{0xfd});
+        writeLittleEndian(static_cast<std::uint16_t>(size), out);
+    } else if(size <= 0xffffffff) {
+        out.push_back(std::byte{0xfe});
+        writeLittleEndian(static_cast<std::uint32_t>(size), out);
+    } else {
+        out.push_back(std::byte{0xff});
+        writeLittleEndian(size, out);
+    }
+}
+
+auto compactSizeLength(std::uint64_t size)
+    -> std::size_t
+{
+    if(size < 0xfd) {
+        return 1;
+    }
+    if(size <= 0xffff) {
+        return 3;
+    }
+    if(size <= 0xffffffff) {
+        return 5;
+    }
+    return 9;
+}
+
+auto writeOutpoint(std::string_view txid,
+                   std::int64_t index,
+                   std::vector<std::byte>& out)
+    -> Result<void, ClientError>
+{
+    std::array<std::byte, SHA256_DIGEST_SIZE> txid_bytes;
+    if(txid.size() != hexEncodedSize(SHA256_DIGEST_SIZE)
+       || !decodeHex(txid, txid_bytes.data())) {
+        auto error = fmt::format("{} is not a valid txid",
+                                 txid);
+        return ClientError{std::move(error)};
+    }
+
+    if(index < 0 || index > 0xffffffff) {
+        auto error = fmt::format("{} is not a valid output index",
+                                 index);
+        return ClientError{std::move(error)};
+    }
+
+    //txids are displayed in reversed byte order
+    out.insert(std::end(out),
+               std::rbegin(txid_bytes),
+               std::rend(txid_bytes));
+    writeLittleEndian(static_cast<std::uint32_t>(index), out);
+    return {};
+}
+
+auto writePubkeyHashScript(Coin coin,
+                           const std::string& address,
+                           std::vector<std::byte>& out)
+    -> Result<void, ClientError>
+{
+    auto decoded_opt = decodeBase58Check(address);
+    if(!decoded_opt
+       || decoded_opt.getValue().size() != PUBKEY_HASH_SIZE + 1
+       || decoded_opt.getValue().front() != getPubkeyAddressPrefix(coin)) {
+        auto error = fmt::format("{} is not a valid pay to pubkey hash address",
+                                 address);
+        return ClientError{std::move(error)};
+    }
+
+    auto& decoded = decoded_opt.getValue();
+
+    writeCompactSize(PUBKEY_HASH_SIZE + 5, out);
+    out.push_back(OP_DUP);
+    out.push_back(OP_HASH160);
+    out.push_back(static_cast<std::byte>(PUBKEY_HASH_SIZE));
+    out.insert(std::end(out),
+               std::next(std::cbegin(decoded)),
+               std::cend(decoded));
+    out.push_back(OP_EQUALVERIFY);
+    out.push_back(OP_CHECKSIG);
+    return {};
+}
+
+auto writeOpReturnScript(const std::vector<std::byte>& metadata,
+                         std::vector<std::byte>& out)
+    -> Result<void, ClientError>
+{
+    std::vector<std::byte> script{OP_RETURN};
+
+    //smallest push opcode which fits the metadata
+    if(metadata.size() <= MAX_DIRECT_PUSH_SIZE) {
+        script.push_back(static_cast<std::byte>(metadata.size()));
+    } else if(metadata.size() <= 0xff) {
+        script.push_back(OP_PUSHDATA1);
+        script.push_back(static_cast<std::byte>(metadata.size()));
+    } else if(metadata.size() <= 0xffff) {
+        script.push_back(OP_PUSHDATA2);
+        writeLittleEndian(static_cast<std::uint16_t>(metadata.size()), script);
+    } else {
+        auto error = fmt::format("metadata of {} bytes is too large",
+                                 metadata.size());
+        return ClientError{std::move(error)};
+    }
+
+    script.insert(std::end(script),
+                  std::cbegin(metadata),
+                  std::cend(metadata));
+
+    writeCompactSize(script.size(), out);
+    out.insert(std::end(out),
+               std::cbegin(script),
+               std::cend(script));
+    return {};
+}
+
+auto writeValue(std::int64_t value,
+                std::vector<std::byte>& out)
+    -> Result<void, ClientError>
+{
+    if(value < 0) {
+        auto error = fmt::format("output value {} is negative",
+                                 value);
+        return ClientError{std::move(error)};
+    }
+
+    writeLittleEndian(value, out);
+    return {};
+}
+
+} // namespace
+
+
+auto forge::client::odin::buildRawTx(Coin coin,
+                                     std::string_view input_txid,
+                                     std::int64_t index,
+                                     const std::vector<std::byte>& metadata,
+                                     std::int64_t burn_value,
+                                     const std::vector<
+                                         std::pair<std::string,
+                                                   std::int64_t>>& outputs)
+    -> Result<std::vector<std::byte>,
+              ClientError>
+{
+    std::vector<std::byte> tx;
+    //version, outpoint, sequence, lock time and
+    //a pubkey hash output per address
+    tx.reserve(60 + metadata.size() + outputs.size() * 34);
+
+    writeLittleEndian(RAW_TX_VERSION, tx);
+
+    writeCompactSize(1, tx);
+    if(auto res = writeOutpoint(input_txid, index, tx);
+       !res) {
+        return res.getError();
+    }
+    //the empty script sig is filled by the signing
+    writeCompactSize(0, tx);
+    writeLittleEndian(FINAL_SEQUENCE, tx);
+
+    writeCompactSize(outputs.size() + 1, tx);
+    for(auto&& [address, value] : outputs) {
+        if(auto res = writeValue(value, tx)
+                          .flatMap([&]() {
+                              return writePubkeyHashScript(coin, address, tx);
+                          });
+           !res) {
+            return res.getError();
+        }
+    }
+
+    if(auto res = writeValue(burn_value, tx)
+                      .flatMap([&]() {
+                          return writeOpReturnScript(metadata, tx);
+                      });
+       !res) {
+        return res.getError();
+    }
+
+    writeLittleEndian(LOCK_TIME, tx);
+
+    return tx;
+}
+
+auto forge::client::odin::estimateSignedTxSize(std::size_t metadata_size,
+                                               std::size_t number_of_outputs)
+    -> std::size_t
+{
+    auto push_size = [&]() -> std::size_t {
+        if(metadata_size <= MAX_DIRECT_PUSH_SIZE) {
+            return 1;
+        }
+        if(metadata_size <= 0xff) {
+            return 2;
+        }
+        return 3;
+    }();
+    auto op_return_script_size = 1 + push_size + metadata_size;
+
+    auto input_size = OUTPOINT_SIZE
+        + compactSizeLength(SIGNED_SCRIPT_SIG_SIZE)
+        + SIGNED_SCRIPT_SIG_SIZE
+        + sizeof(FINAL_SEQUENCE);
+
+    auto outputs_size = number_of_outputs
+            * (sizeof(std::int64_t)
+               + compactSizeLength(PUBKEY_HASH_SCRIPT_SIZE)
+               + PUBKEY_HASH_SCRIPT_SIZE)
+        + sizeof(std::int64_t)
+        + compactSizeLength(op_return_script_size)
+        + op_return_script_size;
+
+    return sizeof(RAW_TX_VERSION)
+        + compactSizeLength(1)
+        + input_size
+        + compactSizeLength(number_of_outputs + 1)
+        + outputs_size
+        + sizeof(LOCK_TIME);
+}
+
+auto forge::client::odin::computeTxFee(std::size_t tx_size,
+                                       std::int64_t fee_rate)
+    -> std::int64_t
+{
+    //rounded up, so that the rate is never undercut
+    auto size = static_cast<std::int64_t>(tx_size);
+    return (size * fee_rate + 999) / 1000;
+}
+
+auto forge::client::odin::computeTxid(ByteSpan tx)
+    -> std::string
+{
+    auto hash = doubleSha256(tx);
+    std::reverse(std::begin(hash), std::end(hash));
+
+    std::string txid(hexEncodedSize(hash.size()), '\0');
+    encodeHex(hash.data(), hash.size(), txid.data());
+    return txid;
+}
@@ -2,10 +2,13 @@
 #include <core/Coin.hpp>
 #include <client/ReadOnlyClientBase.hpp>
 #include <client/odin/ReadOnlyOdinClient.hpp>
+#include <env/AsyncLogger.hpp>
 #include <fmt/core.h>
 #include <g3log/g3log.hpp>
 #include <jsonrpccpp/client.h>
 #include <jsonrpccpp/client/connectors/httpclient.h>
+#include <metrics/Metrics.hpp>
+#include <metrics/Trace.hpp>
 #include <utilxx/Algorithm.hpp>
 #include <utilxx/Opt.hpp>
 #include <utilxx/Result.hpp>
@@ -26,6 +29,8 @@ using forge::core::buildTxOut;
 using forge::core::Transaction;
 using forge::core::buildTransaction;
 
+using jsonrpc::BatchCall;
+using jsonrpc::BatchResponse;
 using jsonrpc::Client;
 using jsonrpc::JSONRPC_CLIENT_V1;
 using jsonrpc::HttpClient;
@@ -54,6 +59,12 @@ auto ReadOnlyOdinClient::sendcommand(const std::string& command,
                                      Json::Value params) const
     -> Result<Json::Value, ClientError>
 {
+    auto& registry = metrics::getRegistry();
+    metrics::ScopedTimer timer{
+        registry.histogram("forge_daemon_rpc_duration_seconds",
+                           "latency of rpc calls to the daemon",
+                           {{"command", command}})};
+
     return Try<jsonrpc::JsonRpcException>(
                [this](const auto& command,
                       auto params) {
@@ -63,11 +74,73 @@ auto ReadOnlyOdinClient::sendcommand(const std::string& command,
                command,
                std::move(params))
         .mapError([&](auto error) {
-            LOG(WARNING) << command << " failed";
+            FORGE_LOG(WARNING, "{} failed", command);
+            registry.counter("forge_daemon_rpc_errors_total",
+                             "failed rpc calls to the daemon",
+                             {{"command", command}})
+                .increment();
             return ClientError{error.what()};
         });
 }
 
+auto ReadOnlyOdinClient::sendbatch(const std::string& command,
+                                   std::vector<Json::Value> params) const
+    -> std::vector<Result<Json::Value, ClientError>>
+{
+    std::vector<Result<Json::Value, ClientError>> results;
+    if(params.empty()) {
+        return results;
+    }
+
+    auto& registry = metrics::getRegistry();
+    metrics::ScopedTimer timer{
+        registry.histogram("forge_daemon_rpc_batch_duration_seconds",
+                           "latency of batched rpc calls to the daemon",
+                           {{"command", command}})};
+    auto& errors = registry.counter("forge_daemon_rpc_errors_total",
+                                    "failed rpc calls to the daemon",
+                                    {{"command", command}});
+
+    BatchCall batch;
+    std::vector<int> ids;
+    ids.reserve(params.size());
+    for(auto&& param : params) {
+        ids.push_back(batch.addCall(command, param));
+    }
+
+    auto response_res =
+        Try<JsonRpcException>(
+            [this](const auto& batch) {
+                return client_.CallProcedures(batch);
+            },
+            batch);
+
+    results.reserve(ids.size());
+
+    if(!response_res) {
+        FORGE_LOG(WARNING, "batch of {} {} failed", ids.size(), command);
+        errors.increment(ids.size());
+        for(std::size_t i = 0; i < ids.size(); i++) {
+            results.emplace_back(ClientError{response_res.getError().what()});
+        }
+        return results;
+    }
+
+    auto& response = response_res.getValue();
+    for(auto id : ids) {
+        if(response.getErrorCode(id) != 0) {
+            FORGE_LOG(WARNING, "{} failed", command);
+            errors.increment();
+            results.emplace_back(ClientError{response.getErrorMessage(id)});
+            continue;
+        }
+
+        results.emplace_back(response.getResult(id));
+    }
+
+    return results;
+}
+
 auto ReadOnlyOdinClient::getBlockCount() const
     -> Result<std::int64_t, ClientError>
 {
@@ -127,6 +200,8 @@ auto ReadOnlyOdinClient::getNewestBlock() const
 auto ReadOnlyOdinClient::resolveTxIn(TxIn vin) const
     -> utilxx::Result<TxOut, ClientError>
 {
+    metrics::TraceSpan span{"resolveTxIn"};
+
     auto index = vin.getVoutIndex();
     auto txid = std::move(vin.getTxid());
 
@@ -164,12 +239,21 @@ auto ReadOnlyOdinClient::getTransaction(std::string txid) const
 auto ReadOnlyOdinClient::getUnspent() const
     -> Result<std::vector<Unspent>,
               ClientError>
+{
+    return listUnspent(getMaturity(getCoin()),
+                       99999999);
+}
+
+auto ReadOnlyOdinClient::listUnspent(std::int64_t min_confirmations,
+                                     std::int64_t max_confirmations) const
+    -> Result<std::vector<Unspent>,
+              ClientError>
 {
     static const auto command = "listunspent";
 
     Json::Value params;
-    params.append(getMaturity(getCoin()));
-    params.append(99999999);
+    params.append(min_confirmations);
+    params.append(max_confirmations);
 
     return sendcommand(command, params)
         .flatMap([&](auto json) {
@@ -212,6 +296,18 @@ auto ReadOnlyOdinClient::getAddresses() const
         });
 }
 
+auto ReadOnlyOdinClient::getRawMempool() const
+    -> utilxx::Result<std::vector<std::string>,
+                      ClientError>
+{
+    static const auto command = "getrawmempool";
+
+    return sendcommand(command, {})
+        .flatMap([&](auto json) {
+            return odin::processGetRawMempoolResponse(std::move(json));
+        });
+}
+
 
 auto ReadOnlyOdinClient::isMainnet() const
     -> utilxx::Result<bool,
@@ -368,3 +464,25 @@ auto forge::client::odin::processGetAddressesResponse(Json::Value&& response)
 
     return addresses;
 }
+
+auto forge::client::odin::processGetRawMempoolResponse(Json::Value&& response)
+    -> utilxx::Result<std::vector<std::string>,
+                      ClientError>
+{
+    if(!response.isArray()) {
+        return ClientError{"result of \"getrawmempool\" was not an json array"};
+    }
+
+    std::vector<std::string> txids;
+    txids.reserve(response.size());
+
+    for(auto&& txid : response) {
+        if(!txid.isString()) {
+            return ClientError{"result of \"getrawmempool\" contained a txid which is not a string"};
+        }
+
+        txids.push_back(txid.asString());
+    }
+
+    return txids;
+}
@@ -1,10 +1,15 @@
 #include <core/Block.hpp>
 #include <core/Coin.hpp>
 #include <core/Transaction.hpp>
+#include <algorithm>
+#include <client/FeeRateCache.hpp>
 #include <client/ReadOnlyClientBase.hpp>
+#include <client/UnspentSet.hpp>
 #include <client/WriteOnlyClientBase.hpp>
 #include <client/odin/ReadOnlyOdinClient.hpp>
+#include <client/odin/RawTxBuilder.hpp>
 #include <client/odin/ReadWriteOdinClient.hpp>
+#include <cmath>
 #include <fmt/core.h>
 #include <g3log/g3log.hpp>
 #include <json/value.h>
@@ -17,9 +22,26 @@ using utilxx::Opt;
 using utilxx::Result;
 using forge::core::stringToByteVec;
 using forge::core::toHexString;
-using forge::core::getDefaultTxFee;
+using forge::core::getDefaultFeeRate;
+using forge::core::getMaturity;
+using forge::core::getMinimumFeeRate;
+using forge::core::getMinimumTxAmount;
+using forge::client::FEE_ESTIMATION_BLOCKS;
+using forge::client::UNSPENT_SET_RESYNC_INTERVAL;
 using namespace std::string_literals;
 
+ReadWriteOdinClient::ReadWriteOdinClient(const std::string& host,
+                                         const std::string& user,
+                                         const std::string& password,
+                                         std::int64_t port,
+                                         core::Coin coin,
+                                         utilxx::Opt<std::int64_t> fee_rate)
+    : ReadOnlyOdinClient(host,
+                         user,
+                         password,
+                         port,
+                         coin),
+      fee_rate_(std::move(fee_rate)) {}
 
 auto ReadWriteOdinClient::generateRawTx(std::string input_txid,
                                         std::int64_t index,
@@ -32,60 +54,12 @@ auto ReadWriteOdinClient::generateRawTx(std::string input_txid,
     -> Result<std::vector<std::byte>,
               ClientError>
 {
-    static const auto command = "createrawtransaction"s;
-
-    auto params = generateRpcParamsForRawTx(std::move(input_txid),
-                                            index,
-                                            std::move(metadata),
-                                            burn_value,
-                                            std::move(outputs));
-
-    return sendcommand(command, std::move(params))
-        .flatMap([](auto json) {
-            return odin::processGenerateRawTxResponse(std::move(json));
-        });
-}
-
-auto ReadWriteOdinClient::generateRpcParamsForRawTx(std::string input_txid,
-                                                    std::int64_t index,
-                                                    std::vector<std::byte> metadata,
-                                                    std::int64_t burn_value,
-                                                    std::vector<
-                                                        std::pair<std::string,
-                                                                  std::int64_t>>
-                                                        outputs) const
-    -> Json::Value
-{
-    auto metadata_str = toHexString(metadata);
-
-    Json::Value input;
-    input["txid"] = std::move(input_txid);
-    input["vout"] = index;
-
-    Json::Value inputs;
-    inputs.append(std::move(input));
-
-    Json::Value op_return;
-    op_return["data"] = std::move(metadata_str);
-    op_return["amount"] = static_cast<double>(burn_value) * 0.00000001;
-
-    Json::Value json_outputs;
-
-    for(auto&& [address, value] : outputs) {
-        Json::Value output;
-        output["address"] = std::move(address);
-        output["amount"] = static_cast<double>(value) * 0.00000001;
-
-        json_outputs.append(std::move(output));
-    }
-
-    json_outputs.append(std::move(op_return));
-
-    Json::Value param;
-    param.append(std::move(inputs));
-    param.append(std::move(json_outputs));
-
-    return param;
+    return odin::buildRawTx(getCoin(),
+                            input_txid,
+                            index,
+                            metadata,
+                            burn_value,
+                            outputs);
 }
 
 auto ReadWriteOdinClient::signRawTx(std::vector<std::byte> tx) const
@@ -114,16 +88,76 @@ auto ReadWriteOdinClient::sendRawTx(std::vector<std::byte> tx) const
     params.append(true);
 
     return sendcommand(command, std::move(params))
-        .flatMap([](auto json)
-                     -> Result<std::string, ClientError> {
-            if(json.isString()) {
-                return json.asString();
-            }
-
-            return ClientError{json.toStyledString()};
+        .flatMap([](auto json) {
+            return odin::processSendRawTxResponse(std::move(json));
         });
 }
 
+auto ReadWriteOdinClient::signRawTxs(std::vector<std::vector<std::byte>> txs) const
+    -> std::vector<
+        Result<std::vector<std::byte>,
+               ClientError>>
+{
+    static const auto command = "signrawtransaction"s;
+
+    std::vector<Json::Value> params;
+    params.reserve(txs.size());
+    for(const auto& tx : txs) {
+        Json::Value param;
+        param.append(toHexString(tx));
+        params.push_back(std::move(param));
+    }
+
+    auto responses = sendbatch(command, std::move(params));
+
+    std::vector<Result<std::vector<std::byte>,
+                       ClientError>>
+        signed_txs;
+    signed_txs.reserve(responses.size());
+
+    for(auto&& response : responses) {
+        signed_txs.push_back(
+            std::move(response)
+                .flatMap([](auto json) {
+                    return odin::processSignRawTxResponse(std::move(json));
+                }));
+    }
+
+    return signed_txs;
+}
+
+auto ReadWriteOdinClient::sendRawTxs(std::vector<std::vector<std::byte>> txs) const
+    -> std::vector<
+        Result<std::string, ClientError>>
+{
+    static const auto command = "sendrawtransaction"s;
+
+    std::vector<Json::Value> params;
+    params.reserve(txs.size());
+    for(const auto& tx : txs) {
+        Json::Value param;
+        param.append(toHexString(tx));
+        //append to allow high fees
+        param.append(true);
+        params.push_back(std::move(param));
+    }
+
+    auto responses = sendbatch(command, std::move(params));
+
+    std::vector<Result<std::string, ClientError>> txids;
+    txids.reserve(responses.size());
+
+    for(auto&& response : responses) {
+        txids.push_back(
+            std::move(response)
+                .flatMap([](auto json) {
+                    return odin::processSendRawTxResponse(std::move(json));
+                }));
+    }
+
+    return txids;
+}
+
 auto ReadWriteOdinClient::generateNewAddress() const
     -> utilxx::Result<std::string, ClientError>
 {
@@ -135,35 +169,59 @@ auto ReadWriteOdinClient::generateNewAddress() const
         });
 }
 
-auto ReadWriteOdinClient::decodeTxidOfRawTx(const std::vector<std::byte>& tx) const
-    -> utilxx::Result<std::string, ClientError>
+auto ReadWriteOdinClient::generateNewAddresses(std::size_t count) const
+    -> utilxx::Result<std::vector<std::string>, ClientError>
 {
-    static const auto command = "decoderawtransaction"s;
+    static const auto command = "getnewaddress"s;
 
-    Json::Value params;
-    params.append(toHexString(tx));
+    std::vector<Json::Value> params(count, Json::Value{Json::arrayValue});
+    auto responses = sendbatch(command, std::move(params));
 
-    return sendcommand(command, std::move(params))
-        .flatMap([](auto json) {
-            return odin::processDecodeTxidOfRawTxResponse(std::move(json));
-        });
+    std::vector<std::string> addresses;
+    addresses.reserve(responses.size());
+
+    for(auto&& response : responses) {
+        auto address_res =
+            std::move(response)
+                .flatMap([](auto json) {
+                    return odin::processGenerateNewAddressResponse(std::move(json));
+                });
+        if(!address_res) {
+            return address_res.getError();
+        }
+
+        addresses.push_back(std::move(address_res.getValue()));
+    }
+
+    return addresses;
+}
+
+auto ReadWriteOdinClient::decodeTxidOfRawTx(const std::vector<std::byte>& tx) const
+    -> utilxx::Result<std::string, ClientError>
+{
+    return odin::computeTxid(tx);
 }
 
 auto ReadWriteOdinClient::burnAmount(std::int64_t amount,
                                      std::vector<std::byte> metadata) const
     -> utilxx::Result<std::string, ClientError>
 {
-    auto fees = getDefaultTxFee(getCoin());
-    return getUnspent()
-        .flatMap([&](auto unspents)
+    auto fee_rate_res = getFeeRate();
+    if(!fee_rate_res) {
+        return fee_rate_res.getError();
+    }
+
+    //the fee of a transaction with a change output,
+    //burning the whole input only pays a bit more
+    auto fees = computeBurnFee(fee_rate_res.getValue(),
+                               metadata.size(),
+                               1);
+    return lockUnspent(amount + fees,
+                       getMinimumTxAmount(getCoin()),
+                       std::nullopt)
+        .flatMap([&](auto unspent_opt)
                      -> utilxx::Result<std::string, ClientError> {
-            auto iter =
-                std::find_if(std::cbegin(unspents),
-                             std::cend(unspents),
-                             [amount, fees](const auto& elem) {
-                                 return elem.getValue() >= amount + fees;
-                             });
-            if(iter == std::cend(unspents)) {
+            if(!unspent_opt) {
                 return ClientError{"no input available to burn a value of "
                                    + std::to_string(amount)
                                    + " coins + "
@@ -171,30 +229,38 @@ auto ReadWriteOdinClient::burnAmount(std::int64_t amount,
                                    + " in fees"};
             }
 
-            auto vout = iter->getVoutIdx();
-            auto txid = std::move(iter->getTxid());
-            auto value = iter->getValue();
+            auto unspent = std::move(unspent_opt.getValue());
+            auto vout = unspent.getVoutIdx();
+            auto txid = unspent.getTxid();
+            auto value = unspent.getValue();
             auto value_back = value - (fees + amount);
 
             //if the fees + burn value eat the whole input,
             //dont use a change address
             if(value_back == 0) {
-                return writeTxToBlockchain(std::move(txid),
-                                           vout,
-                                           std::move(metadata),
-                                           amount,
-                                           {});
-            }
-
-            //if not, generate an new address and use it as output
-            return generateNewAddress()
-                .flatMap([&](auto exchange_adrs) {
-                    return writeTxToBlockchain(std::move(txid),
+                auto res = writeTxToBlockchain(std::move(txid),
                                                vout,
                                                std::move(metadata),
                                                amount,
-                                               {{std::move(exchange_adrs), value_back}});
-                });
+                                               {});
+                unlockUnspent(unspent, true);
+                return res;
+            }
+
+            //if not, generate an new address and use it as output
+            auto address_res = generateNewAddress();
+            if(!address_res) {
+                unlockUnspent(unspent, false);
+                return address_res.getError();
+            }
+
+            auto res = writeTxToBlockchain(std::move(txid),
+                                           vout,
+                                           std::move(metadata),
+                                           amount,
+                                           {{std::move(address_res.getValue()), value_back}});
+            unlockUnspent(unspent, true);
+            return res;
         });
 }
 
@@ -205,10 +271,17 @@ auto ReadWriteOdinClient::burnAmount(std::string txid,
                                      std::string change_address) const
     -> utilxx::Result<std::string, ClientError>
 {
+    auto fee_rate_res = getFeeRate();
+    if(!fee_rate_res) {
+        return fee_rate_res.getError();
+    }
+
     return getOutputValue(txid, index)
         .flatMap([&](auto output_value)
                      -> Result<std::string, ClientError> {
-            auto fee = getDefaultTxFee(getCoin());
+            auto fee = computeBurnFee(fee_rate_res.getValue(),
+                                      metadata.size(),
+                                      1);
             //if the output value is less than the requested amount + fee return an error
             if(output_value < amount + fee) {
                 auto error = fmt::format("output value of txid: {} and vout: {} is less than requested {}",
@@ -219,11 +292,13 @@ auto ReadWriteOdinClient::burnAmount(std::string txid,
             }
 
             //if the output value is the same as the requested + fee
-            //just burn the whole output and we dont need the change address
+            //just burn the requested amount and we dont need the change address
             if(output_value == amount + fee) {
-                return burnOutput(std::move(txid),
-                                  index,
-                                  std::move(metadata));
+                return writeTxToBlockchain(std::move(txid),
+                                           index,
+                                           std::move(metadata),
+                                           amount,
+                                           {});
             }
 
             return writeTxToBlockchain(std::move(txid),
@@ -239,9 +314,16 @@ auto ReadWriteOdinClient::burnOutput(std::string txid,
                                      std::vector<std::byte> metadata) const
     -> utilxx::Result<std::string, ClientError>
 {
+    auto fee_rate_res = getFeeRate();
+    if(!fee_rate_res) {
+        return fee_rate_res.getError();
+    }
+
     return getOutputValue(txid, index)
         .flatMap([&](auto output_value) {
-            auto fee = getDefaultTxFee(getCoin());
+            auto fee = computeBurnFee(fee_rate_res.getValue(),
+                                      metadata.size(),
+                                      0);
             return writeTxToBlockchain(std::move(txid),
                                        index,
                                        std::move(metadata),
@@ -250,6 +332,172 @@ auto ReadWriteOdinClient::burnOutput(std::string txid,
         });
 }
 
+auto ReadWriteOdinClient::lockUnspent(std::int64_t amount,
+                                      std::int64_t min_change,
+                                      const utilxx::Opt<std::string>& address) const
+    -> utilxx::Result<utilxx::Opt<core::Unspent>,
+                      ClientError>
+{
+    if(auto res = refreshUnspentSet();
+       !res) {
+        return res.getError();
+    }
+
+    auto output_opt = unspent_set_->lock(amount,
+                                         min_change,
+                                         address);
+    if(!output_opt) {
+        return output_opt;
+    }
+
+    if(auto res = lockInDaemon(output_opt.getValue(), true);
+       !res) {
+        unspent_set_->unlock(output_opt.getValue(), false);
+        return res.getError();
+    }
+
+    return output_opt;
+}
+
+auto ReadWriteOdinClient::unlockUnspent(const core::Unspent& output,
+                                        bool spent) const
+    -> void
+{
+    //a spent output is unlocked as well, in case sending it failed
+    //after all. the daemon may refuse this for outputs which are spent
+    if(auto res = lockInDaemon(output, false);
+       !res && !spent) {
+        LOG(WARNING) << "unable to unlock output " << output.getTxid()
+                     << ":" << output.getVoutIdx() << " in the daemon";
+    }
+
+    unspent_set_->unlock(output, spent);
+}
+
+auto ReadWriteOdinClient::lockInDaemon(const core::Unspent& output,
+                                       bool lock) const
+    -> utilxx::Result<void, ClientError>
+{
+    static const auto command = "lockunspent"s;
+
+    Json::Value outpoint;
+    outpoint["txid"] = output.getTxid();
+    outpoint["vout"] = static_cast<Json::Int64>(output.getVoutIdx());
+
+    Json::Value outpoints{Json::arrayValue};
+    outpoints.append(std::move(outpoint));
+
+    Json::Value params;
+    //the first parameter is unlock
+    params.append(!lock);
+    params.append(std::move(outpoints));
+
+    return sendcommand(command, std::move(params))
+        .flatMap([&](auto json)
+                     -> Result<void, ClientError> {
+            if(json.isBool() && json.asBool()) {
+                return {};
+            }
+
+            auto error = fmt::format("unable to {} output {}:{}",
+                                     lock ? "lock" : "unlock",
+                                     output.getTxid(),
+                                     output.getVoutIdx());
+            return ClientError{std::move(error)};
+        });
+}
+
+auto ReadWriteOdinClient::getFeeRate() const
+    -> utilxx::Result<std::int64_t, ClientError>
+{
+    static const auto command = "estimatefee"s;
+
+    if(fee_rate_) {
+        return fee_rate_.getValue();
+    }
+
+    auto height_res = getBlockCount();
+    if(!height_res) {
+        return height_res.getError();
+    }
+
+    auto height = height_res.getValue();
+    if(auto cached_opt = fee_rate_cache_->get(height);
+       cached_opt) {
+        return cached_opt.getValue();
+    }
+
+    Json::Value params;
+    params.append(FEE_ESTIMATION_BLOCKS);
+
+    return sendcommand(command, std::move(params))
+        .flatMap([](auto json) {
+            return odin::processEstimateFeeResponse(std::move(json));
+        })
+        .map([&](auto estimate_opt) {
+            auto fee_rate = std::max(estimate_opt.valueOr(getDefaultFeeRate(getCoin())),
+                                     getMinimumFeeRate(getCoin()));
+            fee_rate_cache_->set(fee_rate, height);
+            return fee_rate;
+        });
+}
+
+auto ReadWriteOdinClient::computeBurnFee(std::int64_t fee_rate,
+                                         std::size_t metadata_size,
+                                         std::size_t number_of_outputs) const
+    -> std::int64_t
+{
+    auto size = odin::estimateSignedTxSize(metadata_size,
+                                           number_of_outputs);
+    return odin::computeTxFee(size, fee_rate);
+}
+
+auto ReadWriteOdinClient::refreshUnspentSet() const
+    -> utilxx::Result<void, ClientError>
+{
+    auto height_res = getBlockCount();
+    if(!height_res) {
+        return height_res.getError();
+    }
+
+    auto height = height_res.getValue();
+    auto last_opt = unspent_set_->getHeight();
+    auto reset_opt = unspent_set_->getResetHeight();
+
+    //list everything on the first write, after a reorg and from time to time,
+    //so that outputs spent outside of forge are dropped
+    if(!last_opt
+       || !reset_opt
+       || height < last_opt.getValue()
+       || height - reset_opt.getValue() >= UNSPENT_SET_RESYNC_INTERVAL) {
+        auto unspent_res = getUnspent();
+        if(!unspent_res) {
+            return unspent_res.getError();
+        }
+
+        unspent_set_->reset(std::move(unspent_res.getValue()),
+                            height);
+        return {};
+    }
+
+    auto new_blocks = height - last_opt.getValue();
+    if(new_blocks == 0) {
+        return {};
+    }
+
+    //outputs which reached the maturity since the last refresh
+    auto maturity = getMaturity(getCoin());
+    auto unspent_res = listUnspent(maturity,
+                                   maturity + new_blocks - 1);
+    if(!unspent_res) {
+        return unspent_res.getError();
+    }
+
+    unspent_set_->add(std::move(unspent_res.getValue()),
+                      height);
+    return {};
+}
+
 namespace {
 
 std::string roundDouble(double num)
@@ -282,6 +530,40 @@ auto ReadWriteOdinClient::sendToAddress(std::int64_t amount,
         });
 }
 
+auto ReadWriteOdinClient::sendToAddresses(std::vector<
+                                          std::pair<std::string,
+                                                    std::int64_t>> amounts) const
+    -> utilxx::Result<std::string, ClientError>
+{
+    static const auto command = "sendmany"s;
+
+    Json::Value json_amounts{Json::objectValue};
+    for(auto&& [address, amount] : amounts) {
+        auto coins = static_cast<double>(amount) / 100000000.;
+        json_amounts[address] = roundDouble(coins);
+    }
+
+    Json::Value params;
+    //default account
+    params.append("");
+    params.append(std::move(json_amounts));
+
+    return sendcommand(command, std::move(params))
+        .flatMap([](auto json)
+                     -> Result<std::string, ClientError> {
+            if(json.isString()) {
+                return json.asString();
+            }
+
+            return ClientError{json.toStyledString()};
+        });
+}
+
+auto ReadWriteOdinClient::getTransaction(std::string txid) const
+    -> utilxx::Result<core::Transaction, ClientError>
+{
+    return ReadOnlyOdinClient::getTransaction(std::move(txid));
+}
 
 auto ReadWriteOdinClient::getVOutIdxByAmountAndAddress(std::string txid,
                                                        std::int64_t amount,
@@ -304,33 +586,6 @@ auto ReadWriteOdinClient::getVOutIdxByAmountAndAddress(std::string txid,
 }
 
 
-auto forge::client::odin::processGenerateRawTxResponse(Json::Value&& response)
-    -> utilxx::Result<std::vector<std::byte>,
-                      ClientError>
-{
-    auto result = response.toStyledString();
-
-    auto number_of_delimiters =
-        std::count(std::begin(result),
-                   std::end(result),
-                   '"');
-
-    if(number_of_delimiters < 2) {
-        return ClientError{"The result of \"createrawtransaction\" was way to short"};
-    }
-
-    auto first = result.find('"') + 1;
-    auto last = result.find_last_of('"');
-    result = result.substr(first, last - first);
-
-    if(auto byte_vec_opt = stringToByteVec(result);
-       byte_vec_opt) {
-        return byte_vec_opt.getValue();
-    } else {
-        return ClientError{std::move(result)};
-    }
-}
-
 auto forge::client::odin::processSignRawTxResponse(Json::Value&& response)
     -> utilxx::Result<std::vector<std::byte>,
                       ClientError>
@@ -366,6 +621,16 @@ auto forge::client::odin::processSignRawTxResponse(Json::Value&& response)
     return hex_vec.getValue();
 }
 
+auto forge::client::odin::processSendRawTxResponse(Json::Value&& response)
+    -> utilxx::Result<std::string, ClientError>
+{
+    if(!response.isString()) {
+        return ClientError{response.toStyledString()};
+    }
+
+    return response.asString();
+}
+
 auto forge::client::odin::processGenerateNewAddressResponse(Json::Value&& response)
     -> utilxx::Result<std::string, ClientError>
 {
@@ -376,17 +641,22 @@ auto forge::client::odin::processGenerateNewAddressResponse(Json::Value&& respon
     return response.asString();
 }
 
-auto forge::client::odin::processDecodeTxidOfRawTxResponse(Json::Value&& response)
-    -> utilxx::Result<std::string, ClientError>
+auto forge::client::odin::processEstimateFeeResponse(Json::Value&& response)
+    -> utilxx::Result<utilxx::Opt<std::int64_t>,
+                      ClientError>
 {
-    if(!response.isMember("txid")
-       || !response["txid"].isString()) {
-        auto error = fmt::format("unable to find txid in decoded raw transaction {}",
-                                 response.toStyledString());
-        return ClientError{std::move(error)};
+    if(!response.isNumeric()) {
+        return ClientError{"unknown error while estimating the fee rate"};
+    }
+
+    //the daemon answers with -1 if it has not seen enough blocks,
+    //the rate is in coins per 1000 bytes
+    auto coins = response.asDouble();
+    if(coins <= 0) {
+        return utilxx::Opt<std::int64_t>{};
     }
 
-    return response["txid"].asString();
+    return utilxx::Opt<std::int64_t>{std::llround(coins * 100000000.)};
 }
 
 auto forge::client::odin::processSendToAddressResponse(Json::Value&& response,
@@ -0,0 +1,112 @@
+#include <algorithm>
+#include <array>
+#include <core/Base58.hpp>
+#include <core/ByteSpan.hpp>
+#include <core/Sha256.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+#include <utilxx/Opt.hpp>
+#include <vector>
+
+using forge::core::ByteSpan;
+using forge::core::BASE58_CHECKSUM_SIZE;
+using utilxx::Opt;
+
+namespace {
+
+constexpr inline std::int8_t INVALID_DIGIT = -1;
+
+//value of every base58 character, INVALID_DIGIT for all others
+constexpr auto makeDecodeTable()
+    -> std::array<std::int8_t, 256>
+{
+    constexpr char alphabet[] =
+        "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+    std::array<std::int8_t, 256> table{};
+
+    for(auto& value : table) {
+        value = INVALID_DIGIT;
+    }
+    for(std::int8_t i = 0; i < 58; i++) {
+        table[static_cast<unsigned char>(alphabet[i])] = i;
+    }
+
+    return table;
+}
+
+constexpr inline auto DECODE_TABLE = makeDecodeTable();
+
+} // namespace
+
+
+auto forge::core::decodeBase58(std::string_view str)
+    -> Opt<std::vector<std::byte>>
+{
+    //every leading '1' is a leading zero byte
+    auto leading_zeros = std::distance(std::cbegin(str),
+                                       std::find_if(std::cbegin(str),
+                                                    std::cend(str),
+                                                    [](auto c) {
+                                                        return c != '1';
+                                                    }));
+
+    //big endian base256 number, log(58) / log(256) ~ 0.733
+    std::vector<std::uint8_t> number(str.size() * 733 / 1000 + 1, 0);
+
+    for(auto c : str.substr(leading_zeros)) {
+        auto digit = DECODE_TABLE[static_cast<unsigned char>(c)];
+        if(digit == INVALID_DIGIT) {
+            return std::nullopt;
+        }
+
+        std::uint32_t carry = digit;
+        for(auto iter = std::rbegin(number); iter != std::rend(number); ++iter) {
+            carry += static_cast<std::uint32_t>(*iter) * 58;
+            *iter = static_cast<std::uint8_t>(carry);
+            carry >>= 8;
+        }
+    }
+
+    auto first_non_zero = std::find_if(std::cbegin(number),
+                                       std::cend(number),
+                                       [](auto byte) {
+                                           return byte != 0;
+                                       });
+
+    std::vector<std::byte> result(leading_zeros, std::byte{0});
+    result.reserve(leading_zeros + std::distance(first_non_zero, std::cend(number)));
+    std::transform(first_non_zero,
+                   std::cend(number),
+                   std::back_inserter(result),
+                   [](auto byte) {
+                       return static_cast<std::byte>(byte);
+                   });
+
+    return result;
+}
+
+auto forge::core::decodeBase58Check(std::string_view str)
+    -> Opt<std::vector<std::byte>>
+{
+    return decodeBase58(str)
+        .flatMap([](auto decoded)
+                     -> Opt<std::vector<std::byte>> {
+            if(decoded.size() < BASE58_CHECKSUM_SIZE) {
+                return std::nullopt;
+            }
+
+            auto payload_size = decoded.size() - BASE58_CHECKSUM_SIZE;
+            auto checksum = doubleSha256(ByteSpan{decoded.data(), payload_size});
+
+            if(!std::equal(std::cbegin(decoded) + payload_size,
+                           std::cend(decoded),
+                           std::cbegin(checksum))) {
+                return std::nullopt;
+            }
+
+            decoded.resize(payload_size);
+            return decoded;
+        });
+}
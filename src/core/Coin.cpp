@@ -1,6 +1,8 @@
 #include <core/Coin.hpp>
+#include <cstddef>
 #include <cstdint>
 #include <g3log/g3log.hpp>
+#include <limits>
 
 using forge::core::Coin;
 
@@ -60,13 +62,26 @@ auto forge::core::getBlockTimeInSeconds(Coin c)
     }
 }
 
-auto forge::core::getDefaultTxFee(Coin c)
+auto forge::core::getDefaultFeeRate(Coin c)
     -> std::int64_t
 {
     switch(c) {
     case Coin::Odin:
     case Coin::tOdin:
-        return 50000;
+        return 100000;
+    default:
+        LOG(FATAL) << "entered default case which should never happen";
+        return 0;
+    }
+}
+
+auto forge::core::getMinimumFeeRate(Coin c)
+    -> std::int64_t
+{
+    switch(c) {
+    case Coin::Odin:
+    case Coin::tOdin:
+        return 10000;
     default:
         LOG(FATAL) << "entered default case which should never happen";
         return 0;
@@ -87,6 +102,20 @@ auto forge::core::getValidityLength(Coin c)
     }
 }
 
+auto forge::core::getCreationBurnComparisonHeight(Coin c)
+    -> std::int64_t
+{
+    switch(c) {
+    case Coin::Odin:
+    case Coin::tOdin:
+        //not scheduled yet
+        return std::numeric_limits<std::int64_t>::max();
+    default:
+        LOG(FATAL) << "entered default case which should never happen";
+        return 0;
+    }
+}
+
 
 auto forge::core::getMinimumTxAmount(Coin c)
     -> std::int64_t
@@ -100,3 +129,17 @@ auto forge::core::getMinimumTxAmount(Coin c)
         return 0;
     }
 }
+
+auto forge::core::getPubkeyAddressPrefix(Coin c)
+    -> std::byte
+{
+    switch(c) {
+    case Coin::Odin:
+        return std::byte{115}; //'o'
+    case Coin::tOdin:
+        return std::byte{111};
+    default:
+        LOG(FATAL) << "entered default case which should never happen";
+        return std::byte{0};
+    }
+}
@@ -0,0 +1,148 @@
+#include <array>
+#include <core/Hex.hpp>
+#include <cstdint>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+constexpr inline std::uint8_t INVALID_NIBBLE = 0xFF;
+
+//both characters of every byte value, so encoding needs
+//one lookup per byte
+constexpr auto makeEncodeTable()
+    -> std::array<char, 512>
+{
+    constexpr char digits[] = "0123456789abcdef";
+    std::array<char, 512> table{};
+
+    for(std::size_t i = 0; i < 256; i++) {
+        table[i * 2] = digits[i >> 4];
+        table[i * 2 + 1] = digits[i & 0x0F];
+    }
+
+    return table;
+}
+
+//value of every hex character, INVALID_NIBBLE for all others
+constexpr auto makeDecodeTable()
+    -> std::array<std::uint8_t, 256>
+{
+    std::array<std::uint8_t, 256> table{};
+
+    for(auto& value : table) {
+        value = INVALID_NIBBLE;
+    }
+    for(std::uint8_t i = 0; i < 10; i++) {
+        table['0' + i] = i;
+    }
+    for(std::uint8_t i = 0; i < 6; i++) {
+        table['a' + i] = 10 + i;
+        table['A' + i] = 10 + i;
+    }
+
+    return table;
+}
+
+constexpr inline auto ENCODE_TABLE = makeEncodeTable();
+constexpr inline auto DECODE_TABLE = makeDecodeTable();
+
+#if defined(__SSE2__)
+
+//encodes 16 bytes at once into 32 characters
+constexpr inline std::size_t SIMD_BLOCK_SIZE = 16;
+
+auto nibblesToAscii(__m128i nibbles)
+    -> __m128i
+{
+    const auto ascii_zero = _mm_set1_epi8('0');
+    const auto nine = _mm_set1_epi8(9);
+    const auto letter_offset = _mm_set1_epi8('a' - '0' - 10);
+
+    auto is_letter = _mm_cmpgt_epi8(nibbles, nine);
+    return _mm_add_epi8(_mm_add_epi8(nibbles, ascii_zero),
+                        _mm_and_si128(is_letter, letter_offset));
+}
+
+auto encodeHexBlocks(const std::byte* bytes,
+                     std::size_t blocks,
+                     char* out)
+    -> void
+{
+    const auto low_mask = _mm_set1_epi8(0x0F);
+
+    for(std::size_t i = 0; i < blocks; i++) {
+        auto input = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(bytes + i * SIMD_BLOCK_SIZE));
+
+        auto high = _mm_and_si128(_mm_srli_epi16(input, 4), low_mask);
+        auto low = _mm_and_si128(input, low_mask);
+
+        //interleave, the high nibble is written first
+        auto first = nibblesToAscii(_mm_unpacklo_epi8(high, low));
+        auto second = nibblesToAscii(_mm_unpackhi_epi8(high, low));
+
+        auto* dest = out + forge::core::hexEncodedSize(i * SIMD_BLOCK_SIZE);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest), first);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + SIMD_BLOCK_SIZE), second);
+    }
+}
+
+#endif
+
+} // namespace
+
+
+auto forge::core::encodeHex(const std::byte* bytes,
+                            std::size_t size,
+                            char* out)
+    -> void
+{
+    std::size_t i = 0;
+
+#if defined(__SSE2__)
+    auto blocks = size / SIMD_BLOCK_SIZE;
+    encodeHexBlocks(bytes, blocks, out);
+    i = blocks * SIMD_BLOCK_SIZE;
+#endif
+
+    for(; i < size; i++) {
+        auto index = static_cast<std::size_t>(bytes[i]) * 2;
+        out[i * 2] = ENCODE_TABLE[index];
+        out[i * 2 + 1] = ENCODE_TABLE[index + 1];
+    }
+}
+
+auto forge::core::decodeHex(std::string_view hex,
+                            std::byte* out)
+    -> bool
+{
+    if(hex.size() % 2 != 0) {
+        return false;
+    }
+
+    //collect invalid characters instead of branching on every byte
+    std::uint8_t invalid{0};
+
+    for(std::size_t i = 0; i < hex.size() / 2; i++) {
+        auto high = DECODE_TABLE[static_cast<unsigned char>(hex[i * 2])];
+        auto low = DECODE_TABLE[static_cast<unsigned char>(hex[i * 2 + 1])];
+
+        invalid |= high | low;
+        out[i] = static_cast<std::byte>((high << 4) | low);
+    }
+
+    //valid nibbles never have the upper bits set
+    return (invalid & 0xF0) == 0;
+}
+
+auto forge::core::appendHex(const std::vector<std::byte>& bytes,
+                            std::string& out)
+    -> void
+{
+    auto offset = out.size();
+    out.resize(offset + hexEncodedSize(bytes.size()));
+    encodeHex(bytes.data(), bytes.size(), &out[offset]);
+}
@@ -0,0 +1,140 @@
+#include <algorithm>
+#include <array>
+#include <core/ByteSpan.hpp>
+#include <core/Sha256.hpp>
+#include <cstddef>
+#include <cstdint>
+
+using forge::core::ByteSpan;
+using forge::core::Sha256Digest;
+
+namespace {
+
+constexpr inline std::size_t BLOCK_SIZE = 64;
+
+constexpr inline std::array<std::uint32_t, 64> ROUND_CONSTANTS = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+constexpr inline std::array<std::uint32_t, 8> INITIAL_STATE = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+constexpr auto rotateRight(std::uint32_t value,
+                           unsigned bits)
+    -> std::uint32_t
+{
+    return (value >> bits) | (value << (32 - bits));
+}
+
+auto processBlock(std::array<std::uint32_t, 8>& state,
+                  const std::byte* block)
+    -> void
+{
+    std::array<std::uint32_t, 64> schedule;
+
+    for(std::size_t i = 0; i < 16; i++) {
+        schedule[i] = static_cast<std::uint32_t>(block[i * 4]) << 24
+            | static_cast<std::uint32_t>(block[i * 4 + 1]) << 16
+            | static_cast<std::uint32_t>(block[i * 4 + 2]) << 8
+            | static_cast<std::uint32_t>(block[i * 4 + 3]);
+    }
+
+    for(std::size_t i = 16; i < 64; i++) {
+        auto s0 = rotateRight(schedule[i - 15], 7)
+            ^ rotateRight(schedule[i - 15], 18)
+            ^ (schedule[i - 15] >> 3);
+        auto s1 = rotateRight(schedule[i - 2], 17)
+            ^ rotateRight(schedule[i - 2], 19)
+            ^ (schedule[i - 2] >> 10);
+        schedule[i] = schedule[i - 16] + s0 + schedule[i - 7] + s1;
+    }
+
+    auto [a, b, c, d, e, f, g, h] = state;
+
+    for(std::size_t i = 0; i < 64; i++) {
+        auto s1 = rotateRight(e, 6) ^ rotateRight(e, 11) ^ rotateRight(e, 25);
+        auto choice = (e & f) ^ (~e & g);
+        auto temp1 = h + s1 + choice + ROUND_CONSTANTS[i] + schedule[i];
+        auto s0 = rotateRight(a, 2) ^ rotateRight(a, 13) ^ rotateRight(a, 22);
+        auto majority = (a & b) ^ (a & c) ^ (b & c);
+        auto temp2 = s0 + majority;
+
+        h = g;
+        g = f;
+        f = e;
+        e = d + temp1;
+        d = c;
+        c = b;
+        b = a;
+        a = temp1 + temp2;
+    }
+
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+}
+
+} // namespace
+
+
+auto forge::core::sha256(ByteSpan data)
+    -> Sha256Digest
+{
+    auto state = INITIAL_STATE;
+
+    auto full_blocks = data.size() / BLOCK_SIZE;
+    for(std::size_t i = 0; i < full_blocks; i++) {
+        processBlock(state, data.data() + i * BLOCK_SIZE);
+    }
+
+    //the remaining bytes, a single 1 bit and the length in bits
+    //as big endian 64 bit integer, padded to one or two blocks
+    std::array<std::byte, BLOCK_SIZE * 2> tail{};
+    auto remaining = data.size() - full_blocks * BLOCK_SIZE;
+    std::copy(data.begin() + full_blocks * BLOCK_SIZE,
+              data.end(),
+              tail.begin());
+    tail[remaining] = std::byte{0x80};
+
+    auto tail_size = remaining + 1 + 8 <= BLOCK_SIZE
+        ? BLOCK_SIZE
+        : BLOCK_SIZE * 2;
+
+    auto bit_length = static_cast<std::uint64_t>(data.size()) * 8;
+    for(std::size_t i = 0; i < 8; i++) {
+        tail[tail_size - 1 - i] = static_cast<std::byte>(bit_length >> (i * 8));
+    }
+
+    for(std::size_t offset = 0; offset < tail_size; offset += BLOCK_SIZE) {
+        processBlock(state, tail.data() + offset);
+    }
+
+    Sha256Digest digest;
+    for(std::size_t i = 0; i < state.size(); i++) {
+        digest[i * 4] = static_cast<std::byte>(state[i] >> 24);
+        digest[i * 4 + 1] = static_cast<std::byte>(state[i] >> 16);
+        digest[i * 4 + 2] = static_cast<std::byte>(state[i] >> 8);
+        digest[i * 4 + 3] = static_cast<std::byte>(state[i]);
+    }
+
+    return digest;
+}
+
+auto forge::core::doubleSha256(ByteSpan data)
+    -> Sha256Digest
+{
+    auto first = sha256(data);
+    return sha256(ByteSpan{first.data(), first.size()});
+}
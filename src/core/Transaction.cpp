@@ -1,12 +1,12 @@
 #include <array>
 #include <core/FlagIndexes.hpp>
+#include <core/Hex.hpp>
 #include <core/Transaction.hpp>
 #include <cstddef>
 #include <client/ReadOnlyClientBase.hpp>
 #include <fmt/core.h>
-#include <iomanip>
 #include <json/value.h>
-#include <sstream>
+#include <string_view>
 #include <utility>
 #include <utilxx/Opt.hpp>
 #include <vector>
@@ -408,7 +408,7 @@ auto forge::core::buildTransaction(Json::Value&& json)
     }
 }
 
-auto forge::core::extractMetadata(std::string&& hex)
+auto forge::core::extractMetadata(std::string_view hex)
     -> utilxx::Opt<std::vector<std::byte>>
 {
     if(hex.size() < 4) {
@@ -420,14 +420,14 @@ auto forge::core::extractMetadata(std::string&& hex)
         return std::nullopt;
     }
 
-    //remove the op return Opcode
+    //skip the op return Opcode
     //and the next byte
-    hex.erase(0, 4);
+    hex.remove_prefix(4);
 
     return stringToByteVec(hex);
 }
 
-auto forge::core::stringToByteVec(const std::string& str)
+auto forge::core::stringToByteVec(std::string_view str)
     -> utilxx::Opt<std::vector<std::byte>>
 {
     //check if the string has even characters
@@ -435,25 +435,13 @@ auto forge::core::stringToByteVec(const std::string& str)
         return std::nullopt;
     }
 
-    //check if all characters are [0-1a-fA-F]
-    auto is_hex = std::all_of(std::begin(str),
-                              std::end(str),
-                              [](auto c) {
-                                  return std::isxdigit(c);
-                              });
+    std::vector<std::byte> data(str.length() / 2);
 
-    if(!is_hex) {
+    //fails if not all characters are [0-9a-fA-F]
+    if(!decodeHex(str, data.data())) {
         return std::nullopt;
     }
 
-    std::vector<std::byte> data;
-
-    for(size_t i = 0; i < str.length(); i += 2) {
-        auto byte_string = str.substr(i, 2);
-        auto byte = static_cast<std::byte>(std::strtol(byte_string.c_str(), nullptr, 16));
-        data.push_back(byte);
-    }
-
     return data;
 }
 
@@ -471,12 +459,9 @@ auto forge::core::metadataStartsWithForgeId(const std::vector<std::byte>& metada
 auto forge::core::toHexString(const std::vector<std::byte>& bytes)
     -> std::string
 {
-    std::stringstream ss;
-    ss << std::hex;
-    for(auto&& b : bytes) {
-        ss << std::setw(2) << std::setfill('0') << static_cast<int>(b);
-    }
-    return ss.str();
+    std::string hex;
+    appendHex(bytes, hex);
+    return hex;
 }
 
 
@@ -1,3 +1,4 @@
+#include <cstdint>
 #include <entrys/EntryCreationOp.hpp>
 #include <entrys/token/UtilityTokenCreationOp.hpp>
 #include <entrys/uentry/UniqueEntryCreationOp.hpp>
@@ -22,3 +23,40 @@ auto forge::core::getBurnValue(const EntryCreationOp& op)
             }},
         op);
 }
+
+auto forge::core::getBurnAmount(const EntryCreationOp& op)
+    -> std::int64_t
+{
+    return std::visit(
+        utilxx::overload{
+            [](const core::UtilityTokenCreationOp& creation) {
+                return creation.getBurnValue();
+            },
+            [](const core::UniqueEntryCreationOp& creation) {
+                return creation.getValue();
+            },
+            [](const core::UMEntryCreationOp& creation) {
+                return creation.getValue();
+            }},
+        op);
+}
+
+auto forge::core::getEntryKey(const EntryCreationOp& op)
+    -> const EntryKey&
+{
+    return std::visit(
+        utilxx::overload{
+            [](const core::UtilityTokenCreationOp& creation)
+                -> const EntryKey& {
+                return creation.getUtilityToken().getId();
+            },
+            [](const core::UniqueEntryCreationOp& creation)
+                -> const EntryKey& {
+                return creation.getEntryKey();
+            },
+            [](const core::UMEntryCreationOp& creation)
+                -> const EntryKey& {
+                return creation.getEntryKey();
+            }},
+        op);
+}
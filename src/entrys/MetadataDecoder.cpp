@@ -0,0 +1,158 @@
+#include <algorithm>
+#include <array>
+#include <core/ByteSpan.hpp>
+#include <core/FlagIndexes.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <entrys/MetadataDecoder.hpp>
+#include <entrys/umentry/UMEntry.hpp>
+#include <utilxx/Opt.hpp>
+
+using forge::core::ByteSpan;
+using forge::core::DecodedEntry;
+using forge::core::DecodedToken;
+using forge::core::MetadataLayout;
+using forge::core::UMEntryValue;
+using forge::core::IPv4Value;
+using forge::core::IPv6Value;
+using forge::core::ByteArray;
+using forge::core::NoneValue;
+using forge::core::ENTRY_VALUE_FLAG_INDEX;
+using forge::core::TOKEN_TYPE_INDEX;
+using forge::core::UTILITY_TOKEN_AMOUNT_INDEX;
+using forge::core::UTILITY_TOKEN_ID_START_INDEX;
+using utilxx::Opt;
+
+namespace {
+
+enum class ValueKind : std::uint8_t {
+    Invalid = 0,
+    IPv4,
+    IPv6,
+    None,
+    ByteArray
+};
+
+//byte arrays store their length in the byte following
+//the value flag, all other values have a fixed size
+struct ValueLayout
+{
+    ValueKind kind;
+    std::size_t size;
+    bool length_prefixed;
+};
+
+constexpr auto makeValueTable()
+    -> std::array<ValueLayout, 256>
+{
+    std::array<ValueLayout, 256> table{};
+
+    table[static_cast<std::size_t>(forge::core::IPv4_VALUE_FLAG)] =
+        ValueLayout{ValueKind::IPv4, std::tuple_size_v<IPv4Value>, false};
+    table[static_cast<std::size_t>(forge::core::IPv6_VALUE_FLAG)] =
+        ValueLayout{ValueKind::IPv6, std::tuple_size_v<IPv6Value>, false};
+    table[static_cast<std::size_t>(forge::core::NONE_VALUE_FLAG)] =
+        ValueLayout{ValueKind::None, 0, false};
+    table[static_cast<std::size_t>(forge::core::BYTE_ARRAY_VALUE_FLAG)] =
+        ValueLayout{ValueKind::ByteArray, 0, true};
+
+    return table;
+}
+
+constexpr inline auto VALUE_TABLE = makeValueTable();
+
+template<class Array>
+auto copyValue(ByteSpan metadata,
+               std::size_t start)
+    -> Array
+{
+    Array value;
+    std::copy_n(metadata.begin() + start,
+                value.size(),
+                value.begin());
+    return value;
+}
+
+} // namespace
+
+
+auto forge::core::decodeEntryValue(ByteSpan metadata)
+    -> Opt<DecodedEntry>
+{
+    //every value is followed by at least one byte,
+    //either the length of a byte array or the key
+    if(metadata.size() < ENTRY_VALUE_FLAG_INDEX + 2) {
+        return std::nullopt;
+    }
+
+    auto flag = metadata[ENTRY_VALUE_FLAG_INDEX];
+    const auto& layout = VALUE_TABLE[static_cast<std::size_t>(flag)];
+
+    if(layout.kind == ValueKind::Invalid) {
+        return std::nullopt;
+    }
+
+    std::size_t value_start = ENTRY_VALUE_FLAG_INDEX + 1 + layout.length_prefixed;
+    auto value_size = layout.length_prefixed
+        ? static_cast<std::size_t>(metadata[ENTRY_VALUE_FLAG_INDEX + 1])
+        : layout.size;
+    auto key_start = value_start + value_size;
+
+    //the only bounds check needed, the key has to
+    //be at least one byte
+    if(key_start >= metadata.size()) {
+        return std::nullopt;
+    }
+
+    auto key = metadata.subspan(key_start);
+
+    switch(layout.kind) {
+    case ValueKind::IPv4:
+        return DecodedEntry{copyValue<IPv4Value>(metadata, value_start),
+                            key};
+    case ValueKind::IPv6:
+        return DecodedEntry{copyValue<IPv6Value>(metadata, value_start),
+                            key};
+    case ValueKind::None:
+        return DecodedEntry{NoneValue{},
+                            key};
+    case ValueKind::ByteArray:
+        return DecodedEntry{ByteArray(metadata.begin() + value_start,
+                                      metadata.begin() + key_start),
+                            key};
+    default:
+        return std::nullopt;
+    }
+}
+
+auto forge::core::decodeEntry(ByteSpan metadata,
+                              const MetadataLayout& layout)
+    -> Opt<DecodedEntry>
+{
+    if(metadata.size() < layout.min_size
+       || metadata[TOKEN_TYPE_INDEX] != layout.token_type) {
+        return std::nullopt;
+    }
+
+    return decodeEntryValue(metadata);
+}
+
+auto forge::core::decodeToken(ByteSpan metadata,
+                              const MetadataLayout& layout)
+    -> Opt<DecodedToken>
+{
+    if(metadata.size() < layout.min_size
+       || metadata[TOKEN_TYPE_INDEX] != layout.token_type) {
+        return std::nullopt;
+    }
+
+    //big endian
+    std::uint64_t amount{0};
+    for(std::size_t i = 0; i < sizeof(amount); i++) {
+        amount = (amount << 8)
+            | static_cast<std::uint64_t>(metadata[UTILITY_TOKEN_AMOUNT_INDEX + i]);
+    }
+
+    return DecodedToken{amount,
+                        metadata.subspan(UTILITY_TOKEN_ID_START_INDEX)};
+}
@@ -1,10 +1,13 @@
 
 #include <array>
+#include <core/ByteSpan.hpp>
 #include <core/FlagIndexes.hpp>
 #include <core/Transaction.hpp>
 #include <cstddef>
 #include <cstdint>
+#include <entrys/MetadataDecoder.hpp>
 #include <entrys/token/UtilityToken.hpp>
+#include <entrys/token/UtilityTokenOperation.hpp>
 #include <iterator>
 #include <json/value.h>
 #include <utilxx/Opt.hpp>
@@ -12,9 +15,7 @@
 #include <vector>
 
 using forge::core::UtilityToken;
-using forge::core::UTILITY_TOKEN_IDENTIFICATION_FLAG;
-using forge::core::UTILITY_TOKEN_ID_START_INDEX;
-using forge::core::TOKEN_TYPE_INDEX;
+using forge::core::ByteSpan;
 
 UtilityToken::UtilityToken(EntryKey id,
                            std::uint64_t attached_amount)
@@ -85,36 +86,12 @@ auto UtilityToken::operator!=(const UtilityToken& rhs) const
     return id_ != rhs.id_;
 }
 
-auto forge::core::parseUtilityToken(const std::vector<std::byte>& metadata)
+auto forge::core::parseUtilityToken(ByteSpan metadata)
     -> utilxx::Opt<UtilityToken>
 {
-    //3 bytes mask
-    //1 tokeyn type flag
-    //1 op flag
-    //8 amount
-    //at least 1 id
-    if(metadata.size() < 14) {
-        return std::nullopt;
-    }
-
-    //check that the metadata actualy refers to a mutable entry
-    if(metadata[TOKEN_TYPE_INDEX] != UTILITY_TOKEN_IDENTIFICATION_FLAG) {
-        return std::nullopt;
-    }
-
-    std::vector id(std::cbegin(metadata) + UTILITY_TOKEN_ID_START_INDEX,
-                   std::cend(metadata));
-
-    std::uint64_t amount =
-        (static_cast<std::uint64_t>(metadata[5]) << 56)
-        | (static_cast<std::uint64_t>(metadata[6]) << 48)
-        | (static_cast<std::uint64_t>(metadata[7]) << 40)
-        | (static_cast<std::uint64_t>(metadata[8]) << 32)
-        | (static_cast<std::uint64_t>(metadata[9]) << 24)
-        | (static_cast<std::uint64_t>(metadata[10]) << 16)
-        | (static_cast<std::uint64_t>(metadata[11]) << 8)
-        | (static_cast<std::uint64_t>(metadata[12]));
-
-    return UtilityToken{std::move(id),
-                        amount};
+    return decodeToken(metadata, UTILITY_TOKEN_METADATA_LAYOUT)
+        .map([](auto decoded) {
+            return UtilityToken{decoded.id.toVector(),
+                                decoded.amount};
+        });
 }
@@ -1,4 +1,5 @@
 #include <array>
+#include <core/ByteSpan.hpp>
 #include <core/FlagIndexes.hpp>
 #include <core/Transaction.hpp>
 #include <cstddef>
@@ -6,11 +7,13 @@
 #include <cstring>
 #include <client/ClientError.hpp>
 #include <client/ReadOnlyClientBase.hpp>
+#include <entrys/MetadataDecoder.hpp>
 #include <entrys/token/UtilityToken.hpp>
 #include <entrys/token/UtilityTokenCreationOp.hpp>
 #include <entrys/token/UtilityTokenDeletionOp.hpp>
 #include <entrys/token/UtilityTokenOperation.hpp>
 #include <entrys/token/UtilityTokenOwnershipTransferOp.hpp>
+#include <env/AsyncLogger.hpp>
 #include <fmt/core.h>
 #include <g3log/g3log.hpp>
 #include <json/value.h>
@@ -20,10 +23,8 @@
 #include <vector>
 
 using forge::core::UtilityToken;
-using forge::core::OPERATION_FLAG_INDEX;
-using forge::core::UTILITY_TOKEN_CREATION_FLAG;
-using forge::core::UTILITY_TOKEN_DELETION_FLAG;
-using forge::core::UTILITY_TOKEN_OWNERSHIP_TRANSFER_FLAG;
+using forge::core::ByteSpan;
+using forge::core::OperationKind;
 using forge::core::Transaction;
 using forge::core::UtilityTokenOperation;
 using forge::client::ReadOnlyClientBase;
@@ -107,7 +108,7 @@ auto forge::core::extractOperationFlag(const UtilityTokenOperation& op)
         op);
 }
 
-auto forge::core::parseTransactionToUtilityTokenOp(Transaction tx,
+auto forge::core::parseTransactionToUtilityTokenOp(const Transaction& tx,
                                                    std::int64_t block,
                                                    const ReadOnlyClientBase* client)
     -> utilxx::Result<utilxx::Opt<UtilityTokenOperation>,
@@ -126,7 +127,7 @@ auto forge::core::parseTransactionToUtilityTokenOp(Transaction tx,
         return ResultType{std::nullopt};
     }
 
-    LOG(INFO) << tx.getTxid() << " contains a OP_RETURN output";
+    FORGE_LOG(INFO, "{} contains a OP_RETURN output", tx.getTxid());
 
     //save, because we checked that the tx has exactly one
     //op return output
@@ -135,30 +136,15 @@ auto forge::core::parseTransactionToUtilityTokenOp(Transaction tx,
             .getValue()
             .get();
 
-    //get optional new owner
-    //for ownership transfer
-    auto new_owner_opt =
-        tx.getFirstNonOpReturnOutput()
-            .flatMap([](auto ref)
-                         -> utilxx::Opt<std::string> {
-                //we only care about outputs with exactly one
-                //address
-                if(ref.get().getAddresses().size() != 1) {
-                    return std::nullopt;
-                }
-                return ref.get().getAddresses()[0];
-            });
-
     //save, because we have checked that the tx has exactly
     //one input
-    auto vin = std::move(tx.getInputs()[0]);
+    const auto& vin = tx.getInputs()[0];
 
     //value of the op return output
     auto value = op_return_output.getValue();
 
     //extract the metadata from the output script
-    auto output_script = std::move(op_return_output.getHex());
-    auto metadata_opt = extractMetadata(std::move(output_script));
+    auto metadata_opt = extractMetadata(op_return_output.getHex());
 
     if(!metadata_opt) {
         return ResultType{std::nullopt};
@@ -173,9 +159,23 @@ auto forge::core::parseTransactionToUtilityTokenOp(Transaction tx,
         return ResultType{std::nullopt};
     }
 
-    LOG(DEBUG) << "resoving vin from " << vin.getTxid();
+    //get optional new owner
+    //for ownership transfer
+    auto new_owner_opt =
+        tx.getFirstNonOpReturnOutput()
+            .flatMap([](auto ref)
+                         -> utilxx::Opt<std::string> {
+                //we only care about outputs with exactly one
+                //address
+                if(ref.get().getAddresses().size() != 1) {
+                    return std::nullopt;
+                }
+                return ref.get().getAddresses()[0];
+            });
+
+    FORGE_LOG(DEBUG, "resolving vin from {}", vin.getTxid());
     return client
-        ->resolveTxIn(std::move(vin))
+        ->resolveTxIn(vin)
         .flatMap([&](auto resolvedVin) {
             //we can only have one input address
             if(resolvedVin.getAddresses().size() != 1) {
@@ -188,7 +188,7 @@ auto forge::core::parseTransactionToUtilityTokenOp(Transaction tx,
             //parse the metadata nd put it into
             //the ResultType
             return ResultType{
-                parseMetadataToUtilityTokenOp(std::move(metadata),
+                parseMetadataToUtilityTokenOp(metadata,
                                               block,
                                               std::move(owner),
                                               value,
@@ -197,25 +197,21 @@ auto forge::core::parseTransactionToUtilityTokenOp(Transaction tx,
 }
 
 
-auto forge::core::parseMetadataToUtilityTokenOp(const std::vector<std::byte>& metadata,
+auto forge::core::parseMetadataToUtilityTokenOp(ByteSpan metadata,
                                                 std::int64_t block,
                                                 std::string&& owner,
                                                 std::int64_t burn_value,
                                                 utilxx::Opt<std::string>&& new_owner_opt)
     -> utilxx::Opt<UtilityTokenOperation>
 {
-    if(metadata.size() < 14) {
-        return std::nullopt;
-    }
-
     return parseUtilityToken(metadata)
         .flatMap([&](auto entry)
                      -> utilxx::Opt<UtilityTokenOperation> {
             auto amount = entry.getAttachedAmount();
 
-            switch(metadata[OPERATION_FLAG_INDEX]) {
+            switch(decodeOperation(metadata, UTILITY_TOKEN_METADATA_LAYOUT)) {
 
-            case UTILITY_TOKEN_CREATION_FLAG:
+            case OperationKind::Creation:
                 return UtilityTokenOperation{
                     UtilityTokenCreationOp{std::move(entry),
                                            amount,
@@ -223,7 +219,7 @@ auto forge::core::parseMetadataToUtilityTokenOp(const std::vector<std::byte>& me
                                            block,
                                            burn_value}};
 
-            case UTILITY_TOKEN_OWNERSHIP_TRANSFER_FLAG:
+            case OperationKind::OwnershipTransfer:
                 return new_owner_opt
                     .map([&](auto new_owner) {
                         return UtilityTokenOperation{
@@ -234,7 +230,7 @@ auto forge::core::parseMetadataToUtilityTokenOp(const std::vector<std::byte>& me
                                                             block,
                                                             burn_value}};
                     });
-            case UTILITY_TOKEN_DELETION_FLAG:
+            case OperationKind::Deletion:
                 return UtilityTokenOperation{
                     UtilityTokenDeletionOp{std::move(entry),
                                            amount,
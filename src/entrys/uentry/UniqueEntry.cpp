@@ -1,21 +1,21 @@
+#include <core/ByteSpan.hpp>
 #include <core/FlagIndexes.hpp>
 #include <core/Transaction.hpp>
+#include <entrys/MetadataDecoder.hpp>
 #include <entrys/uentry/UniqueEntry.hpp>
+#include <entrys/uentry/UniqueEntryOperation.hpp>
 #include <entrys/umentry/UMEntry.hpp>
 #include <utilxx/Overload.hpp>
 #include <variant>
 #include <vector>
 
 using forge::core::UniqueEntry;
+using forge::core::ByteSpan;
 using forge::core::NoneValue;
 using forge::core::ByteArray;
 using forge::core::UniqueEntryValue;
 using forge::core::EntryKey;
-using forge::core::ENTRY_VALUE_FLAG_INDEX;
-using forge::core::NONE_VALUE_FLAG;
 using forge::core::BYTE_ARRAY_VALUE_FLAG;
-using forge::core::IPv4_VALUE_FLAG;
-using forge::core::IPv6_VALUE_FLAG;
 using forge::core::IPv4Value;
 using forge::core::IPv6Value;
 
@@ -26,10 +26,17 @@ UniqueEntry::UniqueEntry(EntryKey key, UniqueEntryValue value)
 auto UniqueEntry::toRawData() const
     -> std::vector<std::byte>
 {
-    auto key_data = std::move(getKey());
+    const auto& key_data = getKey();
     auto value_data = uniqueEntryValueToRawData(getValue());
     auto value_flag = extractValueFlag(getValue());
 
+    //byte arrays are prefixed with their length, values from json
+    //are limited to MAX_BYTE_ARRAY_VALUE_SIZE by jsonToUMEntryValue
+    if(value_flag == BYTE_ARRAY_VALUE_FLAG) {
+        value_data.insert(std::begin(value_data),
+                          static_cast<std::byte>(value_data.size()));
+    }
+
     value_data.insert(std::begin(value_data),
                       value_flag);
 
@@ -80,7 +87,7 @@ auto UniqueEntry::getValue()
 }
 
 
-auto forge::core::parseUniqueValue(const std::vector<std::byte>& data)
+auto forge::core::parseUniqueValue(ByteSpan data)
     -> utilxx::Opt<UniqueEntryValue>
 {
     return parseUMValue(data)
@@ -93,39 +100,23 @@ auto forge::core::parseUniqueValue(const std::vector<std::byte>& data)
         });
 }
 
-auto forge::core::parseUniqueKey(const std::vector<std::byte>& data)
+auto forge::core::parseUniqueKey(ByteSpan data)
     -> utilxx::Opt<EntryKey>
 {
     return parseUMKey(data);
 }
 
-auto forge::core::parseUniqueEntry(const std::vector<std::byte>& data)
+auto forge::core::parseUniqueEntry(ByteSpan data)
     -> utilxx::Opt<UniqueEntry>
 {
-    //3 bytes mask
-    //1 tokeyn type flag
-    //1 op flag
-    //1 value flag
-    //at least 4 value
-    //at least 1 key
-    if(data.size() < 11) {
-        return std::nullopt;
-    }
-
-    //check that the metadata actualy refers to a mutable entry
-    if(data[TOKEN_TYPE_INDEX] != UNIQUE_ENTRY_IDENTIFICATION_FLAG) {
-        return std::nullopt;
-    }
-
-    auto value_opt = parseUniqueValue(data);
-    auto key_opt = parseUniqueKey(data);
-
-
-    return combine(std::move(key_opt),
-                   std::move(value_opt))
-        .map([](auto pair) {
-            return UniqueEntry{std::move(pair.first),
-                               std::move(pair.second)};
+    return decodeEntry(data, UNIQUE_ENTRY_METADATA_LAYOUT)
+        .map([](auto decoded) {
+            return UniqueEntry{decoded.key.toVector(),
+                               std::visit(
+                                   [](auto value) {
+                                       return UniqueEntryValue{std::move(value)};
+                                   },
+                                   std::move(decoded.value))};
         });
 }
 
@@ -1,9 +1,12 @@
+#include <core/ByteSpan.hpp>
 #include <core/FlagIndexes.hpp>
 #include <core/Transaction.hpp>
 #include <cstddef>
 #include <client/ReadOnlyClientBase.hpp>
+#include <entrys/MetadataDecoder.hpp>
 #include <entrys/uentry/UniqueEntry.hpp>
 #include <entrys/uentry/UniqueEntryOperation.hpp>
+#include <env/AsyncLogger.hpp>
 #include <fmt/core.h>
 #include <g3log/g3log.hpp>
 #include <utilxx/Opt.hpp>
@@ -19,6 +22,8 @@ using forge::core::Transaction;
 using forge::client::ReadOnlyClientBase;
 using forge::client::ClientError;
 using forge::core::parseUniqueEntry;
+using forge::core::ByteSpan;
+using forge::core::OperationKind;
 using forge::core::FORGE_IDENTIFIER_MASK;
 
 auto forge::core::getEntryKey(const UniqueEntryOperation& operation)
@@ -109,37 +114,33 @@ auto forge::core::extractOperationFlag(const UniqueEntryOperation& operation)
 }
 
 
-auto forge::core::parseMetadataToUniqueEntryOp(const std::vector<std::byte>& metadata,
+auto forge::core::parseMetadataToUniqueEntryOp(ByteSpan metadata,
                                                std::int64_t block,
                                                std::string&& owner,
                                                std::int64_t value,
                                                utilxx::Opt<std::string>&& new_owner_opt)
     -> Opt<UniqueEntryOperation>
 {
-    if(metadata.size() < 10) {
-        return std::nullopt;
-    }
-
     return parseUniqueEntry(metadata)
         .flatMap([&](auto entry)
                      -> utilxx::Opt<UniqueEntryOperation> {
-            switch(metadata[OPERATION_FLAG_INDEX]) {
+            switch(decodeOperation(metadata, UNIQUE_ENTRY_METADATA_LAYOUT)) {
 
-            case UNIQUE_ENTRY_CREATION_FLAG:
+            case OperationKind::Creation:
                 return UniqueEntryOperation{
                     UniqueEntryCreationOp{std::move(entry),
                                           std::move(owner),
                                           block,
                                           value}};
 
-            case UNIQUE_ENTRY_RENEWAL_FLAG:
+            case OperationKind::Renewal:
                 return UniqueEntryOperation{
                     UniqueEntryRenewalOp{std::move(entry),
                                          std::move(owner),
                                          block,
                                          value}};
 
-            case UNIQUE_ENTRY_OWNERSHIP_TRANSFER_FLAG:
+            case OperationKind::OwnershipTransfer:
                 return new_owner_opt
                     .map([&](auto new_owner) {
                         return UniqueEntryOperation{
@@ -150,7 +151,7 @@ auto forge::core::parseMetadataToUniqueEntryOp(const std::vector<std::byte>& met
                                                            value}};
                     });
 
-            case UNIQUE_ENTRY_DELETION_FLAG:
+            case OperationKind::Deletion:
                 return UniqueEntryOperation{
                     UniqueEntryDeletionOp{std::move(entry),
                                           std::move(owner),
@@ -163,7 +164,7 @@ auto forge::core::parseMetadataToUniqueEntryOp(const std::vector<std::byte>& met
         });
 }
 
-auto forge::core::parseTransactionToUniqueEntry(Transaction tx,
+auto forge::core::parseTransactionToUniqueEntry(const Transaction& tx,
                                                 std::int64_t block,
                                                 const client::ReadOnlyClientBase* client)
     -> Result<Opt<UniqueEntryOperation>, ClientError>
@@ -180,7 +181,7 @@ auto forge::core::parseTransactionToUniqueEntry(Transaction tx,
         return ResultType{std::nullopt};
     }
 
-    LOG(INFO) << tx.getTxid() << " contains a OP_RETURN output";
+    FORGE_LOG(INFO, "{} contains a OP_RETURN output", tx.getTxid());
 
     //save, because we checked that the tx has exactly one
     //op return output
@@ -189,30 +190,15 @@ auto forge::core::parseTransactionToUniqueEntry(Transaction tx,
             .getValue()
             .get();
 
-    //get optional new owner
-    //for ownership transfer
-    auto new_owner_opt =
-        tx.getFirstNonOpReturnOutput()
-            .flatMap([](auto ref)
-                         -> Opt<std::string> {
-                //we only care about outputs with exactly one
-                //address
-                if(ref.get().getAddresses().size() != 1) {
-                    return std::nullopt;
-                }
-                return ref.get().getAddresses()[0];
-            });
-
     //save, because we have checked that the tx has exactly
     //one input
-    auto vin = std::move(tx.getInputs()[0]);
+    const auto& vin = tx.getInputs()[0];
 
     //value of the op return output
     auto value = op_return_output.getValue();
 
     //extract the metadata from the output script
-    auto output_script = std::move(op_return_output.getHex());
-    auto metadata_opt = extractMetadata(std::move(output_script));
+    auto metadata_opt = extractMetadata(op_return_output.getHex());
 
     if(!metadata_opt) {
         return ResultType{std::nullopt};
@@ -227,9 +213,23 @@ auto forge::core::parseTransactionToUniqueEntry(Transaction tx,
         return ResultType{std::nullopt};
     }
 
-    LOG(DEBUG) << "resoving vin from " << vin.getTxid();
+    //get optional new owner
+    //for ownership transfer
+    auto new_owner_opt =
+        tx.getFirstNonOpReturnOutput()
+            .flatMap([](auto ref)
+                         -> Opt<std::string> {
+                //we only care about outputs with exactly one
+                //address
+                if(ref.get().getAddresses().size() != 1) {
+                    return std::nullopt;
+                }
+                return ref.get().getAddresses()[0];
+            });
+
+    FORGE_LOG(DEBUG, "resolving vin from {}", vin.getTxid());
     return client
-        ->resolveTxIn(std::move(vin))
+        ->resolveTxIn(vin)
         .flatMap([&](auto resolvedVin) {
             //we can only have one input address
             if(resolvedVin.getAddresses().size() != 1) {
@@ -242,7 +242,7 @@ auto forge::core::parseTransactionToUniqueEntry(Transaction tx,
             //parse the metadata nd put it into
             //the ResultType
             return ResultType{
-                parseMetadataToUniqueEntryOp(std::move(metadata),
+                parseMetadataToUniqueEntryOp(metadata,
                                              block,
                                              std::move(owner),
                                              value,
@@ -1,5 +1,7 @@
+#include <core/ByteSpan.hpp>
 #include <core/FlagIndexes.hpp>
 #include <cstddef>
+#include <entrys/MetadataDecoder.hpp>
 #include <entrys/umentry/UMEntry.hpp>
 #include <entrys/umentry/UMEntryOperation.hpp>
 #include <g3log/g3log.hpp>
@@ -10,14 +12,11 @@
 
 using utilxx::Opt;
 using forge::core::UMEntry;
+using forge::core::ByteSpan;
 using forge::core::IPv4Value;
 using forge::core::IPv6Value;
 using forge::core::ByteArray;
 using forge::core::NoneValue;
-using forge::core::ENTRY_VALUE_FLAG_INDEX;
-using forge::core::IPv4_VALUE_FLAG;
-using forge::core::IPv6_VALUE_FLAG;
-using forge::core::NONE_VALUE_FLAG;
 using forge::core::BYTE_ARRAY_VALUE_FLAG;
 
 UMEntry::UMEntry(EntryKey key, UMEntryValue value)
@@ -31,6 +30,13 @@ auto UMEntry::toRawData() const
     auto value_data = umEntryValueToRawData(getValue());
     auto value_flag = extractValueFlag(getValue());
 
+    //byte arrays are prefixed with their length, values from json
+    //are limited to MAX_BYTE_ARRAY_VALUE_SIZE by jsonToUMEntryValue
+    if(value_flag == BYTE_ARRAY_VALUE_FLAG) {
+        value_data.insert(std::begin(value_data),
+                          static_cast<std::byte>(value_data.size()));
+    }
+
     value_data.insert(std::begin(value_data),
                       value_flag);
 
@@ -93,127 +99,31 @@ auto UMEntry::operator!=(const UMEntry& rhs) const
 }
 
 
-auto forge::core::parseUMValue(const std::vector<std::byte>& data)
+auto forge::core::parseUMValue(ByteSpan data)
     -> utilxx::Opt<UMEntryValue>
 {
-    if(data[ENTRY_VALUE_FLAG_INDEX] == NONE_VALUE_FLAG
-       && data.size() > ENTRY_VALUE_FLAG_INDEX + 1) {
-        return UMEntryValue{NoneValue{}};
-    }
-
-    if(data[ENTRY_VALUE_FLAG_INDEX] == BYTE_ARRAY_VALUE_FLAG
-       && static_cast<std::int64_t>(data.size())
-           > ENTRY_VALUE_FLAG_INDEX + 2) {
-        auto value_length = static_cast<std::int64_t>(data[5]);
-
-        //check the bounds
-        if(ENTRY_VALUE_FLAG_INDEX + 2 + value_length
-           > static_cast<std::int64_t>(data.size())) {
-            return std::nullopt;
-        }
-
-        ByteArray byte_array;
-        std::copy(std::begin(data) + ENTRY_VALUE_FLAG_INDEX + 2,
-                  std::begin(data) + ENTRY_VALUE_FLAG_INDEX + 2 + value_length,
-                  std::begin(byte_array));
-
-        return UMEntryValue{std::move(byte_array)};
-    }
-
-    if(data[ENTRY_VALUE_FLAG_INDEX] == IPv4_VALUE_FLAG
-       && data.size() > ENTRY_VALUE_FLAG_INDEX + 5) {
-        IPv4Value ipv4;
-        std::copy(std::begin(data) + ENTRY_VALUE_FLAG_INDEX + 1,
-                  std::begin(data) + ENTRY_VALUE_FLAG_INDEX + 5,
-                  std::begin(ipv4));
-        return UMEntryValue{std::move(ipv4)};
-    }
-
-
-    if(data[ENTRY_VALUE_FLAG_INDEX] == IPv6_VALUE_FLAG
-       && data.size() > ENTRY_VALUE_FLAG_INDEX + 17) {
-
-        IPv6Value ipv6;
-        std::copy(std::begin(data) + ENTRY_VALUE_FLAG_INDEX + 1,
-                  std::begin(data) + ENTRY_VALUE_FLAG_INDEX + 17,
-                  std::begin(ipv6));
-
-        return UMEntryValue{std::move(ipv6)};
-    }
-
-    return std::nullopt;
+    return decodeEntryValue(data)
+        .map([](auto decoded) {
+            return std::move(decoded.value);
+        });
 }
 
-auto forge::core::parseUMKey(const std::vector<std::byte>& data)
+auto forge::core::parseUMKey(ByteSpan data)
     -> utilxx::Opt<EntryKey>
 {
-    if(data[ENTRY_VALUE_FLAG_INDEX] == NONE_VALUE_FLAG
-       && data.size() > ENTRY_VALUE_FLAG_INDEX + 1) {
-
-        return EntryKey{std::begin(data) + ENTRY_VALUE_FLAG_INDEX + 1,
-                        std::end(data)};
-    }
-
-    if(data[ENTRY_VALUE_FLAG_INDEX] == BYTE_ARRAY_VALUE_FLAG
-       && data.size() > ENTRY_VALUE_FLAG_INDEX + 2) {
-        auto value_length = static_cast<std::int64_t>(data[ENTRY_VALUE_FLAG_INDEX + 1]);
-
-        //check the bounds
-        if(ENTRY_VALUE_FLAG_INDEX + 2 + value_length
-           > static_cast<std::int64_t>(data.size())) {
-            return std::nullopt;
-        }
-
-        return EntryKey{std::begin(data) + ENTRY_VALUE_FLAG_INDEX + 2 + value_length,
-                        std::end(data)};
-    }
-
-    if(data[ENTRY_VALUE_FLAG_INDEX] == IPv4_VALUE_FLAG
-       && data.size() > ENTRY_VALUE_FLAG_INDEX + 5) {
-
-        return EntryKey{std::begin(data) + ENTRY_VALUE_FLAG_INDEX + 5,
-                        std::end(data)};
-    }
-
-
-
-    if(data[ENTRY_VALUE_FLAG_INDEX] == IPv6_VALUE_FLAG
-       && data.size() > ENTRY_VALUE_FLAG_INDEX + 17) {
-
-        return EntryKey{std::begin(data) + ENTRY_VALUE_FLAG_INDEX + 17,
-                        std::end(data)};
-    }
-
-    return std::nullopt;
+    return decodeEntryValue(data)
+        .map([](auto decoded) {
+            return decoded.key.toVector();
+        });
 }
 
-auto forge::core::parseUMEntry(const std::vector<std::byte>& data)
+auto forge::core::parseUMEntry(ByteSpan data)
     -> Opt<UMEntry>
 {
-    //3 bytes mask
-    //1 tokeyn type flag
-    //1 op flag
-    //1 value flag
-    //at least 4 value
-    //at least 1 key
-    if(data.size() < 11) {
-        return std::nullopt;
-    }
-
-    //check that the metadata actualy refers to a mutable entry
-    if(data[TOKEN_TYPE_INDEX] != UMENTRY_IDENTIFICATION_FLAG) {
-        return std::nullopt;
-    }
-
-    auto value_opt = parseUMValue(data);
-    auto key_opt = parseUMKey(data);
-
-
-    return combine(std::move(key_opt),
-                   std::move(value_opt))
-        .map([](auto pair) {
-            return UMEntry{std::move(pair.first),
-                           std::move(pair.second)};
+    return decodeEntry(data, UMENTRY_METADATA_LAYOUT)
+        .map([](auto decoded) {
+            return UMEntry{decoded.key.toVector(),
+                           std::move(decoded.value)};
         });
 }
 
@@ -335,6 +245,10 @@ auto forge::core::jsonToUMEntryValue(Json::Value&& value)
 
         auto byte_vec = std::move(byte_vec_opt.getValue());
 
+        if(byte_vec.size() > MAX_BYTE_ARRAY_VALUE_SIZE) {
+            return std::nullopt;
+        }
+
         return UMEntryValue{std::move(byte_vec)};
     }
 
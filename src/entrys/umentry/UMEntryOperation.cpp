@@ -1,9 +1,12 @@
+#include <core/ByteSpan.hpp>
 #include <core/FlagIndexes.hpp>
 #include <core/Transaction.hpp>
 #include <cstddef>
 #include <client/ReadOnlyClientBase.hpp>
+#include <entrys/MetadataDecoder.hpp>
 #include <entrys/umentry/UMEntry.hpp>
 #include <entrys/umentry/UMEntryOperation.hpp>
+#include <env/AsyncLogger.hpp>
 #include <fmt/core.h>
 #include <g3log/g3log.hpp>
 #include <utilxx/Opt.hpp>
@@ -18,7 +21,8 @@ using utilxx::Opt;
 using forge::core::Transaction;
 using forge::client::ReadOnlyClientBase;
 using forge::client::ClientError;
-using forge::core::parseUMEntry;
+using forge::core::ByteSpan;
+using forge::core::OperationKind;
 using forge::core::FORGE_IDENTIFIER_MASK;
 
 auto forge::core::getEntryKey(const UMEntryOperation& operation)
@@ -110,37 +114,42 @@ auto forge::core::extractOperationFlag(const UMEntryOperation& operation)
 }
 
 
-auto forge::core::parseMetadataToUMEntryOp(const std::vector<std::byte>& metadata,
+auto forge::core::parseMetadataToUMEntryOp(ByteSpan metadata,
                                            std::int64_t block,
                                            std::string&& owner,
                                            std::int64_t value,
                                            utilxx::Opt<std::string>&& new_owner_opt)
     -> Opt<UMEntryOperation>
 {
-    if(metadata.size() < 10) {
-        return std::nullopt;
-    }
-
-    return parseUMEntry(metadata)
-        .flatMap([&](auto entry)
+    return decodeEntry(metadata, UMENTRY_METADATA_LAYOUT)
+        .flatMap([&](auto decoded)
                      -> utilxx::Opt<UMEntryOperation> {
-            switch(static_cast<std::byte>(metadata[OPERATION_FLAG_INDEX])) {
+            auto operation = decodeOperation(metadata, UMENTRY_METADATA_LAYOUT);
+
+            if(operation == OperationKind::Invalid) {
+                return std::nullopt;
+            }
 
-            case UMENTRY_CREATION_FLAG:
+            UMEntry entry{decoded.key.toVector(),
+                          std::move(decoded.value)};
+
+            switch(operation) {
+
+            case OperationKind::Creation:
                 return UMEntryOperation{
                     UMEntryCreationOp{std::move(entry),
                                       std::move(owner),
                                       block,
                                       value}};
 
-            case UMENTRY_RENEWAL_FLAG:
+            case OperationKind::Renewal:
                 return UMEntryOperation{
                     UMEntryRenewalOp{std::move(entry),
                                      std::move(owner),
                                      block,
                                      value}};
 
-            case UMENTRY_OWNERSHIP_TRANSFER_FLAG:
+            case OperationKind::OwnershipTransfer:
                 return new_owner_opt
                     .map([&](auto new_owner) {
                         return UMEntryOperation{
@@ -151,14 +160,14 @@ auto forge::core::parseMetadataToUMEntryOp(const std::vector<std::byte>& metadat
                                                        value}};
                     });
 
-            case UMENTRY_UPDATE_FLAG:
+            case OperationKind::Update:
                 return UMEntryOperation{
                     UMEntryUpdateOp{std::move(entry),
                                     std::move(owner),
                                     block,
                                     value}};
 
-            case UMENTRY_DELETION_FLAG:
+            case OperationKind::Deletion:
                 return UMEntryOperation{
                     UMEntryDeletionOp{std::move(entry),
                                       std::move(owner),
@@ -171,7 +180,7 @@ auto forge::core::parseMetadataToUMEntryOp(const std::vector<std::byte>& metadat
         });
 }
 
-auto forge::core::parseTransactionToUMEntry(Transaction tx,
+auto forge::core::parseTransactionToUMEntry(const Transaction& tx,
                                             std::int64_t block,
                                             const client::ReadOnlyClientBase* client)
     -> Result<Opt<UMEntryOperation>, ClientError>
@@ -188,37 +197,22 @@ auto forge::core::parseTransactionToUMEntry(Transaction tx,
         return ResultType{std::nullopt};
     }
 
-    LOG(INFO) << tx.getTxid() << " contains a OP_RETURN output";
+    FORGE_LOG(INFO, "{} contains a OP_RETURN output", tx.getTxid());
 
     //save, because we checked that the tx has exactly one
     //op return output
     const auto& op_return_output =
         tx.getFirstOpReturnOutput().getValue().get();
 
-    //get optional new owner
-    //for ownership transfer
-    auto new_owner_opt =
-        tx.getFirstNonOpReturnOutput()
-            .flatMap([](auto ref)
-                         -> Opt<std::string> {
-                //we only care about outputs with exactly one
-                //address
-                if(ref.get().getAddresses().size() != 1) {
-                    return std::nullopt;
-                }
-                return ref.get().getAddresses()[0];
-            });
-
     //save, because we have checked that the tx has exactly
     //one input
-    auto vin = std::move(tx.getInputs()[0]);
+    const auto& vin = tx.getInputs()[0];
 
     //value of the op return output
     auto value = op_return_output.getValue();
 
     //extract the metadata from the output script
-    auto output_script = std::move(op_return_output.getHex());
-    auto metadata_opt = extractMetadata(std::move(output_script));
+    auto metadata_opt = extractMetadata(op_return_output.getHex());
 
     if(!metadata_opt) {
         return ResultType{std::nullopt};
@@ -233,9 +227,23 @@ auto forge::core::parseTransactionToUMEntry(Transaction tx,
         return ResultType{std::nullopt};
     }
 
-    LOG(DEBUG) << "resoving vin from " << vin.getTxid();
+    //get optional new owner
+    //for ownership transfer
+    auto new_owner_opt =
+        tx.getFirstNonOpReturnOutput()
+            .flatMap([](auto ref)
+                         -> Opt<std::string> {
+                //we only care about outputs with exactly one
+                //address
+                if(ref.get().getAddresses().size() != 1) {
+                    return std::nullopt;
+                }
+                return ref.get().getAddresses()[0];
+            });
+
+    FORGE_LOG(DEBUG, "resolving vin from {}", vin.getTxid());
     return client
-        ->resolveTxIn(std::move(vin))
+        ->resolveTxIn(vin)
         .flatMap([&](auto resolvedVin) {
             //we can only have one input address
             if(resolvedVin.getAddresses().size() != 1) {
@@ -248,7 +256,7 @@ auto forge::core::parseTransactionToUMEntry(Transaction tx,
             //parse the metadata nd put it into
             //the ResultType
             return ResultType{
-                parseMetadataToUMEntryOp(std::move(metadata),
+                parseMetadataToUMEntryOp(metadata,
                                          block,
                                          std::move(owner),
                                          value,
@@ -0,0 +1,329 @@
+#include <chrono>
+#include <env/AsyncLogger.hpp>
+#include <fmt/format.h>
+#include <g3log/g3log.hpp>
+#include <metrics/Metrics.hpp>
+
+using forge::env::AsyncLogger;
+using forge::env::LogArg;
+using forge::env::LogLevel;
+using forge::env::LogRecord;
+using forge::env::LogSink;
+using forge::env::LogSite;
+using forge::env::LogString;
+
+//formats a queued argument like the value it was created from
+template<>
+struct fmt::formatter<LogArg>
+{
+    constexpr auto parse(format_parse_context& ctx)
+    {
+        return ctx.begin();
+    }
+
+    template<class FormatContext>
+    auto format(const LogArg& arg, FormatContext& ctx) const
+    {
+        return std::visit(
+            [&](const auto& value) {
+                using Type = std::decay_t<decltype(value)>;
+                if constexpr(std::is_same_v<Type, LogString>) {
+                    std::string_view view{value.data.data(), value.size};
+                    return format_to(ctx.out(), "{}", view);
+                } else {
+                    return format_to(ctx.out(), "{}", value);
+                }
+            },
+            arg);
+    }
+};
+
+namespace {
+
+//how long the logger thread sleeps if the queue is empty
+constexpr inline auto LOG_POLL_INTERVAL = std::chrono::milliseconds{10};
+
+auto nextPowerOfTwo(std::size_t value)
+    -> std::size_t
+{
+    std::size_t result{1};
+    while(result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+auto currentSecond()
+    -> std::int64_t
+{
+    auto now = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::seconds>(
+               now.time_since_epoch())
+        .count();
+}
+
+auto formatRecord(const LogRecord& record)
+    -> std::string
+{
+    const auto& a = record.args;
+
+    switch(record.number_of_args) {
+    case 0:
+        return fmt::vformat(record.format, fmt::make_format_args());
+    case 1:
+        return fmt::vformat(record.format, fmt::make_format_args(a[0]));
+    case 2:
+        return fmt::vformat(record.format, fmt::make_format_args(a[0], a[1]));
+    case 3:
+        return fmt::vformat(record.format, fmt::make_format_args(a[0], a[1], a[2]));
+    default:
+        return fmt::vformat(record.format, fmt::make_format_args(a[0], a[1], a[2], a[3]));
+    }
+}
+
+} // namespace
+
+
+LogSite::LogSite(LogLevel level,
+                 const char* file,
+                 int line,
+                 std::uint32_t every_n,
+                 std::uint32_t max_per_second)
+    : level_(level),
+      file_(file),
+      line_(line),
+      every_n_(std::max<std::uint32_t>(every_n, 1)),
+      max_per_second_(max_per_second) {}
+
+auto LogSite::shouldLog()
+    -> bool
+{
+    auto hit = hits_.fetch_add(1, std::memory_order_relaxed);
+    if(hit % every_n_ != 0) {
+        return false;
+    }
+
+    if(level_ >= LogLevel::WARNING) {
+        return true;
+    }
+
+    //a new window might reset the counter twice when two
+    //threads race here, this only lets a few more messages through
+    auto second = currentSecond();
+    if(window_.load(std::memory_order_relaxed) != second) {
+        window_.store(second, std::memory_order_relaxed);
+        logged_in_window_.store(0, std::memory_order_relaxed);
+    }
+
+    if(logged_in_window_.fetch_add(1, std::memory_order_relaxed)
+       >= max_per_second_) {
+        suppressed_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    return true;
+}
+
+auto LogSite::takeSuppressed()
+    -> std::uint64_t
+{
+    return suppressed_.exchange(0, std::memory_order_relaxed);
+}
+
+auto LogSite::getLevel() const
+    -> LogLevel
+{
+    return level_;
+}
+
+auto LogSite::getFile() const
+    -> const char*
+{
+    return file_;
+}
+
+auto LogSite::getLine() const
+    -> int
+{
+    return line_;
+}
+
+
+auto forge::env::g3logSink(const LogSite& site,
+                           std::string&& message)
+    -> void
+{
+    auto level = [&] {
+        switch(site.getLevel()) {
+        case LogLevel::DEBUG:
+            return DEBUG;
+        case LogLevel::INFO:
+            return INFO;
+        default:
+            return WARNING;
+        }
+    }();
+
+    LogCapture(site.getFile(), site.getLine(), "", level).stream() << message;
+}
+
+
+AsyncLogger::AsyncLogger(LogSink sink,
+                         std::size_t capacity)
+    : sink_(std::move(sink)),
+      mask_(nextPowerOfTwo(std::max<std::size_t>(capacity, 2)) - 1),
+      cells_(std::make_unique<Cell[]>(mask_ + 1))
+{
+    for(std::size_t i = 0; i <= mask_; i++) {
+        cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    thread_ = std::thread{[this] { run(); }};
+}
+
+AsyncLogger::~AsyncLogger()
+{
+    should_stop_ = true;
+    thread_.join();
+}
+
+//bounded multi producer queue, every cell carries the position
+//it can be written (sequence == pos) or read (sequence == pos + 1) at
+auto AsyncLogger::push(LogRecord&& record)
+    -> void
+{
+    auto pos = enqueue_pos_.load(std::memory_order_relaxed);
+
+    while(true) {
+        auto& cell = cells_[pos & mask_];
+        auto sequence = cell.sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<std::intptr_t>(sequence)
+            - static_cast<std::intptr_t>(pos);
+
+        if(diff == 0) {
+            if(enqueue_pos_.compare_exchange_weak(pos,
+                                                  pos + 1,
+                                                  std::memory_order_relaxed)) {
+                cell.record = std::move(record);
+                cell.sequence.store(pos + 1, std::memory_order_release);
+                return;
+            }
+        } else if(diff < 0) {
+            //the queue is full, logging must never block sync
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+
+            static auto& dropped_records =
+                metrics::getRegistry().counter("forge_log_records_dropped_total",
+                                               "log records dropped because the log queue was full");
+            dropped_records.increment();
+            return;
+        } else {
+            pos = enqueue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+auto AsyncLogger::pop(LogRecord& record)
+    -> bool
+{
+    auto& cell = cells_[dequeue_pos_ & mask_];
+    auto sequence = cell.sequence.load(std::memory_order_acquire);
+
+    if(sequence != dequeue_pos_ + 1) {
+        return false;
+    }
+
+    record = std::move(cell.record);
+    cell.sequence.store(dequeue_pos_ + mask_ + 1, std::memory_order_release);
+    ++dequeue_pos_;
+
+    return true;
+}
+
+auto AsyncLogger::write(const LogRecord& record)
+    -> void
+{
+    std::string message;
+    try {
+        message = formatRecord(record);
+    } catch(const fmt::format_error& error) {
+        message = fmt::format("{} (invalid log format: {})",
+                              record.format,
+                              error.what());
+    }
+
+    if(record.suppressed > 0) {
+        message += fmt::format(" ({} similar messages suppressed)",
+                               record.suppressed);
+    }
+
+    sink_(*record.site, std::move(message));
+}
+
+auto AsyncLogger::writeUnqueued(const LogSite& site,
+                                const char* format,
+                                fmt::format_args args)
+    -> void
+{
+    std::string message;
+    try {
+        message = fmt::vformat(format, args);
+    } catch(const fmt::format_error& error) {
+        message = fmt::format("{} (invalid log format: {})",
+                              format,
+                              error.what());
+    }
+
+    sink_(site, std::move(message));
+}
+
+auto AsyncLogger::run()
+    -> void
+{
+    LogRecord record;
+
+    while(true) {
+        //read the flag first, so nothing pushed before
+        //the destructor was called is lost
+        auto should_stop = should_stop_.load();
+
+        auto written_any{false};
+        while(pop(record)) {
+            write(record);
+            written_.store(dequeue_pos_, std::memory_order_release);
+            written_any = true;
+        }
+
+        if(should_stop) {
+            return;
+        }
+
+        if(!written_any) {
+            std::this_thread::sleep_for(LOG_POLL_INTERVAL);
+        }
+    }
+}
+
+auto AsyncLogger::flush()
+    -> void
+{
+    auto target = enqueue_pos_.load(std::memory_order_acquire);
+
+    while(written_.load(std::memory_order_acquire) < target) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+}
+
+auto AsyncLogger::getDropped() const
+    -> std::uint64_t
+{
+    return dropped_.load(std::memory_order_relaxed);
+}
+
+
+auto forge::env::getAsyncLogger()
+    -> AsyncLogger&
+{
+    static AsyncLogger logger;
+    return logger;
+}
@@ -22,7 +22,12 @@ ProgramOptions::ProgramOptions(std::string&& logfolder,
                                std::string&& coin_password,
                                std::int64_t rpc_port,
                                std::string&& rpc_user,
-                               std::string&& rpc_password)
+                               std::string&& rpc_password,
+                               utilxx::Opt<std::string>&& shm_name,
+                               utilxx::Opt<std::int64_t>&& metrics_port,
+                               bool track_pending,
+                               std::string&& address_book_path,
+                               utilxx::Opt<std::int64_t>&& fee_rate)
     : logfolder_(std::move(logfolder)),
       number_of_threads_(number_of_threads),
       mode_(mode),
@@ -34,7 +39,12 @@ ProgramOptions::ProgramOptions(std::string&& logfolder,
       coin_password_(std::move(coin_password)),
       rpc_port_(rpc_port),
       rpc_user_(std::move(rpc_user)),
-      rpc_password_(std::move(rpc_password)) {}
+      rpc_password_(std::move(rpc_password)),
+      shm_name_(std::move(shm_name)),
+      metrics_port_(std::move(metrics_port)),
+      track_pending_(track_pending),
+      address_book_path_(std::move(address_book_path)),
+      fee_rate_(std::move(fee_rate)) {}
 
 auto ProgramOptions::getLogFolder() const
     -> const std::string&
@@ -116,6 +126,36 @@ auto ProgramOptions::getRpcPassword() const
     return rpc_password_;
 }
 
+auto ProgramOptions::getSharedMemoryName() const
+    -> const utilxx::Opt<std::string>&
+{
+    return shm_name_;
+}
+
+auto ProgramOptions::getMetricsPort() const
+    -> const utilxx::Opt<std::int64_t>&
+{
+    return metrics_port_;
+}
+
+auto ProgramOptions::shouldTrackPendingOperations() const
+    -> bool
+{
+    return track_pending_;
+}
+
+auto ProgramOptions::getAddressBookPath() const
+    -> const std::string&
+{
+    return address_book_path_;
+}
+
+auto ProgramOptions::getFeeRate() const
+    -> const utilxx::Opt<std::int64_t>&
+{
+    return fee_rate_;
+}
+
 auto ProgramOptions::getNumberOfThreads() const
     -> std::int64_t
 {
@@ -234,6 +274,68 @@ auto getThreadsEnv()
     }
 }
 
+auto getSharedMemoryNameFromEnv()
+    -> utilxx::Opt<std::string>
+{
+    auto raw_str = std::getenv("SHM_NAME");
+    if(raw_str == nullptr) {
+        return std::nullopt;
+    }
+
+    return std::string{raw_str};
+}
+
+auto getMetricsPortFromEnv()
+    -> utilxx::Opt<std::int64_t>
+{
+    try {
+        auto raw_str = std::getenv("METRICS_PORT");
+        if(raw_str == nullptr) {
+            return std::nullopt;
+        }
+        return std::stoll(raw_str);
+    } catch(...) {
+        return std::nullopt;
+    }
+}
+
+auto getTrackPendingFromEnv()
+    -> bool
+{
+    auto raw_str = std::getenv("TRACK_PENDING");
+    std::string str = raw_str ? raw_str : "";
+    for(auto& ch : str) {
+        ch = std::toupper(ch);
+    }
+
+    return str == "TRUE";
+}
+
+auto getAddressBookPathFromEnv(const std::string& base_path)
+    -> std::string
+{
+    auto raw_str = std::getenv("ADDRESS_BOOK");
+    if(raw_str == nullptr) {
+        return base_path + "/addressbook";
+    }
+
+    return raw_str;
+}
+
+auto getFeeRateFromEnv()
+    -> utilxx::Opt<std::int64_t>
+{
+    try {
+        auto raw_str = std::getenv("FEE_RATE");
+        if(raw_str == nullptr) {
+            return std::nullopt;
+        }
+        return std::stoll(raw_str);
+    } catch(...) {
+        return std::nullopt;
+    }
+}
+
 } // namespace
 
 auto forge::env::parseOptions(int argc, char* argv[])
@@ -320,6 +422,11 @@ auto forge::env::parseConfigFile(const std::string& config_path)
     auto rpc_user = config->get_qualified_as<std::string>("rpc.user").value_or("user");
     auto rpc_password = config->get_qualified_as<std::string>("rpc.password").value_or("password");
     auto threads = config->get_qualified_as<std::int64_t>("server.threads").value_or(5);
+    auto shm_name_opt = config->get_qualified_as<std::string>("shm.name");
+    auto metrics_port_opt = config->get_qualified_as<std::int64_t>("metrics.port");
+    auto track_pending = config->get_qualified_as<bool>("lookup.pending").value_or(false);
+    auto address_book_path = config->get_qualified_as<std::string>("wallet.addressbook").value_or(config_path + "/addressbook");
+    auto fee_rate_opt = config->get_qualified_as<std::int64_t>("coin.feerate");
 
 
     //create the log folder
@@ -346,6 +453,24 @@ auto forge::env::parseConfigFile(const std::string& config_path)
         std::exit(-1);
     }
 
+    //publishing the lookup to shared memory is optional
+    utilxx::Opt<std::string> shm_name;
+    if(shm_name_opt) {
+        shm_name = *shm_name_opt;
+    }
+
+    //so is serving metrics
+    utilxx::Opt<std::int64_t> metrics_port;
+    if(metrics_port_opt) {
+        metrics_port = utilxx::Opt<std::int64_t>{*metrics_port_opt};
+    }
+
+    //without a fee rate the daemon estimates it
+    utilxx::Opt<std::int64_t> fee_rate;
+    if(fee_rate_opt) {
+        fee_rate = utilxx::Opt<std::int64_t>{*fee_rate_opt};
+    }
+
     return ProgramOptions{std::move(log_path),
                           threads,
                           mode,
@@ -357,7 +482,12 @@ auto forge::env::parseConfigFile(const std::string& config_path)
                           std::move(coin_password),
                           rpc_port,
                           std::move(rpc_user),
-                          std::move(rpc_password)};
+                          std::move(rpc_password),
+                          std::move(shm_name),
+                          std::move(metrics_port),
+                          track_pending,
+                          std::move(address_book_path),
+                          std::move(fee_rate)};
 }
 
 
@@ -379,6 +509,11 @@ auto forge::env::fromEnvironment()
     auto rpc_user = "";
     auto rpc_password = "";
     auto threads = getThreadsEnv();
+    auto shm_name = getSharedMemoryNameFromEnv();
+    auto metrics_port = getMetricsPortFromEnv();
+    auto track_pending = getTrackPendingFromEnv();
+    auto address_book_path = getAddressBookPathFromEnv(config);
+    auto fee_rate = getFeeRateFromEnv();
 
     //create the log folder
     fs::create_directory(log_path);
@@ -416,5 +551,10 @@ auto forge::env::fromEnvironment()
                           std::move(coin_password),
                           rpc_port,
                           std::move(rpc_user),
-                          std::move(rpc_password)};
+                          std::move(rpc_password),
+                          std::move(shm_name),
+                          std::move(metrics_port),
+                          track_pending,
+                          std::move(address_book_path),
+                          std::move(fee_rate)};
 }
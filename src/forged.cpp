@@ -17,6 +17,9 @@
 #include <getopt.h>
 #include <jsonrpccpp/server/connectors/httpserver.h>
 #include <lookup/LookupManager.hpp>
+#include <lookup/SharedLookupPublisher.hpp>
+#include <metrics/MetricsServer.hpp>
+#include <metrics/Trace.hpp>
 #include <rpc/JsonRpcServer.hpp>
 #include <sys/stat.h>
 #include <sys/types.h>
@@ -25,12 +28,15 @@
 #include <unistd.h>
 #include <utilxx/Opt.hpp>
 #include <utilxx/Result.hpp>
+#include <wallet/AddressBook.hpp>
 #include <wallet/ReadOnlyWallet.hpp>
 #include <wallet/ReadWriteWallet.hpp>
 
 using forge::lookup::LookupManager;
+using forge::lookup::make_shared_lookup_publisher;
 using forge::client::make_readonly_client;
 using forge::client::make_writing_client;
+using forge::wallet::AddressBook;
 using forge::wallet::ReadWriteWallet;
 using forge::wallet::ReadOnlyWallet;
 using forge::env::initConsoleLogger;
@@ -38,6 +44,9 @@ using forge::env::initFileLogger;
 using forge::env::parseOptions;
 using forge::env::ProgramOptions;
 using forge::rpc::JsonRpcServer;
+using forge::metrics::MetricsServer;
+using forge::metrics::make_metrics_server;
+using forge::metrics::TraceDumper;
 using jsonrpc::HttpServer;
 using jsonrpc::JSONRPC_SERVER_V1V2;
 
@@ -118,6 +127,47 @@ auto assertOnMainnet(const forge::client::ReadOnlyClientBase& client)
     }
 }
 
+auto attachSharedLookup(LookupManager& lookup,
+                        const ProgramOptions& params)
+{
+    const auto& shm_name = params.getSharedMemoryName();
+    if(!shm_name) {
+        return;
+    }
+
+    auto publisher_res = make_shared_lookup_publisher(shm_name.getValue());
+    if(!publisher_res) {
+        fmt::print("{}\n", publisher_res.getError().what());
+        std::exit(-1);
+    }
+
+    lookup.setSharedLookupPublisher(std::move(publisher_res.getValue()));
+}
+
+auto startMetricsServer(const ProgramOptions& params)
+    -> std::unique_ptr<MetricsServer>
+{
+    const auto& port = params.getMetricsPort();
+    if(!port) {
+        return nullptr;
+    }
+
+    auto server_res = make_metrics_server(port.getValue());
+    if(!server_res) {
+        fmt::print("{}\n", server_res.getError().what());
+        std::exit(-1);
+    }
+
+    return std::move(server_res.getValue());
+}
+
+//SIGUSR1 dumps the trace spans next to the logs
+auto startTraceDumper(const ProgramOptions& params)
+    -> std::unique_ptr<TraceDumper>
+{
+    return std::make_unique<TraceDumper>(params.getLogFolder());
+}
+
 auto runLookupOnlyServer(const ProgramOptions& params)
 {
     auto client = make_readonly_client(params.getCoinHost(),
@@ -136,12 +186,16 @@ auto runLookupOnlyServer(const ProgramOptions& params)
                           "",
                           static_cast<int>(threads)};
 
-    LookupManager lookup{std::move(client)};
+    auto lookup = std::make_unique<LookupManager>(std::move(client));
+    attachSharedLookup(*lookup, params);
+    lookup->setTrackPendingOperations(params.shouldTrackPendingOperations());
 
     JsonRpcServer rpcserver{httpserver,
                             JSONRPC_SERVER_V1V2,
                             std::move(lookup)};
     rpcserver.StartListening();
+    auto metrics_server = startMetricsServer(params);
+    auto trace_dumper = startTraceDumper(params);
 
     forge::rpc::waitForShutdown(rpcserver);
 
@@ -159,7 +213,10 @@ auto runReadOnlyWalletServer(const ProgramOptions& params)
     assertOnMainnet(*client);
 
     auto lookup = std::make_unique<LookupManager>(std::move(client));
-    ReadOnlyWallet wallet{std::move(lookup)};
+    attachSharedLookup(*lookup, params);
+    lookup->setTrackPendingOperations(params.shouldTrackPendingOperations());
+    ReadOnlyWallet wallet{std::move(lookup),
+                          AddressBook{params.getAddressBookPath()}};
 
     auto port = params.getRpcPort();
     auto threads = params.getNumberOfThreads();
@@ -174,6 +231,8 @@ auto runReadOnlyWalletServer(const ProgramOptions& params)
                             JSONRPC_SERVER_V1V2,
                             std::move(wallet)};
     rpcserver.StartListening();
+    auto metrics_server = startMetricsServer(params);
+    auto trace_dumper = startTraceDumper(params);
 
     forge::rpc::waitForShutdown(rpcserver);
 
@@ -194,11 +253,15 @@ auto runReadWriteWalletServer(const ProgramOptions& params)
                                       params.getCoinUser(),
                                       params.getCoinPassword(),
                                       params.getCoinPort(),
-                                      params.getCoin());
+                                      params.getCoin(),
+                                      params.getFeeRate());
 
     auto lookup = std::make_unique<LookupManager>(std::move(reader));
+    attachSharedLookup(*lookup, params);
+    lookup->setTrackPendingOperations(params.shouldTrackPendingOperations());
     ReadWriteWallet wallet{std::move(lookup),
-                           std::move(writer)};
+                           std::move(writer),
+                           AddressBook{params.getAddressBookPath()}};
 
     auto port = params.getRpcPort();
     auto threads = params.getNumberOfThreads();
@@ -213,6 +276,8 @@ auto runReadWriteWalletServer(const ProgramOptions& params)
                             JSONRPC_SERVER_V1V2,
                             std::move(wallet)};
     rpcserver.StartListening();
+    auto metrics_server = startMetricsServer(params);
+    auto trace_dumper = startTraceDumper(params);
 
     forge::rpc::waitForShutdown(rpcserver);
 
@@ -0,0 +1,91 @@
+#include <algorithm>
+#include <cstddef>
+#include <lookup/BlockArena.hpp>
+#include <memory>
+#include <memory_resource>
+
+using forge::lookup::BlockArena;
+using forge::lookup::MAX_BLOCK_ARENA_SIZE;
+
+BlockArena::BlockArena(std::size_t initial_size)
+    : buffer_(std::make_unique<std::byte[]>(initial_size)),
+      buffer_size_(initial_size)
+{
+    resource_.emplace(buffer_.get(),
+                      buffer_size_,
+                      &overflow_);
+}
+
+auto BlockArena::getResource()
+    -> std::pmr::memory_resource*
+{
+    return &resource_.value();
+}
+
+auto BlockArena::reset()
+    -> void
+{
+    //gives the overflow back to the heap
+    resource_->release();
+
+    auto needed = buffer_size_ + overflow_.getAllocated();
+    overflow_.clear();
+
+    if(needed == buffer_size_
+       || buffer_size_ >= MAX_BLOCK_ARENA_SIZE) {
+        return;
+    }
+
+    buffer_size_ = std::min(needed, MAX_BLOCK_ARENA_SIZE);
+    resource_.reset();
+    buffer_ = std::make_unique<std::byte[]>(buffer_size_);
+    resource_.emplace(buffer_.get(),
+                      buffer_size_,
+                      &overflow_);
+}
+
+auto BlockArena::getBufferSize() const
+    -> std::size_t
+{
+    return buffer_size_;
+}
+
+auto BlockArena::getOverflowSize() const
+    -> std::size_t
+{
+    return overflow_.getAllocated();
+}
+
+auto BlockArena::OverflowResource::getAllocated() const
+    -> std::size_t
+{
+    return allocated_;
+}
+
+auto BlockArena::OverflowResource::clear()
+    -> void
+{
+    allocated_ = 0;
+}
+
+auto BlockArena::OverflowResource::do_allocate(std::size_t bytes,
+                                               std::size_t alignment)
+    -> void*
+{
+    allocated_ += bytes;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+}
+
+auto BlockArena::OverflowResource::do_deallocate(void* ptr,
+                                                 std::size_t bytes,
+                                                 std::size_t alignment)
+    -> void
+{
+    std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+}
+
+auto BlockArena::OverflowResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+    -> bool
+{
+    return this == &other;
+}
@@ -0,0 +1,253 @@
+#include <algorithm>
+#include <chrono>
+#include <core/Transaction.hpp>
+#include <entrys/token/UtilityTokenOperation.hpp>
+#include <entrys/uentry/UniqueEntryOperation.hpp>
+#include <entrys/umentry/UMEntryOperation.hpp>
+#include <iterator>
+#include <json/value.h>
+#include <lookup/ChangeFeed.hpp>
+#include <mutex>
+#include <utilxx/Overload.hpp>
+#include <variant>
+
+using forge::lookup::ChangeFeed;
+using forge::lookup::ChangeEvent;
+using forge::lookup::operationToJson;
+using forge::core::UMEntryOperation;
+using forge::core::UniqueEntryOperation;
+using forge::core::UtilityTokenOperation;
+
+
+ChangeFeed::ChangeFeed(std::size_t capacity)
+    : mtx_(std::make_unique<std::mutex>()),
+      new_events_(std::make_unique<std::condition_variable>()),
+      next_sequence_(0),
+      capacity_(std::max<std::size_t>(capacity, 1)) {}
+
+template<class Operation>
+auto ChangeFeed::recordOperations(std::int64_t block_height,
+                                  const std::vector<Operation>& ops)
+    -> void
+{
+    if(ops.empty()) {
+        return;
+    }
+
+    //build the json outside of the lock
+    std::vector<Json::Value> jsons;
+    jsons.reserve(ops.size());
+    std::transform(std::cbegin(ops),
+                   std::cend(ops),
+                   std::back_inserter(jsons),
+                   [](const auto& op) {
+                       return operationToJson(op);
+                   });
+
+    std::unique_lock lock{*mtx_};
+    for(auto&& json : jsons) {
+        push(block_height, std::move(json));
+    }
+    lock.unlock();
+
+    new_events_->notify_all();
+}
+
+template auto ChangeFeed::recordOperations(std::int64_t block_height,
+                                           const std::vector<UMEntryOperation>& ops)
+    -> void;
+template auto ChangeFeed::recordOperations(std::int64_t block_height,
+                                           const std::vector<UniqueEntryOperation>& ops)
+    -> void;
+template auto ChangeFeed::recordOperations(std::int64_t block_height,
+                                           const std::vector<UtilityTokenOperation>& ops)
+    -> void;
+
+auto ChangeFeed::recordRollback(std::int64_t first_invalid_block)
+    -> void
+{
+    Json::Value json;
+    json["event"] = "rollback";
+
+    std::unique_lock lock{*mtx_};
+    push(first_invalid_block, std::move(json));
+    lock.unlock();
+
+    new_events_->notify_all();
+}
+
+auto ChangeFeed::getEvents(std::uint64_t since,
+                           std::size_t limit,
+                           std::chrono::milliseconds timeout) const
+    -> std::vector<ChangeEvent>
+{
+    timeout = std::min<std::chrono::milliseconds>(timeout, MAX_CHANGE_FEED_WAIT);
+
+    std::unique_lock lock{*mtx_};
+    new_events_->wait_for(lock,
+                          timeout,
+                          [&] {
+                              return next_sequence_ > since;
+                          });
+
+    std::vector<ChangeEvent> ret_vec;
+    if(events_.empty()) {
+        return ret_vec;
+    }
+
+    //events which were already dropped are skipped,
+    //the subscriber can detect this by comparing the sequences
+    auto first = events_.front().sequence;
+    auto start = since > first ? since - first : 0;
+
+    for(auto idx = start;
+        idx < events_.size() && ret_vec.size() < limit;
+        ++idx) {
+        ret_vec.push_back(events_[idx]);
+    }
+
+    return ret_vec;
+}
+
+auto ChangeFeed::getFirstSequence() const
+    -> std::uint64_t
+{
+    std::unique_lock lock{*mtx_};
+    if(events_.empty()) {
+        return next_sequence_;
+    }
+
+    return events_.front().sequence;
+}
+
+auto ChangeFeed::getNextSequence() const
+    -> std::uint64_t
+{
+    std::unique_lock lock{*mtx_};
+    return next_sequence_;
+}
+
+auto ChangeFeed::push(std::int64_t block_height,
+                      Json::Value&& data)
+    -> void
+{
+    events_.push_back(ChangeEvent{next_sequence_++,
+                                  block_height,
+                                  std::move(data)});
+
+    while(events_.size() > capacity_) {
+        events_.pop_front();
+    }
+}
+
+auto forge::lookup::changeEventToJson(const ChangeEvent& event)
+    -> Json::Value
+{
+    auto json = event.data;
+    json["sequence"] = static_cast<Json::UInt64>(event.sequence);
+    json["height"] = static_cast<Json::Int64>(event.block_height);
+
+    return json;
+}
+
+auto forge::lookup::operationToJson(const UMEntryOperation& operation)
+    -> Json::Value
+{
+    using namespace forge::core;
+
+    Json::Value json;
+    json["event"] = "operation";
+    json["entrytype"] = "umentry";
+    json["key"] = toHexString(getEntryKey(operation));
+    json["owner"] = getOwner(operation);
+    json["burnvalue"] = static_cast<Json::Int64>(getValue(operation));
+
+    std::visit(
+        utilxx::overload{
+            [&](const UMEntryCreationOp& op) {
+                json["operation"] = "creation";
+                json["value"] = umentryValueToJson(op.getUMEntry().getValue());
+            },
+            [&](const UMEntryRenewalOp&) {
+                json["operation"] = "renewal";
+            },
+            [&](const UMEntryOwnershipTransferOp& op) {
+                json["operation"] = "ownershiptransfer";
+                json["newowner"] = op.getNewOwner();
+            },
+            [&](const UMEntryUpdateOp& op) {
+                json["operation"] = "update";
+                json["value"] = umentryValueToJson(op.getUMEntry().getValue());
+            },
+            [&](const UMEntryDeletionOp&) {
+                json["operation"] = "deletion";
+            }},
+        operation);
+
+    return json;
+}
+
+auto forge::lookup::operationToJson(const UniqueEntryOperation& operation)
+    -> Json::Value
+{
+    using namespace forge::core;
+
+    Json::Value json;
+    json["event"] = "operation";
+    json["entrytype"] = "uniqueentry";
+    json["key"] = toHexString(getEntryKey(operation));
+    json["owner"] = getOwner(operation);
+    json["burnvalue"] = static_cast<Json::Int64>(getValue(operation));
+
+    std::visit(
+        utilxx::overload{
+            [&](const UniqueEntryCreationOp& op) {
+                json["operation"] = "creation";
+                json["value"] = uniqueEntryValueToJson(op.getUniqueEntry().getValue());
+            },
+            [&](const UniqueEntryRenewalOp&) {
+                json["operation"] = "renewal";
+            },
+            [&](const UniqueEntryOwnershipTransferOp& op) {
+                json["operation"] = "ownershiptransfer";
+                json["newowner"] = op.getNewOwner();
+            },
+            [&](const UniqueEntryDeletionOp&) {
+                json["operation"] = "deletion";
+            }},
+        operation);
+
+    return json;
+}
+
+auto forge::lookup::operationToJson(const UtilityTokenOperation& operation)
+    -> Json::Value
+{
+    using namespace forge::core;
+
+    Json::Value json;
+    json["event"] = "operation";
+    json["entrytype"] = "utilitytoken";
+    json["token"] = toHexString(getUtilitToken(operation).getId());
+    json["amount"] = std::to_string(getAmount(operation));
+    json["owner"] = getCreator(operation);
+
+    std::visit(
+        utilxx::overload{
+            [&](const UtilityTokenCreationOp& op) {
+                json["operation"] = "creation";
+                json["burnvalue"] = static_cast<Json::Int64>(op.getBurnValue());
+            },
+            [&](const UtilityTokenDeletionOp& op) {
+                json["operation"] = "deletion";
+                json["burnvalue"] = static_cast<Json::Int64>(op.getBurnValue());
+            },
+            [&](const UtilityTokenOwnershipTransferOp& op) {
+                json["operation"] = "ownershiptransfer";
+                json["newowner"] = op.getReciever();
+                json["burnvalue"] = static_cast<Json::Int64>(op.getBurnValue());
+            }},
+        operation);
+
+    return json;
+}
@@ -0,0 +1,129 @@
+#include <algorithm>
+#include <core/ByteSpan.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <lookup/CountingBloomFilter.hpp>
+
+using forge::lookup::CountingBloomFilter;
+using forge::lookup::BLOOM_COUNTERS_PER_KEY;
+using forge::lookup::BLOOM_NUMBER_OF_HASHES;
+using forge::core::ByteSpan;
+
+namespace {
+
+constexpr inline auto MAX_COUNTER = std::numeric_limits<std::uint8_t>::max();
+
+//splitmix64 finalizer, spreads the fnv hash over all bits
+auto mix(std::uint64_t value)
+    -> std::uint64_t
+{
+    value ^= value >> 30;
+    value *= 0xbf58476d1ce4e5b9;
+    value ^= value >> 27;
+    value *= 0x94d049bb133111eb;
+    value ^= value >> 31;
+    return value;
+}
+
+auto hashKey(ByteSpan key)
+    -> std::uint64_t
+{
+    //fnv-1a
+    std::uint64_t hash = 0xcbf29ce484222325;
+    for(auto byte : key) {
+        hash ^= static_cast<std::uint64_t>(byte);
+        hash *= 0x100000001b3;
+    }
+    return hash;
+}
+
+} // namespace
+
+
+CountingBloomFilter::CountingBloomFilter(std::size_t capacity)
+{
+    clear(capacity);
+}
+
+//double hashing, the i-th counter is h1 + i * h2
+template<class Func>
+auto CountingBloomFilter::forEachCounter(ByteSpan key,
+                                         Func&& func) const
+    -> void
+{
+    //a moved from filter has no counters
+    if(counters_.empty()) {
+        return;
+    }
+
+    auto hash = hashKey(key);
+    auto first = mix(hash);
+    //odd, so that it never maps every index to the same counter
+    auto second = mix(hash ^ 0x9e3779b97f4a7c15) | 1;
+
+    for(std::size_t i = 0; i < BLOOM_NUMBER_OF_HASHES; i++) {
+        func((first + i * second) % counters_.size());
+    }
+}
+
+auto CountingBloomFilter::insert(ByteSpan key)
+    -> void
+{
+    forEachCounter(key,
+                   [this](auto index) {
+                       auto& counter = counters_[index];
+                       if(counter != MAX_COUNTER) {
+                           ++counter;
+                       }
+                   });
+    ++size_;
+}
+
+auto CountingBloomFilter::erase(ByteSpan key)
+    -> void
+{
+    forEachCounter(key,
+                   [this](auto index) {
+                       auto& counter = counters_[index];
+                       //saturated counters lost their count
+                       if(counter != MAX_COUNTER && counter != 0) {
+                           --counter;
+                       }
+                   });
+
+    if(size_ > 0) {
+        --size_;
+    }
+}
+
+auto CountingBloomFilter::mayContain(ByteSpan key) const
+    -> bool
+{
+    bool contained{true};
+    forEachCounter(key,
+                   [&](auto index) {
+                       contained &= counters_[index] != 0;
+                   });
+    return contained;
+}
+
+auto CountingBloomFilter::size() const
+    -> std::size_t
+{
+    return size_;
+}
+
+auto CountingBloomFilter::getCapacity() const
+    -> std::size_t
+{
+    return capacity_;
+}
+
+auto CountingBloomFilter::clear(std::size_t capacity)
+    -> void
+{
+    capacity_ = std::max<std::size_t>(capacity, 1);
+    size_ = 0;
+    counters_.assign(capacity_ * BLOOM_COUNTERS_PER_KEY, 0);
+}
@@ -0,0 +1,195 @@
+#include <algorithm>
+#include <cstdint>
+#include <entrys/Entry.hpp>
+#include <iterator>
+#include <lookup/EntryHistory.hpp>
+#include <string>
+#include <utilxx/Opt.hpp>
+#include <variant>
+
+using forge::lookup::EntryHistory;
+using forge::lookup::EntryVersion;
+using forge::lookup::EntryState;
+using forge::core::EntryKey;
+using utilxx::Opt;
+
+auto EntryHistory::record(const EntryKey& key,
+                          std::int64_t block,
+                          Opt<EntryState>&& state)
+    -> void
+{
+    auto iter = history_.find(key);
+
+    //keys which never existed don't need a history
+    if(iter == std::end(history_)) {
+        if(!state) {
+            return;
+        }
+
+        iter = history_.emplace(key, KeyHistory{}).first;
+    }
+
+    auto& history = iter->second;
+    auto& versions = history.versions;
+
+    //drop the replaced version together with the values it added
+    if(!versions.empty()
+       && versions.back().block == block) {
+        versions.pop_back();
+
+        std::size_t values{0};
+        std::size_t activation_blocks{0};
+        if(!versions.empty()) {
+            values = versions.back().value + 1;
+            activation_blocks = versions.back().activation_block + 1;
+        }
+
+        history.values.resize(std::min(values, history.values.size()));
+        history.activation_blocks.resize(std::min(activation_blocks,
+                                                  history.activation_blocks.size()));
+    }
+
+    //a deleted version points to the same values as the one before
+    CompactVersion version{block, 0, 0, 0, EntryKind::Deleted};
+    if(!versions.empty()) {
+        version = versions.back();
+        version.block = block;
+        version.kind = EntryKind::Deleted;
+    }
+
+    if(!state) {
+        versions.push_back(version);
+        return;
+    }
+
+    auto& [entry, owner, activation_block] = state.getValue();
+
+    //only umentrys and unique entrys have a history
+    auto* value = [&]() -> core::UMEntryValue* {
+        if(auto* um_entry = std::get_if<core::UMEntry>(&entry)) {
+            version.kind = EntryKind::UMEntry;
+            return &um_entry->getValue();
+        }
+
+        version.kind = EntryKind::UniqueEntry;
+        return &std::get<core::UniqueEntry>(entry).getValue();
+    }();
+
+    if(history.values.empty()
+       || !(history.values.back() == *value)) {
+        history.values.push_back(std::move(*value));
+    }
+
+    if(history.activation_blocks.empty()
+       || history.activation_blocks.back() != activation_block) {
+        history.activation_blocks.push_back(activation_block);
+    }
+
+    version.value = static_cast<std::uint32_t>(history.values.size() - 1);
+    version.activation_block = static_cast<std::uint32_t>(history.activation_blocks.size() - 1);
+    version.owner = internOwner(std::move(owner));
+
+    versions.push_back(version);
+}
+
+auto EntryHistory::lookupAt(const EntryKey& key,
+                            std::int64_t block) const
+    -> Opt<EntryVersion>
+{
+    auto iter = history_.find(key);
+    if(iter == std::cend(history_)) {
+        return std::nullopt;
+    }
+
+    const auto& versions = iter->second.versions;
+
+    //first version which was created after the given block
+    auto after = std::upper_bound(std::cbegin(versions),
+                                  std::cend(versions),
+                                  block,
+                                  [](auto block, const auto& version) {
+                                      return block < version.block;
+                                  });
+
+    if(after == std::cbegin(versions)) {
+        return std::nullopt;
+    }
+
+    const auto& version = *std::prev(after);
+    if(version.kind == EntryKind::Deleted) {
+        return std::nullopt;
+    }
+
+    return expand(iter->first, iter->second, version);
+}
+
+auto EntryHistory::getVersions(const EntryKey& key) const
+    -> std::vector<EntryVersion>
+{
+    auto iter = history_.find(key);
+    if(iter == std::cend(history_)) {
+        return {};
+    }
+
+    std::vector<EntryVersion> versions;
+    versions.reserve(iter->second.versions.size());
+
+    for(const auto& version : iter->second.versions) {
+        versions.push_back(expand(iter->first, iter->second, version));
+    }
+
+    return versions;
+}
+
+auto EntryHistory::getNumberOfOwners() const
+    -> std::size_t
+{
+    return owners_.size();
+}
+
+auto EntryHistory::clear()
+    -> void
+{
+    history_.clear();
+    owner_ids_.clear();
+    owners_.clear();
+}
+
+auto EntryHistory::internOwner(std::string&& owner)
+    -> std::uint32_t
+{
+    if(auto iter = owner_ids_.find(owner);
+       iter != std::cend(owner_ids_)) {
+        return iter->second;
+    }
+
+    auto id = static_cast<std::uint32_t>(owners_.size());
+    owners_.push_back(std::move(owner));
+    owner_ids_.emplace(owners_.back(), id);
+
+    return id;
+}
+
+auto EntryHistory::expand(const EntryKey& key,
+                          const KeyHistory& history,
+                          const CompactVersion& version) const
+    -> EntryVersion
+{
+    if(version.kind == EntryKind::Deleted) {
+        return EntryVersion{version.block, std::nullopt};
+    }
+
+    const auto& value = history.values[version.value];
+    auto entry = [&]() -> core::Entry {
+        if(version.kind == EntryKind::UMEntry) {
+            return core::UMEntry{key, value};
+        }
+
+        return core::UniqueEntry{key, value};
+    }();
+
+    return EntryVersion{version.block,
+                        EntryState{std::move(entry),
+                                   owners_[version.owner],
+                                   history.activation_blocks[version.activation_block]}};
+}
@@ -0,0 +1,247 @@
+#include <algorithm>
+#include <iterator>
+#include <lookup/EntryKeyIndex.hpp>
+#include <lookup/UMEntryLookup.hpp>
+#include <lookup/UniqueEntryLookup.hpp>
+#include <lookup/UtilityTokenLookup.hpp>
+#include <utilxx/Opt.hpp>
+#include <utility>
+
+using forge::lookup::EntryKeyIndex;
+using forge::lookup::IndexedEntryType;
+using forge::core::EntryKey;
+using utilxx::Opt;
+
+auto EntryKeyIndex::rebuild(const UMEntryLookup& um_entrys,
+                            const UniqueEntryLookup& unique_entrys,
+                            const UtilityTokenLookup& utility_tokens)
+    -> void
+{
+    clear();
+
+    const auto& um_map = um_entrys.getLookupMap();
+    const auto& unique_map = unique_entrys.getLookupMap();
+    const auto& token_map = utility_tokens.getAccountMap();
+
+    records_.reserve(um_map.size()
+                     + unique_map.size()
+                     + token_map.size());
+
+    for(const auto& [key, _] : um_map) {
+        append(key, IndexedEntryType::UMEntry);
+    }
+    auto um_end = records_.size();
+
+    for(const auto& [key, _] : unique_map) {
+        append(key, IndexedEntryType::UniqueEntry);
+    }
+    auto unique_end = records_.size();
+
+    for(const auto& [key, _] : token_map) {
+        append(key, IndexedEntryType::UtilityToken);
+    }
+
+    //every map is already sorted, so merging
+    //the three ranges is enough
+    auto less = [this](const auto& lhs, const auto& rhs) {
+        return std::lexicographical_compare(keyBegin(lhs),
+                                            keyBegin(lhs) + lhs.size,
+                                            keyBegin(rhs),
+                                            keyBegin(rhs) + rhs.size);
+    };
+
+    auto begin = std::begin(records_);
+    std::inplace_merge(begin,
+                       begin + um_end,
+                       begin + unique_end,
+                       less);
+    std::inplace_merge(begin,
+                       begin + unique_end,
+                       std::end(records_),
+                       less);
+}
+
+auto EntryKeyIndex::update(const EntryKey& key,
+                           const std::vector<IndexedEntryType>& types)
+    -> void
+{
+    auto first = std::lower_bound(std::begin(records_),
+                                  std::end(records_),
+                                  key,
+                                  [this](const auto& record, const auto& key) {
+                                      return std::lexicographical_compare(keyBegin(record),
+                                                                          keyBegin(record) + record.size,
+                                                                          std::cbegin(key),
+                                                                          std::cend(key));
+                                  });
+    //a key is at most in every lookup once
+    auto last = std::find_if_not(first,
+                                 std::end(records_),
+                                 [&](const auto& record) {
+                                     return record.size == key.size()
+                                         && std::equal(std::cbegin(key),
+                                                       std::cend(key),
+                                                       keyBegin(record));
+                                 });
+
+    auto unchanged =
+        std::equal(first,
+                   last,
+                   std::cbegin(types),
+                   std::cend(types),
+                   [](const auto& record, auto type) {
+                       return record.type == type;
+                   });
+    if(unchanged) {
+        return;
+    }
+
+    //the records of a key which stays in the index share the existing bytes
+    std::uint32_t offset{0};
+    if(first != last && !types.empty()) {
+        offset = first->offset;
+        unused_bytes_ += (std::distance(first, last) - 1) * key.size();
+    } else if(first != last) {
+        unused_bytes_ += std::distance(first, last) * key.size();
+    } else {
+        offset = static_cast<std::uint32_t>(key_data_.size());
+        key_data_.insert(std::end(key_data_),
+                         std::cbegin(key),
+                         std::cend(key));
+    }
+
+    auto pos = records_.erase(first, last);
+
+    std::vector<IndexRecord> new_records;
+    new_records.reserve(types.size());
+    for(auto type : types) {
+        new_records.push_back(IndexRecord{offset,
+                                          static_cast<std::uint32_t>(key.size()),
+                                          type});
+    }
+    records_.insert(pos,
+                    std::cbegin(new_records),
+                    std::cend(new_records));
+
+    if(unused_bytes_ > key_data_.size() / 2) {
+        compact();
+    }
+}
+
+auto EntryKeyIndex::scan(const EntryKey& prefix,
+                         const Opt<EntryKey>& cursor,
+                         std::size_t limit) const
+    -> ScanResult
+{
+    auto record_less = [this](const auto& record, const auto& key) {
+        return std::lexicographical_compare(keyBegin(record),
+                                            keyBegin(record) + record.size,
+                                            std::cbegin(key),
+                                            std::cend(key));
+    };
+    auto key_less = [this](const auto& key, const auto& record) {
+        return std::lexicographical_compare(std::cbegin(key),
+                                            std::cend(key),
+                                            keyBegin(record),
+                                            keyBegin(record) + record.size);
+    };
+
+    auto iter = std::lower_bound(std::cbegin(records_),
+                                 std::cend(records_),
+                                 prefix,
+                                 record_less);
+
+    //continue after the last key of the previous page
+    if(cursor && !std::lexicographical_compare(std::cbegin(cursor.getValue()),
+                                               std::cend(cursor.getValue()),
+                                               std::cbegin(prefix),
+                                               std::cend(prefix))) {
+        iter = std::upper_bound(iter,
+                                std::cend(records_),
+                                cursor.getValue(),
+                                key_less);
+    }
+
+    ScanResult ret_vec;
+    for(; iter != std::cend(records_) && ret_vec.size() < limit; ++iter) {
+        const auto* begin = keyBegin(*iter);
+
+        if(iter->size < prefix.size()
+           || !std::equal(std::cbegin(prefix),
+                          std::cend(prefix),
+                          begin)) {
+            break;
+        }
+
+        ret_vec.emplace_back(EntryKey(begin, begin + iter->size),
+                             iter->type);
+    }
+
+    return ret_vec;
+}
+
+auto EntryKeyIndex::size() const
+    -> std::size_t
+{
+    return records_.size();
+}
+
+auto EntryKeyIndex::clear()
+    -> void
+{
+    key_data_.clear();
+    records_.clear();
+    unused_bytes_ = 0;
+}
+
+auto EntryKeyIndex::append(const EntryKey& key,
+                           IndexedEntryType type)
+    -> void
+{
+    records_.push_back(IndexRecord{static_cast<std::uint32_t>(key_data_.size()),
+                                   static_cast<std::uint32_t>(key.size()),
+                                   type});
+
+    key_data_.insert(std::end(key_data_),
+                     std::cbegin(key),
+                     std::cend(key));
+}
+
+auto EntryKeyIndex::compact()
+    -> void
+{
+    std::vector<std::byte> key_data;
+    key_data.reserve(key_data_.size() - unused_bytes_);
+
+    //records of the same key are next to each other and share their bytes
+    const std::byte* previous_key{nullptr};
+    std::uint32_t previous_size{0};
+    std::uint32_t previous_offset{0};
+
+    for(auto& record : records_) {
+        const auto* begin = keyBegin(record);
+        auto same_key = previous_key != nullptr
+            && previous_size == record.size
+            && std::equal(begin, begin + record.size, previous_key);
+
+        if(!same_key) {
+            previous_key = begin;
+            previous_size = record.size;
+            previous_offset = static_cast<std::uint32_t>(key_data.size());
+            key_data.insert(std::end(key_data),
+                            begin,
+                            begin + record.size);
+        }
+
+        record.offset = previous_offset;
+    }
+
+    key_data_ = std::move(key_data);
+    unused_bytes_ = 0;
+}
+
+auto EntryKeyIndex::keyBegin(const IndexRecord& record) const
+    -> const std::byte*
+{
+    return key_data_.data() + record.offset;
+}
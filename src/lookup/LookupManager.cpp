@@ -5,20 +5,47 @@
 #include <entrys/token/UtilityToken.hpp>
 #include <entrys/token/UtilityTokenOperation.hpp>
 #include <entrys/umentry/UMEntryOperation.hpp>
+#include <env/AsyncLogger.hpp>
 #include <fmt/format.h>
 #include <functional>
 #include <g3log/g3log.hpp>
 #include <iterator>
+#include <lookup/BlockArena.hpp>
+#include <lookup/ChangeFeed.hpp>
+#include <lookup/CountingBloomFilter.hpp>
+#include <lookup/EntryKeyIndex.hpp>
+#include <lookup/LookupChangeSet.hpp>
+#include <lookup/EntryHistory.hpp>
 #include <lookup/LookupManager.hpp>
+#include <lookup/OperationFilter.hpp>
+#include <lookup/PendingOperations.hpp>
+#include <lookup/SharedLookupPublisher.hpp>
 #include <lookup/UMEntryLookup.hpp>
+#include <map>
 #include <memory>
+#include <memory_resource>
+#include <metrics/Metrics.hpp>
+#include <metrics/Trace.hpp>
+#include <mutex>
 #include <shared_mutex>
 #include <utilxx/Opt.hpp>
 #include <utilxx/Overload.hpp>
 #include <utilxx/Result.hpp>
 
 using forge::lookup::LookupManager;
+using forge::lookup::BlockArena;
 using forge::lookup::LookupError;
+using forge::lookup::ChangeFeed;
+using forge::lookup::EntryState;
+using forge::lookup::EntryVersion;
+using forge::lookup::IndexedEntryType;
+using forge::lookup::LookupChangeSet;
+using forge::lookup::MAX_LOOKUP_CHANGE_SETS;
+using forge::lookup::INITIAL_RESERVED_KEY_CAPACITY;
+using forge::lookup::SharedLookupPublisher;
+using forge::lookup::PendingOperations;
+using forge::lookup::PendingOperationVariant;
+using forge::lookup::PendingTransaction;
 using forge::core::EntryKey;
 using forge::core::UMEntryValue;
 using forge::core::UMEntryOperation;
@@ -29,19 +56,64 @@ using utilxx::Result;
 using utilxx::traverse;
 using forge::client::ReadOnlyClientBase;
 
+namespace {
+
+auto sortAndDeduplicate(std::pmr::vector<const forge::core::EntryKey*>& keys)
+    -> void
+{
+    std::sort(std::begin(keys),
+              std::end(keys),
+              [](auto* lhs, auto* rhs) {
+                  return *lhs < *rhs;
+              });
+    keys.erase(std::unique(std::begin(keys),
+                           std::end(keys),
+                           [](auto* lhs, auto* rhs) {
+                               return *lhs == *rhs;
+                           }),
+               std::end(keys));
+}
+
+auto recordOperationMetrics(const std::string& lookup,
+                            std::size_t parsed,
+                            std::size_t applied)
+    -> void
+{
+    auto& registry = forge::metrics::getRegistry();
+    static const auto help = "forge operations found in blocks, by lookup and if they were applied";
+
+    registry.counter("forge_lookup_operations_total",
+                     help,
+                     {{"lookup", lookup}, {"state", "applied"}})
+        .increment(applied);
+    registry.counter("forge_lookup_operations_total",
+                     help,
+                     {{"lookup", lookup}, {"state", "filtered"}})
+        .increment(parsed - applied);
+}
+
+} // namespace
+
 LookupManager::LookupManager(std::unique_ptr<client::ReadOnlyClientBase>&& client)
     : client_(std::move(client)),
       rw_mtx_(std::make_unique<std::shared_mutex>()),
       um_entry_lookup_(this, getStartingBlock(client_->getCoin())),
       unique_entry_lookup_(this, getStartingBlock(client_->getCoin())),
-      utility_token_lookup_(this, core::getStartingBlock(client_->getCoin()))
+      utility_token_lookup_(this, core::getStartingBlock(client_->getCoin())),
+      lookup_block_height_(core::getStartingBlock(client_->getCoin())),
+      next_change_set_(0),
+      block_arena_(std::make_unique<BlockArena>()),
+      reserved_keys_(INITIAL_RESERVED_KEY_CAPACITY),
+      pending_mtx_(std::make_unique<std::mutex>())
 {}
 
 auto LookupManager::updateLookup()
     -> utilxx::Result<bool, ManagerError>
 {
+    metrics::TraceSpan span{"updateLookup"};
+
     //aquire writer lock
-    std::unique_lock lock{*rw_mtx_};
+    auto lock = lockExclusive();
     const auto maturity = getMaturity(client_->getCoin());
 
     return client_->getBlockCount()
@@ -61,6 +133,8 @@ auto LookupManager::updateLookup()
 
             //process missing blocks
             while(actual_height - maturity > lookup_block_height_) {
+                metrics::TraceSpan block_span{"fetchAndProcessBlock",
+                                              lookup_block_height_ + 1};
                 auto res =
                     //get block hash
                     client_->getBlockHash(++lookup_block_height_)
@@ -76,14 +150,29 @@ auto LookupManager::updateLookup()
                             return processBlock(std::move(block));
                         });
 
-                //if an error occured return the error
+                //if an error occured return the error, the blocks
+                //before are applied and still have to be published.
+                //the failed block is tried again with the next update
                 if(!res) {
+                    --lookup_block_height_;
+                    if(new_block_added) {
+                        metrics::TraceSpan publish_span{"publishLookup"};
+                        publishSharedLookup();
+                    }
                     return res.getError();
                 }
 
                 new_block_added = true;
             }
 
+            //make the new state visible to local readers
+            if(new_block_added) {
+                metrics::TraceSpan publish_span{"publishLookup"};
+                publishSharedLookup();
+            }
+
+            updateSizeMetrics(actual_height);
+
             return new_block_added;
         });
 }
@@ -91,9 +180,23 @@ auto LookupManager::updateLookup()
 auto LookupManager::rebuildLookup()
     -> utilxx::Result<void, ManagerError>
 {
-    std::unique_lock lock{*rw_mtx_};
+    auto lock = lockExclusive();
     um_entry_lookup_.clear();
     unique_entry_lookup_.clear();
+    utility_token_lookup_.clear();
+    block_hashes_.clear();
+    entry_history_.clear();
+    key_index_.clear();
+    reserved_keys_.clear(INITIAL_RESERVED_KEY_CAPACITY);
+
+    //skip one generation, so that every consumer notices
+    //that it missed changes and rescans
+    change_sets_.clear();
+    ++next_change_set_;
+    lookup_block_height_ = getStartingBlock(client_->getCoin());
+
+    //subscribers have to drop everything after the starting block
+    change_feed_.recordRollback(lookup_block_height_ + 1);
     lock.unlock();
 
     if(auto res = updateLookup();
@@ -104,17 +207,185 @@ auto LookupManager::rebuildLookup()
     return {};
 }
 
+auto LookupManager::setTrackPendingOperations(bool track)
+    -> void
+{
+    track_pending_ = track;
+    if(!track) {
+        pending_operations_.clear();
+    }
+}
+
+auto LookupManager::updatePendingOperations()
+    -> utilxx::Result<void, ManagerError>
+{
+    if(!track_pending_) {
+        return {};
+    }
+
+    metrics::TraceSpan span{"updatePendingOperations"};
+    std::lock_guard pending_lock{*pending_mtx_};
+
+    //everything after the last block of the lookup is pending
+    auto first_block = [&] {
+        auto lock = lockShared();
+        return lookup_block_height_ + 1;
+    }();
+
+    auto height_res = client_->getBlockCount();
+    if(!height_res) {
+        return ManagerError{std::move(height_res.getError())};
+    }
+    auto height = height_res.getValue();
+
+    std::vector<std::pair<std::string, Opt<std::int64_t>>> txids;
+
+    for(auto block_height = first_block; block_height <= height; block_height++) {
+        auto block_res =
+            client_->getBlockHash(block_height)
+                .flatMap([&](auto block_hash) {
+                    return client_->getBlock(std::move(block_hash));
+                });
+        if(!block_res) {
+            return ManagerError{std::move(block_res.getError())};
+        }
+
+        for(auto&& txid : block_res.getValue().getTxids()) {
+            txids.emplace_back(std::move(txid),
+                               Opt<std::int64_t>{block_height});
+        }
+    }
+
+    auto mempool_res = client_->getRawMempool();
+    if(!mempool_res) {
+        return ManagerError{std::move(mempool_res.getError())};
+    }
+
+    for(auto&& txid : mempool_res.getValue()) {
+        txids.emplace_back(std::move(txid),
+                           std::nullopt);
+    }
+
+    std::map<std::string, PendingTransaction> transactions;
+
+    for(auto&& [txid, block_height] : txids) {
+        //only transactions which are new or were mined since are fetched
+        if(auto known_opt = pending_operations_.getTransaction(txid, block_height);
+           known_opt) {
+            transactions.emplace(std::move(txid),
+                                 std::move(known_opt.getValue()));
+            continue;
+        }
+
+        auto tx_res = client_->getTransaction(txid);
+        if(!tx_res) {
+            //transactions can leave the mempool at any time
+            FORGE_LOG(WARNING, "{}", tx_res.getError().what());
+            continue;
+        }
+
+        //transactions of the mempool can be in the next block at the earliest
+        auto parse_height = block_height ? block_height.getValue() : height + 1;
+        auto operations = parsePendingTransaction(tx_res.getValue(),
+                                                  parse_height);
+
+        transactions.emplace(std::move(txid),
+                             PendingTransaction{block_height,
+                                                std::move(operations)});
+    }
+
+    pending_operations_.replace(std::move(transactions));
+
+    static auto& pending_size =
+        metrics::getRegistry().gauge("forge_lookup_pending_operations",
+                                     "forge operations in the mempool and in immature blocks");
+    pending_size.set(static_cast<std::int64_t>(pending_operations_.size()));
+
+    return {};
+}
+
+auto LookupManager::setSharedLookupPublisher(std::unique_ptr<SharedLookupPublisher>&& publisher)
+    -> void
+{
+    auto lock = lockExclusive();
+    shared_publisher_ = std::move(publisher);
+    publishSharedLookup();
+}
+
+auto LookupManager::publishSharedLookup()
+    -> void
+{
+    if(!shared_publisher_) {
+        return;
+    }
+
+    auto res = shared_publisher_->publish(um_entry_lookup_,
+                                          unique_entry_lookup_,
+                                          utility_token_lookup_,
+                                          lookup_block_height_);
+    if(!res) {
+        LOG(WARNING) << res.getError().what();
+    }
+}
+
+auto LookupManager::lockShared() const
+    -> std::shared_lock<std::shared_mutex>
+{
+    static auto& wait_time =
+        metrics::getRegistry().histogram("forge_lookup_lock_wait_seconds",
+                                         "time spent waiting for the lookup lock",
+                                         {{"mode", "shared"}});
+
+    metrics::ScopedTimer timer{wait_time};
+    return std::shared_lock{*rw_mtx_};
+}
+
+auto LookupManager::lockExclusive() const
+    -> std::unique_lock<std::shared_mutex>
+{
+    static auto& wait_time =
+        metrics::getRegistry().histogram("forge_lookup_lock_wait_seconds",
+                                         "time spent waiting for the lookup lock",
+                                         {{"mode", "exclusive"}});
+
+    metrics::ScopedTimer timer{wait_time};
+    return std::unique_lock{*rw_mtx_};
+}
+
+auto LookupManager::updateSizeMetrics(std::int64_t actual_height) const
+    -> void
+{
+    auto& registry = metrics::getRegistry();
+    static const auto size_help = "number of entries in a lookup table";
+
+    registry.gauge("forge_lookup_size", size_help, {{"lookup", "umentry"}})
+        .set(um_entry_lookup_.getLookupMap().size());
+    registry.gauge("forge_lookup_size", size_help, {{"lookup", "uniqueentry"}})
+        .set(unique_entry_lookup_.getLookupMap().size());
+    registry.gauge("forge_lookup_size", size_help, {{"lookup", "utilitytoken"}})
+        .set(utility_token_lookup_.getNumberOfTokens());
+
+    registry.gauge("forge_lookup_block_height",
+                   "height of the last block processed by the lookup")
+        .set(lookup_block_height_);
+    registry.gauge("forge_lookup_sync_lag_blocks",
+                   "mature blocks the lookup has not processed yet")
+        .set(actual_height
+             - getMaturity(client_->getCoin())
+             - lookup_block_height_);
+}
+
 auto LookupManager::lookupUMValue(const core::EntryKey& key) const
     -> utilxx::Opt<std::reference_wrapper<const core::UMEntryValue>>
 {
-    std::shared_lock lock{*rw_mtx_};
+    auto lock = lockShared();
     return um_entry_lookup_.lookup(key);
 }
 
 auto LookupManager::lookupUniqueValue(const core::EntryKey& key) const
     -> utilxx::Opt<std::reference_wrapper<const core::UniqueEntryValue>>
 {
-    std::shared_lock lock{*rw_mtx_};
+    auto lock = lockShared();
     return unique_entry_lookup_.lookup(key);
 }
 
@@ -143,7 +414,7 @@ auto LookupManager::lookup(const core::EntryKey& key) const
 auto LookupManager::lookupOwner(const core::EntryKey& key) const
     -> utilxx::Opt<std::reference_wrapper<const std::string>>
 {
-    std::shared_lock lock{*rw_mtx_};
+    auto lock = lockShared();
     auto um_owner_opt = um_entry_lookup_.lookupOwner(key);
 
     if(um_owner_opt) {
@@ -156,7 +427,7 @@ auto LookupManager::lookupOwner(const core::EntryKey& key) const
 auto LookupManager::lookupActivationBlock(const core::EntryKey& key) const
     -> utilxx::Opt<std::reference_wrapper<const std::int64_t>>
 {
-    std::shared_lock lock{*rw_mtx_};
+    auto lock = lockShared();
 
     auto um_block_op = um_entry_lookup_.lookupActivationBlock(key);
     if(um_block_op) {
@@ -182,13 +453,13 @@ auto LookupManager::processUMEntrys(const std::vector<core::Transaction>& txs,
                                                 client_.get());
         //if we dont get an opt, but an error we log it
         if(!op_res) {
-            LOG(WARNING) << op_res.getError().what();
+            FORGE_LOG(WARNING, "{}", op_res.getError().what());
             continue;
         }
 
-        LOG_IF(DEBUG, op_res.getValue().hasValue())
-            << "found unique modifiable entry operation "
-            << txid;
+        if(op_res.getValue().hasValue()) {
+            FORGE_LOG(DEBUG, "found unique modifiable entry operation {}", txid);
+        }
 
         //check if the operation was parsed, and if
         //we add it to the std::vector<UMEntryOperation> vec
@@ -216,13 +487,13 @@ auto LookupManager::processUniqueEntrys(const std::vector<core::Transaction>& tx
                                                     client_.get());
         //if we dont get an opt, but an error we log it
         if(!op_res) {
-            LOG(WARNING) << op_res.getError().what();
+            FORGE_LOG(WARNING, "{}", op_res.getError().what());
             continue;
         }
 
-        LOG_IF(DEBUG, op_res.getValue().hasValue())
-            << "found unique immutable entry operation "
-            << txid;
+        if(op_res.getValue().hasValue()) {
+            FORGE_LOG(DEBUG, "found unique immutable entry operation {}", txid);
+        }
 
         //check if the operation was parsed, and if
         //we add it to the std::vector<UMEntryOperation> vec
@@ -250,13 +521,13 @@ auto LookupManager::processUtilityTokens(const std::vector<core::Transaction>& t
                                                              client_.get());
         //if we dont get an opt, but an error we log it
         if(!op_res) {
-            LOG(WARNING) << op_res.getError().what();
+            FORGE_LOG(WARNING, "{}", op_res.getError().what());
             continue;
         }
 
-        LOG_IF(DEBUG, op_res.getValue().hasValue())
-            << "found unique immutable entry operation "
-            << txid;
+        if(op_res.getValue().hasValue()) {
+            FORGE_LOG(DEBUG, "found utility token operation {}", txid);
+        }
 
         //check if the operation was parsed, and if
         //we add it to the std::vector<UMEntryOperation> vec
@@ -275,9 +546,21 @@ auto LookupManager::processBlock(core::Block&& block)
     auto block_height = block.getHeight();
     auto block_hash = std::move(block.getHash());
 
+    metrics::TraceSpan span{"processBlock", block_height};
+
+    //everything the previous block left in the arena
+    //is dead by now
+    block_arena_->reset();
+
+    static auto& arena_size =
+        metrics::getRegistry().gauge("forge_lookup_block_arena_bytes",
+                                     "bytes preallocated for the transient data of a block");
+    arena_size.set(static_cast<std::int64_t>(block_arena_->getBufferSize()));
+
     //traverse all txids to transactions
-    auto txs_res =
-        traverse(
+    auto txs_res = [&] {
+        metrics::TraceSpan fetch_span{"fetchTransactions", block_height};
+        return traverse(
             std::move(block.getTxids()),
             [this](auto txid) {
                 return client_
@@ -286,6 +569,7 @@ auto LookupManager::processBlock(core::Block&& block)
                         return ManagerError{std::move(error)};
                     });
             });
+    }();
 
     //check if an error occured
     if(!txs_res) {
@@ -299,16 +583,329 @@ auto LookupManager::processBlock(core::Block&& block)
         parseAndFilter(std::move(transactions),
                        block_height);
 
-    um_entry_lookup_.executeOperations(std::move(um_ops));
-    unique_entry_lookup_.executeOperations(std::move(unique_ops));
-    utility_token_lookup_.executeOperations(std::move(utility_ops));
+    LookupChangeSet change_set;
+    change_set.block_height = block_height;
+
+    //every lookup is filtered and applied before the next one is filtered,
+    //because the validity checks of the unique entrys and the tokens read the
+    //keys the um entrys of the same block created or deleted.
+    //filtering first makes the change feed only see applied operations
+    {
+        auto parsed = um_ops.size();
+        um_ops = um_entry_lookup_.filterNonRelevantOperations(std::move(um_ops));
+        recordOperationMetrics("umentry", parsed, um_ops.size());
+        change_feed_.recordOperations(block_height, um_ops);
+        addToChangeSet(change_set, um_ops);
+
+        auto touched_keys = collectTouchedKeys(change_set.um_entry_keys);
+        reserveKeys(touched_keys);
+        um_entry_lookup_.applyOperations(std::move(um_ops));
+        releaseKeys(touched_keys);
+    }
+    {
+        auto parsed = unique_ops.size();
+        unique_ops = unique_entry_lookup_.filterNonRelevantOperations(std::move(unique_ops));
+        recordOperationMetrics("uniqueentry", parsed, unique_ops.size());
+        change_feed_.recordOperations(block_height, unique_ops);
+        addToChangeSet(change_set, unique_ops);
+
+        auto touched_keys = collectTouchedKeys(change_set.unique_entry_keys);
+        reserveKeys(touched_keys);
+        unique_entry_lookup_.applyOperations(std::move(unique_ops));
+        releaseKeys(touched_keys);
+    }
+    {
+        auto parsed = utility_ops.size();
+        utility_ops = utility_token_lookup_.filterNonRelevantOperations(std::move(utility_ops));
+        recordOperationMetrics("utilitytoken", parsed, utility_ops.size());
+        change_feed_.recordOperations(block_height, utility_ops);
+        addToChangeSet(change_set, utility_ops);
+
+        auto touched_keys = collectTouchedKeys(change_set.token_accounts);
+        reserveKeys(touched_keys);
+        utility_token_lookup_.applyOperations(std::move(utility_ops));
+        releaseKeys(touched_keys);
+    }
+
+    if(reserved_keys_.size() > reserved_keys_.getCapacity()) {
+        rebuildReservedKeyFilter(2 * reserved_keys_.size());
+    }
+
+    {
+        metrics::TraceSpan history_span{"recordHistory", block_height};
+        recordHistory(change_set.um_entry_keys, block_height);
+        recordHistory(change_set.unique_entry_keys, block_height);
+    }
+
+    updateKeyIndex(change_set);
+
+    change_sets_.push_back(std::move(change_set));
+    if(change_sets_.size() > MAX_LOOKUP_CHANGE_SETS) {
+        change_sets_.pop_front();
+    }
+    ++next_change_set_;
 
     //add blockhash to the processed blocks
     block_hashes_.push_back(std::move(block_hash));
 
+    static auto& processed_blocks =
+        metrics::getRegistry().counter("forge_lookup_blocks_processed_total",
+                                       "blocks processed by the lookup");
+    processed_blocks.increment();
+
     return {};
 }
 
+auto LookupManager::lookupEntryState(const core::EntryKey& key) const
+    -> utilxx::Opt<EntryState>
+{
+    if(auto um_entry = um_entry_lookup_.lookupUMEntry(key);
+       um_entry) {
+        auto [value, owner, block] = um_entry.getValue();
+        return EntryState{core::Entry{core::UMEntry{key, value.get()}},
+                          owner.get(),
+                          block.get()};
+    }
+
+    if(auto unique_entry = unique_entry_lookup_.lookupUniqueEntry(key);
+       unique_entry) {
+        auto [value, owner, block] = unique_entry.getValue();
+        return EntryState{core::Entry{core::UniqueEntry{key, value.get()}},
+                          owner.get(),
+                          block.get()};
+    }
+
+    return std::nullopt;
+}
+
+auto LookupManager::recordHistory(const std::vector<core::EntryKey>& keys,
+                                  std::int64_t block_height)
+    -> void
+{
+    for(const auto& key : keys) {
+        entry_history_.record(key,
+                              block_height,
+                              lookupEntryState(key));
+    }
+}
+
+auto LookupManager::collectTouchedKeys(const std::vector<core::EntryKey>& entry_keys)
+    -> std::pmr::vector<const core::EntryKey*>
+{
+    std::pmr::vector<const core::EntryKey*> keys{block_arena_->getResource()};
+    keys.reserve(entry_keys.size());
+
+    for(const auto& key : entry_keys) {
+        keys.push_back(&key);
+    }
+
+    sortAndDeduplicate(keys);
+    return keys;
+}
+
+auto LookupManager::collectTouchedKeys(const std::vector<std::pair<core::EntryKey, std::string>>& token_accounts)
+    -> std::pmr::vector<const core::EntryKey*>
+{
+    std::pmr::vector<const core::EntryKey*> keys{block_arena_->getResource()};
+    keys.reserve(token_accounts.size());
+
+    for(const auto& [token, _] : token_accounts) {
+        keys.push_back(&token);
+    }
+
+    sortAndDeduplicate(keys);
+    return keys;
+}
+
+auto LookupManager::reserveKeys(const std::pmr::vector<const core::EntryKey*>& keys)
+    -> void
+{
+    for(const auto* key : keys) {
+        if(!isKeyInLookups(*key)) {
+            reserved_keys_.insert(*key);
+        }
+    }
+}
+
+auto LookupManager::releaseKeys(const std::pmr::vector<const core::EntryKey*>& keys)
+    -> void
+{
+    for(const auto* key : keys) {
+        if(!isKeyInLookups(*key)) {
+            reserved_keys_.erase(*key);
+        }
+    }
+}
+
+auto LookupManager::updateKeyIndex(const LookupChangeSet& change_set)
+    -> void
+{
+    const auto& accounts = utility_token_lookup_.getAccountMap();
+    std::vector<IndexedEntryType> types;
+
+    auto update = [&](const core::EntryKey& key) {
+        types.clear();
+        if(um_entry_lookup_.lookup(key)) {
+            types.push_back(IndexedEntryType::UMEntry);
+        }
+        if(unique_entry_lookup_.lookup(key)) {
+            types.push_back(IndexedEntryType::UniqueEntry);
+        }
+        if(accounts.find(key) != std::cend(accounts)) {
+            types.push_back(IndexedEntryType::UtilityToken);
+        }
+        key_index_.update(key, types);
+    };
+
+    for(const auto& key : change_set.um_entry_keys) {
+        update(key);
+    }
+    for(const auto& key : change_set.unique_entry_keys) {
+        update(key);
+    }
+    for(const auto& [token, _] : change_set.token_accounts) {
+        update(token);
+    }
+}
+
+auto LookupManager::isKeyInLookups(const core::EntryKey& key) const
+    -> bool
+{
+    const auto& accounts = utility_token_lookup_.getAccountMap();
+
+    return um_entry_lookup_.lookup(key)
+        || unique_entry_lookup_.lookup(key)
+        || accounts.find(key) != std::cend(accounts);
+}
+
+auto LookupManager::rebuildReservedKeyFilter(std::size_t capacity)
+    -> void
+{
+    reserved_keys_.clear(std::max(capacity, INITIAL_RESERVED_KEY_CAPACITY));
+
+    for(const auto& [key, _] : um_entry_lookup_.getLookupMap()) {
+        reserved_keys_.insert(key);
+    }
+    for(const auto& [key, _] : unique_entry_lookup_.getLookupMap()) {
+        reserved_keys_.insert(key);
+    }
+    for(const auto& [token, _] : utility_token_lookup_.getAccountMap()) {
+        reserved_keys_.insert(token);
+    }
+}
+
+auto LookupManager::addToChangeSet(LookupChangeSet& change_set,
+                                   const std::vector<core::UMEntryOperation>& ops) const
+    -> void
+{
+    change_set.um_entry_keys.reserve(ops.size());
+    for(const auto& op : ops) {
+        change_set.um_entry_keys.push_back(getEntryKey(op));
+    }
+}
+
+auto LookupManager::addToChangeSet(LookupChangeSet& change_set,
+                                   const std::vector<core::UniqueEntryOperation>& ops) const
+    -> void
+{
+    change_set.unique_entry_keys.reserve(ops.size());
+    for(const auto& op : ops) {
+        change_set.unique_entry_keys.push_back(getEntryKey(op));
+    }
+}
+
+auto LookupManager::addToChangeSet(LookupChangeSet& change_set,
+                                   const std::vector<core::UtilityTokenOperation>& ops) const
+    -> void
+{
+    for(const auto& op : ops) {
+        const auto& token = core::getUtilitToken(op).getId();
+        change_set.token_accounts.emplace_back(token,
+                                               core::getCreator(op));
+
+        if(const auto* transfer = std::get_if<core::UtilityTokenOwnershipTransferOp>(&op)) {
+            change_set.token_accounts.emplace_back(token,
+                                                   transfer->getReciever());
+        }
+    }
+}
+
+auto LookupManager::getChangeSetGeneration() const
+    -> std::uint64_t
+{
+    auto lock = lockShared();
+    return next_change_set_;
+}
+
+auto LookupManager::getChangeSetsSince(std::uint64_t generation) const
+    -> utilxx::Opt<std::vector<LookupChangeSet>>
+{
+    auto lock = lockShared();
+
+    auto first = next_change_set_ - change_sets_.size();
+    if(generation < first || generation > next_change_set_) {
+        return std::nullopt;
+    }
+
+    return std::vector<LookupChangeSet>(std::cbegin(change_sets_) + (generation - first),
+                                        std::cend(change_sets_));
+}
+
+auto LookupManager::lookupAt(const core::EntryKey& key,
+                             std::int64_t block) const
+    -> utilxx::Opt<EntryVersion>
+{
+    auto lock = lockShared();
+
+    return entry_history_.lookupAt(key, block);
+}
+
+auto LookupManager::scanEntrys(const core::EntryKey& prefix,
+                               const utilxx::Opt<core::EntryKey>& cursor,
+                               std::size_t limit) const
+    -> std::vector<core::Entry>
+{
+    auto lock = lockShared();
+
+    auto keys = key_index_.scan(prefix, cursor, limit);
+
+    std::vector<core::Entry> ret_vec;
+    ret_vec.reserve(keys.size());
+
+    //keys which do not resolve anymore are skipped,
+    //the index should never hold them though
+    for(auto&& [key, type] : keys) {
+        switch(type) {
+        case IndexedEntryType::UMEntry: {
+            auto value = um_entry_lookup_.lookup(key);
+            if(!value) {
+                break;
+            }
+            ret_vec.emplace_back(core::UMEntry{std::move(key),
+                                               value.getValue().get()});
+            break;
+        }
+        case IndexedEntryType::UniqueEntry: {
+            auto value = unique_entry_lookup_.lookup(key);
+            if(!value) {
+                break;
+            }
+            ret_vec.emplace_back(core::UniqueEntry{std::move(key),
+                                                   value.getValue().get()});
+            break;
+        }
+        case IndexedEntryType::UtilityToken: {
+            auto supply = utility_token_lookup_.getSupplyOfToken(key);
+            ret_vec.emplace_back(core::UtilityToken{std::move(key),
+                                                    supply});
+            break;
+        }
+        }
+    }
+
+    return ret_vec;
+}
+
 auto LookupManager::lookupIsValid() const
     -> utilxx::Result<bool, client::ClientError>
 {
@@ -327,7 +924,7 @@ auto LookupManager::getLastValidBlockHeight() const
 {
     auto starting_block = getStartingBlock(client_->getCoin());
 
-    std::shared_lock lock{*rw_mtx_};
+    auto lock = lockShared();
     for(auto&& hash : block_hashes_) {
         if(auto res = client_->getBlockHash(++starting_block);
            res) {
@@ -345,7 +942,7 @@ auto LookupManager::getLastValidBlockHeight() const
 auto LookupManager::getUMEntrysOfOwner(const std::string& owner) const
     -> std::vector<core::UMEntry>
 {
-    std::shared_lock lock{*rw_mtx_};
+    auto lock = lockShared();
     return um_entry_lookup_.getUMEntrysOfOwner(owner);
 }
 
@@ -353,14 +950,14 @@ auto LookupManager::getUMEntrysOfOwner(const std::string& owner) const
 auto LookupManager::getUniqueEntrysOfOwner(const std::string& owner) const
     -> std::vector<core::UniqueEntry>
 {
-    std::shared_lock lock{*rw_mtx_};
+    auto lock = lockShared();
     return unique_entry_lookup_.getUniqueEntrysOfOwner(owner);
 }
 
 auto LookupManager::getUtilityTokensOfOwner(const std::string& owner) const
     -> std::vector<core::UtilityToken>
 {
-    std::shared_lock lock{*rw_mtx_};
+    auto lock = lockShared();
     return utility_token_lookup_.getUtilityTokensOfOwner(owner);
 }
 
@@ -368,7 +965,7 @@ auto LookupManager::getUtilityTokenCreditOf(const std::string& owner,
                                             const std::vector<std::byte>& token) const
     -> std::uint64_t
 {
-    std::shared_lock lock{*rw_mtx_};
+    auto lock = lockShared();
     return utility_token_lookup_.getAvailableBalanceOf(owner,
                                                        token);
 }
@@ -376,14 +973,14 @@ auto LookupManager::getUtilityTokenCreditOf(const std::string& owner,
 auto LookupManager::getSupplyOfToken(const std::vector<std::byte>& token) const
     -> std::uint64_t
 {
-    std::shared_lock lock{*rw_mtx_};
+    auto lock = lockShared();
     return utility_token_lookup_.getSupplyOfToken(token);
 }
 
 auto LookupManager::getNumberOfExisitingTokens() const
     -> std::int64_t
 {
-    std::shared_lock lock{*rw_mtx_};
+    auto lock = lockShared();
     return utility_token_lookup_.getNumberOfTokens();
 }
 
@@ -423,6 +1020,23 @@ auto LookupManager::getEntrysOfOwner(const std::string& owner) const
 auto LookupManager::isReserverdEntryKey(const std::vector<std::byte>& key) const
     -> bool
 {
+    static auto& filtered_checks =
+        metrics::getRegistry().counter("forge_lookup_reserved_key_checks_total",
+                                       "checks for reserved keys",
+                                       {{"result", "filtered"}});
+    static auto& looked_up_checks =
+        metrics::getRegistry().counter("forge_lookup_reserved_key_checks_total",
+                                       "checks for reserved keys",
+                                       {{"result", "looked_up"}});
+
+    //most keys of new entrys are free, which the filter
+    //answers without searching three lookups
+    if(!reserved_keys_.mayContain(key)) {
+        filtered_checks.increment();
+        return false;
+    }
+    looked_up_checks.increment();
+
     auto unique_opt = unique_entry_lookup_.lookup(key);
     auto um_opt = um_entry_lookup_.lookup(key);
     auto utility_token_opt = utility_token_lookup_.getSupplyOfToken(key);
@@ -447,6 +1061,18 @@ auto forge::lookup::generateMessage(ManagerError&& error)
                       std::move(error));
 }
 
+auto LookupManager::getChangeFeed() const
+    -> const ChangeFeed&
+{
+    return change_feed_;
+}
+
+auto LookupManager::getPendingOperations() const
+    -> const PendingOperations&
+{
+    return pending_operations_;
+}
+
 auto LookupManager::getClient() const
     -> const client::ReadOnlyClientBase&
 {
@@ -460,17 +1086,54 @@ auto LookupManager::getCoin() const
 }
 
 
+auto LookupManager::parsePendingTransaction(const core::Transaction& tx,
+                                            std::int64_t block_height) const
+    -> std::vector<PendingOperationVariant>
+{
+    std::vector<PendingOperationVariant> operations;
+
+    //getting an error instead of an Opt indicates a wallet error
+    auto log_error = [](const auto& error) {
+        FORGE_LOG(WARNING, "{}", error.what());
+    };
+
+    if(auto um_res = core::parseTransactionToUMEntry(tx, block_height, client_.get());
+       !um_res) {
+        log_error(um_res.getError());
+    } else if(um_res.getValue()) {
+        operations.emplace_back(std::move(um_res.getValue().getValue()));
+    }
+
+    if(auto unique_res = core::parseTransactionToUniqueEntry(tx, block_height, client_.get());
+       !unique_res) {
+        log_error(unique_res.getError());
+    } else if(unique_res.getValue()) {
+        operations.emplace_back(std::move(unique_res.getValue().getValue()));
+    }
+
+    if(auto utility_res = core::parseTransactionToUtilityTokenOp(tx, block_height, client_.get());
+       !utility_res) {
+        log_error(utility_res.getError());
+    } else if(utility_res.getValue()) {
+        operations.emplace_back(std::move(utility_res.getValue().getValue()));
+    }
+
+    return operations;
+}
+
 auto LookupManager::extractUMEntryOperations(const std::vector<core::Transaction>& txs,
                                              std::int64_t block_height)
-    -> std::vector<core::UMEntryOperation>
+    -> std::pmr::vector<core::UMEntryOperation>
 {
-    std::vector<core::UMEntryOperation> um_ops;
+    metrics::TraceSpan span{"extractUMEntryOperations", block_height};
+
+    std::pmr::vector<core::UMEntryOperation> um_ops{block_arena_->getResource()};
 
     for(const auto& tx : txs) {
         auto um_res = core::parseTransactionToUMEntry(tx, block_height, client_.get());
         if(!um_res) {
             //getting an error instead of an Opt indicates a wallet error
-            LOG(WARNING) << um_res.getError().what();
+            FORGE_LOG(WARNING, "{}", um_res.getError().what());
             continue;
         }
 
@@ -488,15 +1151,17 @@ auto LookupManager::extractUMEntryOperations(const std::vector<core::Transaction
 
 auto LookupManager::extractUniqueEntryOperations(const std::vector<core::Transaction>& txs,
                                                  std::int64_t block_height)
-    -> std::vector<core::UniqueEntryOperation>
+    -> std::pmr::vector<core::UniqueEntryOperation>
 {
-    std::vector<core::UniqueEntryOperation> unique_ops;
+    metrics::TraceSpan span{"extractUniqueEntryOperations", block_height};
+
+    std::pmr::vector<core::UniqueEntryOperation> unique_ops{block_arena_->getResource()};
 
     for(const auto& tx : txs) {
         auto unique_res = core::parseTransactionToUniqueEntry(tx, block_height, client_.get());
         if(!unique_res) {
             //getting an error instead of an Opt indicates a wallet error
-            LOG(WARNING) << unique_res.getError().what();
+            FORGE_LOG(WARNING, "{}", unique_res.getError().what());
             continue;
         }
 
@@ -514,14 +1179,16 @@ auto LookupManager::extractUniqueEntryOperations(const std::vector<core::Transac
 
 auto LookupManager::extractUtilityTokenOperations(const std::vector<core::Transaction>& txs,
                                                   std::int64_t block_height)
-    -> std::vector<core::UtilityTokenOperation>
+    -> std::pmr::vector<core::UtilityTokenOperation>
 {
-    std::vector<core::UtilityTokenOperation> utility_ops;
+    metrics::TraceSpan span{"extractUtilityTokenOperations", block_height};
+
+    std::pmr::vector<core::UtilityTokenOperation> utility_ops{block_arena_->getResource()};
     for(const auto& tx : txs) {
         auto utility_res = core::parseTransactionToUtilityTokenOp(tx, block_height, client_.get());
         if(!utility_res) {
             //getting an error instead of an Opt indicates a wallet error
-            LOG(WARNING) << utility_res.getError().what();
+            FORGE_LOG(WARNING, "{}", utility_res.getError().what());
             continue;
         }
 
@@ -543,7 +1210,11 @@ auto LookupManager::parseAndFilter(std::vector<core::Transaction>&& txs,
                   std::vector<core::UniqueEntryOperation>,
                   std::vector<core::UtilityTokenOperation>>
 {
-    std::map<EntryKey, std::vector<core::EntryCreationOp>> creation_map;
+    metrics::TraceSpan span{"parseAndFilter", block_height};
+
+    //only the returned operations outlive the block,
+    //everything else is allocated in the block arena
+    auto* arena = block_arena_->getResource();
 
     std::vector<core::UMEntryOperation> um_ops;
     std::vector<core::UniqueEntryOperation> unique_ops;
@@ -553,79 +1224,68 @@ auto LookupManager::parseAndFilter(std::vector<core::Transaction>&& txs,
     auto raw_unique_ops = extractUniqueEntryOperations(txs, block_height);
     auto raw_utility_ops = extractUtilityTokenOperations(txs, block_height);
 
-    for(auto um_op : std::move(raw_um_ops)) {
-        if(std::holds_alternative<core::UMEntryCreationOp>(um_op)) {
-            auto creation = std::get<core::UMEntryCreationOp>(std::move(um_op));
-            auto key = creation.getEntryKey();
-            auto [iter, inserted] = creation_map.insert({std::move(key), {creation}});
-            if(!inserted) {
-                iter->second.emplace_back(std::move(creation));
-            }
-            continue;
-        }
+    um_ops.reserve(raw_um_ops.size());
+    unique_ops.reserve(raw_unique_ops.size());
+    utility_ops.reserve(raw_utility_ops.size());
 
-        um_ops.emplace_back(std::move(um_op));
-    }
+    //creations of all token types compete for the same keys
+    std::pmr::vector<core::EntryCreationOp> creations{arena};
 
-    for(auto unique_op : std::move(raw_unique_ops)) {
-        if(std::holds_alternative<core::UniqueEntryCreationOp>(unique_op)) {
-            auto creation = std::get<core::UniqueEntryCreationOp>(std::move(unique_op));
-            auto key = creation.getEntryKey();
-            auto [iter, inserted] = creation_map.insert({std::move(key), {creation}});
-            if(!inserted) {
-                iter->second.emplace_back(std::move(creation));
-            }
-            continue;
+    for(auto& um_op : raw_um_ops) {
+        if(auto* creation = std::get_if<core::UMEntryCreationOp>(&um_op)) {
+            creations.emplace_back(std::move(*creation));
+        } else {
+            um_ops.emplace_back(std::move(um_op));
         }
-
-        unique_ops.emplace_back(std::move(unique_op));
     }
 
-    for(auto utility_op : std::move(raw_utility_ops)) {
-        if(std::holds_alternative<core::UtilityTokenCreationOp>(utility_op)) {
-            auto creation = std::get<core::UtilityTokenCreationOp>(std::move(utility_op));
-            auto key = creation.getUtilityToken().getId();
-            auto [iter, inserted] = creation_map.insert({std::move(key), {creation}});
-            if(!inserted) {
-                iter->second.emplace_back(std::move(creation));
-            }
-            continue;
+    for(auto& unique_op : raw_unique_ops) {
+        if(auto* creation = std::get_if<core::UniqueEntryCreationOp>(&unique_op)) {
+            creations.emplace_back(std::move(*creation));
+        } else {
+            unique_ops.emplace_back(std::move(unique_op));
         }
-
-        utility_ops.emplace_back(std::move(utility_op));
     }
 
-    for(auto [_, creations] : std::move(creation_map)) {
-
-        if(creations.empty()) {
-            continue;
+    for(auto& utility_op : raw_utility_ops) {
+        if(auto* creation = std::get_if<core::UtilityTokenCreationOp>(&utility_op)) {
+            creations.emplace_back(std::move(*creation));
+        } else {
+            utility_ops.emplace_back(std::move(utility_op));
         }
+    }
 
-
-        std::sort(std::begin(creations),
-                  std::end(creations),
-                  [](const auto& lhs, const auto& rhs) {
-                      return core::getBurnValue(lhs) < core::getBurnValue(rhs);
-                  });
-
-        std::reverse(std::begin(creations),
-                     std::end(creations));
-
-
-        if(creations.size() == 1
-           || core::getBurnValue(creations[0]) != core::getBurnValue(creations[1])) {
-            std::visit(utilxx::overload{
-                           [&](core::UMEntryCreationOp op) {
-                               um_ops.emplace_back(std::move(op));
-                           },
-                           [&](core::UniqueEntryCreationOp op) {
-                               unique_ops.emplace_back(std::move(op));
-                           },
-                           [&](core::UtilityTokenCreationOp op) {
-                               utility_ops.emplace_back(std::move(op));
-                           }},
-                       std::move(creations[0]));
-        }
+    //before the activation height every creation which burns anything ties
+    const auto compare_amounts =
+        block_height >= core::getCreationBurnComparisonHeight(client_->getCoin());
+
+    auto selected =
+        selectHighestBurnPerKey(creations,
+                                [](const auto& creation)
+                                    -> const EntryKey& {
+                                    return core::getEntryKey(creation);
+                                },
+                                [&](const auto& creation)
+                                    -> std::int64_t {
+                                    if(compare_amounts) {
+                                        return core::getBurnAmount(creation);
+                                    }
+                                    return core::getBurnValue(creation);
+                                },
+                                arena);
+
+    for(auto index : selected) {
+        std::visit(utilxx::overload{
+                       [&](core::UMEntryCreationOp&& op) {
+                           um_ops.emplace_back(std::move(op));
+                       },
+                       [&](core::UniqueEntryCreationOp&& op) {
+                           unique_ops.emplace_back(std::move(op));
+                       },
+                       [&](core::UtilityTokenCreationOp&& op) {
+                           utility_ops.emplace_back(std::move(op));
+                       }},
+                   std::move(creations[index]));
     }
 
     return std::tuple{std::move(um_ops),
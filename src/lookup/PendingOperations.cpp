@@ -0,0 +1,179 @@
+#include <core/Transaction.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <entrys/token/UtilityTokenOperation.hpp>
+#include <entrys/uentry/UniqueEntryOperation.hpp>
+#include <entrys/umentry/UMEntryOperation.hpp>
+#include <json/value.h>
+#include <lookup/ChangeFeed.hpp>
+#include <lookup/PendingOperations.hpp>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utilxx/Opt.hpp>
+#include <utilxx/Overload.hpp>
+#include <variant>
+#include <vector>
+
+using forge::lookup::PendingOperations;
+using forge::lookup::PendingOperation;
+using forge::lookup::PendingOperationVariant;
+using forge::lookup::PendingTransaction;
+using forge::core::EntryKey;
+using utilxx::Opt;
+
+namespace {
+
+//umentrys and unique entrys are identified by their key,
+//utility tokens by their id
+auto getKeyOf(const PendingOperationVariant& operation)
+    -> const EntryKey&
+{
+    return std::visit(
+        utilxx::overload{
+            [](const forge::core::UMEntryOperation& op)
+                -> const EntryKey& {
+                return forge::core::getEntryKey(op);
+            },
+            [](const forge::core::UniqueEntryOperation& op)
+                -> const EntryKey& {
+                return forge::core::getEntryKey(op);
+            },
+            [](const forge::core::UtilityTokenOperation& op)
+                -> const EntryKey& {
+                return forge::core::getUtilitToken(op).getId();
+            }},
+        operation);
+}
+
+} // namespace
+
+
+PendingOperations::PendingOperations()
+    : mtx_(std::make_unique<std::mutex>()) {}
+
+auto PendingOperations::getTransaction(const std::string& txid,
+                                       const Opt<std::int64_t>& block_height) const
+    -> Opt<PendingTransaction>
+{
+    std::lock_guard lock{*mtx_};
+
+    auto iter = transactions_.find(txid);
+    if(iter == std::cend(transactions_)) {
+        return std::nullopt;
+    }
+
+    //a transaction of the mempool which was mined since
+    //is parsed again with the height of its block
+    const auto& known_height = iter->second.block_height;
+    if(known_height.hasValue() != block_height.hasValue()
+       || (known_height && known_height.getValue() != block_height.getValue())) {
+        return std::nullopt;
+    }
+
+    return iter->second;
+}
+
+auto PendingOperations::replace(std::map<std::string, PendingTransaction>&& transactions)
+    -> void
+{
+    //the indexes are built outside of the lock
+    std::map<EntryKey, std::vector<PendingOperation>> by_key;
+    std::map<std::pair<std::string, EntryKey>, std::uint64_t> token_debits;
+    std::size_t size{0};
+
+    for(const auto& [txid, transaction] : transactions) {
+        for(const auto& operation : transaction.operations) {
+            by_key[getKeyOf(operation)].push_back(PendingOperation{txid,
+                                                                   transaction.block_height,
+                                                                   operation});
+            ++size;
+
+            const auto* token_op = std::get_if<core::UtilityTokenOperation>(&operation);
+            if(token_op
+               && !std::holds_alternative<core::UtilityTokenCreationOp>(*token_op)) {
+                auto debit_key = std::pair{core::getCreator(*token_op),
+                                           core::getUtilitToken(*token_op).getId()};
+                token_debits[std::move(debit_key)] += core::getAmount(*token_op);
+            }
+        }
+    }
+
+    std::lock_guard lock{*mtx_};
+    transactions_ = std::move(transactions);
+    by_key_ = std::move(by_key);
+    token_debits_ = std::move(token_debits);
+    size_ = size;
+}
+
+auto PendingOperations::getOperationsOn(const EntryKey& key) const
+    -> std::vector<PendingOperation>
+{
+    std::lock_guard lock{*mtx_};
+
+    auto iter = by_key_.find(key);
+    if(iter == std::cend(by_key_)) {
+        return {};
+    }
+
+    return iter->second;
+}
+
+auto PendingOperations::hasOperationsOn(const EntryKey& key) const
+    -> bool
+{
+    std::lock_guard lock{*mtx_};
+    return by_key_.count(key) != 0;
+}
+
+auto PendingOperations::getUtilityTokenDebitOf(const std::string& owner,
+                                               const EntryKey& token) const
+    -> std::uint64_t
+{
+    std::lock_guard lock{*mtx_};
+
+    auto iter = token_debits_.find(std::pair{owner, token});
+    if(iter == std::cend(token_debits_)) {
+        return 0;
+    }
+
+    return iter->second;
+}
+
+auto PendingOperations::size() const
+    -> std::size_t
+{
+    std::lock_guard lock{*mtx_};
+    return size_;
+}
+
+auto PendingOperations::clear()
+    -> void
+{
+    std::lock_guard lock{*mtx_};
+    transactions_.clear();
+    by_key_.clear();
+    token_debits_.clear();
+    size_ = 0;
+}
+
+auto forge::lookup::pendingOperationToJson(const PendingOperation& operation)
+    -> Json::Value
+{
+    auto json = std::visit(
+        [](const auto& op) {
+            return operationToJson(op);
+        },
+        operation.operation);
+
+    json.removeMember("event");
+    json["txid"] = operation.txid;
+    if(operation.block_height) {
+        json["height"] = static_cast<Json::Int64>(operation.block_height.getValue());
+    } else {
+        json["height"] = Json::nullValue;
+    }
+
+    return json;
+}
@@ -0,0 +1,345 @@
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <entrys/uentry/UniqueEntry.hpp>
+#include <entrys/umentry/UMEntry.hpp>
+#include <fcntl.h>
+#include <fmt/core.h>
+#include <g3log/g3log.hpp>
+#include <lookup/SharedLookupLayout.hpp>
+#include <lookup/SharedLookupPublisher.hpp>
+#include <new>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utilxx/Result.hpp>
+
+using forge::lookup::SharedLookupPublisher;
+using forge::lookup::SharedLookupHeader;
+using forge::lookup::SharedRecordHeader;
+using forge::lookup::SharedTableDescriptor;
+using forge::lookup::SharedTable;
+using forge::lookup::LookupError;
+using forge::lookup::alignSharedOffset;
+using utilxx::Result;
+
+namespace {
+
+auto appendBytes(std::vector<std::byte>& image,
+                 const void* data,
+                 std::size_t size)
+    -> void
+{
+    auto* begin = static_cast<const std::byte*>(data);
+    image.insert(std::end(image),
+                 begin,
+                 begin + size);
+}
+
+auto alignImage(std::vector<std::byte>& image)
+    -> void
+{
+    image.resize(alignSharedOffset(image.size()));
+}
+
+//appends a record and returns its offset in the data area
+auto appendRecord(std::vector<std::byte>& image,
+                  const std::vector<std::byte>& key,
+                  std::string_view owner,
+                  const std::vector<std::byte>& value,
+                  std::byte value_flag,
+                  std::int64_t block,
+                  std::uint64_t amount)
+    -> std::uint64_t
+{
+    auto offset = image.size();
+
+    SharedRecordHeader record{};
+    record.block = block;
+    record.amount = amount;
+    record.key_size = static_cast<std::uint32_t>(key.size());
+    record.owner_size = static_cast<std::uint32_t>(owner.size());
+    record.value_size = static_cast<std::uint32_t>(value.size());
+    record.value_flag = static_cast<std::uint8_t>(value_flag);
+
+    appendBytes(image, &record, sizeof(record));
+    appendBytes(image, key.data(), key.size());
+    appendBytes(image, owner.data(), owner.size());
+    appendBytes(image, value.data(), value.size());
+    alignImage(image);
+
+    return offset;
+}
+
+auto appendIndex(std::vector<std::byte>& image,
+                 const std::vector<std::uint64_t>& offsets)
+    -> SharedTableDescriptor
+{
+    SharedTableDescriptor desc{offsets.size(),
+                               image.size()};
+
+    appendBytes(image,
+                offsets.data(),
+                offsets.size() * sizeof(std::uint64_t));
+
+    return desc;
+}
+
+//std::map is sorted by key, therefore the offsets
+//are already in the order the reader expects
+template<class MapType, class ToRawData, class ToValueFlag>
+auto appendEntryTable(std::vector<std::byte>& image,
+                      const MapType& map,
+                      ToRawData&& to_raw_data,
+                      ToValueFlag&& to_value_flag)
+    -> SharedTableDescriptor
+{
+    std::vector<std::uint64_t> offsets;
+    offsets.reserve(map.size());
+
+    for(const auto& [key, entry] : map) {
+        const auto& [value, owner, block] = entry;
+        offsets.push_back(appendRecord(image,
+                                       key,
+                                       owner,
+                                       to_raw_data(value),
+                                       to_value_flag(value),
+                                       block,
+                                       0));
+    }
+
+    return appendIndex(image, offsets);
+}
+
+} // namespace
+
+
+SharedLookupPublisher::SharedLookupPublisher(std::string&& name,
+                                             int fd,
+                                             void* base,
+                                             std::size_t mapped_size)
+    : name_(std::move(name)),
+      fd_(fd),
+      base_(base),
+      mapped_size_(mapped_size),
+      tables_{} {}
+
+SharedLookupPublisher::~SharedLookupPublisher()
+{
+    //readers which still have the region mapped notice that it is dead
+    header()->closed.store(1, std::memory_order_release);
+
+    ::munmap(base_, mapped_size_);
+    ::close(fd_);
+    ::shm_unlink(name_.c_str());
+}
+
+auto SharedLookupPublisher::publish(const UMEntryLookup& um_entrys,
+                                    const UniqueEntryLookup& unique_entrys,
+                                    const UtilityTokenLookup& utility_tokens,
+                                    std::int64_t block_height)
+    -> utilxx::Result<void, LookupError>
+{
+    buildImage(um_entrys,
+               unique_entrys,
+               utility_tokens);
+
+    if(auto res = ensureSize(sizeof(SharedLookupHeader) + image_.size());
+       !res) {
+        return res.getError();
+    }
+
+    auto* hdr = header();
+
+    //odd sequence, readers will retry until we are done
+    auto sequence = hdr->sequence.load(std::memory_order_relaxed);
+    hdr->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    std::memcpy(static_cast<std::byte*>(base_) + sizeof(SharedLookupHeader),
+                image_.data(),
+                image_.size());
+
+    hdr->region_size = mapped_size_;
+    hdr->image_size = image_.size();
+    hdr->block_height = block_height;
+    std::copy(std::begin(tables_),
+              std::end(tables_),
+              std::begin(hdr->tables));
+
+    hdr->sequence.store(sequence + 2, std::memory_order_release);
+
+    LOG(DEBUG) << "published lookup snapshot of block "
+               << block_height
+               << " ("
+               << image_.size()
+               << " bytes) to shared memory "
+               << name_;
+
+    return {};
+}
+
+auto SharedLookupPublisher::getName() const
+    -> const std::string&
+{
+    return name_;
+}
+
+auto SharedLookupPublisher::buildImage(const UMEntryLookup& um_entrys,
+                                       const UniqueEntryLookup& unique_entrys,
+                                       const UtilityTokenLookup& utility_tokens)
+    -> void
+{
+    image_.clear();
+
+    tables_[static_cast<std::size_t>(SharedTable::UMEntrys)] =
+        appendEntryTable(image_,
+                         um_entrys.getLookupMap(),
+                         core::umEntryValueToRawData,
+                         core::extractValueFlag);
+
+    tables_[static_cast<std::size_t>(SharedTable::UniqueEntrys)] =
+        appendEntryTable(image_,
+                         unique_entrys.getLookupMap(),
+                         core::uniqueEntryValueToRawData,
+                         core::extractUniqueValueFlag);
+
+    //the accounts of a token are unordered, so we sort them by owner
+    std::vector<std::uint64_t> offsets;
+    std::vector<std::pair<std::string_view, std::uint64_t>> accounts;
+    static const std::vector<std::byte> no_value;
+
+    for(const auto& [token, token_accounts] : utility_tokens.getAccountMap()) {
+        accounts.assign(std::cbegin(token_accounts),
+                        std::cend(token_accounts));
+
+        std::sort(std::begin(accounts),
+                  std::end(accounts));
+
+        for(const auto& [owner, balance] : accounts) {
+            offsets.push_back(appendRecord(image_,
+                                           token,
+                                           owner,
+                                           no_value,
+                                           std::byte{0},
+                                           0,
+                                           balance));
+        }
+    }
+
+    tables_[static_cast<std::size_t>(SharedTable::UtilityTokens)] =
+        appendIndex(image_, offsets);
+}
+
+auto SharedLookupPublisher::ensureSize(std::size_t size)
+    -> utilxx::Result<void, LookupError>
+{
+    if(size <= mapped_size_) {
+        return {};
+    }
+
+    auto new_size = std::max(size, 2 * mapped_size_);
+
+    if(::ftruncate(fd_, new_size) != 0) {
+        return LookupError{
+            fmt::format("unable to grow shared memory {} to {} bytes: {}",
+                        name_,
+                        new_size,
+                        std::strerror(errno))};
+    }
+
+    auto* base = ::mmap(nullptr,
+                        new_size,
+                        PROT_READ | PROT_WRITE,
+                        MAP_SHARED,
+                        fd_,
+                        0);
+
+    if(base == MAP_FAILED) {
+        return LookupError{
+            fmt::format("unable to map shared memory {}: {}",
+                        name_,
+                        std::strerror(errno))};
+    }
+
+    ::munmap(base_, mapped_size_);
+    base_ = base;
+    mapped_size_ = new_size;
+
+    LOG(INFO) << "grew shared memory " << name_ << " to " << new_size << " bytes";
+
+    return {};
+}
+
+auto SharedLookupPublisher::header()
+    -> SharedLookupHeader*
+{
+    return static_cast<SharedLookupHeader*>(base_);
+}
+
+
+auto forge::lookup::make_shared_lookup_publisher(std::string name,
+                                                 std::size_t initial_size)
+    -> utilxx::Result<std::unique_ptr<SharedLookupPublisher>, LookupError>
+{
+    initial_size = std::max(initial_size, sizeof(SharedLookupHeader));
+
+    //remove leftovers of a previous run, readers still holding
+    //the old region notice the new generation with isReplaced
+    ::shm_unlink(name.c_str());
+
+    auto fd = ::shm_open(name.c_str(), O_CREAT | O_RDWR | O_EXCL, 0644);
+    if(fd < 0) {
+        return LookupError{
+            fmt::format("unable to create shared memory {}: {}",
+                        name,
+                        std::strerror(errno))};
+    }
+
+    if(::ftruncate(fd, initial_size) != 0) {
+        auto error = std::strerror(errno);
+        ::close(fd);
+        ::shm_unlink(name.c_str());
+        return LookupError{
+            fmt::format("unable to resize shared memory {}: {}",
+                        name,
+                        error)};
+    }
+
+    auto* base = ::mmap(nullptr,
+                        initial_size,
+                        PROT_READ | PROT_WRITE,
+                        MAP_SHARED,
+                        fd,
+                        0);
+
+    if(base == MAP_FAILED) {
+        auto error = std::strerror(errno);
+        ::close(fd);
+        ::shm_unlink(name.c_str());
+        return LookupError{
+            fmt::format("unable to map shared memory {}: {}",
+                        name,
+                        error)};
+    }
+
+    auto* hdr = new(base) SharedLookupHeader{};
+    hdr->magic = SHARED_LOOKUP_MAGIC;
+    hdr->version = SHARED_LOOKUP_VERSION;
+    hdr->header_size = sizeof(SharedLookupHeader);
+    hdr->region_size = initial_size;
+    hdr->image_size = 0;
+    hdr->block_height = -1;
+    hdr->generation = static_cast<std::uint64_t>(
+        std::chrono::system_clock::now().time_since_epoch().count());
+    hdr->closed.store(0, std::memory_order_relaxed);
+    hdr->sequence.store(0, std::memory_order_release);
+
+    return std::make_unique<SharedLookupPublisher>(std::move(name),
+                                                   fd,
+                                                   base,
+                                                   initial_size);
+}
@@ -1,10 +1,13 @@
 #include <algorithm>
 #include <core/Coin.hpp>
 #include <entrys/umentry/UMEntryOperation.hpp>
+#include <env/AsyncLogger.hpp>
 #include <functional>
 #include <g3log/g3log.hpp>
 #include <lookup/LookupManager.hpp>
+#include <lookup/OperationFilter.hpp>
 #include <lookup/UMEntryLookup.hpp>
+#include <metrics/Trace.hpp>
 #include <unordered_map>
 #include <utilxx/Algorithm.hpp>
 #include <utilxx/Opt.hpp>
@@ -13,6 +16,7 @@
 using utilxx::Opt;
 using forge::core::UMEntryOperation;
 using forge::core::getValue;
+using forge::core::getEntryKey;
 using forge::core::UMEntryValue;
 using forge::core::EntryKey;
 using forge::core::UMEntry;
@@ -34,7 +38,15 @@ UMEntryLookup::UMEntryLookup(const LookupManager* const manager,
 auto UMEntryLookup::executeOperations(std::vector<UMEntryOperation>&& ops)
     -> void
 {
-    ops = filterNonRelevantOperations(std::move(ops));
+    metrics::TraceSpan span{"UMEntryLookup::executeOperations"};
+
+    applyOperations(filterNonRelevantOperations(std::move(ops)));
+}
+
+auto UMEntryLookup::applyOperations(std::vector<UMEntryOperation>&& ops)
+    -> void
+{
+    metrics::TraceSpan span{"UMEntryLookup::applyOperations"};
 
     for(auto&& op : ops) {
         std::visit(*this,
@@ -213,6 +225,8 @@ auto UMEntryLookup::isCurrentlyValid(const UMEntryOperation& op) const
 auto UMEntryLookup::filterNonRelevantOperations(std::vector<UMEntryOperation>&& ops) const
     -> std::vector<UMEntryOperation>
 {
+    metrics::TraceSpan span{"UMEntryLookup::filterNonRelevantOperations"};
+
     //erase non valid operations
     ops.erase(
         std::remove_if(std::begin(ops),
@@ -222,55 +236,21 @@ auto UMEntryLookup::filterNonRelevantOperations(std::vector<UMEntryOperation>&&
                        }),
         ops.end());
 
-    std::map<core::EntryKey,
-             std::vector<UMEntryOperation>>
-        bucket_map;
-
-    //fill map with operations
-    for(auto&& op : ops) {
-        auto key = std::visit(
-            [](const auto& op)
-                -> const EntryKey& {
-                return op.getEntryKey();
-            },
-            op);
-
-        if(auto iter = bucket_map.find(key);
-           iter != bucket_map.end()) {
-            iter->second.push_back(std::move(op));
-        } else {
-            bucket_map.insert({key, {std::move(op)}});
-        }
-    }
+    auto selected =
+        selectHighestBurnPerKey(ops,
+                                [](const auto& op)
+                                    -> const EntryKey& {
+                                    return getEntryKey(op);
+                                },
+                                [](const auto& op) {
+                                    return getValue(op);
+                                });
 
     std::vector<UMEntryOperation> relevant_ops;
-    for(auto&& [_, operations] : bucket_map) {
-        //its save to asume that there is a max element, because those
-        //vectors cannot be empty
-        auto max_iter =
-            std::max_element(std::begin(operations),
-                             std::end(operations),
-                             [](const auto& lhs, const auto& rhs) {
-                                 auto lhs_value = getValue(lhs);
-                                 auto rhs_value = getValue(rhs);
-
-                                 return lhs_value < rhs_value;
-                             });
-
-        //if there are two or more operations
-        //with the same burn value which is the highest one
-        //we dont execute any operation of them because
-        //it would be ambiguous
-        auto number_of_ops_with_max_burn =
-            std::count_if(std::cbegin(operations),
-                          std::cend(operations),
-                          [&max_iter](const auto& op) {
-                              return getValue(op) >= getValue(*max_iter);
-                          });
-
-        if(number_of_ops_with_max_burn == 1) {
-            relevant_ops.emplace_back(std::move(*max_iter));
-        }
+    relevant_ops.reserve(selected.size());
+
+    for(auto index : selected) {
+        relevant_ops.emplace_back(std::move(ops[index]));
     }
 
     return relevant_ops;
@@ -316,7 +296,7 @@ auto UMEntryLookup::operator()(UMEntryCreationOp&& op)
                             std::move(value_tuple)});
     }
 
-    LOG(DEBUG) << "executed entry creation op";
+    FORGE_LOG(DEBUG, "executed entry creation op");
 }
 
 auto UMEntryLookup::operator()(UMEntryRenewalOp&& op)
@@ -341,7 +321,7 @@ auto UMEntryLookup::operator()(UMEntryRenewalOp&& op)
             }
         });
 
-    LOG(DEBUG) << "executed entry renewal op";
+    FORGE_LOG(DEBUG, "executed entry renewal op");
 }
 
 auto UMEntryLookup::operator()(UMEntryOwnershipTransferOp&& op)
@@ -366,7 +346,7 @@ auto UMEntryLookup::operator()(UMEntryOwnershipTransferOp&& op)
             }
         });
 
-    LOG(DEBUG) << "executed ownership transfer op";
+    FORGE_LOG(DEBUG, "executed ownership transfer op");
 }
 
 auto UMEntryLookup::operator()(UMEntryUpdateOp&& op)
@@ -388,7 +368,7 @@ auto UMEntryLookup::operator()(UMEntryUpdateOp&& op)
             }
         });
 
-    LOG(DEBUG) << "executed entry update op";
+    FORGE_LOG(DEBUG, "executed entry update op");
 }
 
 auto UMEntryLookup::operator()(UMEntryDeletionOp&& op)
@@ -413,7 +393,7 @@ auto UMEntryLookup::operator()(UMEntryDeletionOp&& op)
             }
         });
 
-    LOG(DEBUG) << "executed entry deletion op";
+    FORGE_LOG(DEBUG, "executed entry deletion op");
 }
 
 auto UMEntryLookup::getBlockHeight() const
@@ -428,3 +408,9 @@ auto UMEntryLookup::clear()
     lookup_map_.clear();
     block_height_ = start_block_;
 }
+
+auto UMEntryLookup::getLookupMap() const
+    -> const MapType&
+{
+    return lookup_map_;
+}
@@ -1,10 +1,13 @@
 #include <core/Coin.hpp>
 #include <cstddef>
 #include <entrys/uentry/UniqueEntryOperation.hpp>
+#include <env/AsyncLogger.hpp>
 #include <functional>
 #include <g3log/g3log.hpp>
 #include <lookup/LookupManager.hpp>
+#include <lookup/OperationFilter.hpp>
 #include <lookup/UniqueEntryLookup.hpp>
+#include <metrics/Trace.hpp>
 #include <unordered_map>
 #include <utilxx/Algorithm.hpp>
 #include <utilxx/Opt.hpp>
@@ -13,6 +16,7 @@
 using utilxx::Opt;
 using forge::core::UniqueEntryOperation;
 using forge::core::getValue;
+using forge::core::getEntryKey;
 using forge::core::UniqueEntryValue;
 using forge::core::EntryKey;
 using forge::core::UniqueEntry;
@@ -31,7 +35,15 @@ UniqueEntryLookup::UniqueEntryLookup(const LookupManager* const manager,
 auto UniqueEntryLookup::executeOperations(std::vector<UniqueEntryOperation>&& ops)
     -> void
 {
-    ops = filterNonRelevantOperations(std::move(ops));
+    metrics::TraceSpan span{"UniqueEntryLookup::executeOperations"};
+
+    applyOperations(filterNonRelevantOperations(std::move(ops)));
+}
+
+auto UniqueEntryLookup::applyOperations(std::vector<UniqueEntryOperation>&& ops)
+    -> void
+{
+    metrics::TraceSpan span{"UniqueEntryLookup::applyOperations"};
 
     for(auto&& op : ops) {
         std::visit(*this,
@@ -210,6 +222,8 @@ auto UniqueEntryLookup::isCurrentlyValid(const UniqueEntryOperation& op) const
 auto UniqueEntryLookup::filterNonRelevantOperations(std::vector<UniqueEntryOperation>&& ops) const
     -> std::vector<UniqueEntryOperation>
 {
+    metrics::TraceSpan span{"UniqueEntryLookup::filterNonRelevantOperations"};
+
     //erase non valid operations
     ops.erase(
         std::remove_if(std::begin(ops),
@@ -219,55 +233,21 @@ auto UniqueEntryLookup::filterNonRelevantOperations(std::vector<UniqueEntryOpera
                        }),
         ops.end());
 
-    std::map<core::EntryKey,
-             std::vector<UniqueEntryOperation>>
-        bucket_map;
-
-    //fill map with operations
-    for(auto&& op : ops) {
-        auto key = std::visit(
-            [](const auto& op)
-                -> const EntryKey& {
-                return op.getEntryKey();
-            },
-            op);
-
-        if(auto iter = bucket_map.find(key);
-           iter != bucket_map.end()) {
-            iter->second.push_back(std::move(op));
-        } else {
-            bucket_map.insert({key, {std::move(op)}});
-        }
-    }
+    auto selected =
+        selectHighestBurnPerKey(ops,
+                                [](const auto& op)
+                                    -> const EntryKey& {
+                                    return getEntryKey(op);
+                                },
+                                [](const auto& op) {
+                                    return getValue(op);
+                                });
 
     std::vector<UniqueEntryOperation> relevant_ops;
-    for(auto&& [_, operations] : bucket_map) {
-        //its save to asume that there is a max element, because those
-        //vectors cannot be empty
-        auto max_iter =
-            std::max_element(std::begin(operations),
-                             std::end(operations),
-                             [](const auto& lhs, const auto& rhs) {
-                                 auto lhs_value = getValue(lhs);
-                                 auto rhs_value = getValue(rhs);
-
-                                 return lhs_value < rhs_value;
-                             });
-
-        //if there are two or more operations
-        //with the same burn value which is the highest one
-        //we dont execute any operation of them because
-        //it would be ambiguous
-        auto number_of_ops_with_max_burn =
-            std::count_if(std::cbegin(operations),
-                          std::cend(operations),
-                          [&max_iter](const auto& op) {
-                              return getValue(op) >= getValue(*max_iter);
-                          });
-
-        if(number_of_ops_with_max_burn == 1) {
-            relevant_ops.emplace_back(std::move(*max_iter));
-        }
+    relevant_ops.reserve(selected.size());
+
+    for(auto index : selected) {
+        relevant_ops.emplace_back(std::move(ops[index]));
     }
 
     return relevant_ops;
@@ -313,7 +293,7 @@ auto UniqueEntryLookup::operator()(UniqueEntryCreationOp&& op)
                             std::move(value_tuple)});
     }
 
-    LOG(DEBUG) << "executed entry creation op";
+    FORGE_LOG(DEBUG, "executed entry creation op");
 }
 
 auto UniqueEntryLookup::operator()(UniqueEntryRenewalOp&& op)
@@ -338,7 +318,7 @@ auto UniqueEntryLookup::operator()(UniqueEntryRenewalOp&& op)
             }
         });
 
-    LOG(DEBUG) << "executed entry renewal op";
+    FORGE_LOG(DEBUG, "executed entry renewal op");
 }
 
 auto UniqueEntryLookup::operator()(UniqueEntryOwnershipTransferOp&& op)
@@ -363,7 +343,7 @@ auto UniqueEntryLookup::operator()(UniqueEntryOwnershipTransferOp&& op)
             }
         });
 
-    LOG(DEBUG) << "executed ownership transfer op";
+    FORGE_LOG(DEBUG, "executed ownership transfer op");
 }
 
 auto UniqueEntryLookup::operator()(UniqueEntryDeletionOp&& op)
@@ -388,7 +368,7 @@ auto UniqueEntryLookup::operator()(UniqueEntryDeletionOp&& op)
             }
         });
 
-    LOG(DEBUG) << "executed entry deletion op";
+    FORGE_LOG(DEBUG, "executed entry deletion op");
 }
 
 auto UniqueEntryLookup::getBlockHeight() const
@@ -403,3 +383,9 @@ auto UniqueEntryLookup::clear()
     lookup_map_.clear();
     block_height_ = start_block_;
 }
+
+auto UniqueEntryLookup::getLookupMap() const
+    -> const MapType&
+{
+    return lookup_map_;
+}
@@ -11,6 +11,7 @@
 #include <iterator>
 #include <limits>
 #include <lookup/UtilityTokenLookup.hpp>
+#include <metrics/Trace.hpp>
 #include <numeric>
 #include <unordered_map>
 #include <unordered_set>
@@ -33,8 +34,17 @@ UtilityTokenLookup::UtilityTokenLookup(const LookupManager* const manager,
 auto UtilityTokenLookup::executeOperations(std::vector<UtilityTokenOperation>&& ops)
     -> void
 {
-    auto filtered = filterNonRelevantOperations(std::move(ops));
-    for(auto&& op : filtered) {
+    metrics::TraceSpan span{"UtilityTokenLookup::executeOperations"};
+
+    applyOperations(filterNonRelevantOperations(std::move(ops)));
+}
+
+auto UtilityTokenLookup::applyOperations(std::vector<UtilityTokenOperation>&& ops)
+    -> void
+{
+    metrics::TraceSpan span{"UtilityTokenLookup::applyOperations"};
+
+    for(auto&& op : ops) {
         std::visit(*this,
                    std::move(op));
     }
@@ -120,6 +130,12 @@ auto UtilityTokenLookup::getSupplyOfToken(const std::vector<std::byte>& token) c
                            });
 }
 
+auto UtilityTokenLookup::getAccountMap() const
+    -> const AccountMapType&
+{
+    return utility_account_lookup_;
+}
+
 
 auto UtilityTokenLookup::operator()(UtilityTokenCreationOp&& op)
     -> void
@@ -182,6 +198,8 @@ auto UtilityTokenLookup::operator()(UtilityTokenDeletionOp&& op)
 auto UtilityTokenLookup::filterNonRelevantOperations(std::vector<UtilityTokenOperation>&& ops) const
     -> std::vector<UtilityTokenOperation>
 {
+    metrics::TraceSpan span{"UtilityTokenLookup::filterNonRelevantOperations"};
+
     auto grouped = groupOperationsByToken(std::move(ops));
     std::vector<UtilityTokenOperation> relevant_ops;
 
@@ -342,22 +360,17 @@ auto UtilityTokenLookup::groupOperationsByToken(std::vector<UtilityTokenOperatio
              std::vector<UtilityTokenOperation>>
         operations;
 
-    for(auto&& op : ops) {
-        std::visit(
-            [&](const auto& operation) {
-                const auto& token_id = operation.getUtilityToken().getId();
-                auto iter = operations.find(token_id);
-                if(iter != operations.end()) {
-                    iter
-                        ->second
-                        .emplace_back(std::move(operation));
-                } else {
-                    std::vector<UtilityTokenOperation> tmp_op{std::move(operation)};
-                    operations.emplace(token_id,
-                                       tmp_op);
-                }
+    for(auto& op : ops) {
+        const auto& token_id = std::visit(
+            [](const auto& operation)
+                -> const std::vector<std::byte>& {
+                return operation.getUtilityToken().getId();
             },
-            std::move(op));
+            op);
+
+        //the id is only copied for the first operation of a token
+        //and the op is moved after the lookup is done with the id
+        operations[token_id].emplace_back(std::move(op));
     }
 
     return operations;
@@ -371,23 +384,15 @@ auto UtilityTokenLookup::groupOperationsByCreator(std::vector<core::UtilityToken
                        std::vector<UtilityTokenOperation>>
         operations;
 
-    for(auto&& op : ops) {
-        std::visit(
-            [&](const auto& operation) {
-                const auto& creator = operation.getCreator();
-                auto iter = operations.find(creator);
-                if(iter != operations.end()) {
-                    iter
-                        ->second
-                        .emplace_back(std::move(operation));
-                } else {
-                    auto creator_copy = creator;
-                    UtilityTokenOperation tmp_op{std::move(operation)};
-                    operations.emplace(creator_copy,
-                                       std::vector{std::move(tmp_op)});
-                }
+    for(auto& op : ops) {
+        const auto& creator = std::visit(
+            [](const auto& operation)
+                -> const std::string& {
+                return operation.getCreator();
             },
-            std::move(op));
+            op);
+
+        operations[creator].emplace_back(std::move(op));
     }
 
     return operations;
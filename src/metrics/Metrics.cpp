@@ -0,0 +1,328 @@
+#include <algorithm>
+#include <fmt/format.h>
+#include <iterator>
+#include <metrics/Metrics.hpp>
+#include <mutex>
+
+using forge::metrics::Counter;
+using forge::metrics::Gauge;
+using forge::metrics::Histogram;
+using forge::metrics::Labels;
+using forge::metrics::Registry;
+using forge::metrics::ScopedTimer;
+
+namespace {
+
+auto escapeLabelValue(const std::string& value)
+    -> std::string
+{
+    std::string escaped;
+    escaped.reserve(value.size());
+
+    for(auto c : value) {
+        switch(c) {
+        case '\\':
+            escaped += "\\\\";
+            break;
+        case '"':
+            escaped += "\\\"";
+            break;
+        case '\n':
+            escaped += "\\n";
+            break;
+        default:
+            escaped += c;
+        }
+    }
+
+    return escaped;
+}
+
+//renders {name="value",...}, extra is appended as last label
+auto renderLabels(const Labels& labels,
+                  const Labels& extra = {})
+    -> std::string
+{
+    if(labels.empty() && extra.empty()) {
+        return "";
+    }
+
+    std::string rendered{"{"};
+    auto first = true;
+
+    for(const auto* label_set : {&labels, &extra}) {
+        for(const auto& [name, value] : *label_set) {
+            if(!first) {
+                rendered += ',';
+            }
+            first = false;
+
+            rendered += fmt::format("{}=\"{}\"",
+                                    name,
+                                    escapeLabelValue(value));
+        }
+    }
+
+    rendered += '}';
+    return rendered;
+}
+
+auto renderHeader(fmt::memory_buffer& out,
+                  const std::string& name,
+                  const std::string& help,
+                  const char* type)
+    -> void
+{
+    fmt::format_to(std::back_inserter(out), "# HELP {} {}\n", name, help);
+    fmt::format_to(std::back_inserter(out), "# TYPE {} {}\n", name, type);
+}
+
+} // namespace
+
+
+auto Counter::increment(std::uint64_t value)
+    -> void
+{
+    value_.fetch_add(value, std::memory_order_relaxed);
+}
+
+auto Counter::getValue() const
+    -> std::uint64_t
+{
+    return value_.load(std::memory_order_relaxed);
+}
+
+
+auto Gauge::set(std::int64_t value)
+    -> void
+{
+    value_.store(value, std::memory_order_relaxed);
+}
+
+auto Gauge::getValue() const
+    -> std::int64_t
+{
+    return value_.load(std::memory_order_relaxed);
+}
+
+
+Histogram::Histogram(std::vector<double> bounds)
+    : bounds_(std::move(bounds)),
+      buckets_(std::make_unique<std::atomic<std::uint64_t>[]>(bounds_.size() + 1))
+{
+    for(std::size_t i = 0; i <= bounds_.size(); i++) {
+        buckets_[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+auto Histogram::observe(double value)
+    -> void
+{
+    auto iter = std::lower_bound(std::cbegin(bounds_),
+                                 std::cend(bounds_),
+                                 value);
+    auto index = std::distance(std::cbegin(bounds_), iter);
+
+    buckets_[index].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+
+    //there is no fetch_add for atomic doubles in C++17
+    auto sum = sum_.load(std::memory_order_relaxed);
+    while(!sum_.compare_exchange_weak(sum,
+                                      sum + value,
+                                      std::memory_order_relaxed)) {
+    }
+}
+
+auto Histogram::getBounds() const
+    -> const std::vector<double>&
+{
+    return bounds_;
+}
+
+auto Histogram::getBucketCounts() const
+    -> std::vector<std::uint64_t>
+{
+    std::vector<std::uint64_t> counts;
+    counts.reserve(bounds_.size() + 1);
+
+    std::uint64_t cumulative{0};
+    for(std::size_t i = 0; i <= bounds_.size(); i++) {
+        cumulative += buckets_[i].load(std::memory_order_relaxed);
+        counts.push_back(cumulative);
+    }
+
+    return counts;
+}
+
+auto Histogram::getCount() const
+    -> std::uint64_t
+{
+    return count_.load(std::memory_order_relaxed);
+}
+
+auto Histogram::getSum() const
+    -> double
+{
+    return sum_.load(std::memory_order_relaxed);
+}
+
+
+ScopedTimer::ScopedTimer(Histogram& histogram)
+    : histogram_(histogram),
+      start_(std::chrono::steady_clock::now()) {}
+
+ScopedTimer::~ScopedTimer()
+{
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start_;
+
+    histogram_.observe(elapsed.count());
+}
+
+
+template<class Metric, class Factory>
+auto Registry::getOrCreate(std::map<std::string, Family<Metric>>& families,
+                           const std::string& name,
+                           const std::string& help,
+                           const Labels& labels,
+                           Factory&& factory)
+    -> Metric&
+{
+    {
+        std::shared_lock lock{mtx_};
+        if(auto family_iter = families.find(name);
+           family_iter != families.end()) {
+            const auto& metrics = family_iter->second.metrics;
+            if(auto iter = metrics.find(labels);
+               iter != metrics.end()) {
+                return *iter->second;
+            }
+        }
+    }
+
+    std::unique_lock lock{mtx_};
+    auto& family = families[name];
+    if(family.help.empty()) {
+        family.help = help;
+    }
+
+    auto& metric = family.metrics[labels];
+    if(!metric) {
+        metric = factory();
+    }
+
+    return *metric;
+}
+
+auto Registry::counter(const std::string& name,
+                       const std::string& help,
+                       const Labels& labels)
+    -> Counter&
+{
+    return getOrCreate(counters_,
+                       name,
+                       help,
+                       labels,
+                       [] {
+                           return std::make_unique<Counter>();
+                       });
+}
+
+auto Registry::gauge(const std::string& name,
+                     const std::string& help,
+                     const Labels& labels)
+    -> Gauge&
+{
+    return getOrCreate(gauges_,
+                       name,
+                       help,
+                       labels,
+                       [] {
+                           return std::make_unique<Gauge>();
+                       });
+}
+
+auto Registry::histogram(const std::string& name,
+                         const std::string& help,
+                         const Labels& labels,
+                         const std::vector<double>& bounds)
+    -> Histogram&
+{
+    return getOrCreate(histograms_,
+                       name,
+                       help,
+                       labels,
+                       [&] {
+                           return std::make_unique<Histogram>(bounds);
+                       });
+}
+
+auto Registry::render() const
+    -> std::string
+{
+    std::shared_lock lock{mtx_};
+    fmt::memory_buffer out;
+
+    for(const auto& [name, family] : counters_) {
+        renderHeader(out, name, family.help, "counter");
+        for(const auto& [labels, counter] : family.metrics) {
+            fmt::format_to(std::back_inserter(out),
+                           "{}{} {}\n",
+                           name,
+                           renderLabels(labels),
+                           counter->getValue());
+        }
+    }
+
+    for(const auto& [name, family] : gauges_) {
+        renderHeader(out, name, family.help, "gauge");
+        for(const auto& [labels, gauge] : family.metrics) {
+            fmt::format_to(std::back_inserter(out),
+                           "{}{} {}\n",
+                           name,
+                           renderLabels(labels),
+                           gauge->getValue());
+        }
+    }
+
+    for(const auto& [name, family] : histograms_) {
+        renderHeader(out, name, family.help, "histogram");
+        for(const auto& [labels, histogram] : family.metrics) {
+            const auto& bounds = histogram->getBounds();
+            auto counts = histogram->getBucketCounts();
+
+            for(std::size_t i = 0; i < counts.size(); i++) {
+                auto le = i < bounds.size()
+                    ? fmt::format("{}", bounds[i])
+                    : std::string{"+Inf"};
+
+                fmt::format_to(std::back_inserter(out),
+                               "{}_bucket{} {}\n",
+                               name,
+                               renderLabels(labels, {{"le", le}}),
+                               counts[i]);
+            }
+
+            fmt::format_to(std::back_inserter(out),
+                           "{}_sum{} {}\n",
+                           name,
+                           renderLabels(labels),
+                           histogram->getSum());
+            fmt::format_to(std::back_inserter(out),
+                           "{}_count{} {}\n",
+                           name,
+                           renderLabels(labels),
+                           histogram->getCount());
+        }
+    }
+
+    return fmt::to_string(out);
+}
+
+auto forge::metrics::getRegistry()
+    -> Registry&
+{
+    static Registry registry;
+    return registry;
+}
@@ -0,0 +1,186 @@
+#include <arpa/inet.h>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fmt/core.h>
+#include <g3log/g3log.hpp>
+#include <metrics/MetricsServer.hpp>
+#include <netinet/in.h>
+#include <poll.h>
+#include <string>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+using forge::metrics::MetricsError;
+using forge::metrics::MetricsServer;
+using forge::metrics::Registry;
+
+namespace {
+
+//how often the accept loop checks if it should stop
+constexpr inline auto POLL_TIMEOUT_MS = 200;
+
+//requests are small, everything above is rejected
+constexpr inline std::size_t MAX_REQUEST_SIZE = 8 * 1024;
+
+auto sendAll(int fd, const std::string& data)
+    -> void
+{
+    std::size_t sent{0};
+    while(sent < data.size()) {
+        auto res = ::send(fd,
+                          data.data() + sent,
+                          data.size() - sent,
+                          MSG_NOSIGNAL);
+        if(res <= 0) {
+            return;
+        }
+        sent += static_cast<std::size_t>(res);
+    }
+}
+
+auto makeResponse(const char* status,
+                  const std::string& content_type,
+                  const std::string& body)
+    -> std::string
+{
+    return fmt::format("HTTP/1.1 {}\r\n"
+                       "Content-Type: {}\r\n"
+                       "Content-Length: {}\r\n"
+                       "Connection: close\r\n"
+                       "\r\n"
+                       "{}",
+                       status,
+                       content_type,
+                       body.size(),
+                       body);
+}
+
+} // namespace
+
+
+MetricsServer::MetricsServer(int fd,
+                             const Registry& registry)
+    : fd_(fd),
+      registry_(registry),
+      thread_([this] { run(); }) {}
+
+MetricsServer::~MetricsServer()
+{
+    should_stop_ = true;
+    thread_.join();
+    ::close(fd_);
+}
+
+auto MetricsServer::run()
+    -> void
+{
+    while(!should_stop_) {
+        pollfd pfd{fd_, POLLIN, 0};
+        if(::poll(&pfd, 1, POLL_TIMEOUT_MS) <= 0) {
+            continue;
+        }
+
+        auto client_fd = ::accept(fd_, nullptr, nullptr);
+        if(client_fd < 0) {
+            continue;
+        }
+
+        handleConnection(client_fd);
+        ::close(client_fd);
+    }
+}
+
+auto MetricsServer::handleConnection(int client_fd)
+    -> void
+{
+    //dont let a slow client block the server
+    timeval timeout{1, 0};
+    ::setsockopt(client_fd,
+                 SOL_SOCKET,
+                 SO_RCVTIMEO,
+                 &timeout,
+                 sizeof(timeout));
+
+    std::string request;
+    char buffer[1024];
+
+    while(request.find("\r\n\r\n") == std::string::npos) {
+        if(request.size() > MAX_REQUEST_SIZE) {
+            return;
+        }
+
+        auto res = ::recv(client_fd, buffer, sizeof(buffer), 0);
+        if(res <= 0) {
+            break;
+        }
+        request.append(buffer, static_cast<std::size_t>(res));
+    }
+
+    auto request_line = request.substr(0, request.find("\r\n"));
+    auto method_end = request_line.find(' ');
+    auto path_end = request_line.find(' ', method_end + 1);
+
+    if(method_end == std::string::npos
+       || path_end == std::string::npos) {
+        sendAll(client_fd,
+                makeResponse("400 Bad Request", "text/plain", "bad request\n"));
+        return;
+    }
+
+    auto method = request_line.substr(0, method_end);
+    auto path = request_line.substr(method_end + 1,
+                                    path_end - method_end - 1);
+
+    if(method != "GET") {
+        sendAll(client_fd,
+                makeResponse("405 Method Not Allowed", "text/plain", "method not allowed\n"));
+        return;
+    }
+
+    if(path != "/metrics") {
+        sendAll(client_fd,
+                makeResponse("404 Not Found", "text/plain", "not found\n"));
+        return;
+    }
+
+    sendAll(client_fd,
+            makeResponse("200 OK",
+                         "text/plain; version=0.0.4",
+                         registry_.render()));
+}
+
+auto forge::metrics::make_metrics_server(std::int64_t port,
+                                         const Registry& registry)
+    -> utilxx::Result<std::unique_ptr<MetricsServer>, MetricsError>
+{
+    auto fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if(fd < 0) {
+        return MetricsError{
+            fmt::format("unable to create metrics socket: {}",
+                        std::strerror(errno))};
+    }
+
+    int reuse = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(static_cast<std::uint16_t>(port));
+
+    if(::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0
+       || ::listen(fd, SOMAXCONN) != 0) {
+        auto error = std::strerror(errno);
+        ::close(fd);
+        return MetricsError{
+            fmt::format("unable to listen for metrics on port {}: {}",
+                        port,
+                        error)};
+    }
+
+    LOG(INFO) << "serving metrics on port " << port;
+
+    return std::make_unique<MetricsServer>(fd, registry);
+}
@@ -0,0 +1,256 @@
+#include <algorithm>
+#include <csignal>
+#include <fmt/core.h>
+#include <fstream>
+#include <g3log/g3log.hpp>
+#include <json/writer.h>
+#include <metrics/Trace.hpp>
+#include <unistd.h>
+
+using forge::metrics::MetricsError;
+using forge::metrics::TraceBuffer;
+using forge::metrics::TraceDumper;
+using forge::metrics::TraceEvent;
+using forge::metrics::TraceSpan;
+using utilxx::Result;
+
+namespace {
+
+//how often the dumper checks for a pending signal
+constexpr inline auto DUMP_POLL_INTERVAL = std::chrono::milliseconds{200};
+
+volatile std::sig_atomic_t dump_requested = 0;
+
+extern "C" void onDumpSignal(int /*signal*/)
+{
+    dump_requested = 1;
+}
+
+auto nextPowerOfTwo(std::size_t value)
+    -> std::size_t
+{
+    std::size_t result{1};
+    while(result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+//small sequential ids render nicer than hashed std::thread::ids
+auto currentThreadId()
+    -> std::uint32_t
+{
+    static std::atomic<std::uint32_t> next_id{1};
+    thread_local const auto id = next_id.fetch_add(1, std::memory_order_relaxed);
+    return id;
+}
+
+auto toNanoseconds(std::chrono::steady_clock::time_point point)
+    -> std::int64_t
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               point.time_since_epoch())
+        .count();
+}
+
+} // namespace
+
+
+TraceBuffer::TraceBuffer(std::size_t capacity)
+    : mask_(nextPowerOfTwo(std::max<std::size_t>(capacity, 1)) - 1),
+      slots_(std::make_unique<Slot[]>(mask_ + 1)) {}
+
+auto TraceBuffer::record(const char* name,
+                         std::int64_t start_ns,
+                         std::int64_t duration_ns,
+                         std::int64_t arg)
+    -> void
+{
+    auto index = next_.fetch_add(1, std::memory_order_relaxed);
+    auto& slot = slots_[index & mask_];
+
+    slot.sequence.store(index * 2 + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.start_ns.store(start_ns, std::memory_order_relaxed);
+    slot.duration_ns.store(duration_ns, std::memory_order_relaxed);
+    slot.thread_id.store(currentThreadId(), std::memory_order_relaxed);
+    slot.arg.store(arg, std::memory_order_relaxed);
+
+    slot.sequence.store(index * 2 + 2, std::memory_order_release);
+}
+
+auto TraceBuffer::snapshot() const
+    -> std::vector<TraceEvent>
+{
+    auto end = next_.load(std::memory_order_acquire);
+    auto capacity = getCapacity();
+    auto begin = end > capacity ? end - capacity : 0;
+
+    std::vector<TraceEvent> events;
+    events.reserve(end - begin);
+
+    for(auto index = begin; index < end; index++) {
+        const auto& slot = slots_[index & mask_];
+        auto expected = index * 2 + 2;
+
+        //not yet written or already overwritten
+        if(slot.sequence.load(std::memory_order_acquire) != expected) {
+            continue;
+        }
+
+        TraceEvent event{slot.name.load(std::memory_order_relaxed),
+                         slot.start_ns.load(std::memory_order_relaxed),
+                         slot.duration_ns.load(std::memory_order_relaxed),
+                         slot.thread_id.load(std::memory_order_relaxed),
+                         slot.arg.load(std::memory_order_relaxed)};
+
+        //a writer started on the slot while we copied it
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if(slot.sequence.load(std::memory_order_relaxed) != expected) {
+            continue;
+        }
+
+        events.push_back(event);
+    }
+
+    return events;
+}
+
+auto TraceBuffer::getCapacity() const
+    -> std::size_t
+{
+    return mask_ + 1;
+}
+
+
+TraceSpan::TraceSpan(const char* name,
+                     std::int64_t arg)
+    : TraceSpan(name, arg, getTraceBuffer()) {}
+
+TraceSpan::TraceSpan(const char* name,
+                     std::int64_t arg,
+                     TraceBuffer& buffer)
+    : name_(name),
+      arg_(arg),
+      buffer_(buffer),
+      start_(std::chrono::steady_clock::now()) {}
+
+TraceSpan::~TraceSpan()
+{
+    auto end = std::chrono::steady_clock::now();
+    buffer_.record(name_,
+                   toNanoseconds(start_),
+                   toNanoseconds(end) - toNanoseconds(start_),
+                   arg_);
+}
+
+
+TraceDumper::TraceDumper(std::string folder,
+                         const TraceBuffer& buffer)
+    : folder_(std::move(folder)),
+      buffer_(buffer)
+{
+    dump_requested = 0;
+    std::signal(SIGUSR1, onDumpSignal);
+    thread_ = std::thread{[this] { run(); }};
+}
+
+TraceDumper::~TraceDumper()
+{
+    std::signal(SIGUSR1, SIG_DFL);
+    should_stop_ = true;
+    thread_.join();
+}
+
+auto TraceDumper::run()
+    -> void
+{
+    while(!should_stop_) {
+        std::this_thread::sleep_for(DUMP_POLL_INTERVAL);
+
+        if(!dump_requested) {
+            continue;
+        }
+        dump_requested = 0;
+
+        auto now = std::chrono::system_clock::now();
+        auto seconds = std::chrono::duration_cast<std::chrono::seconds>(
+                           now.time_since_epoch())
+                           .count();
+        auto path = fmt::format("{}/forge-trace-{}.json",
+                                folder_,
+                                seconds);
+
+        auto res = dumpChromeTrace(buffer_, path);
+        if(!res) {
+            LOG(WARNING) << res.getError().what();
+            continue;
+        }
+
+        LOG(INFO) << "dumped trace to " << path;
+    }
+}
+
+
+auto forge::metrics::getTraceBuffer()
+    -> TraceBuffer&
+{
+    static TraceBuffer buffer;
+    return buffer;
+}
+
+auto forge::metrics::toChromeTrace(const std::vector<TraceEvent>& events)
+    -> Json::Value
+{
+    static const auto pid = static_cast<Json::Int64>(::getpid());
+
+    Json::Value trace_events{Json::arrayValue};
+
+    for(const auto& event : events) {
+        Json::Value value;
+        value["name"] = event.name;
+        value["cat"] = "forge";
+        value["ph"] = "X";
+        //chrome traces are in microseconds
+        value["ts"] = static_cast<double>(event.start_ns) / 1000.0;
+        value["dur"] = static_cast<double>(event.duration_ns) / 1000.0;
+        value["pid"] = pid;
+        value["tid"] = event.thread_id;
+
+        if(event.arg != NO_TRACE_ARG) {
+            value["args"]["block"] = static_cast<Json::Int64>(event.arg);
+        }
+
+        trace_events.append(std::move(value));
+    }
+
+    Json::Value trace;
+    trace["traceEvents"] = std::move(trace_events);
+    trace["displayTimeUnit"] = "ms";
+
+    return trace;
+}
+
+auto forge::metrics::dumpChromeTrace(const TraceBuffer& buffer,
+                                     const std::string& path)
+    -> Result<void, MetricsError>
+{
+    std::ofstream file{path};
+    if(!file) {
+        return MetricsError{fmt::format("unable to create trace file {}", path)};
+    }
+
+    Json::StreamWriterBuilder builder;
+    builder["indentation"] = "";
+
+    std::unique_ptr<Json::StreamWriter> writer{builder.newStreamWriter()};
+    writer->write(toChromeTrace(buffer.snapshot()), &file);
+
+    if(!file) {
+        return MetricsError{fmt::format("unable to write trace file {}", path)};
+    }
+
+    return {};
+}
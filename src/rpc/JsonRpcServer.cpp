@@ -1,15 +1,23 @@
 #include <chrono>
 #include <core/Transaction.hpp>
+#include <entrys/Entry.hpp>
 #include <entrys/token/UtilityToken.hpp>
 #include <fmt/core.h>
 #include <fmt/format.h>
 #include <g3log/g3log.hpp>
 #include <jsonrpccpp/server.h>
 #include <jsonrpccpp/server/connectors/httpserver.h>
+#include <lookup/ChangeFeed.hpp>
 #include <lookup/LookupManager.hpp>
+#include <lookup/PendingOperations.hpp>
+#include <metrics/Metrics.hpp>
+#include <metrics/Trace.hpp>
 #include <mutex>
+#include <map>
 #include <numeric>
 #include <rpc/JsonRpcServer.hpp>
+#include <rpc/OperationError.hpp>
+#include <rpc/OperationQueue.hpp>
 #include <thread>
 #include <utilxx/Algorithm.hpp>
 #include <utilxx/Overload.hpp>
@@ -27,13 +35,115 @@ using forge::core::ByteArray;
 using forge::wallet::ReadWriteWallet;
 using forge::wallet::ReadOnlyWallet;
 using forge::lookup::LookupManager;
+using forge::rpc::AbstractJsonRpcStubSever;
+using forge::rpc::OperationError;
+using forge::rpc::OperationQueue;
+using forge::rpc::OperationStatus;
+using forge::rpc::SYNC_WRITE_TIMEOUT;
+using forge::rpc::WRITE_OPERATION_WORKERS;
 using jsonrpc::JsonRpcException;
 
+namespace {
+
+template<class Call>
+auto measureCall(const std::string& method,
+                 Call&& call)
+    -> void
+{
+    auto& registry = forge::metrics::getRegistry();
+    forge::metrics::ScopedTimer timer{
+        registry.histogram("forge_rpc_request_duration_seconds",
+                           "latency of the json rpc calls to forged",
+                           {{"method", method}})};
+
+    try {
+        call();
+    } catch(...) {
+        registry.counter("forge_rpc_errors_total",
+                         "json rpc calls to forged which failed",
+                         {{"method", method}})
+            .increment();
+        throw;
+    }
+}
+
+//value of the entry, if it is mature, together with all operations
+//on its key which are not. Returns none if there is neither
+auto withPendingOperations(utilxx::Opt<Json::Value>&& value,
+                           const forge::lookup::PendingOperations& pending,
+                           const EntryKey& key)
+    -> utilxx::Opt<Json::Value>
+{
+    auto operations = pending.getOperationsOn(key);
+    if(!value && operations.empty()) {
+        return std::nullopt;
+    }
+
+    Json::Value json_operations{Json::ValueType::arrayValue};
+    for(const auto& operation : operations) {
+        json_operations.append(forge::lookup::pendingOperationToJson(operation));
+    }
+
+    Json::Value ret_json{Json::ValueType::objectValue};
+    if(value) {
+        ret_json = std::move(value.getValue());
+    }
+    ret_json["pending"] = std::move(json_operations);
+
+    return ret_json;
+}
+
+struct OperationHandler
+{
+    void (AbstractJsonRpcStubSever::*call)(const Json::Value&, Json::Value&);
+    std::vector<std::string> params;
+};
+
+//write rpcs which can be submitted with submitoperation,
+//these are all rpcs which write to the wallet or the daemon
+const std::map<std::string, OperationHandler> OPERATION_HANDLERS{
+    {"createnewumentry",
+     {&AbstractJsonRpcStubSever::createnewumentryI,
+      {"address", "burnvalue", "isstring", "key", "value"}}},
+    {"createnewuniqueentry",
+     {&AbstractJsonRpcStubSever::createnewuniqueentryI,
+      {"address", "burnvalue", "isstring", "key", "value"}}},
+    {"createnewutilitytoken",
+     {&AbstractJsonRpcStubSever::createnewutilitytokenI,
+      {"address", "burnvalue", "isstring", "key", "supply"}}},
+    {"updateumentry",
+     {&AbstractJsonRpcStubSever::updateumentryI,
+      {"burnvalue", "isstring", "key", "value"}}},
+    {"renewentry",
+     {&AbstractJsonRpcStubSever::renewentryI,
+      {"burnvalue", "isstring", "key"}}},
+    {"deleteentry",
+     {&AbstractJsonRpcStubSever::deleteentryI,
+      {"burnvalue", "isstring", "key"}}},
+    {"transferownership",
+     {&AbstractJsonRpcStubSever::transferownershipI,
+      {"burnvalue", "isstring", "key", "newowner"}}},
+    {"paytoentryowner",
+     {&AbstractJsonRpcStubSever::paytoentryownerI,
+      {"amount", "isstring", "key"}}},
+    {"sendutilitytokens",
+     {&AbstractJsonRpcStubSever::sendutilitytokensI,
+      {"amount", "burnvalue", "isstring", "key", "recipient"}}},
+    {"burnutilitytokens",
+     {&AbstractJsonRpcStubSever::burnutilitytokensI,
+      {"amount", "burnvalue", "isstring", "key"}}},
+    {"submitbulk",
+     {&AbstractJsonRpcStubSever::submitbulkI,
+      {"burnvalue", "operations"}}}};
+
+} // namespace
+
 JsonRpcServer::JsonRpcServer(jsonrpc::AbstractServerConnector& connector,
                              jsonrpc::serverVersion_t type,
                              wallet::ReadWriteWallet&& wallet)
     : AbstractJsonRpcStubSever(connector, type),
-      logic_(std::move(wallet))
+      logic_(std::move(wallet)),
+      write_queue_(std::make_unique<OperationQueue>(WRITE_OPERATION_WORKERS))
 {
     startUpdaterThread();
 }
@@ -49,7 +159,7 @@ JsonRpcServer::JsonRpcServer(jsonrpc::AbstractServerConnector& connector,
 
 JsonRpcServer::JsonRpcServer(jsonrpc::AbstractServerConnector& connector,
                              jsonrpc::serverVersion_t type,
-                             lookup::LookupManager&& lookup)
+                             std::unique_ptr<lookup::LookupManager>&& lookup)
     : AbstractJsonRpcStubSever(connector, type),
       logic_(std::move(lookup))
 {
@@ -57,6 +167,40 @@ JsonRpcServer::JsonRpcServer(jsonrpc::AbstractServerConnector& connector,
 }
 
 
+auto JsonRpcServer::HandleMethodCall(jsonrpc::Procedure& proc,
+                                     const Json::Value& input,
+                                     Json::Value& output)
+    -> void
+{
+    measureCall(proc.GetProcedureName(),
+                [&] {
+                    //the write rpcs share the wallet and the daemon client
+                    //with the queued operations, so they run on the same worker
+                    auto iter = OPERATION_HANDLERS.find(proc.GetProcedureName());
+                    if(write_queue_ && iter != std::cend(OPERATION_HANDLERS)) {
+                        output = callAsOperation(proc.GetProcedureName(),
+                                                 iter->second.call,
+                                                 input);
+                        return;
+                    }
+
+                    AbstractJsonRpcStubSever::HandleMethodCall(proc,
+                                                               input,
+                                                               output);
+                });
+}
+
+auto JsonRpcServer::HandleNotificationCall(jsonrpc::Procedure& proc,
+                                           const Json::Value& input)
+    -> void
+{
+    measureCall(proc.GetProcedureName(),
+                [&] {
+                    AbstractJsonRpcStubSever::HandleNotificationCall(proc,
+                                                                     input);
+                });
+}
+
 auto JsonRpcServer::updatelookup()
     -> bool
 {
@@ -77,6 +221,12 @@ auto JsonRpcServer::updatelookup()
         throw JsonRpcException{std::move(error_msg)};
     }
 
+    if(auto pending_res = lookup.updatePendingOperations();
+       !pending_res) {
+        auto error_msg = lookup::generateMessage(std::move(pending_res.getError()));
+        throw JsonRpcException{std::move(error_msg)};
+    }
+
     return res.getValue();
 }
 
@@ -149,6 +299,64 @@ auto JsonRpcServer::lookupuniquevalue(bool isstring, const std::string& key)
     return forge::core::umentryValueToJson(res.getValue().get());
 }
 
+auto JsonRpcServer::lookupumvaluepending(bool isstring, const std::string& key)
+    -> Json::Value
+{
+    if(indexing_.load()) {
+        throw JsonRpcException{"Server is indexing"};
+    }
+
+    auto& lookup = getLookup();
+
+    auto key_vec = extractEntryKey(isstring, key);
+
+    auto value = lookup.lookupUMValue(key_vec)
+                     .map([](const auto& value) {
+                         return forge::core::umentryValueToJson(value.get());
+                     });
+
+    auto res = withPendingOperations(std::move(value),
+                                     lookup.getPendingOperations(),
+                                     key_vec);
+
+    if(!res) {
+        auto error_msg = fmt::format("no entrys with key {} found",
+                                     key);
+        throw JsonRpcException{std::move(error_msg)};
+    }
+
+    return std::move(res.getValue());
+}
+
+auto JsonRpcServer::lookupuniquevaluepending(bool isstring, const std::string& key)
+    -> Json::Value
+{
+    if(indexing_.load()) {
+        throw JsonRpcException{"Server is indexing"};
+    }
+
+    auto& lookup = getLookup();
+
+    auto key_vec = extractEntryKey(isstring, key);
+
+    auto value = lookup.lookupUniqueValue(key_vec)
+                     .map([](const auto& value) {
+                         return forge::core::umentryValueToJson(value.get());
+                     });
+
+    auto res = withPendingOperations(std::move(value),
+                                     lookup.getPendingOperations(),
+                                     key_vec);
+
+    if(!res) {
+        auto error_msg = fmt::format("no entrys with key {} found",
+                                     key);
+        throw JsonRpcException{std::move(error_msg)};
+    }
+
+    return std::move(res.getValue());
+}
+
 auto JsonRpcServer::lookupowner(bool isstring, const std::string& key)
     -> std::string
 {
@@ -193,6 +401,98 @@ auto JsonRpcServer::lookupactivationblock(bool isstring, const std::string& key)
     return res.getValue();
 }
 
+auto JsonRpcServer::lookupat(int block,
+                             bool isstring,
+                             const std::string& key)
+    -> Json::Value
+{
+    if(indexing_.load()) {
+        throw JsonRpcException{"Server is indexing"};
+    }
+
+    auto& lookup = getLookup();
+
+    auto key_vec = extractEntryKey(isstring, key);
+
+    auto res = lookup.lookupAt(key_vec, block);
+
+    if(!res) {
+        auto error_msg = fmt::format("no entrys with key {} found at block {}",
+                                     key,
+                                     block);
+        throw JsonRpcException{std::move(error_msg)};
+    }
+
+    auto [since, state] = std::move(res.getValue());
+    auto [entry, owner, activation_block] = std::move(state.getValue());
+
+    auto ret_json = forge::core::entryToJson(entry);
+    ret_json["owner"] = std::move(owner);
+    ret_json["activationblock"] = static_cast<Json::Int64>(activation_block);
+    ret_json["since"] = static_cast<Json::Int64>(since);
+
+    return ret_json;
+}
+
+auto JsonRpcServer::scanentries(const std::string& cursor,
+                                bool isstring,
+                                int limit,
+                                const std::string& prefix)
+    -> Json::Value
+{
+    if(indexing_.load()) {
+        throw JsonRpcException{"Server is indexing"};
+    }
+
+    if(limit <= 0) {
+        throw JsonRpcException{"limit has to be positive"};
+    }
+
+    auto& lookup = getLookup();
+
+    auto prefix_vec = extractEntryKey(isstring, prefix);
+
+    //the cursor is always the hex key returned by the previous call
+    utilxx::Opt<core::EntryKey> cursor_opt;
+    if(!cursor.empty()) {
+        cursor_opt = extractEntryKey(false, cursor);
+    }
+
+    auto entrys = lookup.scanEntrys(prefix_vec,
+                                    cursor_opt,
+                                    limit);
+
+    auto json_entrys =
+        std::accumulate(std::cbegin(entrys),
+                        std::cend(entrys),
+                        Json::Value{Json::ValueType::arrayValue},
+                        [](auto init, const auto& entry) {
+                            init.append(forge::core::entryToJson(entry));
+                            return init;
+                        });
+
+    Json::Value ret_json;
+    ret_json["entries"] = std::move(json_entrys);
+
+    //an empty cursor signals that there are no more entrys
+    if(entrys.size() == static_cast<std::size_t>(limit)) {
+        ret_json["cursor"] =
+            std::visit(
+                utilxx::overload{
+                    [](const core::UtilityToken& token) {
+                        return core::toHexString(token.getId());
+                    },
+                    [](const auto& entry) {
+                        return core::toHexString(entry.getKey());
+                    }},
+                entrys.back());
+    } else {
+        ret_json["cursor"] = "";
+    }
+
+    return ret_json;
+}
+
 auto JsonRpcServer::checkvalidity()
     -> bool
 {
@@ -260,6 +560,44 @@ auto JsonRpcServer::lookupallentrysof(const std::string& owner)
     return ret_json;
 }
 
+auto JsonRpcServer::getchanges(int limit,
+                               int since,
+                               int timeout)
+    -> Json::Value
+{
+    //the change feed has its own lock, so subscribers
+    //can wait for events while the server is indexing
+    if(limit <= 0 || since < 0 || timeout < 0) {
+        throw JsonRpcException{"limit has to be positive, since and timeout must not be negative"};
+    }
+
+    const auto& feed = getLookup().getChangeFeed();
+
+    auto events = feed.getEvents(since,
+                                 limit,
+                                 std::chrono::milliseconds{timeout});
+
+    auto next = events.empty()
+        ? static_cast<std::uint64_t>(since)
+        : events.back().sequence + 1;
+
+    auto json_events =
+        std::accumulate(std::cbegin(events),
+                        std::cend(events),
+                        Json::Value{Json::ValueType::arrayValue},
+                        [](auto init, const auto& event) {
+                            init.append(lookup::changeEventToJson(event));
+                            return init;
+                        });
+
+    Json::Value ret_json;
+    ret_json["first"] = static_cast<Json::UInt64>(feed.getFirstSequence());
+    ret_json["next"] = static_cast<Json::UInt64>(next);
+    ret_json["events"] = std::move(json_events);
+
+    return ret_json;
+}
+
 auto JsonRpcServer::addwatchonlyaddress(const std::string& address)
     -> void
 {
@@ -461,7 +799,7 @@ auto JsonRpcServer::getwatchedaddresses()
     -> Json::Value
 {
     const auto& wallet = getReadOnlyWallet();
-    const auto& addresses = wallet.getWatchedAddresses();
+    auto addresses = wallet.getWatchedAddresses();
     auto ret_json =
         std::accumulate(std::begin(addresses),
                         std::end(addresses),
@@ -477,7 +815,7 @@ auto JsonRpcServer::getownedaddresses()
     -> Json::Value
 {
     const auto& wallet = getReadOnlyWallet();
-    const auto& addresses = wallet.getOwnedAddresses();
+    auto addresses = wallet.getOwnedAddresses();
     auto ret_json =
         std::accumulate(std::begin(addresses),
                         std::end(addresses),
@@ -700,6 +1038,135 @@ auto JsonRpcServer::paytoentryowner(int amount,
     return res.getValue();
 }
 
+auto JsonRpcServer::submitbulk(int burnvalue,
+                               const Json::Value& operations)
+    -> Json::Value
+{
+    auto& wallet = getReadWriteWallet();
+
+    //reject the whole request before anything is sent
+    std::vector<forge::wallet::BulkOperation> bulk_operations;
+    bulk_operations.reserve(operations.size());
+    for(const auto& operation : operations) {
+        bulk_operations.push_back(extractBulkOperation(operation));
+    }
+
+    auto results = wallet.submitBulk(std::move(bulk_operations),
+                                     burnvalue);
+
+    Json::Value ret_json{Json::arrayValue};
+    for(auto&& result : results) {
+        Json::Value result_json;
+        if(result) {
+            result_json["txids"] = Json::Value{Json::arrayValue};
+            for(auto&& txid : result.getValue()) {
+                result_json["txids"].append(std::move(txid));
+            }
+        } else {
+            result_json["error"] = result.getError().what();
+        }
+
+        ret_json.append(std::move(result_json));
+    }
+
+    return ret_json;
+}
+
+auto JsonRpcServer::submitoperation(const std::string& method,
+                                    const Json::Value& params)
+    -> int
+{
+    //fail right away in the other modes
+    getReadWriteWallet();
+
+    auto iter = OPERATION_HANDLERS.find(method);
+    if(iter == std::cend(OPERATION_HANDLERS)) {
+        auto error = fmt::format("{} can not be submitted as operation", method);
+        throw JsonRpcException{std::move(error)};
+    }
+
+    const auto& handler = iter->second;
+    for(const auto& param : handler.params) {
+        if(!params.isMember(param)) {
+            auto error = fmt::format("parameter {} of {} is missing", param, method);
+            throw JsonRpcException{std::move(error)};
+        }
+    }
+
+    auto id = submitOperation(method, handler.call, params);
+
+    return static_cast<int>(id);
+}
+
+auto JsonRpcServer::submitOperation(const std::string& method,
+                                    MethodCall call,
+                                    const Json::Value& params)
+    -> std::uint64_t
+{
+    auto id_res = write_queue_->submit(
+        method,
+        [this, call, params]()
+            -> utilxx::Result<Json::Value, OperationError> {
+            try {
+                Json::Value response;
+                (this->*call)(params, response);
+                return response;
+            } catch(const JsonRpcException& e) {
+                return OperationError{e.GetMessage()};
+            } catch(const std::exception& e) {
+                return OperationError{e.what()};
+            }
+        });
+
+    if(!id_res) {
+        throw JsonRpcException{id_res.getError().what()};
+    }
+
+    return id_res.getValue();
+}
+
+auto JsonRpcServer::callAsOperation(const std::string& method,
+                                    MethodCall call,
+                                    const Json::Value& params)
+    -> Json::Value
+{
+    auto id = submitOperation(method, call, params);
+
+    auto state_opt = write_queue_->waitForOperation(id, SYNC_WRITE_TIMEOUT);
+    if(!state_opt) {
+        auto error = fmt::format("operation {} of {} was forgotten", id, method);
+        throw JsonRpcException{std::move(error)};
+    }
+
+    auto state = std::move(state_opt.getValue());
+    switch(state.status) {
+    case OperationStatus::Done:
+        return std::move(state.result);
+    case OperationStatus::Failed:
+        throw JsonRpcException{state.result.asString()};
+    default: {
+        auto error = fmt::format("{} did not finish in time, poll operation {} with getoperation",
+                                 method,
+                                 id);
+        throw JsonRpcException{std::move(error)};
+    }
+    }
+}
+
+auto JsonRpcServer::getoperation(int id)
+    -> Json::Value
+{
+    getReadWriteWallet();
+
+    auto state_opt = write_queue_->getOperation(static_cast<std::uint64_t>(id));
+    if(!state_opt) {
+        auto error = fmt::format("unknown operation {}", id);
+        throw JsonRpcException{std::move(error)};
+    }
+
+    return forge::rpc::operationStateToJson(state_opt.getValue());
+}
+
 auto JsonRpcServer::getownedutilitytokens()
     -> Json::Value
 {
@@ -819,6 +1286,14 @@ auto JsonRpcServer::getutilitytokensof(const std::string& owner)
     return ret_json;
 }
 
+auto JsonRpcServer::gettrace()
+    -> Json::Value
+{
+    //readable while indexing, so a slow sync can be inspected
+    const auto& buffer = metrics::getTraceBuffer();
+    return metrics::toChromeTrace(buffer.snapshot());
+}
+
 auto JsonRpcServer::getbalanceof(bool isstring,
                                  const std::string& owner,
                                  const std::string& token)
@@ -975,9 +1450,9 @@ auto JsonRpcServer::getLookup()
 {
     return std::visit(
         utilxx::overload{
-            [](LookupManager& lookup)
+            [](std::unique_ptr<LookupManager>& lookup)
                 -> LookupManager& {
-                return lookup;
+                return *lookup;
             },
             [](auto& wallet)
                 -> LookupManager& {
@@ -989,7 +1464,7 @@ auto JsonRpcServer::getLookup()
 auto JsonRpcServer::getReadOnlyWallet()
     -> wallet::ReadOnlyWallet&
 {
-    if(std::holds_alternative<LookupManager>(logic_)) {
+    if(std::holds_alternative<std::unique_ptr<LookupManager>>(logic_)) {
         auto error = fmt::format("rpc server unable to perform this operation in mode {}", getMode());
         throw JsonRpcException(std::move(error));
     }
@@ -1020,7 +1495,7 @@ auto JsonRpcServer::getMode() const
 {
     return std::visit(
         utilxx::overload{
-            [](const LookupManager& /*unused*/) {
+            [](const std::unique_ptr<LookupManager>& /*unused*/) {
                 return "lookuponly";
             },
             [](const ReadOnlyWallet& /*unused*/) {
@@ -1048,6 +1523,68 @@ auto JsonRpcServer::extractEntryKey(bool isstring,
     return vec_opt.getValue();
 }
 
+auto JsonRpcServer::extractBulkOperation(const Json::Value& operation)
+    -> forge::wallet::BulkOperation
+{
+    if(!operation.isObject()
+       || !operation["type"].isString()
+       || !operation["key"].isString()) {
+        auto error = fmt::format("invalid bulk operation {}, it needs string fields \"type\" and \"key\"",
+                                 operation.toStyledString());
+        throw JsonRpcException{std::move(error)};
+    }
+
+    const auto& type = operation["type"].asString();
+    auto key = extractEntryKey(operation["isstring"].asBool(),
+                               operation["key"].asString());
+    auto address = operation["address"].asString();
+
+    if(type == "umentry" || type == "uniqueentry") {
+        //a missing value is a none value
+        auto value = operation["value"];
+        auto value_opt = forge::core::jsonToUMEntryValue(std::move(value));
+        if(!value_opt) {
+            throw JsonRpcException{"unable to decode value"};
+        }
+
+        if(type == "umentry") {
+            return forge::wallet::BulkEntryCreation{
+                core::UMEntry{std::move(key), std::move(value_opt.getValue())},
+                std::move(address)};
+        }
+
+        return forge::wallet::BulkEntryCreation{
+            core::UniqueEntry{std::move(key), std::move(value_opt.getValue())},
+            std::move(address)};
+    }
+
+    if(type == "utilitytoken") {
+        auto supply = std::stoull(operation["supply"].asString());
+        return forge::wallet::BulkEntryCreation{
+            core::UtilityToken{std::move(key), supply},
+            std::move(address)};
+    }
+
+    if(type == "sendutilitytokens") {
+        auto amount = std::stoull(operation["amount"].asString());
+        return forge::wallet::BulkTokenTransfer{std::move(key),
+                                                operation["newowner"].asString(),
+                                                amount};
+    }
+
+    if(type == "burnutilitytokens") {
+        auto amount = std::stoull(operation["amount"].asString());
+        return forge::wallet::BulkTokenDeletion{std::move(key),
+                                                amount};
+    }
+
+    auto error = fmt::format("unknown bulk operation type {}, allowed are "
+                             "\"umentry\", \"uniqueentry\", \"utilitytoken\", "
+                             "\"sendutilitytokens\" and \"burnutilitytokens\"",
+                             type);
+    throw JsonRpcException{std::move(error)};
+}
+
 auto JsonRpcServer::startUpdaterThread()
     -> void
 {
@@ -1064,6 +1601,12 @@ auto JsonRpcServer::startUpdaterThread()
                 indexing_.store(true);
                 lookup.updateLookup();
                 indexing_.store(false);
+
+                //does not block readers of the lookup
+                if(auto res = lookup.updatePendingOperations();
+                   !res) {
+                    LOG(WARNING) << lookup::generateMessage(std::move(res.getError()));
+                }
                 std::unique_lock lock{mtx};
                 shutdown_requested_.wait_for(lock, sleeptime);
             }
@@ -0,0 +1,217 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fmt/core.h>
+#include <json/value.h>
+#include <metrics/Metrics.hpp>
+#include <mutex>
+#include <rpc/OperationError.hpp>
+#include <rpc/OperationQueue.hpp>
+#include <string>
+#include <utilxx/Opt.hpp>
+#include <utilxx/Result.hpp>
+
+using forge::rpc::OperationError;
+using forge::rpc::OperationQueue;
+using forge::rpc::OperationState;
+using forge::rpc::OperationStatus;
+using utilxx::Opt;
+using utilxx::Result;
+
+namespace {
+
+auto setOpenOperationsGauge(std::size_t open_operations)
+    -> void
+{
+    forge::metrics::getRegistry()
+        .gauge("forge_rpc_open_operations",
+               "write operations which are queued or running")
+        .set(static_cast<std::int64_t>(open_operations));
+}
+
+} // namespace
+
+OperationQueue::OperationQueue(std::size_t number_of_workers,
+                               std::size_t history_size,
+                               std::size_t max_queued)
+    : history_size_(history_size),
+      max_queued_(max_queued)
+{
+    number_of_workers = std::max<std::size_t>(number_of_workers, 1);
+    workers_.reserve(number_of_workers);
+
+    for(std::size_t i = 0; i < number_of_workers; i++) {
+        workers_.emplace_back([this] {
+            work();
+        });
+    }
+}
+
+OperationQueue::~OperationQueue()
+{
+    {
+        std::lock_guard lock{mtx_};
+        stop_ = true;
+    }
+    work_available_.notify_all();
+
+    for(auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+auto OperationQueue::submit(std::string method,
+                            Task&& task)
+    -> Result<std::uint64_t, OperationError>
+{
+    std::unique_lock lock{mtx_};
+
+    if(queue_.size() >= max_queued_) {
+        auto error = fmt::format("{} operations are queued already, try again later",
+                                 queue_.size());
+        return OperationError{std::move(error)};
+    }
+
+    auto id = next_id_++;
+    operations_.emplace(id,
+                        OperationState{id,
+                                       std::move(method),
+                                       OperationStatus::Queued,
+                                       Json::nullValue});
+    queue_.emplace_back(id, std::move(task));
+    setOpenOperationsGauge(++open_operations_);
+
+    lock.unlock();
+    work_available_.notify_one();
+
+    return id;
+}
+
+auto OperationQueue::getOperation(std::uint64_t id) const
+    -> Opt<OperationState>
+{
+    std::lock_guard lock{mtx_};
+
+    auto iter = operations_.find(id);
+    if(iter == std::cend(operations_)) {
+        return std::nullopt;
+    }
+
+    return iter->second;
+}
+
+auto OperationQueue::waitForOperation(std::uint64_t id,
+                                      std::chrono::milliseconds timeout) const
+    -> Opt<OperationState>
+{
+    std::unique_lock lock{mtx_};
+
+    operation_finished_.wait_for(lock,
+                                 timeout,
+                                 [&] {
+                                     auto iter = operations_.find(id);
+                                     return iter == std::cend(operations_)
+                                         || iter->second.status == OperationStatus::Done
+                                         || iter->second.status == OperationStatus::Failed;
+                                 });
+
+    auto iter = operations_.find(id);
+    if(iter == std::cend(operations_)) {
+        return std::nullopt;
+    }
+
+    return iter->second;
+}
+
+auto OperationQueue::getNumberOfOpenOperations() const
+    -> std::size_t
+{
+    std::lock_guard lock{mtx_};
+    return open_operations_;
+}
+
+auto OperationQueue::work()
+    -> void
+{
+    std::unique_lock lock{mtx_};
+
+    while(true) {
+        work_available_.wait(lock, [this] {
+            return stop_ || !queue_.empty();
+        });
+
+        if(stop_) {
+            return;
+        }
+
+        auto [id, task] = std::move(queue_.front());
+        queue_.pop_front();
+        operations_[id].status = OperationStatus::Running;
+
+        //the task is run without holding the lock,
+        //so that the state of other operations can be queried
+        lock.unlock();
+        auto result = task();
+        lock.lock();
+
+        finish(id, std::move(result));
+        operation_finished_.notify_all();
+    }
+}
+
+auto OperationQueue::finish(std::uint64_t id,
+                            Result<Json::Value, OperationError>&& result)
+    -> void
+{
+    auto& state = operations_[id];
+    if(result) {
+        state.status = OperationStatus::Done;
+        state.result = std::move(result.getValue());
+    } else {
+        state.status = OperationStatus::Failed;
+        state.result = result.getError().what();
+    }
+
+    setOpenOperationsGauge(--open_operations_);
+
+    finished_.push_back(id);
+    while(finished_.size() > history_size_) {
+        operations_.erase(finished_.front());
+        finished_.pop_front();
+    }
+}
+
+auto forge::rpc::operationStatusToString(OperationStatus status)
+    -> std::string
+{
+    switch(status) {
+    case OperationStatus::Queued:
+        return "queued";
+    case OperationStatus::Running:
+        return "running";
+    case OperationStatus::Done:
+        return "done";
+    case OperationStatus::Failed:
+        return "failed";
+    }
+
+    return "unknown";
+}
+
+auto forge::rpc::operationStateToJson(const OperationState& state)
+    -> Json::Value
+{
+    Json::Value json{Json::objectValue};
+    json["id"] = static_cast<Json::UInt64>(state.id);
+    json["method"] = state.method;
+    json["status"] = operationStatusToString(state.status);
+
+    if(state.status == OperationStatus::Done) {
+        json["result"] = state.result;
+    } else if(state.status == OperationStatus::Failed) {
+        json["error"] = state.result;
+    }
+
+    return json;
+}
@@ -0,0 +1,180 @@
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <g3log/g3log.hpp>
+#include <string>
+#include <utilxx/Opt.hpp>
+#include <wallet/AddressBook.hpp>
+
+using forge::wallet::AddressBook;
+using forge::wallet::AddressSet;
+using forge::wallet::ADDRESS_BOOK_COMPACTION_FACTOR;
+using utilxx::Opt;
+
+namespace {
+
+constexpr inline auto OWNED_RECORD = 'o';
+constexpr inline auto WATCHED_RECORD = 'w';
+constexpr inline auto UNWATCHED_RECORD = 'u';
+
+} // namespace
+
+AddressBook::AddressBook(std::string path)
+    : path_(std::move(path))
+{
+    auto records = load();
+    auto addresses = owned_.size() + watched_.size();
+
+    if(records > ADDRESS_BOOK_COMPACTION_FACTOR * addresses) {
+        compact();
+    }
+
+    log_.open(path_.getValue(), std::ios::app);
+    if(!log_) {
+        LOG(WARNING) << "unable to open address book "
+                     << path_.getValue()
+                     << ", new addresses will not be persisted";
+    }
+}
+
+auto AddressBook::addOwned(std::string address)
+    -> bool
+{
+    auto [iter, inserted] = owned_.insert(std::move(address));
+    if(inserted) {
+        append(OWNED_RECORD, *iter);
+    }
+
+    return inserted;
+}
+
+auto AddressBook::addWatched(std::string address)
+    -> bool
+{
+    auto [iter, inserted] = watched_.insert(std::move(address));
+    if(inserted) {
+        append(WATCHED_RECORD, *iter);
+    }
+
+    return inserted;
+}
+
+auto AddressBook::removeWatched(const std::string& address)
+    -> bool
+{
+    if(watched_.erase(address) == 0) {
+        return false;
+    }
+
+    append(UNWATCHED_RECORD, address);
+    return true;
+}
+
+auto AddressBook::getOwned() const
+    -> const AddressSet&
+{
+    return owned_;
+}
+
+auto AddressBook::getWatched() const
+    -> const AddressSet&
+{
+    return watched_;
+}
+
+auto AddressBook::isOwned(const std::string& address) const
+    -> bool
+{
+    return owned_.count(address) != 0;
+}
+
+auto AddressBook::isWatched(const std::string& address) const
+    -> bool
+{
+    return watched_.count(address) != 0;
+}
+
+auto AddressBook::getPath() const
+    -> const Opt<std::string>&
+{
+    return path_;
+}
+
+auto AddressBook::load()
+    -> std::size_t
+{
+    std::ifstream file{path_.getValue()};
+    std::size_t records{0};
+
+    std::string line;
+    while(std::getline(file, line)) {
+        //a record which was cut off while writing it
+        if(line.size() < 3 || line[1] != ' ') {
+            LOG(WARNING) << "skipping invalid record in address book "
+                         << path_.getValue();
+            continue;
+        }
+
+        auto address = line.substr(2);
+        switch(line[0]) {
+        case OWNED_RECORD:
+            owned_.insert(std::move(address));
+            break;
+        case WATCHED_RECORD:
+            watched_.insert(std::move(address));
+            break;
+        case UNWATCHED_RECORD:
+            watched_.erase(address);
+            break;
+        default:
+            LOG(WARNING) << "skipping invalid record in address book "
+                         << path_.getValue();
+            continue;
+        }
+
+        records++;
+    }
+
+    return records;
+}
+
+auto AddressBook::compact()
+    -> void
+{
+    const auto& path = path_.getValue();
+    auto tmp_path = path + ".tmp";
+
+    {
+        std::ofstream file{tmp_path, std::ios::trunc};
+        for(const auto& address : owned_) {
+            file << OWNED_RECORD << ' ' << address << '\n';
+        }
+        for(const auto& address : watched_) {
+            file << WATCHED_RECORD << ' ' << address << '\n';
+        }
+
+        if(!file.flush()) {
+            LOG(WARNING) << "unable to compact address book " << path;
+            std::remove(tmp_path.c_str());
+            return;
+        }
+    }
+
+    //the old log stays valid until it is replaced
+    if(std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+        LOG(WARNING) << "unable to replace address book " << path;
+        std::remove(tmp_path.c_str());
+    }
+}
+
+auto AddressBook::append(char kind,
+                         const std::string& address)
+    -> void
+{
+    if(!log_.is_open()) {
+        return;
+    }
+
+    log_ << kind << ' ' << address << '\n';
+    log_.flush();
+}
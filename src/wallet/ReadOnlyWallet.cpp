@@ -1,72 +1,94 @@
 #include <lookup/LookupManager.hpp>
 #include <memory>
-#include <set>
+#include <mutex>
 #include <string>
 #include <vector>
+#include <wallet/AddressBook.hpp>
 #include <wallet/ReadOnlyWallet.hpp>
+#include <wallet/WalletView.hpp>
 
 using forge::lookup::LookupManager;
 using forge::wallet::ReadOnlyWallet;
+using forge::wallet::AddressBook;
+using forge::wallet::AddressSet;
 using forge::core::UMEntry;
 
 
-ReadOnlyWallet::ReadOnlyWallet(std::unique_ptr<lookup::LookupManager>&& lookup)
-    : lookup_(std::move(lookup))
+ReadOnlyWallet::ReadOnlyWallet(std::unique_ptr<lookup::LookupManager>&& lookup,
+                               AddressBook&& address_book)
+    : lookup_(std::move(lookup)),
+      address_book_(std::move(address_book)),
+      view_mtx_(std::make_unique<std::mutex>()),
+      view_generation_(lookup_->getChangeSetGeneration())
 {
-    lookup_
-        ->getClient()
-        .getAddresses()
-        .onValue([this](auto addresses) {
-            for(auto&& addr : addresses) {
-                this->addNewOwnedAddress(std::move(addr));
-            }
-        });
+    for(const auto& addr : address_book_.getOwned()) {
+        owned_view_.addAddress(*lookup_, addr);
+    }
+    for(const auto& addr : address_book_.getWatched()) {
+        watched_view_.addAddress(*lookup_, addr);
+    }
+
+    if(address_book_.getOwned().empty()) {
+        importOwnedAddresses();
+    }
 }
 
 auto ReadOnlyWallet::addWatchOnlyAddress(std::string adr)
     -> void
 {
-    watched_addresses_.insert(std::move(adr));
+    std::unique_lock lock{*view_mtx_};
+    if(address_book_.addWatched(adr)) {
+        watched_view_.addAddress(*lookup_, adr);
+    }
 }
 
 auto ReadOnlyWallet::deleteWatchOnlyAddress(const std::string& adr)
     -> void
 {
-    watched_addresses_.erase(adr);
+    std::unique_lock lock{*view_mtx_};
+    if(address_book_.removeWatched(adr)) {
+        watched_view_.removeAddress(*lookup_, adr);
+    }
 }
 
 auto ReadOnlyWallet::addNewOwnedAddress(std::string adr)
     -> void
 {
-    owned_addresses_.insert(std::move(adr));
+    std::unique_lock lock{*view_mtx_};
+    if(address_book_.addOwned(adr)) {
+        owned_view_.addAddress(*lookup_, adr);
+    }
+}
+
+auto ReadOnlyWallet::importOwnedAddresses()
+    -> void
+{
+    lookup_
+        ->getClient()
+        .getAddresses()
+        .onValue([this](auto addresses) {
+            for(auto&& addr : addresses) {
+                this->addNewOwnedAddress(std::move(addr));
+            }
+        });
 }
 
 auto ReadOnlyWallet::getOwnedUMEntrys() const
     -> std::vector<UMEntry>
 {
-    std::vector<UMEntry> ret_vec;
-    for(auto&& addr : owned_addresses_) {
-        auto new_entrys = lookup_->getUMEntrysOfOwner(addr);
-        ret_vec.insert(std::end(ret_vec),
-                       std::make_move_iterator(std::begin(new_entrys)),
-                       std::make_move_iterator(std::end(new_entrys)));
-    }
+    std::unique_lock lock{*view_mtx_};
+    syncViews();
 
-    return ret_vec;
+    return owned_view_.getUMEntrys(*lookup_);
 }
 
 auto ReadOnlyWallet::getWatchOnlyUMEntrys() const
     -> std::vector<UMEntry>
 {
-    std::vector<UMEntry> ret_vec;
-    for(auto&& addr : watched_addresses_) {
-        auto new_entrys = lookup_->getUMEntrysOfOwner(addr);
-        ret_vec.insert(std::end(ret_vec),
-                       std::make_move_iterator(std::begin(new_entrys)),
-                       std::make_move_iterator(std::end(new_entrys)));
-    }
+    std::unique_lock lock{*view_mtx_};
+    syncViews();
 
-    return ret_vec;
+    return watched_view_.getUMEntrys(*lookup_);
 }
 
 auto ReadOnlyWallet::getAllWatchedUMEntrys() const
@@ -85,29 +107,19 @@ auto ReadOnlyWallet::getAllWatchedUMEntrys() const
 auto ReadOnlyWallet::getOwnedUniqueEntrys() const
     -> std::vector<core::UniqueEntry>
 {
-    std::vector<core::UniqueEntry> ret_vec;
-    for(auto&& addr : owned_addresses_) {
-        auto new_entrys = lookup_->getUniqueEntrysOfOwner(addr);
-        ret_vec.insert(std::end(ret_vec),
-                       std::make_move_iterator(std::begin(new_entrys)),
-                       std::make_move_iterator(std::end(new_entrys)));
-    }
+    std::unique_lock lock{*view_mtx_};
+    syncViews();
 
-    return ret_vec;
+    return owned_view_.getUniqueEntrys(*lookup_);
 }
 
 auto ReadOnlyWallet::getWatchOnlyUniqueEntrys() const
     -> std::vector<core::UniqueEntry>
 {
-    std::vector<core::UniqueEntry> ret_vec;
-    for(auto&& addr : watched_addresses_) {
-        auto new_entrys = lookup_->getUniqueEntrysOfOwner(addr);
-        ret_vec.insert(std::end(ret_vec),
-                       std::make_move_iterator(std::begin(new_entrys)),
-                       std::make_move_iterator(std::end(new_entrys)));
-    }
+    std::unique_lock lock{*view_mtx_};
+    syncViews();
 
-    return ret_vec;
+    return watched_view_.getUniqueEntrys(*lookup_);
 }
 
 auto ReadOnlyWallet::getAllWatchedUniqueEntrys() const
@@ -126,29 +138,19 @@ auto ReadOnlyWallet::getAllWatchedUniqueEntrys() const
 auto ReadOnlyWallet::getOwnedUtilityTokens() const
     -> std::vector<core::UtilityToken>
 {
-    std::vector<core::UtilityToken> ret_vec;
-    for(auto&& addr : owned_addresses_) {
-        auto new_entrys = lookup_->getUtilityTokensOfOwner(addr);
-        ret_vec.insert(std::end(ret_vec),
-                       std::make_move_iterator(std::begin(new_entrys)),
-                       std::make_move_iterator(std::end(new_entrys)));
-    }
+    std::unique_lock lock{*view_mtx_};
+    syncViews();
 
-    return ret_vec;
+    return owned_view_.getUtilityTokens(*lookup_);
 }
 
 auto ReadOnlyWallet::getWatchOnlyUtilityTokens() const
     -> std::vector<core::UtilityToken>
 {
-    std::vector<core::UtilityToken> ret_vec;
-    for(auto&& addr : watched_addresses_) {
-        auto new_entrys = lookup_->getUtilityTokensOfOwner(addr);
-        ret_vec.insert(std::end(ret_vec),
-                       std::make_move_iterator(std::begin(new_entrys)),
-                       std::make_move_iterator(std::end(new_entrys)));
-    }
+    std::unique_lock lock{*view_mtx_};
+    syncViews();
 
-    return ret_vec;
+    return watched_view_.getUtilityTokens(*lookup_);
 }
 
 auto ReadOnlyWallet::getAllWatchedUtilityTokens() const
@@ -165,21 +167,24 @@ auto ReadOnlyWallet::getAllWatchedUtilityTokens() const
 }
 
 auto ReadOnlyWallet::getWatchedAddresses() const
-    -> const std::set<std::string>&
+    -> AddressSet
 {
-    return watched_addresses_;
+    std::unique_lock lock{*view_mtx_};
+    return address_book_.getWatched();
 }
 
 auto ReadOnlyWallet::getOwnedAddresses() const
-    -> const std::set<std::string>&
+    -> AddressSet
 {
-    return owned_addresses_;
+    std::unique_lock lock{*view_mtx_};
+    return address_book_.getOwned();
 }
 
 auto ReadOnlyWallet::ownesAddress(const std::string& addr) const
     -> bool
 {
-    return owned_addresses_.find(addr) != owned_addresses_.end();
+    std::unique_lock lock{*view_mtx_};
+    return address_book_.isOwned(addr);
 }
 
 auto ReadOnlyWallet::getLookup() const
@@ -193,3 +198,35 @@ auto ReadOnlyWallet::getLookup()
 {
     return *lookup_;
 }
+
+auto ReadOnlyWallet::syncViews() const
+    -> void
+{
+    auto change_sets_opt = lookup_->getChangeSetsSince(view_generation_);
+
+    //we fell behind or the lookup was rebuilt,
+    //so the views are materialized again
+    if(!change_sets_opt) {
+        view_generation_ = lookup_->getChangeSetGeneration();
+
+        owned_view_.clear();
+        for(const auto& addr : address_book_.getOwned()) {
+            owned_view_.addAddress(*lookup_, addr);
+        }
+
+        watched_view_.clear();
+        for(const auto& addr : address_book_.getWatched()) {
+            watched_view_.addAddress(*lookup_, addr);
+        }
+
+        return;
+    }
+
+    const auto& change_sets = change_sets_opt.getValue();
+    for(const auto& change_set : change_sets) {
+        owned_view_.apply(*lookup_, change_set, address_book_.getOwned());
+        watched_view_.apply(*lookup_, change_set, address_book_.getWatched());
+    }
+
+    view_generation_ += change_sets.size();
+}
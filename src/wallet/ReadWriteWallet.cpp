@@ -1,30 +1,46 @@
+#include <algorithm>
 #include <core/Coin.hpp>
 #include <core/Transaction.hpp>
 #include <entrys/Entry.hpp>
 #include <entrys/EntryOperation.hpp>
+#include <entrys/token/UtilityTokenCreationOp.hpp>
 #include <entrys/token/UtilityTokenOwnershipTransferOp.hpp>
+#include <entrys/uentry/UniqueEntryCreationOp.hpp>
 #include <entrys/uentry/UniqueEntryDeletionOp.hpp>
 #include <entrys/umentry/UMEntryCreationOp.hpp>
 #include <entrys/umentry/UMEntryRenewalOp.hpp>
 #include <fmt/core.h>
 #include <fmt/format.h>
+#include <g3log/g3log.hpp>
 #include <lookup/LookupManager.hpp>
+#include <map>
 #include <memory>
 #include <string>
 #include <unordered_map>
 #include <utilxx/Opt.hpp>
+#include <utilxx/Overload.hpp>
+#include <variant>
 #include <vector>
+#include <wallet/AddressBook.hpp>
 #include <wallet/ReadOnlyWallet.hpp>
 #include <wallet/ReadWriteWallet.hpp>
+#include <wallet/TokenSendPlan.hpp>
 #include <wallet/WalletError.hpp>
 
+using forge::wallet::AddressBook;
 using forge::wallet::ReadOnlyWallet;
 using forge::wallet::ReadWriteWallet;
 using forge::wallet::WalletError;
+using forge::wallet::BulkOperation;
+using forge::wallet::BulkEntryCreation;
+using forge::wallet::BulkTokenTransfer;
+using forge::wallet::BulkTokenDeletion;
+using forge::wallet::TokenBalances;
+using forge::wallet::planTokenSends;
+using forge::wallet::BULK_BATCH_SIZE;
 using forge::core::UMEntry;
 using forge::core::UtilityToken;
 using forge::core::UniqueEntry;
-using forge::core::getDefaultTxFee;
 using forge::core::getMinimumTxAmount;
 using forge::core::toHexString;
 using forge::core::EntryKey;
@@ -33,9 +49,75 @@ using forge::core::createUMEntryCreationOpMetadata;
 using forge::core::createUMEntryUpdateOpMetadata;
 using utilxx::Result;
 
+namespace {
+
+//umentrys and unique entrys are identified by their key,
+//utility tokens by their id
+auto getKeyOfEntry(const forge::core::Entry& entry)
+    -> const EntryKey&
+{
+    return std::visit(
+        utilxx::overload{
+            [](const UMEntry& entry)
+                -> const EntryKey& {
+                return entry.getKey();
+            },
+            [](const UniqueEntry& entry)
+                -> const EntryKey& {
+                return entry.getKey();
+            },
+            [](const UtilityToken& entry)
+                -> const EntryKey& {
+                return entry.getId();
+            }},
+        entry);
+}
+
+auto createCreationOpMetadata(forge::core::Entry&& entry)
+    -> std::vector<std::byte>
+{
+    return std::visit(
+        utilxx::overload{
+            [](UMEntry&& entry) {
+                return createUMEntryCreationOpMetadata(std::move(entry));
+            },
+            [](UniqueEntry&& entry) {
+                return forge::core::createUniqueEntryCreationOpMetadata(std::move(entry));
+            },
+            [](UtilityToken&& entry) {
+                return forge::core::createUtilityTokenCreationOpMetadata(std::move(entry));
+            }},
+        std::move(entry));
+}
+
+//the first error of an operation is kept,
+//txids which were already sent are added to it
+template<class Results>
+auto setBulkError(Results& results,
+                  std::size_t operation,
+                  std::string error)
+    -> void
+{
+    auto& result = results[operation];
+    if(!result) {
+        return;
+    }
+
+    if(!result.getValue().empty()) {
+        error += fmt::format(", already sent transactions: {}",
+                             fmt::join(result.getValue(), ", "));
+    }
+
+    result = WalletError{std::move(error)};
+}
+
+} // namespace
+
 ReadWriteWallet::ReadWriteWallet(std::unique_ptr<lookup::LookupManager>&& lookup,
-                                 std::unique_ptr<client::WriteOnlyClientBase>&& client)
-    : ReadOnlyWallet(std::move(lookup)),
+                                 std::unique_ptr<client::WriteOnlyClientBase>&& client,
+                                 AddressBook&& address_book)
+    : ReadOnlyWallet(std::move(lookup),
+                     std::move(address_book)),
       client_(std::move(client)) {}
 
 
@@ -66,6 +148,11 @@ auto ReadWriteWallet::createNewUMEntry(core::EntryKey key,
                                        std::int64_t burn_amount)
     -> utilxx::Result<std::string, WalletError>
 {
+    if(auto res = checkForPendingOperations(key);
+       !res) {
+        return res.getError();
+    }
+
     //create entry
     auto entry = UMEntry{std::move(key),
                          std::move(value)};
@@ -92,6 +179,11 @@ auto ReadWriteWallet::updateUMEntry(core::EntryKey key,
                                     std::int64_t burn_amount)
     -> utilxx::Result<std::string, WalletError>
 {
+    if(auto res = checkForPendingOperations(key);
+       !res) {
+        return res.getError();
+    }
+
     //lookup the owner of the key
     auto owner_opt = lookup_->lookupOwner(key);
     if(!owner_opt) {
@@ -171,6 +263,11 @@ auto ReadWriteWallet::createNewUniqueEntry(core::EntryKey key,
                                            std::int64_t burn_amount)
     -> utilxx::Result<std::string, WalletError>
 {
+    if(auto res = checkForPendingOperations(key);
+       !res) {
+        return res.getError();
+    }
+
     //create entry
     auto entry = UniqueEntry{std::move(key),
                              std::move(value)};
@@ -199,6 +296,11 @@ auto ReadWriteWallet::createNewUtilityToken(core::EntryKey id,
                                             std::int64_t burn_amount)
     -> utilxx::Result<std::string, WalletError>
 {
+    if(auto res = checkForPendingOperations(id);
+       !res) {
+        return res.getError();
+    }
+
     //create entry
     auto entry = UtilityToken{std::move(id),
                               std::move(supply)};
@@ -346,26 +448,14 @@ auto ReadWriteWallet::transferUtilityTokens(core::EntryKey id,
     -> utilxx::Result<std::vector<std::string>,
                       WalletError>
 {
-    auto send_list_res = getUtilityTokenSendVector(id,
-                                                   amount);
-
-    if(!send_list_res) {
-        return send_list_res.getError();
-    }
-    auto send_list = std::move(send_list_res.getValue());
-
-    return utilxx::traverse(
-        std::move(send_list),
-        [&](auto triple) {
-            auto [address, used] = std::move(triple);
-            UtilityToken token{id, used};
-            auto metadata =
-                createUtilityTokenOwnershipTransferOpMetadata(std::move(token));
-            return burn(address,
-                        new_owner,
-                        burn_amount,
-                        std::move(metadata));
-        });
+    std::vector<BulkOperation> operations;
+    operations.emplace_back(BulkTokenTransfer{std::move(id),
+                                              std::move(new_owner),
+                                              amount});
+
+    return std::move(submitBulk(std::move(operations),
+                                burn_amount)
+                         .front());
 }
 
 auto ReadWriteWallet::deleteUtilityTokens(core::EntryKey id,
@@ -374,66 +464,420 @@ auto ReadWriteWallet::deleteUtilityTokens(core::EntryKey id,
     -> utilxx::Result<std::vector<std::string>,
                       WalletError>
 {
-    auto send_list_res = getUtilityTokenSendVector(id,
-                                                   amount);
+    std::vector<BulkOperation> operations;
+    operations.emplace_back(BulkTokenDeletion{std::move(id),
+                                              amount});
 
-    if(!send_list_res) {
-        return send_list_res.getError();
-    }
-    auto send_list = std::move(send_list_res.getValue());
-
-    return utilxx::traverse(
-        std::move(send_list),
-        [&](auto triple) {
-            auto [address, used] = std::move(triple);
-            UtilityToken token{id, used};
-            auto metadata =
-                createUtilityTokenDeletionOpMetadata(std::move(token));
-            return burn(address,
-                        burn_amount,
-                        std::move(metadata));
-        });
+    return std::move(submitBulk(std::move(operations),
+                                burn_amount)
+                         .front());
 }
 
 auto ReadWriteWallet::getUtilityTokenSendVector(const std::vector<std::byte>& token,
-                                                std::uint64_t desired_amount)
+                                                std::uint64_t desired_amount,
+                                                const std::map<std::string, std::uint64_t>& reserved)
     -> utilxx::Result<
         std::vector<
             std::pair<std::string,
                       std::uint64_t>>,
         WalletError>
 {
-    std::vector<std::pair<std::string, //address
-                          std::uint64_t>> //used for this transaction
-        owned_token_balances;
+    TokenBalances balances;
+    std::uint64_t available{0};
 
-    std::uint64_t covered{0};
-    for(auto&& address : owned_addresses_) {
+    for(const auto& address : getOwnedAddresses()) {
         auto balance = lookup_->getUtilityTokenCreditOf(address,
                                                         token);
 
-        if(balance != 0) {
-            auto used = std::min(balance, desired_amount - covered);
-            owned_token_balances.emplace_back(address,
-                                              used);
+        //tokens which are sent by transactions that are not mature yet
+        balance -= std::min(balance,
+                            lookup_->getPendingOperations()
+                                .getUtilityTokenDebitOf(address, token));
+
+        if(auto iter = reserved.find(address);
+           iter != std::cend(reserved)) {
+            balance -= std::min(balance, iter->second);
         }
 
-        if(covered == desired_amount) {
-            break;
+        if(balance != 0) {
+            balances.emplace_back(address, balance);
+            available += balance;
         }
     }
 
-    if(covered != desired_amount) {
+    auto plan_opt = planTokenSends(std::move(balances),
+                                   desired_amount);
+    if(!plan_opt) {
         auto token_str = toHexString(token);
         auto error =
             fmt::format("insufficient funds of token {}, needed: {}, available: {}",
                         token_str,
                         desired_amount,
-                        covered);
+                        available);
         return WalletError{std::move(error)};
     }
 
-    return owned_token_balances;
+    return std::move(plan_opt.getValue());
+}
+
+auto ReadWriteWallet::submitBulk(std::vector<BulkOperation> operations,
+                                 std::int64_t burn_amount)
+    -> std::vector<
+        utilxx::Result<std::vector<std::string>,
+                       WalletError>>
+{
+    BulkResults results(operations.size(),
+                        std::vector<std::string>{});
+
+    auto burns = prepareBulkBurns(std::move(operations),
+                                  burn_amount,
+                                  results);
+    selectBulkOutputs(burns, results);
+    sendBulkBurns(burns, burn_amount, results);
+
+    return results;
+}
+
+auto ReadWriteWallet::prepareBulkBurns(std::vector<BulkOperation>&& operations,
+                                       std::int64_t burn_amount,
+                                       BulkResults& results)
+    -> std::vector<PendingBurn>
+{
+    auto coin = getLookup().getCoin();
+    auto min_amount = getMinimumTxAmount(coin);
+
+    //the rate is fetched once for the whole bulk
+    auto fee_rate_res = client_->getFeeRate();
+    if(!fee_rate_res) {
+        for(std::size_t i = 0; i < operations.size(); i++) {
+            setBulkError(results, i, fee_rate_res.getError().what());
+        }
+        return {};
+    }
+    auto fee_rate = fee_rate_res.getValue();
+
+    std::vector<PendingBurn> burns;
+    burns.reserve(operations.size());
+
+    //tokens which earlier operations already send, per token and address
+    std::map<EntryKey, std::map<std::string, std::uint64_t>> reserved_tokens;
+
+    //creations without an owner get a new address,
+    //all of them are generated with one request
+    auto needed_addresses =
+        std::count_if(std::cbegin(operations),
+                      std::cend(operations),
+                      [](const auto& operation) {
+                          const auto* creation = std::get_if<BulkEntryCreation>(&operation);
+                          return creation != nullptr && creation->address.empty();
+                      });
+    auto new_addresses_res =
+        client_->generateNewAddresses(static_cast<std::size_t>(needed_addresses));
+    std::size_t next_address{0};
+
+    for(std::size_t i = 0; i < operations.size(); i++) {
+        std::visit(
+            utilxx::overload{
+                [&](BulkEntryCreation&& creation) {
+                    if(auto res = checkForPendingOperations(getKeyOfEntry(creation.entry));
+                       !res) {
+                        setBulkError(results, i, res.getError().what());
+                        return;
+                    }
+
+                    auto address = std::move(creation.address);
+
+                    if(address.empty()) {
+                        if(!new_addresses_res) {
+                            setBulkError(results, i, new_addresses_res.getError().what());
+                            return;
+                        }
+
+                        address = std::move(new_addresses_res.getValue()[next_address++]);
+                        addNewOwnedAddress(address);
+                    } else if(!ownesAddress(address)) {
+                        auto error = fmt::format(
+                            "it seems that you aren't the owner of "
+                            "the address {}",
+                            address);
+                        setBulkError(results, i, std::move(error));
+                        return;
+                    }
+
+                    //the owner gets the change
+                    auto metadata = createCreationOpMetadata(std::move(creation.entry));
+                    auto fee = client_->computeBurnFee(fee_rate, metadata.size(), 1);
+
+                    burns.push_back(PendingBurn{i,
+                                                std::move(address),
+                                                std::nullopt,
+                                                std::move(metadata),
+                                                burn_amount + fee,
+                                                std::nullopt});
+                },
+                [&](BulkTokenTransfer&& transfer) {
+                    auto& reserved = reserved_tokens[transfer.token];
+                    auto send_list_res = getUtilityTokenSendVector(transfer.token,
+                                                                   transfer.amount,
+                                                                   reserved);
+                    if(!send_list_res) {
+                        setBulkError(results, i, send_list_res.getError().what());
+                        return;
+                    }
+
+                    //one transaction per sending address, they use
+                    //independent outputs and are submitted together
+                    for(auto&& [address, used] : send_list_res.getValue()) {
+                        reserved[address] += used;
+
+                        UtilityToken token{transfer.token, used};
+                        auto metadata =
+                            createUtilityTokenOwnershipTransferOpMetadata(std::move(token));
+                        //the new owner and the change
+                        auto fee = client_->computeBurnFee(fee_rate, metadata.size(), 2);
+
+                        burns.push_back(PendingBurn{i,
+                                                    std::move(address),
+                                                    transfer.new_owner,
+                                                    std::move(metadata),
+                                                    burn_amount + min_amount + fee,
+                                                    std::nullopt});
+                    }
+                },
+                [&](BulkTokenDeletion&& deletion) {
+                    auto& reserved = reserved_tokens[deletion.token];
+                    auto send_list_res = getUtilityTokenSendVector(deletion.token,
+                                                                   deletion.amount,
+                                                                   reserved);
+                    if(!send_list_res) {
+                        setBulkError(results, i, send_list_res.getError().what());
+                        return;
+                    }
+
+                    for(auto&& [address, used] : send_list_res.getValue()) {
+                        reserved[address] += used;
+
+                        UtilityToken token{deletion.token, used};
+                        auto metadata =
+                            createUtilityTokenDeletionOpMetadata(std::move(token));
+                        auto fee = client_->computeBurnFee(fee_rate, metadata.size(), 1);
+
+                        burns.push_back(PendingBurn{i,
+                                                    std::move(address),
+                                                    std::nullopt,
+                                                    std::move(metadata),
+                                                    burn_amount + fee,
+                                                    std::nullopt});
+                    }
+                }},
+            std::move(operations[i]));
+    }
+
+    return burns;
+}
+
+auto ReadWriteWallet::selectBulkOutputs(std::vector<PendingBurn>& burns,
+                                        BulkResults& results)
+    -> void
+{
+    //amount every owner without a suitable output needs
+    std::map<std::string, std::int64_t> funding;
+
+    for(auto& burn : burns) {
+        burn.output = findOutputOfAddress(burn.owner, burn.needed);
+        if(burn.output) {
+            continue;
+        }
+
+        if(funding.count(burn.owner) == 0) {
+            funding.emplace(burn.owner, burn.needed);
+            continue;
+        }
+
+        //the funding transaction can only have one output per address
+        auto output_res = fundAddress(burn.owner, burn.needed);
+        if(!output_res) {
+            setBulkError(results, burn.operation, output_res.getError().what());
+            continue;
+        }
+        burn.output = std::move(output_res.getValue());
+    }
+
+    if(funding.empty()) {
+        return;
+    }
+
+    auto funding_res =
+        client_
+            ->sendToAddresses({std::cbegin(funding),
+                               std::cend(funding)})
+            .flatMap([&](auto txid) {
+                return client_->getTransaction(std::move(txid));
+            });
+
+    if(!funding_res) {
+        for(const auto& burn : burns) {
+            if(!burn.output) {
+                setBulkError(results, burn.operation, funding_res.getError().what());
+            }
+        }
+        return;
+    }
+
+    const auto& tx = funding_res.getValue();
+    const auto& outputs = tx.getOutputs();
+
+    std::map<std::string, core::Unspent> funded;
+    for(std::size_t vout = 0; vout < outputs.size(); vout++) {
+        const auto& output = outputs[vout];
+        if(output.numberOfAddresses() != 1) {
+            continue;
+        }
+
+        //every address has exactly one output, its value is not compared,
+        //because values parsed from the json of the daemon can be a satoshi short
+        const auto& address = output.getAddresses()[0];
+        auto iter = funding.find(address);
+        if(iter == std::cend(funding)) {
+            continue;
+        }
+
+        funded.emplace(address,
+                       core::Unspent{iter->second,
+                                     static_cast<std::int64_t>(vout),
+                                     0,
+                                     address,
+                                     tx.getTxid()});
+    }
+
+    for(auto& burn : burns) {
+        if(burn.output) {
+            continue;
+        }
+
+        auto iter = funded.find(burn.owner);
+        if(iter == std::end(funded)) {
+            auto error = fmt::format("unable to find the output funding address {} in transaction {}",
+                                     burn.owner,
+                                     tx.getTxid());
+            setBulkError(results, burn.operation, std::move(error));
+            continue;
+        }
+
+        burn.output = std::move(iter->second);
+        funded.erase(iter);
+    }
+}
+
+auto ReadWriteWallet::sendBulkBurns(std::vector<PendingBurn>& burns,
+                                    std::int64_t burn_amount,
+                                    BulkResults& results)
+    -> void
+{
+    auto min_amount = getMinimumTxAmount(getLookup().getCoin());
+
+    //removes the burns of operations which failed, so no transaction
+    //of a failed operation is signed or sent. their outputs stay unspent
+    auto drop_failed_burns = [&](std::vector<PendingBurn*>& batch,
+                                 std::vector<std::vector<std::byte>>& txs) {
+        std::size_t kept{0};
+        for(std::size_t i = 0; i < batch.size(); i++) {
+            if(!results[batch[i]->operation]) {
+                client_->unlockUnspent(batch[i]->output.getValue(), false);
+                continue;
+            }
+
+            if(kept != i) {
+                batch[kept] = batch[i];
+                txs[kept] = std::move(txs[i]);
+            }
+            kept++;
+        }
+
+        batch.resize(kept);
+        txs.resize(kept);
+    };
+
+    for(std::size_t first = 0; first < burns.size(); first += BULK_BATCH_SIZE) {
+        auto last = std::min(first + BULK_BATCH_SIZE, burns.size());
+
+        std::vector<PendingBurn*> batch;
+        std::vector<std::vector<std::byte>> txs;
+
+        for(auto i = first; i < last; i++) {
+            auto& burn = burns[i];
+            if(!burn.output) {
+                continue;
+            }
+
+            const auto& output = burn.output.getValue();
+
+            //another burn of the operation failed
+            if(!results[burn.operation]) {
+                client_->unlockUnspent(output, false);
+                continue;
+            }
+
+            std::vector<std::pair<std::string, std::int64_t>> outputs;
+            if(burn.new_owner) {
+                outputs.emplace_back(burn.new_owner.getValue(), min_amount);
+            }
+            if(auto change = output.getValue() - burn.needed;
+               change > 0) {
+                outputs.emplace_back(burn.owner, change);
+            }
+
+            auto raw_tx_res = client_->generateRawTx(output.getTxid(),
+                                                     output.getVoutIdx(),
+                                                     std::move(burn.metadata),
+                                                     burn_amount,
+                                                     std::move(outputs));
+            if(!raw_tx_res) {
+                client_->unlockUnspent(output, false);
+                setBulkError(results, burn.operation, raw_tx_res.getError().what());
+                continue;
+            }
+
+            batch.push_back(&burn);
+            txs.push_back(std::move(raw_tx_res.getValue()));
+        }
+
+        drop_failed_burns(batch, txs);
+
+        auto signed_txs = client_->signRawTxs(std::move(txs));
+
+        txs.clear();
+        for(std::size_t i = 0; i < batch.size(); i++) {
+            if(!signed_txs[i]) {
+                setBulkError(results, batch[i]->operation, signed_txs[i].getError().what());
+                txs.emplace_back();
+                continue;
+            }
+
+            txs.push_back(std::move(signed_txs[i].getValue()));
+        }
+
+        drop_failed_burns(batch, txs);
+
+        auto txids = client_->sendRawTxs(std::move(txs));
+
+        //all txids are added before the errors, so the error
+        //of an operation lists every transaction which was sent
+        for(std::size_t i = 0; i < batch.size(); i++) {
+            client_->unlockUnspent(batch[i]->output.getValue(), true);
+
+            if(auto& result = results[batch[i]->operation];
+               txids[i] && result) {
+                result.getValue().push_back(std::move(txids[i].getValue()));
+            }
+        }
+
+        for(std::size_t i = 0; i < batch.size(); i++) {
+            if(!txids[i]) {
+                setBulkError(results, batch[i]->operation, txids[i].getError().what());
+            }
+        }
+    }
 }
 
 auto ReadWriteWallet::payToEntryOwner(core::EntryKey key,
@@ -459,11 +903,31 @@ auto ReadWriteWallet::payToEntryOwner(core::EntryKey key,
         });
 }
 
+auto ReadWriteWallet::checkForPendingOperations(const core::EntryKey& key) const
+    -> utilxx::Result<void, WalletError>
+{
+    auto operations = lookup_->getPendingOperations().getOperationsOn(key);
+    if(operations.empty()) {
+        return {};
+    }
+
+    auto error =
+        fmt::format("entry {} has an operation in transaction {} which is not mature yet",
+                    toHexString(key),
+                    operations.front().txid);
+    return WalletError{std::move(error)};
+}
+
 auto ReadWriteWallet::createEntryOwnerPairFromKey(core::EntryKey key)
     -> utilxx::Result<std::pair<core::Entry,
                                 std::string>,
                       WalletError>
 {
+    if(auto res = checkForPendingOperations(key);
+       !res) {
+        return res.getError();
+    }
+
     auto entry_opt = lookup_->lookup(key);
     auto owner_opt = lookup_->lookupOwner(key);
     auto lookup_opt = utilxx::combine(std::move(entry_opt),
@@ -487,6 +951,11 @@ auto ReadWriteWallet::createRenewableEntryOwnerPairFromKey(core::EntryKey key)
                                 std::string>,
                       WalletError>
 {
+    if(auto res = checkForPendingOperations(key);
+       !res) {
+        return res.getError();
+    }
+
     auto entry_opt = [&]()
         -> utilxx::Opt<core::RenewableEntry> {
         if(auto um_entry_opt = lookup_->lookupUMValue(key);
@@ -523,31 +992,91 @@ auto ReadWriteWallet::createRenewableEntryOwnerPairFromKey(core::EntryKey key)
                      std::move(owner)};
 }
 
-auto ReadWriteWallet::burn(const std::string& address,
-                           std::int64_t burn_amount,
-                           std::vector<std::byte> metadata)
-    -> utilxx::Result<std::string, WalletError>
+auto ReadWriteWallet::findOutputOfAddress(const std::string& address,
+                                          std::int64_t amount) const
+    -> utilxx::Opt<core::Unspent>
 {
-    auto default_fee = getDefaultTxFee(getLookup().getCoin());
+    //a change output below the minimum amount would not be relayed
+    auto min_change = getMinimumTxAmount(getLookup().getCoin());
+    auto unspent_res = client_->lockUnspent(amount,
+                                            min_change,
+                                            address);
+    if(!unspent_res) {
+        LOG(WARNING) << "unable to list unspent outputs: "
+                     << unspent_res.getError().what();
+        return std::nullopt;
+    }
 
+    return std::move(unspent_res.getValue());
+}
+
+auto ReadWriteWallet::fundAddress(const std::string& address,
+                                  std::int64_t amount)
+    -> utilxx::Result<core::Unspent, client::ClientError>
+{
     return client_
-        //send the needed amount to the address
-        ->sendToAddress(burn_amount
-                            + default_fee,
+        ->sendToAddress(amount,
                         address)
         .flatMap([&](auto txid) {
-            //write the metadata to the blockchain
             return client_
                 ->getVOutIdxByAmountAndAddress(txid,
-                                               burn_amount
-                                                   + default_fee,
+                                               amount,
                                                address)
-                .flatMap([&](auto vout_idx) {
-                    return client_
-                        ->burnOutput(std::move(txid),
-                                     vout_idx,
-                                     std::move(metadata));
+                .map([&](auto vout_idx) {
+                    return core::Unspent{amount,
+                                         vout_idx,
+                                         0,
+                                         address,
+                                         std::move(txid)};
                 });
+        });
+}
+
+auto ReadWriteWallet::getOutputToBurn(const std::string& address,
+                                      std::int64_t amount)
+    -> utilxx::Result<core::Unspent, client::ClientError>
+{
+    if(auto output_opt = findOutputOfAddress(address, amount);
+       output_opt) {
+        return std::move(output_opt.getValue());
+    }
+
+    //the address has no suitable output, so it gets one
+    //with an additional transaction
+    return fundAddress(address, amount);
+}
+
+auto ReadWriteWallet::burn(const std::string& address,
+                           std::int64_t burn_amount,
+                           std::vector<std::byte> metadata)
+    -> utilxx::Result<std::string, WalletError>
+{
+    auto fee_rate_res = client_->getFeeRate();
+    if(!fee_rate_res) {
+        return WalletError{fee_rate_res.getError().what()};
+    }
+
+    //the address gets the change
+    auto needed = burn_amount
+        + client_->computeBurnFee(fee_rate_res.getValue(),
+                                  metadata.size(),
+                                  1);
+
+    return getOutputToBurn(address, needed)
+        .flatMap([&](auto output) {
+            std::vector<std::pair<std::string, std::int64_t>> outputs;
+            if(auto change = output.getValue() - needed;
+               change > 0) {
+                outputs.emplace_back(address, change);
+            }
+
+            auto res = client_->writeTxToBlockchain(output.getTxid(),
+                                                    output.getVoutIdx(),
+                                                    std::move(metadata),
+                                                    burn_amount,
+                                                    std::move(outputs));
+            client_->unlockUnspent(output, true);
+            return res;
         })
         .onValue([&](auto /*unused*/) {
             addNewOwnedAddress(std::move(address));
@@ -563,29 +1092,36 @@ auto ReadWriteWallet::burn(const std::string& owner,
                            std::vector<std::byte> metadata)
     -> utilxx::Result<std::string, WalletError>
 {
+    auto fee_rate_res = client_->getFeeRate();
+    if(!fee_rate_res) {
+        return WalletError{fee_rate_res.getError().what()};
+    }
+
     auto coin = getLookup().getCoin();
+    //the new owner receives the minimum amount,
+    //the owner gets the change
+    auto needed = burn_amount
+        + getMinimumTxAmount(coin)
+        + client_->computeBurnFee(fee_rate_res.getValue(),
+                                  metadata.size(),
+                                  2);
+
+    return getOutputToBurn(owner, needed)
+        .flatMap([&](auto output) {
+            std::vector<std::pair<std::string, std::int64_t>> outputs{
+                {new_owner, getMinimumTxAmount(coin)}};
+            if(auto change = output.getValue() - needed;
+               change > 0) {
+                outputs.emplace_back(owner, change);
+            }
 
-    return client_
-        //send +minTxAmount because this will be send to the new owner address
-        ->sendToAddress(burn_amount
-                            + getMinimumTxAmount(coin)
-                            + getDefaultTxFee(coin),
-                        owner)
-        .flatMap([&](auto txid) {
-            return client_
-                ->getVOutIdxByAmountAndAddress(txid,
-                                               burn_amount
-                                                   + getMinimumTxAmount(coin)
-                                                   + getDefaultTxFee(coin),
-                                               std::move(owner))
-                .flatMap([&](auto vout_idx) {
-                    return client_
-                        ->burnAmount(std::move(txid),
-                                     vout_idx,
-                                     burn_amount,
-                                     std::move(metadata),
-                                     std::move(new_owner));
-                });
+            auto res = client_->writeTxToBlockchain(output.getTxid(),
+                                                    output.getVoutIdx(),
+                                                    std::move(metadata),
+                                                    burn_amount,
+                                                    std::move(outputs));
+            client_->unlockUnspent(output, true);
+            return res;
         })
         .mapError([](auto error) {
             return WalletError{std::move(error.what())};
@@ -0,0 +1,42 @@
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <utilxx/Opt.hpp>
+#include <vector>
+#include <wallet/TokenSendPlan.hpp>
+
+using forge::wallet::TokenBalances;
+
+auto forge::wallet::planTokenSends(TokenBalances balances,
+                                   std::uint64_t amount)
+    -> utilxx::Opt<TokenBalances>
+{
+    //ordered by address for equal balances,
+    //so that a plan does not depend on the order of the wallet
+    std::sort(std::begin(balances),
+              std::end(balances),
+              [](const auto& lhs, const auto& rhs) {
+                  return lhs.second != rhs.second
+                      ? lhs.second > rhs.second
+                      : lhs.first < rhs.first;
+              });
+
+    TokenBalances plan;
+    std::uint64_t covered{0};
+
+    for(auto&& [address, balance] : balances) {
+        if(covered == amount || balance == 0) {
+            break;
+        }
+
+        auto used = std::min(balance, amount - covered);
+        plan.emplace_back(std::move(address), used);
+        covered += used;
+    }
+
+    if(covered != amount) {
+        return std::nullopt;
+    }
+
+    return plan;
+}
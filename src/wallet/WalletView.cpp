@@ -0,0 +1,171 @@
+#include <entrys/token/UtilityToken.hpp>
+#include <entrys/uentry/UniqueEntry.hpp>
+#include <entrys/umentry/UMEntry.hpp>
+#include <iterator>
+#include <lookup/LookupChangeSet.hpp>
+#include <lookup/LookupManager.hpp>
+#include <set>
+#include <string>
+#include <vector>
+#include <wallet/AddressBook.hpp>
+#include <wallet/WalletView.hpp>
+
+using forge::wallet::WalletView;
+using forge::wallet::AddressSet;
+using forge::lookup::LookupManager;
+using forge::lookup::LookupChangeSet;
+using forge::core::EntryKey;
+
+namespace {
+
+auto isOwnedByAny(const LookupManager& lookup,
+                  const EntryKey& key,
+                  const AddressSet& addresses)
+    -> bool
+{
+    auto owner_opt = lookup.lookupOwner(key);
+    if(!owner_opt) {
+        return false;
+    }
+
+    const std::string owner = owner_opt.getValue().get();
+    return addresses.find(owner) != addresses.end();
+}
+
+template<class Set>
+auto updateMembership(Set& set,
+                      const EntryKey& key,
+                      bool is_member)
+    -> void
+{
+    if(is_member) {
+        set.insert(key);
+    } else {
+        set.erase(key);
+    }
+}
+
+} // namespace
+
+auto WalletView::addAddress(const LookupManager& lookup,
+                            const std::string& address)
+    -> void
+{
+    for(auto&& entry : lookup.getUMEntrysOfOwner(address)) {
+        um_entrys_.insert(std::move(entry.getKey()));
+    }
+
+    for(auto&& entry : lookup.getUniqueEntrysOfOwner(address)) {
+        unique_entrys_.insert(std::move(entry.getKey()));
+    }
+
+    auto& tokens = utility_tokens_[address];
+    for(auto&& token : lookup.getUtilityTokensOfOwner(address)) {
+        if(token.getAttachedAmount() > 0) {
+            tokens.insert(std::move(token.getId()));
+        }
+    }
+}
+
+auto WalletView::removeAddress(const LookupManager& lookup,
+                               const std::string& address)
+    -> void
+{
+    AddressSet removed{address};
+
+    for(auto iter = std::begin(um_entrys_); iter != std::end(um_entrys_);) {
+        iter = isOwnedByAny(lookup, *iter, removed)
+            ? um_entrys_.erase(iter)
+            : std::next(iter);
+    }
+
+    for(auto iter = std::begin(unique_entrys_); iter != std::end(unique_entrys_);) {
+        iter = isOwnedByAny(lookup, *iter, removed)
+            ? unique_entrys_.erase(iter)
+            : std::next(iter);
+    }
+
+    utility_tokens_.erase(address);
+}
+
+auto WalletView::apply(const LookupManager& lookup,
+                       const LookupChangeSet& change_set,
+                       const AddressSet& addresses)
+    -> void
+{
+    for(const auto& key : change_set.um_entry_keys) {
+        auto is_member = lookup.lookupUMValue(key)
+            && isOwnedByAny(lookup, key, addresses);
+        updateMembership(um_entrys_, key, is_member);
+    }
+
+    for(const auto& key : change_set.unique_entry_keys) {
+        auto is_member = lookup.lookupUniqueValue(key)
+            && isOwnedByAny(lookup, key, addresses);
+        updateMembership(unique_entrys_, key, is_member);
+    }
+
+    for(const auto& [token, owner] : change_set.token_accounts) {
+        if(addresses.find(owner) == addresses.end()) {
+            continue;
+        }
+
+        auto credit = lookup.getUtilityTokenCreditOf(owner, token);
+        updateMembership(utility_tokens_[owner], token, credit > 0);
+    }
+}
+
+auto WalletView::getUMEntrys(const LookupManager& lookup) const
+    -> std::vector<core::UMEntry>
+{
+    std::vector<core::UMEntry> ret_vec;
+    ret_vec.reserve(um_entrys_.size());
+
+    for(const auto& key : um_entrys_) {
+        lookup.lookupUMValue(key)
+            .onValue([&](auto value) {
+                ret_vec.emplace_back(key, value.get());
+            });
+    }
+
+    return ret_vec;
+}
+
+auto WalletView::getUniqueEntrys(const LookupManager& lookup) const
+    -> std::vector<core::UniqueEntry>
+{
+    std::vector<core::UniqueEntry> ret_vec;
+    ret_vec.reserve(unique_entrys_.size());
+
+    for(const auto& key : unique_entrys_) {
+        lookup.lookupUniqueValue(key)
+            .onValue([&](auto value) {
+                ret_vec.emplace_back(key, value.get());
+            });
+    }
+
+    return ret_vec;
+}
+
+auto WalletView::getUtilityTokens(const LookupManager& lookup) const
+    -> std::vector<core::UtilityToken>
+{
+    std::vector<core::UtilityToken> ret_vec;
+
+    for(const auto& [owner, tokens] : utility_tokens_) {
+        for(const auto& token : tokens) {
+            ret_vec.emplace_back(token,
+                                 lookup.getUtilityTokenCreditOf(owner, token));
+        }
+    }
+
+    return ret_vec;
+}
+
+auto WalletView::clear()
+    -> void
+{
+    um_entrys_.clear();
+    unique_entrys_.clear();
+    utility_tokens_.clear();
+}
@@ -0,0 +1,118 @@
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <string>
+#include <wallet/AddressBook.hpp>
+
+using namespace forge::wallet;
+
+namespace {
+
+auto makeTempPath(const std::string& name)
+    -> std::string
+{
+    auto path = std::filesystem::temp_directory_path() / name;
+    std::filesystem::remove(path);
+    return path.string();
+}
+
+auto countLines(const std::string& path)
+    -> std::size_t
+{
+    std::ifstream file{path};
+    std::size_t lines{0};
+
+    std::string line;
+    while(std::getline(file, line)) {
+        lines++;
+    }
+
+    return lines;
+}
+
+} // namespace
+
+TEST(AddressBookTest, InMemoryTest)
+{
+    AddressBook book;
+
+    EXPECT_TRUE(book.addOwned("oLupzckPUYtGydsBisL86zcwsBweJm1dSM"));
+    EXPECT_FALSE(book.addOwned("oLupzckPUYtGydsBisL86zcwsBweJm1dSM"));
+    EXPECT_TRUE(book.addWatched("oMaZKaWWyu6Zqrs5ck3DXgFbMEre7Jo58W"));
+
+    EXPECT_TRUE(book.isOwned("oLupzckPUYtGydsBisL86zcwsBweJm1dSM"));
+    EXPECT_FALSE(book.isOwned("oMaZKaWWyu6Zqrs5ck3DXgFbMEre7Jo58W"));
+    EXPECT_TRUE(book.isWatched("oMaZKaWWyu6Zqrs5ck3DXgFbMEre7Jo58W"));
+
+    EXPECT_TRUE(book.removeWatched("oMaZKaWWyu6Zqrs5ck3DXgFbMEre7Jo58W"));
+    EXPECT_FALSE(book.removeWatched("oMaZKaWWyu6Zqrs5ck3DXgFbMEre7Jo58W"));
+    EXPECT_TRUE(book.getWatched().empty());
+    EXPECT_FALSE(book.getPath());
+}
+
+TEST(AddressBookTest, PersistTest)
+{
+    auto path = makeTempPath("forge_address_book_persist");
+
+    {
+        AddressBook book{path};
+        EXPECT_TRUE(book.getOwned().empty());
+
+        book.addOwned("oLupzckPUYtGydsBisL86zcwsBweJm1dSM");
+        book.addWatched("oMaZKaWWyu6Zqrs5ck3DXgFbMEre7Jo58W");
+        book.addWatched("oRDxB5XznfHGDMPcRyjD2cnq6hahtpWkTT");
+        book.removeWatched("oRDxB5XznfHGDMPcRyjD2cnq6hahtpWkTT");
+    }
+
+    AddressBook book{path};
+    EXPECT_EQ(book.getOwned().size(), 1u);
+    EXPECT_EQ(book.getWatched().size(), 1u);
+    EXPECT_TRUE(book.isOwned("oLupzckPUYtGydsBisL86zcwsBweJm1dSM"));
+    EXPECT_TRUE(book.isWatched("oMaZKaWWyu6Zqrs5ck3DXgFbMEre7Jo58W"));
+    EXPECT_FALSE(book.isWatched("oRDxB5XznfHGDMPcRyjD2cnq6hahtpWkTT"));
+
+    std::filesystem::remove(path);
+}
+
+TEST(AddressBookTest, CompactionTest)
+{
+    auto path = makeTempPath("forge_address_book_compaction");
+
+    {
+        AddressBook book{path};
+        book.addOwned("oLupzckPUYtGydsBisL86zcwsBweJm1dSM");
+        for(int i = 0; i < 10; i++) {
+            book.addWatched("oMaZKaWWyu6Zqrs5ck3DXgFbMEre7Jo58W");
+            book.removeWatched("oMaZKaWWyu6Zqrs5ck3DXgFbMEre7Jo58W");
+        }
+    }
+
+    EXPECT_EQ(countLines(path), 21u);
+
+    //opening the book rewrites the log
+    AddressBook book{path};
+    EXPECT_EQ(countLines(path), 1u);
+    EXPECT_TRUE(book.isOwned("oLupzckPUYtGydsBisL86zcwsBweJm1dSM"));
+    EXPECT_TRUE(book.getWatched().empty());
+
+    std::filesystem::remove(path);
+}
+
+TEST(AddressBookTest, InvalidRecordTest)
+{
+    auto path = makeTempPath("forge_address_book_invalid");
+
+    {
+        std::ofstream file{path};
+        file << "o oLupzckPUYtGydsBisL86zcwsBweJm1dSM\n"
+             << "x oMaZKaWWyu6Zqrs5ck3DXgFbMEre7Jo58W\n"
+             << "w";
+    }
+
+    AddressBook book{path};
+    EXPECT_EQ(book.getOwned().size(), 1u);
+    EXPECT_TRUE(book.getWatched().empty());
+
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,118 @@
+#include <env/AsyncLogger.hpp>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace forge::env;
+
+namespace {
+
+struct CollectingSink
+{
+    auto operator()(const LogSite& /*site*/,
+                    std::string&& message)
+        -> void
+    {
+        std::unique_lock lock{mtx};
+        messages.push_back(std::move(message));
+    }
+
+    auto getMessages()
+        -> std::vector<std::string>
+    {
+        std::unique_lock lock{mtx};
+        return messages;
+    }
+
+    std::mutex mtx;
+    std::vector<std::string> messages;
+};
+
+} // namespace
+
+TEST(AsyncLoggerTest, FormatTest)
+{
+    CollectingSink sink;
+    AsyncLogger logger{std::ref(sink)};
+    LogSite site{LogLevel::INFO, __FILE__, __LINE__, 1, 100};
+
+    std::string txid{"abcdef"};
+    logger.log(site, "{} contains {} outputs, {} {}", txid, 2, -1.5, true);
+    logger.log(site, "no arguments");
+    logger.log(site, "{}", std::string(300, 'x'));
+    logger.flush();
+
+    auto messages = sink.getMessages();
+    ASSERT_EQ(messages.size(), 3);
+    EXPECT_EQ(messages[0], "abcdef contains 2 outputs, -1.5 true");
+    EXPECT_EQ(messages[1], "no arguments");
+
+    //long strings are truncated
+    EXPECT_EQ(messages[2], std::string(MAX_LOG_STRING_SIZE, 'x'));
+}
+
+TEST(AsyncLoggerTest, RateLimitTest)
+{
+    CollectingSink sink;
+    AsyncLogger logger{std::ref(sink)};
+    LogSite limited{LogLevel::DEBUG, __FILE__, __LINE__, 1, 3};
+    LogSite sampled{LogLevel::DEBUG, __FILE__, __LINE__, 4, 100};
+
+    for(int i = 0; i < 10; i++) {
+        logger.log(limited, "limited {}", i);
+        logger.log(sampled, "sampled {}", i);
+    }
+    logger.flush();
+
+    std::vector<std::string> expected{"limited 0",
+                                      "sampled 0",
+                                      "limited 1",
+                                      "limited 2",
+                                      "sampled 4",
+                                      "sampled 8"};
+
+    //unless the test crossed a second boundary
+    auto messages = sink.getMessages();
+    if(messages.size() == expected.size()) {
+        EXPECT_EQ(messages, expected);
+        EXPECT_EQ(limited.takeSuppressed(), 7);
+    }
+}
+
+TEST(AsyncLoggerTest, FullQueueTest)
+{
+    CollectingSink sink;
+    LogSite site{LogLevel::DEBUG, __FILE__, __LINE__, 1, 10000};
+    std::size_t logged{0};
+
+    {
+        AsyncLogger logger{std::ref(sink), 2};
+        for(int i = 0; i < 1000; i++) {
+            logger.log(site, "{}", i);
+        }
+        logged = 1000 - logger.getDropped();
+    }
+
+    //the destructor writes everything which was queued
+    EXPECT_EQ(sink.getMessages().size(), logged);
+}
+
+TEST(AsyncLoggerTest, WarningTest)
+{
+    CollectingSink sink;
+    AsyncLogger logger{std::ref(sink)};
+    LogSite site{LogLevel::WARNING, __FILE__, __LINE__, 1, 3};
+
+    std::string error(300, 'x');
+    for(int i = 0; i < 10; i++) {
+        logger.log(site, "{} {}", i, error);
+    }
+
+    //warnings are written before log returns,
+    //they are neither truncated nor rate limited
+    auto messages = sink.getMessages();
+    ASSERT_EQ(messages.size(), 10);
+    EXPECT_EQ(messages[9], "9 " + error);
+    EXPECT_EQ(site.takeSuppressed(), 0);
+}
@@ -0,0 +1,60 @@
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <lookup/BlockArena.hpp>
+#include <map>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+using namespace forge::lookup;
+
+TEST(BlockArenaTest, AllocateInBufferTest)
+{
+    BlockArena arena{4096};
+
+    {
+        std::pmr::vector<int> values{arena.getResource()};
+        for(int i = 0; i < 100; i++) {
+            values.push_back(i);
+        }
+
+        std::pmr::map<int, std::pmr::vector<int>> grouped{arena.getResource()};
+        for(auto value : values) {
+            grouped[value % 10].push_back(value);
+        }
+
+        //the nested vectors use the arena too
+        EXPECT_EQ(grouped[3].get_allocator().resource(), arena.getResource());
+        EXPECT_EQ(grouped[3].size(), 10);
+    }
+
+    EXPECT_EQ(arena.getOverflowSize(), 0);
+
+    arena.reset();
+    EXPECT_EQ(arena.getBufferSize(), 4096);
+}
+
+TEST(BlockArenaTest, GrowAfterOverflowTest)
+{
+    BlockArena arena{1024};
+
+    {
+        std::pmr::vector<std::byte> bytes{arena.getResource()};
+        bytes.resize(64 * 1024);
+    }
+
+    EXPECT_GT(arena.getOverflowSize(), 0);
+
+    arena.reset();
+
+    //the next block of the same size fits into the buffer
+    EXPECT_GE(arena.getBufferSize(), 64 * 1024);
+    EXPECT_EQ(arena.getOverflowSize(), 0);
+
+    {
+        std::pmr::vector<std::byte> bytes{arena.getResource()};
+        bytes.resize(64 * 1024);
+    }
+
+    EXPECT_EQ(arena.getOverflowSize(), 0);
+}
@@ -0,0 +1,135 @@
+#include <chrono>
+#include <core/Transaction.hpp>
+#include <entrys/token/UtilityTokenOperation.hpp>
+#include <entrys/umentry/UMEntryOperation.hpp>
+#include <gtest/gtest.h>
+#include <lookup/ChangeFeed.hpp>
+#include <string>
+
+using namespace forge::core;
+using namespace forge::lookup;
+using namespace std::chrono_literals;
+
+namespace {
+
+auto createUMOp(std::string&& data,
+                std::string&& owner,
+                std::int64_t block,
+                std::int64_t value)
+    -> UMEntryOperation
+{
+    auto metadata =
+        extractMetadata(std::move(data))
+            .getValue();
+
+    return parseMetadataToUMEntryOp(std::move(metadata),
+                                    block,
+                                    std::move(owner),
+                                    value)
+        .getValue();
+}
+
+auto createTokenOp(const std::string& op,
+                   std::int64_t block,
+                   std::string owner,
+                   std::int64_t burn_value)
+    -> UtilityTokenOperation
+{
+    auto metadata = stringToByteVec(op).getValue();
+
+    return parseMetadataToUtilityTokenOp(metadata,
+                                         block,
+                                         std::move(owner),
+                                         burn_value,
+                                         std::nullopt)
+        .getValue();
+}
+
+} // namespace
+
+TEST(ChangeFeedTest, RecordAndPollTest)
+{
+    ChangeFeed feed;
+
+    feed.recordOperations(
+        10,
+        std::vector{createUMOp("6a00c6dc75010101aabbccdddeadbeef",
+                               "oLupzckPUYtGydsBisL86zcwsBweJm1dSM",
+                               10,
+                               10)});
+
+    feed.recordOperations(
+        11,
+        std::vector{createTokenOp("c6dc75"
+                                  "03"
+                                  "01"
+                                  "0000000000000003"
+                                  "deadbeef",
+                                  11,
+                                  "oLupzckPUYtGydsBisL86zcwsBweJm1dSM",
+                                  10)});
+
+    feed.recordRollback(11);
+
+    EXPECT_EQ(feed.getFirstSequence(), 0);
+    EXPECT_EQ(feed.getNextSequence(), 3);
+
+    auto events = feed.getEvents(0, 10, 0ms);
+    ASSERT_EQ(events.size(), 3);
+
+    auto creation = changeEventToJson(events[0]);
+    EXPECT_EQ(creation["sequence"].asUInt64(), 0);
+    EXPECT_EQ(creation["height"].asInt64(), 10);
+    EXPECT_EQ(creation["event"].asString(), "operation");
+    EXPECT_EQ(creation["entrytype"].asString(), "umentry");
+    EXPECT_EQ(creation["operation"].asString(), "creation");
+    EXPECT_EQ(creation["key"].asString(), "deadbeef");
+    EXPECT_EQ(creation["owner"].asString(), "oLupzckPUYtGydsBisL86zcwsBweJm1dSM");
+
+    auto token = changeEventToJson(events[1]);
+    EXPECT_EQ(token["entrytype"].asString(), "utilitytoken");
+    EXPECT_EQ(token["token"].asString(), "deadbeef");
+    EXPECT_EQ(token["amount"].asString(), "3");
+
+    auto rollback = changeEventToJson(events[2]);
+    EXPECT_EQ(rollback["event"].asString(), "rollback");
+    EXPECT_EQ(rollback["height"].asInt64(), 11);
+
+    //resume after the last seen event
+    auto rest = feed.getEvents(2, 10, 0ms);
+    ASSERT_EQ(rest.size(), 1);
+    EXPECT_EQ(rest[0].sequence, 2);
+
+    EXPECT_EQ(feed.getEvents(0, 1, 0ms).size(), 1);
+    EXPECT_TRUE(feed.getEvents(3, 10, 10ms).empty());
+}
+
+TEST(ChangeFeedTest, CapacityTest)
+{
+    ChangeFeed feed{2};
+
+    feed.recordRollback(1);
+    feed.recordRollback(2);
+    feed.recordRollback(3);
+
+    EXPECT_EQ(feed.getFirstSequence(), 1);
+    EXPECT_EQ(feed.getNextSequence(), 3);
+
+    //dropped events are skipped
+    auto events = feed.getEvents(0, 10, 0ms);
+    ASSERT_EQ(events.size(), 2);
+    EXPECT_EQ(events[0].sequence, 1);
+    EXPECT_EQ(events[1].block_height, 3);
+}
+
+TEST(ChangeFeedTest, WaitIsCappedTest)
+{
+    ChangeFeed feed;
+
+    //a long poll must not hold a server thread for the requested time
+    auto begin = std::chrono::steady_clock::now();
+    EXPECT_TRUE(feed.getEvents(0, 10, 60s).empty());
+    auto waited = std::chrono::steady_clock::now() - begin;
+
+    EXPECT_LT(waited, MAX_CHANGE_FEED_WAIT + 500ms);
+}
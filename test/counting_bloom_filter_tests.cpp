@@ -0,0 +1,103 @@
+#include <cstddef>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <lookup/CountingBloomFilter.hpp>
+#include <utility>
+#include <vector>
+
+using namespace forge::lookup;
+
+namespace {
+
+auto makeKey(std::uint32_t value)
+    -> std::vector<std::byte>
+{
+    return {static_cast<std::byte>(value >> 24),
+            static_cast<std::byte>(value >> 16),
+            static_cast<std::byte>(value >> 8),
+            static_cast<std::byte>(value)};
+}
+
+} // namespace
+
+TEST(CountingBloomFilterTest, InsertEraseTest)
+{
+    CountingBloomFilter filter{100};
+    auto key = makeKey(42);
+
+    EXPECT_FALSE(filter.mayContain(key));
+
+    filter.insert(key);
+    filter.insert(key);
+    EXPECT_TRUE(filter.mayContain(key));
+    EXPECT_EQ(filter.size(), 2);
+
+    //inserted twice, so it has to be erased twice
+    filter.erase(key);
+    EXPECT_TRUE(filter.mayContain(key));
+
+    filter.erase(key);
+    EXPECT_FALSE(filter.mayContain(key));
+    EXPECT_EQ(filter.size(), 0);
+}
+
+TEST(CountingBloomFilterTest, NoFalseNegativesTest)
+{
+    constexpr std::uint32_t number_of_keys = 1000;
+    CountingBloomFilter filter{number_of_keys};
+
+    for(std::uint32_t i = 0; i < number_of_keys; i++) {
+        filter.insert(makeKey(i));
+    }
+
+    //erasing half of the keys must not lose the other half
+    for(std::uint32_t i = 0; i < number_of_keys; i += 2) {
+        filter.erase(makeKey(i));
+    }
+
+    for(std::uint32_t i = 1; i < number_of_keys; i += 2) {
+        EXPECT_TRUE(filter.mayContain(makeKey(i)));
+    }
+}
+
+TEST(CountingBloomFilterTest, FalsePositiveRateTest)
+{
+    constexpr std::uint32_t number_of_keys = 10000;
+    CountingBloomFilter filter{number_of_keys};
+
+    for(std::uint32_t i = 0; i < number_of_keys; i++) {
+        filter.insert(makeKey(i));
+    }
+
+    std::size_t false_positives{0};
+    for(std::uint32_t i = number_of_keys; i < 2 * number_of_keys; i++) {
+        false_positives += filter.mayContain(makeKey(i));
+    }
+
+    //about 1% is expected
+    EXPECT_LT(false_positives, number_of_keys / 50);
+}
+
+TEST(CountingBloomFilterTest, ClearTest)
+{
+    CountingBloomFilter filter{10};
+    filter.insert(makeKey(1));
+
+    filter.clear(1000);
+
+    EXPECT_FALSE(filter.mayContain(makeKey(1)));
+    EXPECT_EQ(filter.size(), 0);
+    EXPECT_EQ(filter.getCapacity(), 1000);
+}
+
+TEST(CountingBloomFilterTest, MovedFromTest)
+{
+    CountingBloomFilter filter{10};
+    auto moved = std::move(filter);
+
+    //a moved from filter may contain every key, but never divides by zero
+    filter.insert(makeKey(1));
+    EXPECT_TRUE(filter.mayContain(makeKey(1)));
+    EXPECT_TRUE(filter.mayContain(makeKey(2)));
+    filter.erase(makeKey(1));
+}
@@ -0,0 +1,149 @@
+#include <core/Transaction.hpp>
+#include <entrys/Entry.hpp>
+#include <entrys/umentry/UMEntry.hpp>
+#include <gtest/gtest.h>
+#include <lookup/EntryHistory.hpp>
+#include <string>
+#include <variant>
+
+using namespace forge::core;
+using namespace forge::lookup;
+
+namespace {
+
+auto createState(const std::string& key,
+                 const std::string& value,
+                 std::string owner,
+                 std::int64_t block)
+    -> EntryState
+{
+    UMEntry entry{stringToByteVec(key).getValue(),
+                  ByteArray{stringToByteVec(value).getValue()}};
+
+    return EntryState{Entry{std::move(entry)},
+                      std::move(owner),
+                      block};
+}
+
+} // namespace
+
+TEST(EntryHistoryTest, LookupAtTest)
+{
+    EntryHistory history;
+    auto key = stringToByteVec("deadbeef").getValue();
+
+    history.record(key,
+                   10,
+                   createState("deadbeef", "aa", "oLupzckPUYtGydsBisL86zcwsBweJm1dSM", 10));
+    history.record(key,
+                   20,
+                   createState("deadbeef", "aa", "oMaZKaWWyu6Zqrs5ck3DXgFbMEre7Jo58W", 10));
+    history.record(key, 30, std::nullopt);
+
+    EXPECT_FALSE(history.lookupAt(key, 9));
+    EXPECT_FALSE(history.lookupAt(key, 30));
+    EXPECT_FALSE(history.lookupAt(key, 100));
+
+    auto first = history.lookupAt(key, 15);
+    ASSERT_TRUE(first);
+    EXPECT_EQ(first.getValue().block, 10);
+    EXPECT_EQ(first.getValue().state.getValue().owner,
+              "oLupzckPUYtGydsBisL86zcwsBweJm1dSM");
+
+    auto second = history.lookupAt(key, 20);
+    ASSERT_TRUE(second);
+    EXPECT_EQ(second.getValue().state.getValue().owner,
+              "oMaZKaWWyu6Zqrs5ck3DXgFbMEre7Jo58W");
+
+    EXPECT_EQ(history.getVersions(key).size(), 3);
+}
+
+TEST(EntryHistoryTest, SameBlockTest)
+{
+    EntryHistory history;
+    auto key = stringToByteVec("deadbeef").getValue();
+
+    //keys which never existed are not recorded
+    history.record(key, 5, std::nullopt);
+    EXPECT_TRUE(history.getVersions(key).empty());
+
+    history.record(key,
+                   10,
+                   createState("deadbeef", "aa", "oLupzckPUYtGydsBisL86zcwsBweJm1dSM", 10));
+    history.record(key,
+                   10,
+                   createState("deadbeef", "bb", "oLupzckPUYtGydsBisL86zcwsBweJm1dSM", 10));
+
+    ASSERT_EQ(history.getVersions(key).size(), 1);
+
+    auto version = history.lookupAt(key, 10);
+    ASSERT_TRUE(version);
+
+    const auto& entry =
+        std::get<UMEntry>(version.getValue().state.getValue().entry);
+    EXPECT_EQ(std::get<ByteArray>(entry.getValue()),
+              stringToByteVec("bb").getValue());
+
+    history.clear();
+    EXPECT_FALSE(history.lookupAt(key, 10));
+}
+
+TEST(EntryHistoryTest, CompactTest)
+{
+    EntryHistory history;
+    auto first_key = stringToByteVec("deadbeef").getValue();
+    auto second_key = stringToByteVec("beefdead").getValue();
+
+    //the owners are interned across all keys
+    for(int block = 10; block < 20; block++) {
+        auto owner = block % 2 == 0
+            ? "oLupzckPUYtGydsBisL86zcwsBweJm1dSM"
+            : "oMaZKaWWyu6Zqrs5ck3DXgFbMEre7Jo58W";
+        auto value = block < 15 ? "aa" : "bb";
+
+        history.record(first_key,
+                       block,
+                       createState("deadbeef", value, owner, 10));
+        history.record(second_key,
+                       block,
+                       createState("beefdead", value, owner, block));
+    }
+
+    EXPECT_EQ(history.getNumberOfOwners(), 2);
+
+    //unchanged fields are taken from the versions before
+    auto version = history.lookupAt(first_key, 17).getValue();
+    EXPECT_EQ(version.block, 17);
+    EXPECT_EQ(version.state.getValue().owner, "oMaZKaWWyu6Zqrs5ck3DXgFbMEre7Jo58W");
+    EXPECT_EQ(version.state.getValue().activation_block, 10);
+
+    const auto& entry = std::get<UMEntry>(version.state.getValue().entry);
+    EXPECT_EQ(entry.getKey(), first_key);
+    EXPECT_EQ(std::get<ByteArray>(entry.getValue()),
+              stringToByteVec("bb").getValue());
+
+    auto early = history.lookupAt(second_key, 12).getValue();
+    EXPECT_EQ(early.state.getValue().activation_block, 12);
+    EXPECT_EQ(std::get<ByteArray>(std::get<UMEntry>(early.state.getValue().entry).getValue()),
+              stringToByteVec("aa").getValue());
+
+    //a replaced version drops the value it added
+    history.record(first_key,
+                   20,
+                   createState("deadbeef", "cc", "oLupzckPUYtGydsBisL86zcwsBweJm1dSM", 10));
+    history.record(first_key, 20, std::nullopt);
+    history.record(first_key,
+                   21,
+                   createState("deadbeef", "bb", "oLupzckPUYtGydsBisL86zcwsBweJm1dSM", 10));
+
+    EXPECT_FALSE(history.lookupAt(first_key, 20));
+
+    auto versions = history.getVersions(first_key);
+    ASSERT_EQ(versions.size(), 12);
+    EXPECT_FALSE(versions[10].state);
+    EXPECT_EQ(std::get<ByteArray>(std::get<UMEntry>(versions[11].state.getValue().entry).getValue()),
+              stringToByteVec("bb").getValue());
+
+    history.clear();
+    EXPECT_EQ(history.getNumberOfOwners(), 0);
+}
@@ -0,0 +1,131 @@
+#include <core/Transaction.hpp>
+#include <entrys/token/UtilityTokenOperation.hpp>
+#include <entrys/umentry/UMEntryOperation.hpp>
+#include <gtest/gtest.h>
+#include <lookup/EntryKeyIndex.hpp>
+#include <lookup/UMEntryLookup.hpp>
+#include <lookup/UniqueEntryLookup.hpp>
+#include <lookup/UtilityTokenLookup.hpp>
+#include <string>
+
+using namespace forge::core;
+using namespace forge::lookup;
+
+namespace {
+
+auto createUMOp(const std::string& key,
+                std::int64_t block)
+    -> UMEntryOperation
+{
+    auto metadata =
+        extractMetadata("6a00c6dc75010101aabbccdd" + key)
+            .getValue();
+
+    return parseMetadataToUMEntryOp(std::move(metadata),
+                                    block,
+                                    "oLupzckPUYtGydsBisL86zcwsBweJm1dSM",
+                                    10)
+        .getValue();
+}
+
+auto createTokenOp(const std::string& token,
+                   std::int64_t block)
+    -> UtilityTokenOperation
+{
+    auto metadata = stringToByteVec("c6dc75"
+                                    "03"
+                                    "01"
+                                    "0000000000000003"
+                                    + token)
+                        .getValue();
+
+    return parseMetadataToUtilityTokenOp(metadata,
+                                         block,
+                                         "oLupzckPUYtGydsBisL86zcwsBweJm1dSM",
+                                         10,
+                                         std::nullopt)
+        .getValue();
+}
+
+auto keysOf(const EntryKeyIndex::ScanResult& result)
+    -> std::vector<std::string>
+{
+    std::vector<std::string> keys;
+    for(const auto& [key, _] : result) {
+        keys.push_back(toHexString(key));
+    }
+    return keys;
+}
+
+} // namespace
+
+TEST(EntryKeyIndexTest, ScanTest)
+{
+    UMEntryLookup um_lookup{nullptr, 0};
+    UniqueEntryLookup unique_lookup{nullptr, 0};
+    UtilityTokenLookup token_lookup{nullptr, 0};
+
+    um_lookup.executeOperations({createUMOp("aa01", 10),
+                                 createUMOp("bb01", 10),
+                                 createUMOp("aa03", 10)});
+
+    token_lookup.executeOperations({createTokenOp("aa02", 10)});
+
+    EntryKeyIndex index;
+    index.rebuild(um_lookup,
+                  unique_lookup,
+                  token_lookup);
+
+    EXPECT_EQ(index.size(), 4);
+
+    auto prefix = stringToByteVec("aa").getValue();
+
+    auto all = index.scan(prefix, std::nullopt, 10);
+    EXPECT_EQ(keysOf(all),
+              (std::vector<std::string>{"aa01", "aa02", "aa03"}));
+    EXPECT_EQ(all[1].second, IndexedEntryType::UtilityToken);
+
+    //paginate with the last key as cursor
+    auto first_page = index.scan(prefix, std::nullopt, 2);
+    ASSERT_EQ(first_page.size(), 2);
+
+    auto second_page = index.scan(prefix, first_page.back().first, 2);
+    EXPECT_EQ(keysOf(second_page),
+              std::vector<std::string>{"aa03"});
+
+    EXPECT_TRUE(index.scan(prefix, second_page.back().first, 2).empty());
+
+    //an empty prefix matches everything
+    EXPECT_EQ(index.scan({}, std::nullopt, 10).size(), 4);
+    EXPECT_TRUE(index.scan(stringToByteVec("cc").getValue(), std::nullopt, 10).empty());
+}
+
+TEST(EntryKeyIndexTest, UpdateTest)
+{
+    EntryKeyIndex index;
+    auto first = stringToByteVec("aa01").getValue();
+    auto second = stringToByteVec("aa02").getValue();
+
+    index.update(second, {IndexedEntryType::UMEntry});
+    index.update(first, {IndexedEntryType::UniqueEntry});
+    index.update(second, {IndexedEntryType::UMEntry,
+                          IndexedEntryType::UtilityToken});
+
+    auto all = index.scan({}, std::nullopt, 10);
+    EXPECT_EQ(keysOf(all),
+              (std::vector<std::string>{"aa01", "aa02", "aa02"}));
+    EXPECT_EQ(all[0].second, IndexedEntryType::UniqueEntry);
+    EXPECT_EQ(all[2].second, IndexedEntryType::UtilityToken);
+
+    //removing keys over and over compacts the key buffer
+    //without losing the keys which are left
+    for(int i = 0; i < 10; i++) {
+        index.update(first, {});
+        index.update(first, {IndexedEntryType::UMEntry});
+    }
+    index.update(second, {});
+
+    EXPECT_EQ(keysOf(index.scan({}, std::nullopt, 10)),
+              std::vector<std::string>{"aa01"});
+    EXPECT_EQ(index.size(), 1);
+}
@@ -375,3 +375,74 @@ TEST(UMEntryTest, UMEntryParsingInvalidIpv4)
 
     ASSERT_FALSE(entry_opt2);
 }
+
+TEST(UMEntryTest, UMEntryValueParsingValidByteArray)
+{
+    auto data1 = forge::core::stringToByteVec("ffffff01ff0803aabbccdeadbeef").getValue();
+    auto entry_opt1 = forge::core::parseUMValue(data1);
+    std::vector expected1{
+        (std::byte)0xaa,
+        (std::byte)0xbb,
+        (std::byte)0xcc};
+
+    ASSERT_TRUE(entry_opt1);
+    EXPECT_EQ(entry_opt1.getValue(), forge::core::UMEntryValue{expected1});
+
+    //the length points past the end of the metadata
+    auto data2 = forge::core::stringToByteVec("ffffff01ff0810aabbcc").getValue();
+    auto entry_opt2 = forge::core::parseUMValue(data2);
+
+    EXPECT_FALSE(entry_opt2);
+}
+
+TEST(UMEntryTest, UMEntryParsingValidByteArray)
+{
+    auto data1 = forge::core::stringToByteVec("ffffff01ff0803aabbccdeadbeef").getValue();
+    auto entry_opt1 = forge::core::parseUMEntry(data1);
+    std::vector key1{
+        (std::byte)0xde,
+        (std::byte)0xad,
+        (std::byte)0xbe,
+        (std::byte)0xef};
+    std::vector value1{
+        (std::byte)0xaa,
+        (std::byte)0xbb,
+        (std::byte)0xcc};
+    forge::core::UMEntry expected1{key1, forge::core::UMEntryValue{value1}};
+
+    ASSERT_TRUE(entry_opt1);
+    EXPECT_EQ(entry_opt1.getValue(), expected1);
+
+    //the raw data has to contain the length again
+    auto data11 = entry_opt1.getValue().toRawData();
+    auto expected11 = forge::core::stringToByteVec("0803aabbccdeadbeef").getValue();
+    EXPECT_EQ(data11, expected11);
+}
+
+TEST(UMEntryTest, UMEntryParsingInvalidValueFlag)
+{
+    auto data1 = forge::core::stringToByteVec("ffffff01ff1000000000deadbeef").getValue();
+    auto entry_opt1 = forge::core::parseUMEntry(data1);
+
+    EXPECT_FALSE(entry_opt1);
+}
+
+TEST(UMEntryTest, JsonToUMEntryValueByteArraySize)
+{
+    Json::Value json;
+    json["type"] = "bytearray";
+
+    //the longest array the length prefix can describe
+    json["value"] = std::string(2 * forge::core::MAX_BYTE_ARRAY_VALUE_SIZE, 'a');
+    auto value_opt1 = forge::core::jsonToUMEntryValue(Json::Value{json});
+
+    ASSERT_TRUE(value_opt1);
+    forge::core::UMEntry entry{{std::byte{0x01}}, value_opt1.getValue()};
+    auto data = entry.toRawData();
+    EXPECT_EQ(data[1], std::byte{0xff});
+
+    json["value"] = std::string(2 * forge::core::MAX_BYTE_ARRAY_VALUE_SIZE + 2, 'a');
+    auto value_opt2 = forge::core::jsonToUMEntryValue(Json::Value{json});
+
+    EXPECT_FALSE(value_opt2);
+}
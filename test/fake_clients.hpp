@@ -0,0 +1,549 @@
+#pragma once
+
+#include <client/ClientError.hpp>
+#include <client/ReadOnlyClientBase.hpp>
+#include <client/WriteOnlyClientBase.hpp>
+#include <core/Block.hpp>
+#include <core/Coin.hpp>
+#include <core/Transaction.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <fmt/core.h>
+#include <json/value.h>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <utilxx/Opt.hpp>
+#include <utilxx/Result.hpp>
+#include <vector>
+
+//serves blocks and transactions from memory instead of a daemon
+class FakeReadOnlyClient final : public forge::client::ReadOnlyClientBase
+{
+public:
+    FakeReadOnlyClient()
+        : ReadOnlyClientBase(forge::core::Coin::tOdin) {}
+
+    //appends a block with the given transactions after the last one,
+    //it is processed by the lookup right away, because the
+    //block count is always maturity blocks ahead
+    auto addBlock(std::vector<forge::core::Transaction> txs)
+        -> void
+    {
+        std::vector<std::string> txids;
+        for(auto& tx : txs) {
+            txids.push_back(tx.getTxid());
+            addTransaction(std::move(tx));
+        }
+
+        blocks_.push_back(std::move(txids));
+    }
+
+    //appends a block with a transaction which was never added,
+    //so that processing the block fails
+    auto addUnfetchableBlock()
+        -> void
+    {
+        blocks_.push_back({makeTxid()});
+    }
+
+    auto addTransaction(forge::core::Transaction tx)
+        -> void
+    {
+        auto txid = tx.getTxid();
+        txs_.insert_or_assign(std::move(txid), std::move(tx));
+    }
+
+    //a transaction which spends an output of *owner* and burns *value*
+    //with the given metadata, the new owner gets the first output
+    auto makeBurnTx(const std::string& owner,
+                    const std::vector<std::byte>& metadata,
+                    std::int64_t value,
+                    const utilxx::Opt<std::string>& new_owner = std::nullopt)
+        -> forge::core::Transaction
+    {
+        auto txid = makeTxid();
+        auto input_txid = makeTxid();
+
+        spent_outputs_.insert_or_assign(input_txid,
+                                        forge::core::TxOut{value + 100000,
+                                                           "76a914",
+                                                           {owner}});
+
+        std::vector<forge::core::TxOut> outputs;
+        if(new_owner) {
+            outputs.emplace_back(10000,
+                                 "76a914",
+                                 std::vector{new_owner.getValue()});
+        }
+        outputs.emplace_back(value,
+                             fmt::format("6a{:02x}{}",
+                                         metadata.size() & 0xff,
+                                         forge::core::toHexString(metadata)),
+                             std::vector<std::string>{});
+
+        std::vector<forge::core::TxIn> inputs;
+        inputs.emplace_back(std::move(input_txid), 0);
+
+        return forge::core::Transaction{std::move(inputs),
+                                        std::move(outputs),
+                                        std::move(txid)};
+    }
+
+    //addresses of the wallet of the daemon
+    auto setAddresses(std::vector<std::string> addresses)
+        -> void
+    {
+        addresses_ = std::move(addresses);
+    }
+
+    auto getNewestBlock() const
+        -> utilxx::Result<forge::core::Block, forge::client::ClientError> override
+    {
+        return getBlockHash(getLastHeight())
+            .flatMap([this](auto hash) {
+                return getBlock(std::move(hash));
+            });
+    }
+
+    auto getTransaction(std::string txid) const
+        -> utilxx::Result<forge::core::Transaction, forge::client::ClientError> override
+    {
+        auto iter = txs_.find(txid);
+        if(iter == std::cend(txs_)) {
+            return forge::client::ClientError{"unknown transaction " + txid};
+        }
+
+        return iter->second;
+    }
+
+    auto resolveTxIn(forge::core::TxIn vin) const
+        -> utilxx::Result<forge::core::TxOut, forge::client::ClientError> override
+    {
+        if(auto iter = spent_outputs_.find(vin.getTxid());
+           iter != std::cend(spent_outputs_)) {
+            return iter->second;
+        }
+
+        return getTransaction(vin.getTxid())
+            .flatMap([&](auto tx)
+                         -> utilxx::Result<forge::core::TxOut, forge::client::ClientError> {
+                auto index = static_cast<std::size_t>(vin.getVoutIndex());
+                if(index >= tx.getOutputs().size()) {
+                    return forge::client::ClientError{"unknown output"};
+                }
+                return tx.getOutputs()[index];
+            });
+    }
+
+    auto getBlockCount() const
+        -> utilxx::Result<std::int64_t, forge::client::ClientError> override
+    {
+        return getLastHeight() + forge::core::getMaturity(getCoin());
+    }
+
+    auto getBlockHash(std::int64_t index) const
+        -> utilxx::Result<std::string, forge::client::ClientError> override
+    {
+        return fmt::format("{}", index);
+    }
+
+    //blocks which were not added are empty
+    auto getBlock(std::string hash) const
+        -> utilxx::Result<forge::core::Block, forge::client::ClientError> override
+    {
+        auto height = std::stoll(hash);
+        auto index = height - forge::core::getStartingBlock(getCoin()) - 1;
+
+        std::vector<std::string> txids;
+        if(index >= 0 && index < static_cast<std::int64_t>(blocks_.size())) {
+            txids = blocks_[static_cast<std::size_t>(index)];
+        }
+
+        return forge::core::Block{std::move(txids),
+                                  height,
+                                  0,
+                                  std::move(hash)};
+    }
+
+    auto getUnspent() const
+        -> utilxx::Result<std::vector<forge::core::Unspent>,
+                          forge::client::ClientError> override
+    {
+        return std::vector<forge::core::Unspent>{};
+    }
+
+    auto getOutputValue(std::string txid,
+                        std::int64_t index) const
+        -> utilxx::Result<std::int64_t, forge::client::ClientError> override
+    {
+        return resolveTxIn(forge::core::TxIn{std::move(txid), index})
+            .map([](auto output) {
+                return output.getValue();
+            });
+    }
+
+    auto getAddresses() const
+        -> utilxx::Result<std::vector<std::string>,
+                          forge::client::ClientError> override
+    {
+        return addresses_;
+    }
+
+    auto getRawMempool() const
+        -> utilxx::Result<std::vector<std::string>,
+                          forge::client::ClientError> override
+    {
+        return std::vector<std::string>{};
+    }
+
+    auto isMainnet() const
+        -> utilxx::Result<bool, forge::client::ClientError> override
+    {
+        return false;
+    }
+
+private:
+    auto getLastHeight() const
+        -> std::int64_t
+    {
+        return forge::core::getStartingBlock(getCoin())
+            + static_cast<std::int64_t>(blocks_.size());
+    }
+
+    auto makeTxid()
+        -> std::string
+    {
+        return fmt::format("{:064x}", next_txid_++);
+    }
+
+private:
+    std::vector<std::vector<std::string>> blocks_;
+    std::map<std::string, forge::core::Transaction> txs_;
+    std::map<std::string, forge::core::TxOut> spent_outputs_;
+    std::vector<std::string> addresses_;
+    std::uint64_t next_txid_{1};
+};
+
+//fee of every burn transaction of FakeWriteOnlyClient
+constexpr inline std::int64_t FAKE_BURN_FEE = 1000;
+
+//records the transactions of the wallet instead of sending them,
+//funding transactions are added to the given read only client
+class FakeWriteOnlyClient final : public forge::client::WriteOnlyClientBase
+{
+public:
+    //a transaction which was broadcast
+    struct SentTx
+    {
+        std::string input_txid;
+        std::int64_t index;
+        std::vector<std::byte> metadata;
+        std::int64_t burn_value;
+        std::vector<std::pair<std::string, std::int64_t>> outputs;
+    };
+
+    explicit FakeWriteOnlyClient(FakeReadOnlyClient* read_client)
+        : read_client_(read_client) {}
+
+    //adds an output which can be locked by the wallet
+    auto addUnspent(std::string address,
+                    std::int64_t value)
+        -> forge::core::Unspent
+    {
+        forge::core::Unspent unspent{value,
+                                     0,
+                                     10,
+                                     std::move(address),
+                                     fmt::format("unspent{}", next_id_++)};
+        available_.push_back(unspent);
+        return unspent;
+    }
+
+    //building, signing or sending a transaction which
+    //spends an output of *txid* fails
+    auto failGeneratingOf(std::string txid)
+        -> void
+    {
+        fail_generating_.insert(std::move(txid));
+    }
+    auto failSigningOf(std::string txid)
+        -> void
+    {
+        fail_signing_.insert(std::move(txid));
+    }
+    auto failSendingOf(std::string txid)
+        -> void
+    {
+        fail_sending_.insert(std::move(txid));
+    }
+
+    auto getSent() const
+        -> const std::vector<SentTx>&
+    {
+        return sent_;
+    }
+
+    //(txid, spent) of every call to unlockUnspent
+    auto getUnlocked() const
+        -> const std::vector<std::pair<std::string, bool>>&
+    {
+        return unlocked_;
+    }
+
+    //number of outputs which are locked right now
+    auto getNumberOfLocked() const
+        -> std::size_t
+    {
+        return locked_.size();
+    }
+
+    auto getNumberOfAvailable() const
+        -> std::size_t
+    {
+        return available_.size();
+    }
+
+    //txids of the funding transactions
+    auto getFundings() const
+        -> const std::vector<std::string>&
+    {
+        return fundings_;
+    }
+
+    auto generateRawTx(std::string input_txid,
+                       std::int64_t index,
+                       std::vector<std::byte> metadata,
+                       std::int64_t burn_value,
+                       std::vector<
+                           std::pair<std::string,
+                                     std::int64_t>>
+                           outputs) const
+        -> utilxx::Result<std::vector<std::byte>,
+                          forge::client::ClientError> override
+    {
+        if(fail_generating_.count(input_txid) != 0) {
+            return forge::client::ClientError{"unable to build a transaction spending " + input_txid};
+        }
+
+        auto id = next_id_++;
+        drafts_.emplace(id, SentTx{std::move(input_txid),
+                                   index,
+                                   std::move(metadata),
+                                   burn_value,
+                                   std::move(outputs)});
+
+        return forge::core::stringToASCIIByteVec(std::to_string(id));
+    }
+
+    auto signRawTx(std::vector<std::byte> tx) const
+        -> utilxx::Result<std::vector<std::byte>,
+                          forge::client::ClientError> override
+    {
+        if(fail_signing_.count(getDraft(tx).input_txid) != 0) {
+            return forge::client::ClientError{"unable to sign transaction"};
+        }
+
+        return tx;
+    }
+
+    auto sendRawTx(std::vector<std::byte> tx) const
+        -> utilxx::Result<std::string, forge::client::ClientError> override
+    {
+        const auto& draft = getDraft(tx);
+        if(fail_sending_.count(draft.input_txid) != 0) {
+            return forge::client::ClientError{"unable to send transaction"};
+        }
+
+        sent_.push_back(draft);
+        return decodeTxidOfRawTx(tx);
+    }
+
+    auto decodeTxidOfRawTx(const std::vector<std::byte>& tx) const
+        -> utilxx::Result<std::string, forge::client::ClientError> override
+    {
+        return "sent" + toString(tx);
+    }
+
+    auto generateNewAddress() const
+        -> utilxx::Result<std::string, forge::client::ClientError> override
+    {
+        return fmt::format("new{}", next_id_++);
+    }
+
+    auto sendToAddress(std::int64_t amount,
+                       std::string address) const
+        -> utilxx::Result<std::string, forge::client::ClientError> override
+    {
+        return sendToAddresses({{std::move(address), amount}});
+    }
+
+    //the transaction is parsed from json like the ones of the daemon,
+    //so the values of its outputs are converted the same way
+    auto sendToAddresses(std::vector<
+                         std::pair<std::string,
+                                   std::int64_t>> amounts) const
+        -> utilxx::Result<std::string, forge::client::ClientError> override
+    {
+        auto txid = fmt::format("funding{}", next_id_++);
+
+        Json::Value json;
+        json["txid"] = txid;
+        json["vin"] = Json::arrayValue;
+        json["vout"] = Json::arrayValue;
+        for(const auto& [address, amount] : amounts) {
+            Json::Value output;
+            output["value"] = static_cast<double>(amount) / 100000000.;
+            output["scriptPubKey"]["hex"] = "76a914";
+            output["scriptPubKey"]["addresses"].append(address);
+            json["vout"].append(std::move(output));
+        }
+
+        read_client_->addTransaction(
+            forge::core::buildTransaction(std::move(json)).getValue());
+        fundings_.push_back(txid);
+
+        return txid;
+    }
+
+    auto burnAmount(std::int64_t /*amount*/,
+                    std::vector<std::byte> /*metadata*/) const
+        -> utilxx::Result<std::string, forge::client::ClientError> override
+    {
+        return forge::client::ClientError{"not supported"};
+    }
+
+    auto burnAmount(std::string /*txid*/,
+                    std::int64_t /*index*/,
+                    std::int64_t /*amount*/,
+                    std::vector<std::byte> /*metadata*/,
+                    std::string /*change_address*/) const
+        -> utilxx::Result<std::string, forge::client::ClientError> override
+    {
+        return forge::client::ClientError{"not supported"};
+    }
+
+    auto burnOutput(std::string /*txid*/,
+                    std::int64_t /*index*/,
+                    std::vector<std::byte> /*metadata*/) const
+        -> utilxx::Result<std::string, forge::client::ClientError> override
+    {
+        return forge::client::ClientError{"not supported"};
+    }
+
+    auto lockUnspent(std::int64_t amount,
+                     std::int64_t min_change,
+                     const utilxx::Opt<std::string>& address) const
+        -> utilxx::Result<utilxx::Opt<forge::core::Unspent>,
+                          forge::client::ClientError> override
+    {
+        for(auto iter = std::begin(available_); iter != std::end(available_); ++iter) {
+            if(address && iter->getAddress() != address.getValue()) {
+                continue;
+            }
+            if(iter->getValue() != amount
+               && iter->getValue() < amount + min_change) {
+                continue;
+            }
+
+            auto unspent = std::move(*iter);
+            available_.erase(iter);
+            locked_.push_back(unspent);
+            return utilxx::Opt<forge::core::Unspent>{std::move(unspent)};
+        }
+
+        return utilxx::Opt<forge::core::Unspent>{};
+    }
+
+    auto unlockUnspent(const forge::core::Unspent& output,
+                       bool spent) const
+        -> void override
+    {
+        unlocked_.emplace_back(output.getTxid(), spent);
+
+        auto iter = std::find_if(std::begin(locked_),
+                                 std::end(locked_),
+                                 [&](const auto& locked) {
+                                     return locked.getTxid() == output.getTxid()
+                                         && locked.getVoutIdx() == output.getVoutIdx();
+                                 });
+        if(iter == std::end(locked_)) {
+            return;
+        }
+
+        if(!spent) {
+            available_.push_back(*iter);
+        }
+        locked_.erase(iter);
+    }
+
+    auto getTransaction(std::string txid) const
+        -> utilxx::Result<forge::core::Transaction, forge::client::ClientError> override
+    {
+        return read_client_->getTransaction(std::move(txid));
+    }
+
+    auto getVOutIdxByAmountAndAddress(std::string txid,
+                                      std::int64_t /*amount*/,
+                                      std::string address) const
+        -> utilxx::Result<std::int64_t, forge::client::ClientError> override
+    {
+        return read_client_->getTransaction(std::move(txid))
+            .flatMap([&](auto tx)
+                         -> utilxx::Result<std::int64_t, forge::client::ClientError> {
+                const auto& outputs = tx.getOutputs();
+                for(std::size_t i = 0; i < outputs.size(); i++) {
+                    if(outputs[i].getAddresses() == std::vector{address}) {
+                        return static_cast<std::int64_t>(i);
+                    }
+                }
+                return forge::client::ClientError{"no output of " + address};
+            });
+    }
+
+    auto getFeeRate() const
+        -> utilxx::Result<std::int64_t, forge::client::ClientError> override
+    {
+        return forge::core::getDefaultFeeRate(forge::core::Coin::tOdin);
+    }
+
+    auto computeBurnFee(std::int64_t /*fee_rate*/,
+                        std::size_t /*metadata_size*/,
+                        std::size_t /*number_of_outputs*/) const
+        -> std::int64_t override
+    {
+        return FAKE_BURN_FEE;
+    }
+
+private:
+    static auto toString(const std::vector<std::byte>& tx)
+        -> std::string
+    {
+        std::string str;
+        for(auto byte : tx) {
+            str.push_back(static_cast<char>(byte));
+        }
+        return str;
+    }
+
+    auto getDraft(const std::vector<std::byte>& tx) const
+        -> const SentTx&
+    {
+        return drafts_.at(std::stoull(toString(tx)));
+    }
+
+private:
+    FakeReadOnlyClient* read_client_;
+    mutable std::uint64_t next_id_{1};
+    mutable std::map<std::uint64_t, SentTx> drafts_;
+    mutable std::vector<SentTx> sent_;
+    mutable std::vector<forge::core::Unspent> available_;
+    mutable std::vector<forge::core::Unspent> locked_;
+    mutable std::vector<std::pair<std::string, bool>> unlocked_;
+    mutable std::vector<std::string> fundings_;
+    std::set<std::string> fail_generating_;
+    std::set<std::string> fail_signing_;
+    std::set<std::string> fail_sending_;
+};
@@ -0,0 +1,161 @@
+#include "fake_clients.hpp"
+#include <core/Coin.hpp>
+#include <core/Transaction.hpp>
+#include <entrys/Entry.hpp>
+#include <entrys/EntryOperation.hpp>
+#include <entrys/token/UtilityToken.hpp>
+#include <entrys/token/UtilityTokenCreationOp.hpp>
+#include <entrys/uentry/UniqueEntry.hpp>
+#include <entrys/uentry/UniqueEntryCreationOp.hpp>
+#include <entrys/umentry/UMEntry.hpp>
+#include <entrys/umentry/UMEntryCreationOp.hpp>
+#include <gtest/gtest.h>
+#include <lookup/LookupManager.hpp>
+#include <lookup/SharedLookupLayout.hpp>
+#include <lookup/SharedLookupPublisher.hpp>
+#include <memory>
+#include <string>
+#include <unistd.h>
+
+using namespace forge::core;
+using namespace forge::lookup;
+
+namespace {
+
+const auto OWNER = std::string{"oLupzckPUYtGydsBisL86zcwsBweJm1dSM"};
+const auto OTHER = std::string{"oMaZKaWWyu6Zqrs5ck3DXgFbMEre7Jo58W"};
+
+} // namespace
+
+TEST(LookupManagerTest, DeleteAndRecreateWithOtherTypeTest)
+{
+    auto client = std::make_unique<FakeReadOnlyClient>();
+    auto* fake = client.get();
+    LookupManager lookup{std::move(client)};
+
+    auto unique_key = stringToASCIIByteVec("unique");
+    auto token_key = stringToASCIIByteVec("token");
+    UMEntryValue value{ByteArray{std::byte{0x01}}};
+
+    fake->addBlock({fake->makeBurnTx(OWNER,
+                                     createUMEntryCreationOpMetadata(UMEntry{unique_key, value}),
+                                     1000),
+                    fake->makeBurnTx(OWNER,
+                                     createUMEntryCreationOpMetadata(UMEntry{token_key, value}),
+                                     1000)});
+    ASSERT_TRUE(lookup.updateLookup());
+    ASSERT_TRUE(lookup.lookupUMValue(unique_key));
+    ASSERT_TRUE(lookup.lookupUMValue(token_key));
+
+    //the um entrys are deleted before the unique entry and
+    //the token with the same keys are checked
+    fake->addBlock({fake->makeBurnTx(OWNER,
+                                     createDeletionOpMetadata(Entry{UMEntry{unique_key, value}}),
+                                     1000),
+                    fake->makeBurnTx(OWNER,
+                                     createDeletionOpMetadata(Entry{UMEntry{token_key, value}}),
+                                     1000),
+                    fake->makeBurnTx(OTHER,
+                                     createUniqueEntryCreationOpMetadata(UniqueEntry{unique_key, value}),
+                                     1000),
+                    fake->makeBurnTx(OTHER,
+                                     createUtilityTokenCreationOpMetadata(UtilityToken{token_key, 50}),
+                                     1000)});
+    ASSERT_TRUE(lookup.updateLookup());
+
+    EXPECT_FALSE(lookup.lookupUMValue(unique_key));
+    EXPECT_FALSE(lookup.lookupUMValue(token_key));
+
+    ASSERT_TRUE(lookup.lookupUniqueValue(unique_key));
+    EXPECT_EQ(lookup.lookupOwner(unique_key).getValue().get(), OTHER);
+    EXPECT_EQ(lookup.getSupplyOfToken(token_key), 50u);
+    EXPECT_EQ(lookup.getUtilityTokenCreditOf(OTHER, token_key), 50u);
+
+    EXPECT_TRUE(lookup.isReserverdEntryKey(unique_key));
+    EXPECT_TRUE(lookup.isReserverdEntryKey(token_key));
+}
+
+TEST(LookupManagerTest, ScanAfterFailedUpdateTest)
+{
+    auto client = std::make_unique<FakeReadOnlyClient>();
+    auto* fake = client.get();
+    LookupManager lookup{std::move(client)};
+
+    auto key = stringToASCIIByteVec("scanned");
+    UMEntryValue value{ByteArray{std::byte{0x01}}};
+
+    fake->addBlock({fake->makeBurnTx(OWNER,
+                                     createUMEntryCreationOpMetadata(UMEntry{key, value}),
+                                     1000)});
+    ASSERT_TRUE(lookup.updateLookup());
+    ASSERT_EQ(lookup.scanEntrys(key, std::nullopt, 10).size(), 1);
+
+    //the deletion is applied before the next block fails
+    fake->addBlock({fake->makeBurnTx(OWNER,
+                                     createDeletionOpMetadata(Entry{UMEntry{key, value}}),
+                                     1000)});
+    fake->addUnfetchableBlock();
+    ASSERT_FALSE(lookup.updateLookup());
+
+    EXPECT_FALSE(lookup.lookupUMValue(key));
+    EXPECT_TRUE(lookup.scanEntrys(key, std::nullopt, 10).empty());
+}
+
+TEST(LookupManagerTest, PublishBeforeFailedBlockTest)
+{
+    auto client = std::make_unique<FakeReadOnlyClient>();
+    auto* fake = client.get();
+    LookupManager lookup{std::move(client)};
+
+    auto name = "/forge-lookup-manager-test-" + std::to_string(::getpid());
+    auto publisher_res = make_shared_lookup_publisher(name);
+    ASSERT_TRUE(publisher_res);
+    lookup.setSharedLookupPublisher(std::move(publisher_res.getValue()));
+
+    auto key = stringToASCIIByteVec("published");
+    fake->addBlock({fake->makeBurnTx(OWNER,
+                                     createUMEntryCreationOpMetadata(UMEntry{key, UMEntryValue{ByteArray{}}}),
+                                     1000)});
+    fake->addUnfetchableBlock();
+    ASSERT_FALSE(lookup.updateLookup());
+
+    //the block before the failed one is published
+    auto reader = SharedLookupReader::open(name);
+    ASSERT_TRUE(reader);
+    EXPECT_EQ(reader->getBlockHeight().getValue(),
+              getStartingBlock(Coin::tOdin) + 1);
+    EXPECT_TRUE(reader->lookupUMEntry(key).getValue());
+}
+
+TEST(LookupManagerTest, CompetingCreationsTest)
+{
+    auto client = std::make_unique<FakeReadOnlyClient>();
+    auto* fake = client.get();
+    LookupManager lookup{std::move(client)};
+
+    auto um_key = stringToASCIIByteVec("umentry");
+    auto token_key = stringToASCIIByteVec("token");
+    UMEntryValue value{ByteArray{std::byte{0x01}}};
+
+    //creations of one key which burn different amounts still tie,
+    //so none of them is applied (consensus rule)
+    fake->addBlock({fake->makeBurnTx(OWNER,
+                                     createUMEntryCreationOpMetadata(UMEntry{um_key, value}),
+                                     1000),
+                    fake->makeBurnTx(OTHER,
+                                     createUniqueEntryCreationOpMetadata(UniqueEntry{um_key, value}),
+                                     2000),
+                    fake->makeBurnTx(OWNER,
+                                     createUtilityTokenCreationOpMetadata(UtilityToken{token_key, 50}),
+                                     1000),
+                    fake->makeBurnTx(OTHER,
+                                     createUtilityTokenCreationOpMetadata(UtilityToken{token_key, 60}),
+                                     5000)});
+    ASSERT_TRUE(lookup.updateLookup());
+
+    EXPECT_FALSE(lookup.lookupUMValue(um_key));
+    EXPECT_FALSE(lookup.lookupUniqueValue(um_key));
+    EXPECT_EQ(lookup.getSupplyOfToken(token_key), 0u);
+    EXPECT_FALSE(lookup.isReserverdEntryKey(um_key));
+    EXPECT_FALSE(lookup.isReserverdEntryKey(token_key));
+}
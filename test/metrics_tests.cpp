@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include <metrics/Metrics.hpp>
+#include <metrics/Trace.hpp>
+#include <string>
+
+using namespace forge::metrics;
+
+TEST(MetricsTest, CounterAndGaugeTest)
+{
+    Registry registry;
+
+    auto& counter = registry.counter("test_total", "test counter", {{"kind", "a"}});
+    counter.increment();
+    counter.increment(2);
+
+    //the same name and labels return the same counter
+    EXPECT_EQ(&counter,
+              &registry.counter("test_total", "test counter", {{"kind", "a"}}));
+    EXPECT_NE(&counter,
+              &registry.counter("test_total", "test counter", {{"kind", "b"}}));
+    EXPECT_EQ(counter.getValue(), 3);
+
+    auto& gauge = registry.gauge("test_size", "test gauge");
+    gauge.set(10);
+    gauge.set(-4);
+    EXPECT_EQ(gauge.getValue(), -4);
+}
+
+TEST(MetricsTest, HistogramTest)
+{
+    Histogram histogram{{1.0, 2.0, 5.0}};
+
+    histogram.observe(0.5);
+    histogram.observe(1.0);
+    histogram.observe(3.0);
+    histogram.observe(100.0);
+
+    std::vector<std::uint64_t> expected{2, 2, 3, 4};
+    EXPECT_EQ(histogram.getBucketCounts(), expected);
+    EXPECT_EQ(histogram.getCount(), 4);
+    EXPECT_DOUBLE_EQ(histogram.getSum(), 104.5);
+}
+
+TEST(MetricsTest, RenderTest)
+{
+    Registry registry;
+
+    registry.counter("test_total", "test counter", {{"command", "get\"block"}})
+        .increment(7);
+    registry.histogram("test_seconds", "test histogram", {}, {0.5})
+        .observe(0.25);
+
+    auto rendered = registry.render();
+
+    EXPECT_NE(rendered.find("# TYPE test_total counter\n"),
+              std::string::npos);
+    EXPECT_NE(rendered.find("test_total{command=\"get\\\"block\"} 7\n"),
+              std::string::npos);
+    EXPECT_NE(rendered.find("# TYPE test_seconds histogram\n"),
+              std::string::npos);
+    EXPECT_NE(rendered.find("test_seconds_bucket{le=\"0.5\"} 1\n"),
+              std::string::npos);
+    EXPECT_NE(rendered.find("test_seconds_bucket{le=\"+Inf\"} 1\n"),
+              std::string::npos);
+    EXPECT_NE(rendered.find("test_seconds_count 1\n"),
+              std::string::npos);
+}
+
+TEST(MetricsTest, TraceBufferTest)
+{
+    TraceBuffer buffer{3};
+
+    //capacity is rounded up to a power of two
+    EXPECT_EQ(buffer.getCapacity(), 4);
+
+    for(std::int64_t i = 0; i < 6; i++) {
+        buffer.record("span", i * 10, 5, i);
+    }
+
+    //only the newest events survive
+    auto events = buffer.snapshot();
+    ASSERT_EQ(events.size(), 4);
+    EXPECT_EQ(events.front().arg, 2);
+    EXPECT_EQ(events.back().arg, 5);
+    EXPECT_EQ(events.back().start_ns, 50);
+}
+
+TEST(MetricsTest, ChromeTraceTest)
+{
+    TraceBuffer buffer;
+
+    {
+        TraceSpan outer{"processBlock", 42, buffer};
+        TraceSpan inner{"parseAndFilter", NO_TRACE_ARG, buffer};
+    }
+
+    auto trace = toChromeTrace(buffer.snapshot());
+    const auto& events = trace["traceEvents"];
+
+    //the inner span ends first
+    ASSERT_EQ(events.size(), 2);
+    EXPECT_EQ(events[0]["name"].asString(), "parseAndFilter");
+    EXPECT_FALSE(events[0].isMember("args"));
+    EXPECT_EQ(events[1]["name"].asString(), "processBlock");
+    EXPECT_EQ(events[1]["ph"].asString(), "X");
+    EXPECT_EQ(events[1]["args"]["block"].asInt64(), 42);
+    EXPECT_LE(events[1]["ts"].asDouble(), events[0]["ts"].asDouble());
+    EXPECT_GE(events[1]["dur"].asDouble(), events[0]["dur"].asDouble());
+}
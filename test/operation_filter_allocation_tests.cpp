@@ -0,0 +1,85 @@
+#include <atomic>
+#include <cstdlib>
+#include <entrys/umentry/UMEntry.hpp>
+#include <entrys/umentry/UMEntryOperation.hpp>
+#include <gtest/gtest.h>
+#include <lookup/UMEntryLookup.hpp>
+#include <new>
+#include <string>
+#include <vector>
+
+//this file replaces the global operator new and delete,
+//so it is built into its own test binary
+
+using namespace forge::core;
+using namespace forge::lookup;
+
+namespace {
+
+std::atomic<std::size_t> allocations{0};
+
+auto makeCreation(std::byte key,
+                  std::int64_t burn)
+    -> UMEntryOperation
+{
+    return UMEntryCreationOp{UMEntry{EntryKey(8, key),
+                                     UMEntryValue{NoneValue{}}},
+                             std::string(40, 'o'),
+                             10,
+                             burn};
+}
+
+} // namespace
+
+//counts every allocation of the test binary, the tests
+//only compare the counter before and after a call
+auto operator new(std::size_t size)
+    -> void*
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if(auto* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc{};
+}
+
+auto operator delete(void* ptr) noexcept
+    -> void
+{
+    std::free(ptr);
+}
+
+auto operator delete(void* ptr, std::size_t) noexcept
+    -> void
+{
+    std::free(ptr);
+}
+
+TEST(OperationFilterAllocationTest, FilterDoesNotCopyOperationsTest)
+{
+    constexpr std::size_t number_of_ops = 1000;
+
+    std::vector<UMEntryOperation> ops;
+    ops.reserve(number_of_ops);
+    for(std::size_t i = 0; i < number_of_ops; i++) {
+        //ten keys, the last creation of every key has the highest burn
+        ops.push_back(makeCreation(static_cast<std::byte>(i % 10),
+                                   static_cast<std::int64_t>(i)));
+    }
+
+    UMEntryLookup lookup{nullptr, 0};
+
+    //the first call sets up the trace buffer
+    lookup.filterNonRelevantOperations({});
+
+    auto before = allocations.load();
+    auto relevant = lookup.filterNonRelevantOperations(std::move(ops));
+    auto needed = allocations.load() - before;
+
+    ASSERT_EQ(relevant.size(), 10);
+    EXPECT_EQ(getValue(relevant[0]), 990);
+
+    //one map node per key and the two result vectors,
+    //copying would cost at least one allocation per op
+    EXPECT_LE(needed, 10 + 2);
+}
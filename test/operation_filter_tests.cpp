@@ -0,0 +1,76 @@
+#include <core/ByteSpan.hpp>
+#include <cstdint>
+#include <entrys/EntryCreationOp.hpp>
+#include <entrys/umentry/UMEntry.hpp>
+#include <gtest/gtest.h>
+#include <lookup/OperationFilter.hpp>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace forge::core;
+using namespace forge::lookup;
+
+TEST(OperationFilterTest, SelectHighestBurnTest)
+{
+    std::vector<std::pair<std::string, int>> ops{{"b", 5},
+                                                 {"a", 5},
+                                                 {"b", 7},
+                                                 {"a", 5},
+                                                 {"c", 1}};
+
+    auto selected =
+        selectHighestBurnPerKey(ops,
+                                [](const auto& op) {
+                                    return ByteSpan{reinterpret_cast<const std::byte*>(op.first.data()),
+                                                    op.first.size()};
+                                },
+                                [](const auto& op) {
+                                    return op.second;
+                                });
+
+    //"a" is ambiguous, the others are ordered by key
+    std::vector<std::size_t> expected{2, 4};
+    EXPECT_EQ(std::vector<std::size_t>(selected.begin(), selected.end()),
+              expected);
+}
+
+TEST(OperationFilterTest, CreationTieRuleTest)
+{
+    auto creation = [](std::byte key, std::int64_t burn)
+        -> EntryCreationOp {
+        return UMEntryCreationOp{UMEntry{EntryKey(8, key),
+                                         UMEntryValue{NoneValue{}}},
+                                 std::string(40, 'o'),
+                                 10,
+                                 burn};
+    };
+
+    std::vector<EntryCreationOp> creations{creation(std::byte{1}, 1000),
+                                           creation(std::byte{1}, 2000),
+                                           creation(std::byte{2}, 0),
+                                           creation(std::byte{2}, 1000)};
+
+    auto select = [&](auto&& burn_of) {
+        auto selected =
+            selectHighestBurnPerKey(creations,
+                                    [](const auto& creation)
+                                        -> const EntryKey& {
+                                        return getEntryKey(creation);
+                                    },
+                                    burn_of);
+        return std::vector<std::size_t>(selected.begin(), selected.end());
+    };
+
+    //before the activation height creations which burn anything tie
+    auto tie_selected = select([](const auto& creation) {
+        return getBurnValue(creation);
+    });
+    EXPECT_EQ(tie_selected, std::vector<std::size_t>{3});
+
+    //from the activation height on the highest burn wins
+    auto amount_selected = select([](const auto& creation) {
+        return getBurnAmount(creation);
+    });
+    EXPECT_EQ(amount_selected, (std::vector<std::size_t>{1, 3}));
+}
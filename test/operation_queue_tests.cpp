@@ -0,0 +1,170 @@
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <gtest/gtest.h>
+#include <json/value.h>
+#include <rpc/OperationError.hpp>
+#include <rpc/OperationQueue.hpp>
+#include <thread>
+#include <utilxx/Result.hpp>
+
+using namespace forge::rpc;
+using namespace std::chrono_literals;
+
+namespace {
+
+auto waitUntilFinished(const OperationQueue& queue,
+                       std::uint64_t id)
+    -> OperationState
+{
+    for(int i = 0; i < 1000; i++) {
+        auto state = queue.getOperation(id).getValue();
+        if(state.status == OperationStatus::Done
+           || state.status == OperationStatus::Failed) {
+            return state;
+        }
+        std::this_thread::sleep_for(1ms);
+    }
+
+    return queue.getOperation(id).getValue();
+}
+
+} // namespace
+
+TEST(OperationQueueTest, DoneAndFailedTest)
+{
+    OperationQueue queue{1};
+
+    auto done = queue.submit("createnewumentry",
+                             []() -> utilxx::Result<Json::Value, OperationError> {
+                                 return Json::Value{"sometxid"};
+                             })
+                    .getValue();
+    auto failed = queue.submit("renewentry",
+                               []() -> utilxx::Result<Json::Value, OperationError> {
+                                   return OperationError{"unable to renew"};
+                               })
+                      .getValue();
+
+    EXPECT_NE(done, failed);
+
+    auto done_state = waitUntilFinished(queue, done);
+    EXPECT_EQ(done_state.status, OperationStatus::Done);
+    EXPECT_EQ(done_state.method, "createnewumentry");
+
+    auto done_json = operationStateToJson(done_state);
+    EXPECT_EQ(done_json["status"].asString(), "done");
+    EXPECT_EQ(done_json["result"].asString(), "sometxid");
+
+    auto failed_json = operationStateToJson(waitUntilFinished(queue, failed));
+    EXPECT_EQ(failed_json["status"].asString(), "failed");
+    EXPECT_EQ(failed_json["error"].asString(), "unable to renew");
+    EXPECT_FALSE(failed_json.isMember("result"));
+
+    EXPECT_EQ(queue.getNumberOfOpenOperations(), 0u);
+    EXPECT_FALSE(queue.getOperation(failed + 1));
+}
+
+TEST(OperationQueueTest, QueuedWhileRunningTest)
+{
+    OperationQueue queue{1};
+    std::promise<void> release;
+    auto released = release.get_future().share();
+
+    auto first = queue.submit("submitbulk",
+                              [released]() -> utilxx::Result<Json::Value, OperationError> {
+                                  released.wait();
+                                  return Json::Value{Json::arrayValue};
+                              })
+                     .getValue();
+    auto second = queue.submit("submitbulk",
+                               []() -> utilxx::Result<Json::Value, OperationError> {
+                                   return Json::Value{Json::arrayValue};
+                               })
+                      .getValue();
+
+    //a single worker runs the operations one after another
+    EXPECT_EQ(queue.getOperation(second).getValue().status, OperationStatus::Queued);
+    EXPECT_EQ(queue.getNumberOfOpenOperations(), 2u);
+
+    release.set_value();
+
+    EXPECT_EQ(waitUntilFinished(queue, first).status, OperationStatus::Done);
+    EXPECT_EQ(waitUntilFinished(queue, second).status, OperationStatus::Done);
+}
+
+TEST(OperationQueueTest, HistorySizeTest)
+{
+    OperationQueue queue{1, 2};
+
+    std::uint64_t last{0};
+    for(int i = 0; i < 3; i++) {
+        last = queue.submit("renewentry",
+                            []() -> utilxx::Result<Json::Value, OperationError> {
+                                return Json::Value{"sometxid"};
+                            })
+                   .getValue();
+        waitUntilFinished(queue, last);
+    }
+
+    //the oldest finished operation is forgotten
+    EXPECT_FALSE(queue.getOperation(last - 2));
+    EXPECT_TRUE(queue.getOperation(last - 1));
+    EXPECT_TRUE(queue.getOperation(last));
+}
+
+TEST(OperationQueueTest, MaxQueuedTest)
+{
+    OperationQueue queue{1, OPERATION_HISTORY_SIZE, 1};
+    std::promise<void> release;
+    auto released = release.get_future().share();
+
+    auto blocking = [released]() -> utilxx::Result<Json::Value, OperationError> {
+        released.wait();
+        return Json::Value{"sometxid"};
+    };
+
+    auto running = queue.submit("renewentry", blocking).getValue();
+    for(int i = 0; i < 1000; i++) {
+        if(queue.getOperation(running).getValue().status == OperationStatus::Running) {
+            break;
+        }
+        std::this_thread::sleep_for(1ms);
+    }
+
+    auto queued = queue.submit("renewentry", blocking);
+    EXPECT_TRUE(queued);
+
+    //the running operation does not count, the queued one does
+    EXPECT_FALSE(queue.submit("renewentry", blocking));
+
+    release.set_value();
+
+    EXPECT_EQ(waitUntilFinished(queue, queued.getValue()).status, OperationStatus::Done);
+    EXPECT_TRUE(queue.submit("renewentry", blocking));
+}
+
+TEST(OperationQueueTest, WaitForOperationTest)
+{
+    OperationQueue queue{1};
+    std::promise<void> release;
+    auto released = release.get_future().share();
+
+    auto id = queue.submit("submitbulk",
+                           [released]() -> utilxx::Result<Json::Value, OperationError> {
+                               released.wait();
+                               return Json::Value{Json::arrayValue};
+                           })
+                  .getValue();
+
+    //the wait is bounded while the operation is still running
+    auto state = queue.waitForOperation(id, 10ms).getValue();
+    EXPECT_NE(state.status, OperationStatus::Done);
+
+    release.set_value();
+
+    state = queue.waitForOperation(id, 10s).getValue();
+    EXPECT_EQ(state.status, OperationStatus::Done);
+
+    EXPECT_FALSE(queue.waitForOperation(id + 1, 10ms));
+}
@@ -0,0 +1,134 @@
+#include <core/Transaction.hpp>
+#include <entrys/token/UtilityTokenOperation.hpp>
+#include <entrys/umentry/UMEntryOperation.hpp>
+#include <gtest/gtest.h>
+#include <lookup/PendingOperations.hpp>
+#include <map>
+#include <string>
+
+using namespace forge::core;
+using namespace forge::lookup;
+
+namespace {
+
+auto createUMOp(std::string&& data,
+                std::string&& owner,
+                std::int64_t block)
+    -> UMEntryOperation
+{
+    auto metadata =
+        extractMetadata(std::move(data))
+            .getValue();
+
+    return parseMetadataToUMEntryOp(std::move(metadata),
+                                    block,
+                                    std::move(owner),
+                                    10)
+        .getValue();
+}
+
+auto createTokenOp(const std::string& op,
+                   std::int64_t block,
+                   std::string owner,
+                   utilxx::Opt<std::string> new_owner = std::nullopt)
+    -> UtilityTokenOperation
+{
+    auto metadata = stringToByteVec(op).getValue();
+
+    return parseMetadataToUtilityTokenOp(metadata,
+                                         block,
+                                         std::move(owner),
+                                         10,
+                                         std::move(new_owner))
+        .getValue();
+}
+
+} // namespace
+
+TEST(PendingOperationsTest, ReplaceAndQueryTest)
+{
+    PendingOperations pending;
+    auto key = stringToByteVec("deadbeef").getValue();
+
+    std::map<std::string, PendingTransaction> transactions;
+    transactions.emplace("aa",
+                         PendingTransaction{std::nullopt,
+                                            {createUMOp("6a00c6dc75010101aabbccdddeadbeef",
+                                                        "oLupzckPUYtGydsBisL86zcwsBweJm1dSM",
+                                                        11)}});
+    transactions.emplace("bb",
+                         PendingTransaction{utilxx::Opt<std::int64_t>{10},
+                                            {}});
+
+    pending.replace(std::move(transactions));
+
+    EXPECT_EQ(pending.size(), 1u);
+    EXPECT_TRUE(pending.hasOperationsOn(key));
+    EXPECT_FALSE(pending.hasOperationsOn(stringToByteVec("aabb").getValue()));
+
+    auto operations = pending.getOperationsOn(key);
+    ASSERT_EQ(operations.size(), 1);
+    EXPECT_EQ(operations[0].txid, "aa");
+    EXPECT_FALSE(operations[0].block_height);
+
+    auto json = pendingOperationToJson(operations[0]);
+    EXPECT_EQ(json["txid"].asString(), "aa");
+    EXPECT_TRUE(json["height"].isNull());
+    EXPECT_EQ(json["operation"].asString(), "creation");
+    EXPECT_FALSE(json.isMember("event"));
+
+    //known transactions are only reused at the same height
+    EXPECT_TRUE(pending.getTransaction("aa", std::nullopt));
+    EXPECT_FALSE(pending.getTransaction("aa", utilxx::Opt<std::int64_t>{11}));
+    EXPECT_TRUE(pending.getTransaction("bb", utilxx::Opt<std::int64_t>{10}));
+    EXPECT_FALSE(pending.getTransaction("cc", std::nullopt));
+
+    pending.replace({});
+    EXPECT_EQ(pending.size(), 0u);
+    EXPECT_FALSE(pending.hasOperationsOn(key));
+}
+
+TEST(PendingOperationsTest, UtilityTokenDebitTest)
+{
+    PendingOperations pending;
+    auto token = stringToByteVec("deadbeef").getValue();
+    auto owner = "oLupzckPUYtGydsBisL86zcwsBweJm1dSM";
+
+    std::map<std::string, PendingTransaction> transactions;
+    //creations do not take tokens from anyone
+    transactions.emplace("aa",
+                         PendingTransaction{std::nullopt,
+                                            {createTokenOp("c6dc75"
+                                                           "03"
+                                                           "01"
+                                                           "0000000000000064"
+                                                           "deadbeef",
+                                                           11,
+                                                           owner)}});
+    transactions.emplace("bb",
+                         PendingTransaction{std::nullopt,
+                                            {createTokenOp("c6dc75"
+                                                           "03"
+                                                           "02"
+                                                           "0000000000000003"
+                                                           "deadbeef",
+                                                           11,
+                                                           owner,
+                                                           std::string{"oMaZKaWWyu6Zqrs5ck3DXgFbMEre7Jo58W"})}});
+    transactions.emplace("cc",
+                         PendingTransaction{utilxx::Opt<std::int64_t>{10},
+                                            {createTokenOp("c6dc75"
+                                                           "03"
+                                                           "04"
+                                                           "0000000000000002"
+                                                           "deadbeef",
+                                                           10,
+                                                           owner)}});
+
+    pending.replace(std::move(transactions));
+
+    EXPECT_EQ(pending.size(), 3u);
+    EXPECT_EQ(pending.getOperationsOn(token).size(), 3);
+    EXPECT_EQ(pending.getUtilityTokenDebitOf(owner, token), 5u);
+    EXPECT_EQ(pending.getUtilityTokenDebitOf("oMaZKaWWyu6Zqrs5ck3DXgFbMEre7Jo58W", token), 0u);
+}
@@ -0,0 +1,164 @@
+#include <client/odin/RawTxBuilder.hpp>
+#include <core/Base58.hpp>
+#include <core/Coin.hpp>
+#include <core/Sha256.hpp>
+#include <core/Transaction.hpp>
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+using forge::client::odin::buildRawTx;
+using forge::client::odin::computeTxFee;
+using forge::client::odin::computeTxid;
+using forge::client::odin::estimateSignedTxSize;
+using forge::core::Coin;
+using forge::core::decodeBase58Check;
+using forge::core::sha256;
+using forge::core::stringToASCIIByteVec;
+using forge::core::stringToByteVec;
+using forge::core::toHexString;
+
+namespace {
+
+auto digestToHex(const forge::core::Sha256Digest& digest)
+    -> std::string
+{
+    return toHexString(std::vector<std::byte>(std::begin(digest),
+                                              std::end(digest)));
+}
+
+} // namespace
+
+TEST(RawTxBuilderTest, Sha256Test)
+{
+    EXPECT_EQ(digestToHex(sha256(std::vector<std::byte>{})),
+              "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+
+    EXPECT_EQ(digestToHex(sha256(stringToASCIIByteVec("abc"))),
+              "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+
+    //needs a second block for the padding
+    auto input = stringToASCIIByteVec("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq");
+    EXPECT_EQ(digestToHex(sha256(input)),
+              "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+}
+
+TEST(RawTxBuilderTest, DecodeBase58CheckTest)
+{
+    auto decoded = decodeBase58Check("oLupzckPUYtGydsBisL86zcwsBweJm1dSM");
+    ASSERT_TRUE(decoded);
+    EXPECT_EQ(toHexString(decoded.getValue()),
+              "732c57ac83a9130495d9262921e89c738e59aa17f8");
+
+    //last character changed, so the checksum does not match
+    EXPECT_FALSE(decodeBase58Check("oLupzckPUYtGydsBisL86zcwsBweJm1dSN"));
+    //0 is not part of the alphabet
+    EXPECT_FALSE(decodeBase58Check("oLupzckPUYtGydsBisL86zcwsBweJm1dS0"));
+}
+
+TEST(RawTxBuilderTest, ComputeTxidTest)
+{
+    auto tx = stringToByteVec("01000000010000000000000000000000000000000000000000000000000000000000000000ffffffff03510101ffffffff010098ea1d052d0000232103aa0e03877477dc25bac11a383874fda2ae40a941bd6d8777de4f8bde711bd494ac00000000")
+                  .getValue();
+
+    EXPECT_EQ(computeTxid(tx),
+              "3f3e472ee4671f5bcf424cf8b8b0552d51e72172e235f8d6eb7f4aca23c6d0b4");
+}
+
+TEST(RawTxBuilderTest, BuildBurnTxTest)
+{
+    auto res = buildRawTx(Coin::Odin,
+                          "79572893884b4c718babb7d75104294b578f0eff8e2b4f34b1a2397687c4fd76",
+                          1,
+                          stringToASCIIByteVec("Goodbye World"),
+                          499000000,
+                          {});
+
+    ASSERT_TRUE(res);
+    EXPECT_EQ(toHexString(res.getValue()),
+              "010000000176fdc4877639a2b1344f2b8eff0e8f574b290451d7b7ab8b714c4b8893285779"
+              "0100000000ffffffff01c022be1d000000000f6a0d476f6f6462796520576f726c6400000000");
+}
+
+TEST(RawTxBuilderTest, BuildTxWithOutputsTest)
+{
+    std::vector<std::byte> metadata(100, std::byte{0xab});
+
+    auto res = buildRawTx(Coin::Odin,
+                          "79572893884b4c718babb7d75104294b578f0eff8e2b4f34b1a2397687c4fd76",
+                          0,
+                          metadata,
+                          10000,
+                          {{"oLupzckPUYtGydsBisL86zcwsBweJm1dSM", 100000000}});
+
+    ASSERT_TRUE(res);
+
+    auto hex = toHexString(res.getValue());
+    //two outputs, the pubkey hash output comes first
+    EXPECT_NE(hex.find("ffffffff0200e1f50500000000"
+                       "1976a9142c57ac83a9130495d9262921e89c738e59aa17f888ac"
+                       "1027000000000000"
+                       "676a4c64abab"),
+              std::string::npos);
+    EXPECT_EQ(res.getValue().size(), 4 + 1 + 36 + 1 + 4 + 1 + 34 + 8 + 1 + 103 + 4);
+}
+
+TEST(RawTxBuilderTest, EstimateSignedTxSizeTest)
+{
+    //the burn of BuildBurnTxTest after it was signed,
+    //its signature is one byte shorter than the largest one
+    auto signed_tx =
+        stringToByteVec("010000000176fdc4877639a2b1344f2b8eff0e8f574b290451d7b7ab8b714c4b8893285779010000006a47304402200f848a103d06cb4f8a7bd571314fff2c1e52a5d130ac2b7f3ee5faf5325bc6e202200b23a0a7d5a1a6348d1edd49cdbb162545641f370a008c7e0a66403079d1d306012102f285704370a212d308afd673f589e1d7de75c1f070cdef4579fbb62d23043a6affffffff01c022be1d000000000f6a0d476f6f6462796520576f726c6400000000")
+            .getValue();
+    EXPECT_EQ(estimateSignedTxSize(13, 0), signed_tx.size() + 1);
+
+    //the script sig replaces the empty one of the unsigned transaction
+    std::vector<std::byte> metadata(100, std::byte{0xab});
+    auto unsigned_tx = buildRawTx(Coin::Odin,
+                                  "79572893884b4c718babb7d75104294b578f0eff8e2b4f34b1a2397687c4fd76",
+                                  0,
+                                  metadata,
+                                  10000,
+                                  {{"oLupzckPUYtGydsBisL86zcwsBweJm1dSM", 100000000},
+                                   {"oLupzckPUYtGydsBisL86zcwsBweJm1dSM", 50000000}});
+    ASSERT_TRUE(unsigned_tx);
+    EXPECT_EQ(estimateSignedTxSize(metadata.size(), 2),
+              unsigned_tx.getValue().size() + 107);
+}
+
+TEST(RawTxBuilderTest, ComputeTxFeeTest)
+{
+    EXPECT_EQ(computeTxFee(250, 10000), 2500);
+    //rounded up
+    EXPECT_EQ(computeTxFee(251, 10000), 2510);
+    EXPECT_EQ(computeTxFee(1, 10), 1);
+    EXPECT_EQ(computeTxFee(1000, 0), 0);
+}
+
+TEST(RawTxBuilderTest, BuildTxErrorTest)
+{
+    auto txid = "79572893884b4c718babb7d75104294b578f0eff8e2b4f34b1a2397687c4fd76";
+
+    //mainnet address on the testnet
+    EXPECT_FALSE(buildRawTx(Coin::tOdin,
+                            txid,
+                            0,
+                            {},
+                            0,
+                            {{"oLupzckPUYtGydsBisL86zcwsBweJm1dSM", 100000}}));
+
+    EXPECT_FALSE(buildRawTx(Coin::Odin,
+                            "79572893884b4c718babb7d75104294b",
+                            0,
+                            {},
+                            0,
+                            {}));
+
+    EXPECT_FALSE(buildRawTx(Coin::Odin,
+                            txid,
+                            0,
+                            {},
+                            -1,
+                            {}));
+}
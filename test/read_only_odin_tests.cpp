@@ -200,3 +200,32 @@ TEST(ReadOnlyOdinClientTest, processGetAddressessInvalid)
     ASSERT_TRUE(res_3.hasValue());
     EXPECT_TRUE(res_3.getValue().empty());
 }
+
+TEST(ReadOnlyOdinClientTest, processGetRawMempoolValid)
+{
+    auto json_str1 = readFile("raw_mempool_valid1.json");
+    auto json1 = parseString(json_str1);
+
+    auto res_1 = forge::client::odin::processGetRawMempoolResponse(std::move(json1));
+    ASSERT_TRUE(res_1.hasValue());
+
+    std::vector<std::string> expected{
+        "3f3e472ee4671f5bcf424cf8b8b0552d51e72172e235f8d6eb7f4aca23c6d0b4",
+        "79572893884b4c718babb7d75104294b578f0eff8e2b4f34b1a2397687c4fd76"};
+    EXPECT_EQ(res_1.getValue(), expected);
+}
+
+TEST(ReadOnlyOdinClientTest, processGetRawMempoolInvalid)
+{
+    auto json_str1 = readFile("raw_mempool_invalid1.json");
+    auto json1 = parseString(json_str1);
+
+    auto res_1 = forge::client::odin::processGetRawMempoolResponse(std::move(json1));
+    ASSERT_TRUE(res_1.hasError());
+
+    auto json_str2 = readFile("raw_mempool_invalid2.json");
+    auto json2 = parseString(json_str2);
+
+    auto res_2 = forge::client::odin::processGetRawMempoolResponse(std::move(json2));
+    ASSERT_TRUE(res_2.hasError());
+}
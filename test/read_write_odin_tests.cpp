@@ -5,44 +5,6 @@
 #include <gtest/gtest.h>
 #include <json/value.h>
 
-TEST(ReadWriteOdinClientTest, processGenerateRawTxResponseValid)
-{
-    using namespace std::string_literals;
-    using forge::core::stringToByteVec;
-
-    auto response1 = "6a14e96a93444c92a7db9accfc4e4675af6ea4c2a74676a025109df614640635"s;
-    auto res_1 = forge::client::odin::processGenerateRawTxResponse(response1);
-    ASSERT_TRUE(res_1.hasValue());
-
-    auto expected1 =
-        stringToByteVec("6a14e96a93444c92a7db9accfc4e4675af6ea4c2a74676a025109df614640635")
-            .getValue();
-    EXPECT_EQ(res_1.getValue(), expected1);
-
-
-    auto response2 = "e1f0d6373e51c572df26f19e161bc0463978604c1148fb4d66fe7800e8c66f31"s;
-    auto res_2 = forge::client::odin::processGenerateRawTxResponse(response2);
-    ASSERT_TRUE(res_2.hasValue());
-
-    auto expected2 =
-        stringToByteVec("e1f0d6373e51c572df26f19e161bc0463978604c1148fb4d66fe7800e8c66f31")
-            .getValue();
-    EXPECT_EQ(res_2.getValue(), expected2);
-}
-
-TEST(ReadWriteOdinClientTest, processGenerateRawTxResponseInvalid)
-{
-    using namespace std::string_literals;
-    using forge::core::stringToByteVec;
-
-    auto response1 = "6X14e96a93444c92a7db9accfc4e4675af6ea4c2a74676a025109df614640635"s;
-    auto res_1 = forge::client::odin::processGenerateRawTxResponse(response1);
-    ASSERT_TRUE(res_1.hasError());
-
-    auto res_2 = forge::client::odin::processGenerateRawTxResponse(10);
-    ASSERT_TRUE(res_2.hasError());
-}
-
 TEST(ReadWriteOdinClientTest, processSignRawTxResponseValid)
 {
     using forge::core::stringToByteVec;
@@ -95,64 +57,103 @@ TEST(ReadWriteOdinClientTest, processSignRawTxResponseInvalid)
     ASSERT_TRUE(res4.hasError());
 }
 
-TEST(ReadWriteOdinClientTest, processGenerateNewAddressResponseValid)
+TEST(ReadWriteOdinClientTest, processSendRawTxResponseValid)
 {
-    auto file1 = readFile("generate_new_address_valid1.json");
+    auto file1 = readFile("send_raw_tx_valid1.json");
     auto json1 = parseString(file1);
 
-    auto res1 = forge::client::odin::processGenerateNewAddressResponse(std::move(json1));
+    auto res1 = forge::client::odin::processSendRawTxResponse(std::move(json1));
 
     ASSERT_TRUE(res1.hasValue());
-    EXPECT_EQ(res1.getValue(), "oRDxB5XznfHGDMPcRyjD2cnq6hahtpWkTT");
+    EXPECT_EQ(res1.getValue(), "fca4a1cb7e28e2fd5dde8d3dbd44a1b5ac20b53a3e1f6e02d5cae7d7c13c7a8b");
 }
 
-TEST(ReadWriteOdinClientTest, processGenerateNewAddressResponseInvalid)
+TEST(ReadWriteOdinClientTest, processSendRawTxResponseInvalid)
 {
-    auto file1 = readFile("generate_new_address_invalid1.json");
+    auto file1 = readFile("send_raw_tx_invalid1.json");
     auto json1 = parseString(file1);
 
-    auto res1 = forge::client::odin::processGenerateNewAddressResponse(std::move(json1));
+    auto res1 = forge::client::odin::processSendRawTxResponse(std::move(json1));
 
     ASSERT_TRUE(res1.hasError());
 
 
-    auto file2 = readFile("generate_new_address_invalid2.json");
+    auto file2 = readFile("send_raw_tx_invalid2.json");
     auto json2 = parseString(file2);
 
-    auto res2 = forge::client::odin::processGenerateNewAddressResponse(std::move(json2));
+    auto res2 = forge::client::odin::processSendRawTxResponse(std::move(json2));
 
     ASSERT_TRUE(res2.hasError());
 }
 
-TEST(ReadWriteOdinClientTest, processDecodeTxidOfRawTxResponseValid)
+TEST(ReadWriteOdinClientTest, processEstimateFeeResponseValid)
 {
-    auto file1 = readFile("decode_txid_valid1.json");
+    auto file1 = readFile("estimate_fee_valid1.json");
     auto json1 = parseString(file1);
 
-    auto res1 = forge::client::odin::processDecodeTxidOfRawTxResponse(std::move(json1));
+    auto res1 = forge::client::odin::processEstimateFeeResponse(std::move(json1));
 
     ASSERT_TRUE(res1.hasValue());
-    EXPECT_EQ(res1.getValue(), "6a14e96a93444c92a7db9accfc4e4675af6ea4c2a74676a025109df614640635");
+    ASSERT_TRUE(res1.getValue());
+    EXPECT_EQ(res1.getValue().getValue(), 21312);
+
+
+    //the daemon has no estimate yet
+    auto file2 = readFile("estimate_fee_valid2.json");
+    auto json2 = parseString(file2);
+
+    auto res2 = forge::client::odin::processEstimateFeeResponse(std::move(json2));
+
+    ASSERT_TRUE(res2.hasValue());
+    EXPECT_FALSE(res2.getValue());
 }
 
-TEST(ReadWriteOdinClientTest, processDecodeTxidOfRawTxResponseInvalid)
+TEST(ReadWriteOdinClientTest, processEstimateFeeResponseInvalid)
 {
-    auto file1 = readFile("decode_txid_invalid1.json");
+    auto file1 = readFile("estimate_fee_invalid1.json");
     auto json1 = parseString(file1);
 
-    auto res1 = forge::client::odin::processDecodeTxidOfRawTxResponse(std::move(json1));
+    auto res1 = forge::client::odin::processEstimateFeeResponse(std::move(json1));
 
     ASSERT_TRUE(res1.hasError());
 
 
-    auto file2 = readFile("decode_txid_invalid2.json");
+    auto file2 = readFile("estimate_fee_invalid2.json");
     auto json2 = parseString(file2);
 
-    auto res2 = forge::client::odin::processGenerateNewAddressResponse(std::move(json2));
+    auto res2 = forge::client::odin::processEstimateFeeResponse(std::move(json2));
 
     ASSERT_TRUE(res2.hasError());
 }
 
+TEST(ReadWriteOdinClientTest, processGenerateNewAddressResponseValid)
+{
+    auto file1 = readFile("generate_new_address_valid1.json");
+    auto json1 = parseString(file1);
+
+    auto res1 = forge::client::odin::processGenerateNewAddressResponse(std::move(json1));
+
+    ASSERT_TRUE(res1.hasValue());
+    EXPECT_EQ(res1.getValue(), "oRDxB5XznfHGDMPcRyjD2cnq6hahtpWkTT");
+}
+
+TEST(ReadWriteOdinClientTest, processGenerateNewAddressResponseInvalid)
+{
+    auto file1 = readFile("generate_new_address_invalid1.json");
+    auto json1 = parseString(file1);
+
+    auto res1 = forge::client::odin::processGenerateNewAddressResponse(std::move(json1));
+
+    ASSERT_TRUE(res1.hasError());
+
+
+    auto file2 = readFile("generate_new_address_invalid2.json");
+    auto json2 = parseString(file2);
+
+    auto res2 = forge::client::odin::processGenerateNewAddressResponse(std::move(json2));
+
+    ASSERT_TRUE(res2.hasError());
+}
 
 TEST(ReadWriteOdinClientTest, processSendToAddressResponseValid)
 {
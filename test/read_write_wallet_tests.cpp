@@ -0,0 +1,254 @@
+#include "fake_clients.hpp"
+#include <core/Coin.hpp>
+#include <core/Transaction.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <entrys/Entry.hpp>
+#include <entrys/token/UtilityToken.hpp>
+#include <entrys/token/UtilityTokenCreationOp.hpp>
+#include <entrys/token/UtilityTokenOwnershipTransferOp.hpp>
+#include <entrys/umentry/UMEntry.hpp>
+#include <entrys/umentry/UMEntryCreationOp.hpp>
+#include <gtest/gtest.h>
+#include <lookup/LookupManager.hpp>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include <wallet/AddressBook.hpp>
+#include <wallet/ReadWriteWallet.hpp>
+
+using namespace forge::core;
+using namespace forge::lookup;
+using namespace forge::wallet;
+
+namespace {
+
+const auto OWNER = std::string{"oLupzckPUYtGydsBisL86zcwsBweJm1dSM"};
+const auto OTHER = std::string{"oMaZKaWWyu6Zqrs5ck3DXgFbMEre7Jo58W"};
+const auto SECOND_OWNER = std::string{"oQ8P6HBnBy5Yp5tqfFM4nZ1YxbYtGnwPjd"};
+
+const auto VALUE = UMEntryValue{ByteArray{std::byte{0x01}}};
+
+constexpr std::int64_t BURN_AMOUNT = 50000;
+
+class ReadWriteWalletTest : public ::testing::Test
+{
+protected:
+    ReadWriteWalletTest()
+    {
+        auto read_client = std::make_unique<FakeReadOnlyClient>();
+        auto write_client = std::make_unique<FakeWriteOnlyClient>(read_client.get());
+        read_ = read_client.get();
+        write_ = write_client.get();
+
+        AddressBook book;
+        book.addOwned(OWNER);
+        book.addOwned(SECOND_OWNER);
+
+        wallet_ = std::make_unique<ReadWriteWallet>(
+            std::make_unique<LookupManager>(std::move(read_client)),
+            std::move(write_client),
+            std::move(book));
+    }
+
+    //OWNER and SECOND_OWNER own 50 tokens each
+    auto createToken(const EntryKey& id)
+        -> void
+    {
+        read_->addBlock({read_->makeBurnTx(OWNER,
+                                           createUtilityTokenCreationOpMetadata(UtilityToken{id, 100}),
+                                           1000)});
+        read_->addBlock({read_->makeBurnTx(OWNER,
+                                           createUtilityTokenOwnershipTransferOpMetadata(UtilityToken{id, 50}),
+                                           1000,
+                                           SECOND_OWNER)});
+        ASSERT_TRUE(wallet_->getLookup().updateLookup());
+    }
+
+    FakeReadOnlyClient* read_;
+    FakeWriteOnlyClient* write_;
+    std::unique_ptr<ReadWriteWallet> wallet_;
+};
+
+} // namespace
+
+TEST_F(ReadWriteWalletTest, BurnTest)
+{
+    auto unspent = write_->addUnspent(OWNER, 100000);
+    auto key = stringToASCIIByteVec("umentry");
+
+    auto res = wallet_->createNewUMEntry(key, VALUE, OWNER, BURN_AMOUNT);
+
+    ASSERT_TRUE(res);
+    ASSERT_EQ(write_->getSent().size(), 1u);
+
+    //the locked output is burned and the owner gets the change
+    const auto& tx = write_->getSent().front();
+    EXPECT_EQ(tx.input_txid, unspent.getTxid());
+    EXPECT_EQ(tx.burn_value, BURN_AMOUNT);
+    EXPECT_EQ(tx.metadata,
+              createUMEntryCreationOpMetadata(UMEntry{key, VALUE}));
+
+    std::vector<std::pair<std::string, std::int64_t>> expected_outputs{
+        {OWNER, 100000 - BURN_AMOUNT - FAKE_BURN_FEE}};
+    EXPECT_EQ(tx.outputs, expected_outputs);
+
+    std::vector<std::pair<std::string, bool>> expected_unlocked{
+        {unspent.getTxid(), true}};
+    EXPECT_EQ(write_->getUnlocked(), expected_unlocked);
+    EXPECT_EQ(write_->getNumberOfLocked(), 0u);
+    EXPECT_TRUE(write_->getFundings().empty());
+}
+
+TEST_F(ReadWriteWalletTest, BurnWithFundingTest)
+{
+    //the output is too small to leave a change output
+    write_->addUnspent(OWNER, BURN_AMOUNT + FAKE_BURN_FEE + 1);
+
+    auto res = wallet_->createNewUMEntry(stringToASCIIByteVec("umentry"),
+                                         VALUE,
+                                         OWNER,
+                                         BURN_AMOUNT);
+
+    ASSERT_TRUE(res);
+    ASSERT_EQ(write_->getFundings().size(), 1u);
+    ASSERT_EQ(write_->getSent().size(), 1u);
+
+    //the funding output covers the burn exactly
+    const auto& tx = write_->getSent().front();
+    EXPECT_EQ(tx.input_txid, write_->getFundings().front());
+    EXPECT_TRUE(tx.outputs.empty());
+    EXPECT_EQ(write_->getNumberOfAvailable(), 1u);
+}
+
+TEST_F(ReadWriteWalletTest, BurnToNewOwnerTest)
+{
+    auto key = stringToASCIIByteVec("umentry");
+    read_->addBlock({read_->makeBurnTx(OWNER,
+                                       createUMEntryCreationOpMetadata(UMEntry{key, VALUE}),
+                                       1000)});
+    ASSERT_TRUE(wallet_->getLookup().updateLookup());
+
+    auto unspent = write_->addUnspent(OWNER, 100000);
+    auto res = wallet_->transferOwnership(key, OTHER, BURN_AMOUNT);
+
+    ASSERT_TRUE(res);
+    ASSERT_EQ(write_->getSent().size(), 1u);
+
+    //the new owner receives the minimum amount
+    auto min_amount = getMinimumTxAmount(Coin::tOdin);
+    std::vector<std::pair<std::string, std::int64_t>> expected_outputs{
+        {OTHER, min_amount},
+        {OWNER, 100000 - BURN_AMOUNT - min_amount - FAKE_BURN_FEE}};
+
+    const auto& tx = write_->getSent().front();
+    EXPECT_EQ(tx.input_txid, unspent.getTxid());
+    EXPECT_EQ(tx.outputs, expected_outputs);
+    EXPECT_EQ(write_->getNumberOfLocked(), 0u);
+}
+
+TEST_F(ReadWriteWalletTest, FailedBurnTest)
+{
+    auto unspent = write_->addUnspent(OWNER, 100000);
+    write_->failSigningOf(unspent.getTxid());
+
+    auto res = wallet_->createNewUMEntry(stringToASCIIByteVec("umentry"),
+                                         VALUE,
+                                         OWNER,
+                                         BURN_AMOUNT);
+
+    EXPECT_FALSE(res);
+    EXPECT_TRUE(write_->getSent().empty());
+
+    //writeTxToBlockchain might have broadcast the transaction before
+    //it failed, so the output is released as spent and not selected again
+    std::vector<std::pair<std::string, bool>> expected_unlocked{
+        {unspent.getTxid(), true}};
+    EXPECT_EQ(write_->getUnlocked(), expected_unlocked);
+    EXPECT_EQ(write_->getNumberOfLocked(), 0u);
+    EXPECT_EQ(write_->getNumberOfAvailable(), 0u);
+}
+
+TEST_F(ReadWriteWalletTest, BulkPartialSigningFailureTest)
+{
+    auto id = stringToASCIIByteVec("token");
+    createToken(id);
+
+    write_->addUnspent(OWNER, 200000);
+    write_->addUnspent(OWNER, 200000);
+    auto failing = write_->addUnspent(SECOND_OWNER, 200000);
+    write_->failSigningOf(failing.getTxid());
+
+    //the transfer needs a transaction of both owners
+    std::vector<BulkOperation> operations;
+    operations.emplace_back(BulkTokenTransfer{id, OTHER, 80});
+    operations.emplace_back(BulkEntryCreation{UMEntry{stringToASCIIByteVec("umentry"), VALUE},
+                                              OWNER});
+
+    auto results = wallet_->submitBulk(std::move(operations), BURN_AMOUNT);
+
+    ASSERT_EQ(results.size(), 2u);
+    EXPECT_FALSE(results[0]);
+    ASSERT_TRUE(results[1]);
+    EXPECT_EQ(results[1].getValue().size(), 1u);
+
+    //no transaction of the failed transfer was sent,
+    //so both of its outputs can be used again
+    ASSERT_EQ(write_->getSent().size(), 1u);
+    EXPECT_EQ(write_->getSent().front().metadata,
+              createUMEntryCreationOpMetadata(UMEntry{stringToASCIIByteVec("umentry"), VALUE}));
+    EXPECT_EQ(write_->getNumberOfLocked(), 0u);
+    EXPECT_EQ(write_->getNumberOfAvailable(), 2u);
+}
+
+TEST_F(ReadWriteWalletTest, BulkPartialSendingFailureTest)
+{
+    auto id = stringToASCIIByteVec("token");
+    createToken(id);
+
+    write_->addUnspent(OWNER, 200000);
+    auto failing = write_->addUnspent(SECOND_OWNER, 200000);
+    write_->failSendingOf(failing.getTxid());
+
+    auto res = wallet_->transferUtilityTokens(id, OTHER, 80, BURN_AMOUNT);
+
+    //the transaction which was sent is part of the error
+    ASSERT_FALSE(res);
+    ASSERT_EQ(write_->getSent().size(), 1u);
+    EXPECT_NE(std::string{res.getError().what()}.find("already sent transactions: sent"),
+              std::string::npos);
+    EXPECT_EQ(write_->getNumberOfLocked(), 0u);
+}
+
+TEST_F(ReadWriteWalletTest, BulkFundingTest)
+{
+    //0.29 coins are parsed as 28999999 satoshis
+    constexpr std::int64_t burn_amount = 29000000 - FAKE_BURN_FEE;
+
+    std::vector<BulkOperation> operations;
+    operations.emplace_back(BulkEntryCreation{UMEntry{stringToASCIIByteVec("first"), VALUE},
+                                              OWNER});
+    operations.emplace_back(BulkEntryCreation{UMEntry{stringToASCIIByteVec("second"), VALUE},
+                                              SECOND_OWNER});
+
+    auto results = wallet_->submitBulk(std::move(operations), burn_amount);
+
+    ASSERT_EQ(results.size(), 2u);
+    EXPECT_TRUE(results[0]);
+    EXPECT_TRUE(results[1]);
+
+    //both owners are funded with one transaction,
+    //whose outputs cover the burns exactly
+    ASSERT_EQ(write_->getFundings().size(), 1u);
+    ASSERT_EQ(write_->getSent().size(), 2u);
+    for(const auto& tx : write_->getSent()) {
+        EXPECT_EQ(tx.input_txid, write_->getFundings().front());
+        EXPECT_EQ(tx.burn_value, burn_amount);
+        EXPECT_TRUE(tx.outputs.empty());
+    }
+
+    auto funding_res = read_->getTransaction(write_->getFundings().front());
+    ASSERT_TRUE(funding_res);
+    EXPECT_EQ(funding_res.getValue().getOutputs().front().getValue(), 28999999);
+}
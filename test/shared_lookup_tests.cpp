@@ -0,0 +1,188 @@
+#include <core/Transaction.hpp>
+#include <entrys/token/UtilityTokenOperation.hpp>
+#include <entrys/umentry/UMEntryOperation.hpp>
+#include <fcntl.h>
+#include <gtest/gtest.h>
+#include <lookup/SharedLookupLayout.hpp>
+#include <lookup/SharedLookupPublisher.hpp>
+#include <lookup/UMEntryLookup.hpp>
+#include <lookup/UniqueEntryLookup.hpp>
+#include <lookup/UtilityTokenLookup.hpp>
+#include <string>
+#include <sys/mman.h>
+#include <unistd.h>
+
+using namespace forge::core;
+using namespace forge::lookup;
+
+namespace {
+
+auto createUMOp(std::string&& data,
+                std::string&& owner,
+                std::int64_t block,
+                std::int64_t value)
+    -> UMEntryOperation
+{
+    auto metadata =
+        extractMetadata(std::move(data))
+            .getValue();
+
+    return parseMetadataToUMEntryOp(std::move(metadata),
+                                    block,
+                                    std::move(owner),
+                                    value)
+        .getValue();
+}
+
+auto createTokenOp(const std::string& op,
+                   std::int64_t block,
+                   std::string owner,
+                   std::int64_t burn_value)
+    -> UtilityTokenOperation
+{
+    auto metadata = stringToByteVec(op).getValue();
+
+    return parseMetadataToUtilityTokenOp(metadata,
+                                         block,
+                                         std::move(owner),
+                                         burn_value,
+                                         std::nullopt)
+        .getValue();
+}
+
+auto testRegionName()
+    -> std::string
+{
+    return "/forge-shared-lookup-test-" + std::to_string(::getpid());
+}
+
+} // namespace
+
+TEST(SharedLookupTest, PublishAndReadTest)
+{
+    UMEntryLookup um_lookup{nullptr, 0};
+    UniqueEntryLookup unique_lookup{nullptr, 0};
+    UtilityTokenLookup token_lookup{nullptr, 0};
+
+    um_lookup.executeOperations(
+        {createUMOp("6a00c6dc75010101aabbccdddeadbeef",
+                    "oLupzckPUYtGydsBisL86zcwsBweJm1dSM",
+                    10,
+                    10),
+         createUMOp("6a00c6dc750101040011223344",
+                    "oMaZKaWWyu6Zqrs5ck3DXgFbMEre7Jo58W",
+                    10,
+                    9)});
+
+    token_lookup.executeOperations(
+        {createTokenOp("c6dc75"
+                       "03"
+                       "01"
+                       "0000000000000003"
+                       "deadbeef",
+                       100,
+                       "oLupzckPUYtGydsBisL86zcwsBweJm1dSM",
+                       10)});
+
+    auto publisher_res = make_shared_lookup_publisher(testRegionName(), 64);
+    ASSERT_TRUE(publisher_res);
+    auto publisher = std::move(publisher_res.getValue());
+
+    //the initial region is too small and has to grow
+    ASSERT_TRUE(publisher->publish(um_lookup,
+                                   unique_lookup,
+                                   token_lookup,
+                                   42));
+
+    auto reader = SharedLookupReader::open(testRegionName());
+    ASSERT_TRUE(reader);
+
+    EXPECT_EQ(reader->getBlockHeight().getValue(), 42);
+
+    auto entry_res = reader->lookupUMEntry(stringToByteVec("deadbeef").getValue());
+    ASSERT_TRUE(entry_res);
+    const auto& entry = entry_res.getValue();
+    ASSERT_TRUE(entry);
+    EXPECT_EQ(entry->owner, "oLupzckPUYtGydsBisL86zcwsBweJm1dSM");
+    EXPECT_EQ(entry->block, 10);
+    EXPECT_EQ(static_cast<std::byte>(entry->value_flag), IPv4_VALUE_FLAG);
+    EXPECT_EQ(entry->value,
+              stringToByteVec("aabbccdd").getValue());
+
+    auto none_entry = reader->lookupUMEntry(stringToByteVec("0011223344").getValue()).getValue();
+    ASSERT_TRUE(none_entry);
+    EXPECT_EQ(static_cast<std::byte>(none_entry->value_flag), NONE_VALUE_FLAG);
+    EXPECT_TRUE(none_entry->value.empty());
+
+    EXPECT_FALSE(reader->lookupUMEntry(stringToByteVec("beef").getValue()).getValue());
+    EXPECT_FALSE(reader->lookupUniqueEntry(stringToByteVec("deadbeef").getValue()).getValue());
+
+    EXPECT_EQ(reader->getBalanceOf(stringToByteVec("deadbeef").getValue(),
+                                   "oLupzckPUYtGydsBisL86zcwsBweJm1dSM")
+                  .getValue(),
+              3);
+    EXPECT_EQ(reader->getBalanceOf(stringToByteVec("deadbeef").getValue(),
+                                   "oMaZKaWWyu6Zqrs5ck3DXgFbMEre7Jo58W")
+                  .getValue(),
+              0);
+
+    //a new snapshot replaces the old one
+    um_lookup.clear();
+    ASSERT_TRUE(publisher->publish(um_lookup,
+                                   unique_lookup,
+                                   token_lookup,
+                                   43));
+
+    EXPECT_EQ(reader->getBlockHeight().getValue(), 43);
+    EXPECT_FALSE(reader->lookupUMEntry(stringToByteVec("deadbeef").getValue()).getValue());
+}
+
+TEST(SharedLookupTest, UnfinishedSnapshotTest)
+{
+    auto publisher_res = make_shared_lookup_publisher(testRegionName());
+    ASSERT_TRUE(publisher_res);
+
+    //a forged which died while publishing leaves an odd sequence
+    auto fd = ::shm_open(testRegionName().c_str(), O_RDWR, 0);
+    ASSERT_GE(fd, 0);
+    auto* base = ::mmap(nullptr, sizeof(SharedLookupHeader), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ASSERT_NE(base, MAP_FAILED);
+    static_cast<SharedLookupHeader*>(base)->sequence.store(1);
+
+    auto reader = SharedLookupReader::open(testRegionName());
+    ASSERT_TRUE(reader);
+
+    auto height_res = reader->getBlockHeight();
+    ASSERT_FALSE(height_res);
+    EXPECT_EQ(height_res.getError(), SharedReadError::Timeout);
+
+    ::munmap(base, sizeof(SharedLookupHeader));
+    ::close(fd);
+}
+
+TEST(SharedLookupTest, ReplacedRegionTest)
+{
+    auto publisher_res = make_shared_lookup_publisher(testRegionName());
+    ASSERT_TRUE(publisher_res);
+    auto publisher = std::move(publisher_res.getValue());
+
+    auto reader = SharedLookupReader::open(testRegionName());
+    ASSERT_TRUE(reader);
+    EXPECT_FALSE(reader->isReplaced());
+
+    //a restarted forged creates a new region under the same name
+    auto restarted_res = make_shared_lookup_publisher(testRegionName());
+    ASSERT_TRUE(restarted_res);
+    EXPECT_TRUE(reader->isReplaced());
+    EXPECT_TRUE(reader->getBlockHeight());
+
+    //a forged which shut down closes its region
+    auto restarted_reader = SharedLookupReader::open(testRegionName());
+    ASSERT_TRUE(restarted_reader);
+    restarted_res.getValue().reset();
+
+    auto height_res = restarted_reader->getBlockHeight();
+    ASSERT_FALSE(height_res);
+    EXPECT_EQ(height_res.getError(), SharedReadError::Closed);
+    EXPECT_TRUE(restarted_reader->isReplaced());
+}
@@ -0,0 +1,35 @@
+#include <gtest/gtest.h>
+#include <wallet/TokenSendPlan.hpp>
+
+using namespace forge::wallet;
+
+TEST(TokenSendPlanTest, LargestBalancesFirstTest)
+{
+    TokenBalances balances{{"a", 10},
+                           {"b", 60},
+                           {"c", 30},
+                           {"d", 0}};
+
+    //a and c together would need a third address
+    auto plan = planTokenSends(balances, 80);
+    ASSERT_TRUE(plan);
+
+    TokenBalances expected{{"b", 60},
+                           {"c", 20}};
+    EXPECT_EQ(plan.getValue(), expected);
+}
+
+TEST(TokenSendPlanTest, EqualBalancesOrderedByAddressTest)
+{
+    auto plan = planTokenSends({{"b", 5}, {"a", 5}}, 5);
+    ASSERT_TRUE(plan);
+
+    TokenBalances expected{{"a", 5}};
+    EXPECT_EQ(plan.getValue(), expected);
+}
+
+TEST(TokenSendPlanTest, InsufficientBalancesTest)
+{
+    EXPECT_FALSE(planTokenSends({{"a", 5}, {"b", 5}}, 11));
+    EXPECT_FALSE(planTokenSends({}, 1));
+}
@@ -7,6 +7,7 @@ using forge::core::buildTxIn;
 using forge::core::buildTxOut;
 using forge::core::buildTransaction;
 using forge::core::stringToByteVec;
+using forge::core::toHexString;
 using forge::core::extractMetadata;
 using forge::core::metadataStartsWithForgeId;
 
@@ -418,6 +419,32 @@ TEST(TransactionTest, StringToByteVecInvalid)
     EXPECT_FALSE(fourth_invalid);
 }
 
+TEST(TransactionTest, HexRoundTrip)
+{
+    const std::string digits{"0123456789abcdef"};
+
+    //every byte value and sizes around the 16 byte blocks
+    //of the vectorized encoder
+    for(std::size_t size : {0, 1, 15, 16, 17, 32, 33, 256}) {
+        std::vector<std::byte> bytes;
+        std::string expected;
+
+        for(std::size_t i = 0; i < size; i++) {
+            auto value = static_cast<std::uint8_t>(i * 7 + size);
+            bytes.push_back(static_cast<std::byte>(value));
+            expected += digits[value >> 4];
+            expected += digits[value & 0x0F];
+        }
+
+        auto hex = toHexString(bytes);
+        EXPECT_EQ(hex, expected);
+
+        auto decoded = stringToByteVec(hex);
+        ASSERT_TRUE(decoded);
+        EXPECT_EQ(decoded.getValue(), bytes);
+    }
+}
+
 TEST(TransactionTest, StartsWithIdCheckValid)
 {
     auto first_valid = stringToByteVec("C6DC75a109A924fb7a90f305881fb9c8c5bd024673456af12e3651c27668a6B79707ad");
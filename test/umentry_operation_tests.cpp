@@ -245,3 +245,37 @@ TEST(UMEntryOperationTest, DeletionOpMetadataCreation)
 
     EXPECT_EQ(created_metadata, expected_metadata);
 }
+
+TEST(UMEntryOperationTest, ByteArrayOpRoundTrip)
+{
+    std::vector key{(std::byte)0xde, (std::byte)0xad};
+    std::vector value{(std::byte)0x01, (std::byte)0x02, (std::byte)0x03};
+    auto op = UMEntryOperation{
+        UMEntryUpdateOp{UMEntry{key, UMEntryValue{value}},
+                        "oLupzckPUYtGydsBisL86zcwsBweJm1dSM"s,
+                        1000,
+                        10}};
+
+    auto metadata = toMetadata(op);
+    EXPECT_EQ(metadata, stringToByteVec("c6dc7501080803010203dead").getValue());
+
+    auto op_opt = parseMetadataToUMEntryOp(metadata,
+                                           1000,
+                                           "oLupzckPUYtGydsBisL86zcwsBweJm1dSM"s,
+                                           10);
+
+    ASSERT_TRUE(op_opt);
+    EXPECT_EQ(getUMEntry(op_opt.getValue()), getUMEntry(op));
+}
+
+TEST(UMEntryOperationTest, UnknownOpFlagParsingInvalid)
+{
+    auto metadata = extractMetadata("6a00c6dc75012001aabbccdddeadbeef").getValue();
+
+    auto op_opt = parseMetadataToUMEntryOp(metadata,
+                                           1000,
+                                           "oLupzckPUYtGydsBisL86zcwsBweJm1dSM"s,
+                                           10);
+
+    EXPECT_FALSE(op_opt);
+}
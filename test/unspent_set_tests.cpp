@@ -0,0 +1,87 @@
+#include <client/UnspentSet.hpp>
+#include <core/Transaction.hpp>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+using namespace forge::client;
+using forge::core::Unspent;
+
+namespace {
+
+auto makeUnspent(std::int64_t value,
+                 std::string address,
+                 std::string txid)
+    -> Unspent
+{
+    return Unspent{value,
+                   0,
+                   100,
+                   std::move(address),
+                   std::move(txid)};
+}
+
+} // namespace
+
+TEST(UnspentSetTest, LockSmallestOutputTest)
+{
+    UnspentSet set;
+    set.reset({makeUnspent(500, "a", "tx1"),
+               makeUnspent(150, "b", "tx2"),
+               makeUnspent(120, "a", "tx3"),
+               makeUnspent(100, "b", "tx4")},
+              10);
+
+    //120 would leave less than the minimum change
+    auto output = set.lock(100, 50, std::nullopt);
+    ASSERT_TRUE(output);
+    EXPECT_EQ(output.getValue().getTxid(), "tx4");
+
+    output = set.lock(100, 50, std::nullopt);
+    ASSERT_TRUE(output);
+    EXPECT_EQ(output.getValue().getTxid(), "tx2");
+
+    output = set.lock(100, 50, std::string{"a"});
+    ASSERT_TRUE(output);
+    EXPECT_EQ(output.getValue().getTxid(), "tx1");
+
+    EXPECT_FALSE(set.lock(100, 50, std::string{"a"}));
+    EXPECT_EQ(set.size(), 1);
+}
+
+TEST(UnspentSetTest, LockedOutputsAreNotSelectedTwiceTest)
+{
+    UnspentSet set;
+    set.reset({makeUnspent(100, "a", "tx1")}, 10);
+
+    auto output = set.lock(100, 0, std::nullopt);
+    ASSERT_TRUE(output);
+    EXPECT_FALSE(set.lock(100, 0, std::nullopt));
+
+    //a refresh which still lists the locked output does not free it
+    set.reset({makeUnspent(100, "a", "tx1")}, 11);
+    EXPECT_FALSE(set.lock(100, 0, std::nullopt));
+
+    set.unlock(output.getValue(), false);
+    EXPECT_TRUE(set.lock(100, 0, std::nullopt));
+}
+
+TEST(UnspentSetTest, SpentOutputsAreDroppedTest)
+{
+    UnspentSet set;
+    set.reset({makeUnspent(100, "a", "tx1")}, 10);
+
+    auto output = set.lock(100, 0, std::nullopt);
+    ASSERT_TRUE(output);
+    set.unlock(output.getValue(), true);
+
+    EXPECT_EQ(set.size(), 0);
+
+    //adding known outputs does not duplicate them
+    set.add({makeUnspent(200, "b", "tx2"),
+             makeUnspent(200, "b", "tx2")},
+            12);
+    EXPECT_EQ(set.size(), 1);
+    EXPECT_EQ(set.getHeight().getValue(), 12);
+    EXPECT_EQ(set.getResetHeight().getValue(), 10);
+}
@@ -0,0 +1,341 @@
+#include "fake_clients.hpp"
+#include <core/Transaction.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <entrys/Entry.hpp>
+#include <entrys/EntryOperation.hpp>
+#include <entrys/token/UtilityToken.hpp>
+#include <entrys/token/UtilityTokenCreationOp.hpp>
+#include <entrys/token/UtilityTokenOwnershipTransferOp.hpp>
+#include <entrys/uentry/UniqueEntry.hpp>
+#include <entrys/uentry/UniqueEntryCreationOp.hpp>
+#include <entrys/umentry/UMEntry.hpp>
+#include <entrys/umentry/UMEntryCreationOp.hpp>
+#include <gtest/gtest.h>
+#include <lookup/LookupChangeSet.hpp>
+#include <lookup/LookupManager.hpp>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <wallet/AddressBook.hpp>
+#include <wallet/ReadOnlyWallet.hpp>
+#include <wallet/WalletView.hpp>
+
+using namespace forge::core;
+using namespace forge::lookup;
+using namespace forge::wallet;
+
+namespace {
+
+const auto OWNER = std::string{"oLupzckPUYtGydsBisL86zcwsBweJm1dSM"};
+const auto OTHER = std::string{"oMaZKaWWyu6Zqrs5ck3DXgFbMEre7Jo58W"};
+
+const auto UM_KEY = stringToASCIIByteVec("umentry");
+const auto UNIQUE_KEY = stringToASCIIByteVec("unique");
+const auto TOKEN_ID = stringToASCIIByteVec("token");
+const auto VALUE = UMEntryValue{ByteArray{std::byte{0x01}}};
+
+auto umKeys(const std::vector<UMEntry>& entrys)
+    -> std::vector<EntryKey>
+{
+    std::vector<EntryKey> keys;
+    for(const auto& entry : entrys) {
+        keys.push_back(entry.getKey());
+    }
+    return keys;
+}
+
+auto uniqueKeys(const std::vector<UniqueEntry>& entrys)
+    -> std::vector<EntryKey>
+{
+    std::vector<EntryKey> keys;
+    for(const auto& entry : entrys) {
+        keys.push_back(entry.getKey());
+    }
+    return keys;
+}
+
+//the tokens of a view which only holds a balance of TOKEN_ID
+auto tokenBalance(std::uint64_t amount)
+    -> std::vector<UtilityToken>
+{
+    return {UtilityToken{TOKEN_ID, amount}};
+}
+
+auto rebuildView(const LookupManager& lookup,
+                 const AddressSet& addresses)
+    -> WalletView
+{
+    WalletView view;
+    for(const auto& addr : addresses) {
+        view.addAddress(lookup, addr);
+    }
+    return view;
+}
+
+auto expectSameAsRebuild(const WalletView& view,
+                         const LookupManager& lookup,
+                         const AddressSet& addresses)
+    -> void
+{
+    auto rebuild = rebuildView(lookup, addresses);
+
+    EXPECT_EQ(umKeys(view.getUMEntrys(lookup)),
+              umKeys(rebuild.getUMEntrys(lookup)));
+    EXPECT_EQ(uniqueKeys(view.getUniqueEntrys(lookup)),
+              uniqueKeys(rebuild.getUniqueEntrys(lookup)));
+    EXPECT_EQ(view.getUtilityTokens(lookup),
+              rebuild.getUtilityTokens(lookup));
+}
+
+//creates an um entry, a unique entry and a token owned by OWNER
+auto addCreationBlock(FakeReadOnlyClient* fake)
+    -> void
+{
+    fake->addBlock({fake->makeBurnTx(OWNER,
+                                     createUMEntryCreationOpMetadata(UMEntry{UM_KEY, VALUE}),
+                                     1000),
+                    fake->makeBurnTx(OWNER,
+                                     createUniqueEntryCreationOpMetadata(UniqueEntry{UNIQUE_KEY, VALUE}),
+                                     1000),
+                    fake->makeBurnTx(OWNER,
+                                     createUtilityTokenCreationOpMetadata(UtilityToken{TOKEN_ID, 100}),
+                                     1000)});
+}
+
+//moves the um entry and 40 tokens to OTHER and deletes the unique entry
+auto addTransferBlock(FakeReadOnlyClient* fake)
+    -> void
+{
+    fake->addBlock({fake->makeBurnTx(OWNER,
+                                     createOwnershipTransferOpMetadata(Entry{UMEntry{UM_KEY, VALUE}}),
+                                     1000,
+                                     OTHER),
+                    fake->makeBurnTx(OWNER,
+                                     createUtilityTokenOwnershipTransferOpMetadata(UtilityToken{TOKEN_ID, 40}),
+                                     1000,
+                                     OTHER),
+                    fake->makeBurnTx(OWNER,
+                                     createDeletionOpMetadata(Entry{UniqueEntry{UNIQUE_KEY, VALUE}}),
+                                     1000)});
+}
+
+class WalletViewTest : public ::testing::Test
+{
+protected:
+    WalletViewTest()
+    {
+        auto client = std::make_unique<FakeReadOnlyClient>();
+        fake_ = client.get();
+        lookup_ = std::make_unique<LookupManager>(std::move(client));
+        generation_ = lookup_->getChangeSetGeneration();
+    }
+
+    //processes the new blocks and applies their change sets to both views
+    auto update()
+        -> void
+    {
+        ASSERT_TRUE(lookup_->updateLookup());
+
+        auto change_sets_opt = lookup_->getChangeSetsSince(generation_);
+        ASSERT_TRUE(change_sets_opt);
+
+        for(const auto& change_set : change_sets_opt.getValue()) {
+            owned_view_.apply(*lookup_, change_set, owned_);
+            watched_view_.apply(*lookup_, change_set, watched_);
+        }
+
+        generation_ = lookup_->getChangeSetGeneration();
+    }
+
+    FakeReadOnlyClient* fake_;
+    std::unique_ptr<LookupManager> lookup_;
+    std::uint64_t generation_;
+
+    AddressSet owned_{OWNER};
+    AddressSet watched_{OTHER};
+    WalletView owned_view_;
+    WalletView watched_view_;
+};
+
+} // namespace
+
+TEST_F(WalletViewTest, ApplyCreationTest)
+{
+    addCreationBlock(fake_);
+    update();
+
+    EXPECT_EQ(umKeys(owned_view_.getUMEntrys(*lookup_)),
+              std::vector<EntryKey>{UM_KEY});
+    EXPECT_EQ(uniqueKeys(owned_view_.getUniqueEntrys(*lookup_)),
+              std::vector<EntryKey>{UNIQUE_KEY});
+    EXPECT_EQ(owned_view_.getUtilityTokens(*lookup_),
+              tokenBalance(100));
+
+    EXPECT_TRUE(watched_view_.getUMEntrys(*lookup_).empty());
+    EXPECT_TRUE(watched_view_.getUniqueEntrys(*lookup_).empty());
+    EXPECT_TRUE(watched_view_.getUtilityTokens(*lookup_).empty());
+
+    expectSameAsRebuild(owned_view_, *lookup_, owned_);
+    expectSameAsRebuild(watched_view_, *lookup_, watched_);
+}
+
+TEST_F(WalletViewTest, ApplyTransferAndDeletionTest)
+{
+    addCreationBlock(fake_);
+    update();
+    addTransferBlock(fake_);
+    update();
+
+    EXPECT_TRUE(owned_view_.getUMEntrys(*lookup_).empty());
+    EXPECT_TRUE(owned_view_.getUniqueEntrys(*lookup_).empty());
+    EXPECT_EQ(owned_view_.getUtilityTokens(*lookup_),
+              tokenBalance(60));
+
+    EXPECT_EQ(umKeys(watched_view_.getUMEntrys(*lookup_)),
+              std::vector<EntryKey>{UM_KEY});
+    EXPECT_TRUE(watched_view_.getUniqueEntrys(*lookup_).empty());
+    EXPECT_EQ(watched_view_.getUtilityTokens(*lookup_),
+              tokenBalance(40));
+
+    expectSameAsRebuild(owned_view_, *lookup_, owned_);
+    expectSameAsRebuild(watched_view_, *lookup_, watched_);
+
+    //the entry moves back and the whole balance of OTHER is spent
+    fake_->addBlock({fake_->makeBurnTx(OTHER,
+                                       createOwnershipTransferOpMetadata(Entry{UMEntry{UM_KEY, VALUE}}),
+                                       1000,
+                                       OWNER),
+                     fake_->makeBurnTx(OTHER,
+                                       createUtilityTokenOwnershipTransferOpMetadata(UtilityToken{TOKEN_ID, 40}),
+                                       1000,
+                                       OWNER)});
+    update();
+
+    EXPECT_EQ(umKeys(owned_view_.getUMEntrys(*lookup_)),
+              std::vector<EntryKey>{UM_KEY});
+    EXPECT_EQ(owned_view_.getUtilityTokens(*lookup_),
+              tokenBalance(100));
+    EXPECT_TRUE(watched_view_.getUMEntrys(*lookup_).empty());
+    EXPECT_TRUE(watched_view_.getUtilityTokens(*lookup_).empty());
+
+    expectSameAsRebuild(owned_view_, *lookup_, owned_);
+    expectSameAsRebuild(watched_view_, *lookup_, watched_);
+}
+
+TEST_F(WalletViewTest, AddAndRemoveAddressTest)
+{
+    addCreationBlock(fake_);
+    update();
+    addTransferBlock(fake_);
+    update();
+
+    owned_.insert(OTHER);
+    owned_view_.addAddress(*lookup_, OTHER);
+
+    EXPECT_EQ(umKeys(owned_view_.getUMEntrys(*lookup_)),
+              std::vector<EntryKey>{UM_KEY});
+    EXPECT_EQ(owned_view_.getUtilityTokens(*lookup_).size(), 2u);
+    expectSameAsRebuild(owned_view_, *lookup_, owned_);
+
+    owned_.erase(OTHER);
+    owned_view_.removeAddress(*lookup_, OTHER);
+
+    EXPECT_TRUE(owned_view_.getUMEntrys(*lookup_).empty());
+    EXPECT_EQ(owned_view_.getUtilityTokens(*lookup_),
+              tokenBalance(60));
+    expectSameAsRebuild(owned_view_, *lookup_, owned_);
+}
+
+TEST(ReadOnlyWalletViewTest, RebuildAfterLookupRebuildTest)
+{
+    auto client = std::make_unique<FakeReadOnlyClient>();
+    auto* fake = client.get();
+
+    AddressBook book;
+    book.addOwned(OWNER);
+    book.addWatched(OTHER);
+
+    ReadOnlyWallet wallet{std::make_unique<LookupManager>(std::move(client)),
+                          std::move(book)};
+
+    addCreationBlock(fake);
+    ASSERT_TRUE(wallet.getLookup().updateLookup());
+    EXPECT_EQ(umKeys(wallet.getOwnedUMEntrys()), std::vector<EntryKey>{UM_KEY});
+
+    //the change sets of the lookup are dropped by the rebuild,
+    //so the wallet has to materialize its views again
+    addTransferBlock(fake);
+    ASSERT_TRUE(wallet.getLookup().rebuildLookup());
+    ASSERT_FALSE(wallet.getLookup().getChangeSetsSince(0));
+
+    EXPECT_TRUE(wallet.getOwnedUMEntrys().empty());
+    EXPECT_TRUE(wallet.getOwnedUniqueEntrys().empty());
+    EXPECT_EQ(umKeys(wallet.getWatchOnlyUMEntrys()), std::vector<EntryKey>{UM_KEY});
+    EXPECT_EQ(wallet.getOwnedUtilityTokens(),
+              tokenBalance(60));
+    EXPECT_EQ(wallet.getWatchOnlyUtilityTokens(),
+              tokenBalance(40));
+}
+
+TEST(ReadOnlyWalletViewTest, RebuildAfterFallingBehindTest)
+{
+    auto client = std::make_unique<FakeReadOnlyClient>();
+    auto* fake = client.get();
+
+    AddressBook book;
+    book.addOwned(OWNER);
+    book.addWatched(OTHER);
+
+    ReadOnlyWallet wallet{std::make_unique<LookupManager>(std::move(client)),
+                          std::move(book)};
+
+    addCreationBlock(fake);
+    ASSERT_TRUE(wallet.getLookup().updateLookup());
+    EXPECT_EQ(umKeys(wallet.getOwnedUMEntrys()), std::vector<EntryKey>{UM_KEY});
+
+    //the change set of the transfer is evicted
+    //before the wallet is queried again
+    addTransferBlock(fake);
+    for(std::size_t i = 0; i < MAX_LOOKUP_CHANGE_SETS; i++) {
+        fake->addBlock({});
+    }
+    ASSERT_TRUE(wallet.getLookup().updateLookup());
+
+    EXPECT_TRUE(wallet.getOwnedUMEntrys().empty());
+    EXPECT_EQ(umKeys(wallet.getWatchOnlyUMEntrys()), std::vector<EntryKey>{UM_KEY});
+    EXPECT_EQ(wallet.getOwnedUtilityTokens(),
+              tokenBalance(60));
+    EXPECT_EQ(wallet.getWatchOnlyUtilityTokens(),
+              tokenBalance(40));
+}
+
+TEST(ReadOnlyWalletViewTest, ConcurrentAddressesTest)
+{
+    AddressBook book;
+    book.addOwned(OWNER);
+
+    ReadOnlyWallet wallet{std::make_unique<LookupManager>(std::make_unique<FakeReadOnlyClient>()),
+                          std::move(book)};
+
+    //the readers get copies, which stay valid
+    //while the sets of the wallet grow
+    std::thread writer{[&] {
+        for(int i = 0; i < 1000; i++) {
+            wallet.addWatchOnlyAddress(std::to_string(i));
+        }
+    }};
+
+    std::size_t last_size{0};
+    while(last_size < 1000) {
+        auto addresses = wallet.getWatchedAddresses();
+        EXPECT_GE(addresses.size(), last_size);
+        last_size = addresses.size();
+        EXPECT_TRUE(wallet.ownesAddress(OWNER));
+    }
+
+    writer.join();
+    EXPECT_EQ(wallet.getOwnedAddresses(), AddressSet{OWNER});
+}